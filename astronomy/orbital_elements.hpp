@@ -26,6 +26,7 @@ using quantities::AngularFrequency;
 using quantities::Difference;
 using quantities::Infinity;
 using quantities::Length;
+using quantities::Product;
 using quantities::Time;
 
 class OrbitalElements {
@@ -36,6 +37,24 @@ class OrbitalElements {
       MassiveBody const& primary,
       Body const& secondary);
 
+  // Same as above, but reuses the osculating elements of |previous| at the
+  // times of |trajectory| where they exist, except for the first point of
+  // |trajectory|, so that only that point and the points of |trajectory| after
+  // the last osculating elements of |previous| need to be processed.  If
+  // |previous| starts with the same osculating elements as |trajectory|, its
+  // running integrals are extended instead of being recomputed, and the result
+  // is identical to that of the above function; otherwise the mean longitudes
+  // may differ by a multiple of 2π, and the result is the same up to rounding.
+  // |previous| must have been computed for the same |primary| and |secondary|
+  // from a trajectory that agrees with |trajectory| on their common times after
+  // the first time of |trajectory|; the first points may differ.
+  template<typename PrimaryCentred>
+  static StatusOr<OrbitalElements> ForTrajectory(
+      DiscreteTrajectory<PrimaryCentred> const& trajectory,
+      MassiveBody const& primary,
+      Body const& secondary,
+      OrbitalElements const& previous);
+
   // The classical Keplerian elements (a, e, i, Ω, ω, M),
   // together with an epoch.
   struct ClassicalElements {
@@ -130,23 +149,50 @@ class OrbitalElements {
   std::vector<EquinoctialElements> const& mean_equinoctial_elements() const;
 
  private:
+  // The integrals of the osculating equinoctial elements from the first
+  // osculating elements to |t_max|.
+  struct IntegratedEquinoctialElements {
+    Instant t_max;
+    Product<Length, Time> ʃ_a_dt;
+    Time ʃ_h_dt;
+    Time ʃ_k_dt;
+    Product<Angle, Time> ʃ_λ_dt;
+    Time ʃ_p_dt;
+    Time ʃ_q_dt;
+    Time ʃ_pʹ_dt;
+    Time ʃ_qʹ_dt;
+  };
+
   OrbitalElements() = default;
 
+  // Appends to |osculating| the osculating elements for the points of
+  // |trajectory| in [begin, end[.  Large ranges are processed in parallel.
   template<typename PrimaryCentred>
-  static std::vector<EquinoctialElements> OsculatingEquinoctialElements(
-      DiscreteTrajectory<PrimaryCentred> const& trajectory,
+  static void AppendOsculatingEquinoctialElements(
+      typename DiscreteTrajectory<PrimaryCentred>::Iterator begin,
+      typename DiscreteTrajectory<PrimaryCentred>::Iterator end,
       MassiveBody const& primary,
-      Body const& secondary);
+      Body const& secondary,
+      std::vector<EquinoctialElements>& osculating);
+
+  // Extends the running integrals |integrals| so that they have one entry for
+  // each element of |osculating|.  |integrals| must have been computed for a
+  // prefix of |osculating|.
+  static void IntegrateEquinoctialElements(
+      std::vector<EquinoctialElements> const& osculating,
+      std::vector<IntegratedEquinoctialElements>& integrals);
 
   // |equinoctial_elements| must contain at least 2 elements.
   static Time SiderealPeriod(
       std::vector<EquinoctialElements> const& equinoctial_elements);
 
-  // |osculating| must contain at least 2 elements.
+  // |osculating| must contain at least 2 elements, and |integrals| must be
+  // their running integrals.
   // The resulting elements are averaged over one period, centred on
   // their |EquinoctialElements::t|.
   static std::vector<EquinoctialElements> MeanEquinoctialElements(
       std::vector<EquinoctialElements> const& osculating,
+      std::vector<IntegratedEquinoctialElements> const& integrals,
       Time const& period);
 
   static std::vector<ClassicalElements> ToClassicalElements(
@@ -163,6 +209,7 @@ class OrbitalElements {
   void ComputeMeanElementIntervals();
 
   std::vector<EquinoctialElements> osculating_equinoctial_elements_;
+  std::vector<IntegratedEquinoctialElements> osculating_integrals_;
   Time sidereal_period_;
   std::vector<EquinoctialElements> mean_equinoctial_elements_;
   std::vector<ClassicalElements> mean_classical_elements_;
@@ -3,8 +3,15 @@
 #include "astronomy/orbital_elements.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "base/thread_pool.hpp"
+#include "glog/logging.h"
 #include "physics/kepler_orbit.hpp"
 #include "quantities/elementary_functions.hpp"
 
@@ -14,6 +21,7 @@ namespace internal_orbital_elements {
 
 using base::Error;
 using base::Status;
+using base::ThreadPool;
 using geometry::Velocity;
 using physics::DegreesOfFreedom;
 using physics::KeplerOrbit;
@@ -21,7 +29,6 @@ using quantities::ArcTan;
 using quantities::Cos;
 using quantities::Mod;
 using quantities::Pow;
-using quantities::Product;
 using quantities::Sin;
 using quantities::Sqrt;
 using quantities::Square;
@@ -29,18 +36,96 @@ using quantities::Tan;
 using quantities::UnwindFrom;
 using quantities::si::Radian;
 
+// Below this number of points the osculating elements are computed
+// sequentially; above it they are computed in chunks of this size on a
+// thread pool.
+constexpr std::int64_t osculating_elements_chunk_size = 1 << 12;
+
+// The pool on which the chunks are computed.  It is shared by all the calls,
+// which happen at every analysis, so that they don't each create and join
+// threads.
+inline ThreadPool<void>& OsculatingElementsPool() {
+  static auto* const pool = new ThreadPool<void>(
+      std::max<std::int64_t>(1, std::thread::hardware_concurrency()));
+  return *pool;
+}
+
 template<typename PrimaryCentred>
 StatusOr<OrbitalElements> OrbitalElements::ForTrajectory(
     DiscreteTrajectory<PrimaryCentred> const& trajectory,
     MassiveBody const& primary,
     Body const& secondary) {
+  return ForTrajectory(trajectory, primary, secondary, OrbitalElements());
+}
+
+template<typename PrimaryCentred>
+StatusOr<OrbitalElements> OrbitalElements::ForTrajectory(
+    DiscreteTrajectory<PrimaryCentred> const& trajectory,
+    MassiveBody const& primary,
+    Body const& secondary,
+    OrbitalElements const& previous) {
   OrbitalElements orbital_elements;
   if (trajectory.Size() < 2) {
     return Status(Error::INVALID_ARGUMENT,
                   "trajectory.Size() is " + std::to_string(trajectory.Size()));
   }
-  orbital_elements.osculating_equinoctial_elements_ =
-      OsculatingEquinoctialElements(trajectory, primary, secondary);
+
+  auto& osculating = orbital_elements.osculating_equinoctial_elements_;
+  auto& integrals = orbital_elements.osculating_integrals_;
+
+  // The first point of |trajectory| need not agree with the trajectory of
+  // |previous|, so its osculating elements are always computed.
+  auto it = trajectory.begin();
+  ++it;
+  AppendOsculatingEquinoctialElements<PrimaryCentred>(
+      trajectory.begin(), it, primary, secondary, osculating);
+
+  // Find the osculating elements of |previous| that may be reused, i.e., those
+  // at the same times as the next points of |trajectory|.
+  auto const& previous_osculating = previous.osculating_equinoctial_elements_;
+  auto previous_it = std::lower_bound(
+      previous_osculating.begin(),
+      previous_osculating.end(),
+      it->time,
+      [](EquinoctialElements const& elements, Instant const& t) {
+        return elements.t < t;
+      });
+  auto const first_reused = previous_it;
+  for (; it != trajectory.end() &&
+         previous_it != previous_osculating.end() &&
+         it->time == previous_it->t;
+       ++it, ++previous_it) {}
+  osculating.insert(osculating.end(), first_reused, previous_it);
+  if (osculating.size() > 1) {
+    // The mean longitudes of |previous| were unwound from its own first
+    // element.
+    osculating[0].λ = UnwindFrom(osculating[1].λ, osculating[0].λ);
+  }
+
+  // The running integrals at an element only depend on the elements up to it,
+  // so those of |previous| may be extended if the elements of |previous| that
+  // we use are a prefix of its elements, i.e., if it has the same first
+  // element.
+  if (first_reused != previous_osculating.begin() &&
+      first_reused - 1 == previous_osculating.begin()) {
+    EquinoctialElements const& first = osculating.front();
+    EquinoctialElements const& previous_first = previous_osculating.front();
+    if (first.t == previous_first.t && first.a == previous_first.a &&
+        first.h == previous_first.h && first.k == previous_first.k &&
+        first.λ == previous_first.λ && first.p == previous_first.p &&
+        first.q == previous_first.q && first.pʹ == previous_first.pʹ &&
+        first.qʹ == previous_first.qʹ) {
+      auto const& previous_integrals = previous.osculating_integrals_;
+      integrals.assign(previous_integrals.begin(),
+                       previous_integrals.begin() +
+                           (previous_it - previous_osculating.begin()));
+    }
+  }
+
+  AppendOsculatingEquinoctialElements<PrimaryCentred>(
+      it, trajectory.end(), primary, secondary, osculating);
+  IntegrateEquinoctialElements(osculating, integrals);
+
   orbital_elements.sidereal_period_ =
       SiderealPeriod(orbital_elements.osculating_equinoctial_elements_);
   if (!IsFinite(orbital_elements.sidereal_period_)) {
@@ -51,6 +136,7 @@ StatusOr<OrbitalElements> OrbitalElements::ForTrajectory(
   }
   orbital_elements.mean_equinoctial_elements_ =
       MeanEquinoctialElements(orbital_elements.osculating_equinoctial_elements_,
+                              orbital_elements.osculating_integrals_,
                               orbital_elements.sidereal_period_);
   if (orbital_elements.mean_equinoctial_elements_.size() < 2) {
     return Status(
@@ -112,40 +198,86 @@ inline Interval<Angle> OrbitalElements::mean_argument_of_periapsis_interval()
 }
 
 template<typename PrimaryCentred>
-std::vector<OrbitalElements::EquinoctialElements>
-OrbitalElements::OsculatingEquinoctialElements(
-    DiscreteTrajectory<PrimaryCentred> const& trajectory,
+void OrbitalElements::AppendOsculatingEquinoctialElements(
+    typename DiscreteTrajectory<PrimaryCentred>::Iterator const begin,
+    typename DiscreteTrajectory<PrimaryCentred>::Iterator const end,
     MassiveBody const& primary,
-    Body const& secondary) {
+    Body const& secondary,
+    std::vector<EquinoctialElements>& osculating) {
+  // The iteration over the trajectory is sequential, so we first copy the
+  // points to a vector that may be processed in chunks.
+  std::vector<std::pair<Instant, DegreesOfFreedom<PrimaryCentred>>> points;
+  for (auto it = begin; it != end; ++it) {
+    points.emplace_back(it->time, it->degrees_of_freedom);
+  }
+  std::int64_t const first = osculating.size();
+  osculating.resize(first + points.size());
+
   DegreesOfFreedom<PrimaryCentred> const primary_dof{
       PrimaryCentred::origin, Velocity<PrimaryCentred>{}};
-  std::vector<EquinoctialElements> result;
-  for (auto const& [time, degrees_of_freedom] : trajectory) {
-    auto const osculating_elements =
-        KeplerOrbit<PrimaryCentred>(primary,
-                                    secondary,
-                                    degrees_of_freedom - primary_dof,
-                                    time)
-            .elements_at_epoch();
-    double const& e = *osculating_elements.eccentricity;
-    Angle const& ϖ = *osculating_elements.longitude_of_periapsis;
-    Angle const& Ω = osculating_elements.longitude_of_ascending_node;
-    Angle const& M = *osculating_elements.mean_anomaly;
-    Angle const& i = osculating_elements.inclination;
-    double const tg_½i = Tan(i / 2);
-    double const cotg_½i = 1 / tg_½i;
-    result.push_back(
-        {/*.t = */ time,
-         /*.a = */ *osculating_elements.semimajor_axis,
-         /*.h = */ e * Sin(ϖ),
-         /*.k = */ e * Cos(ϖ),
-         /*.λ = */ result.empty() ? ϖ + M : UnwindFrom(result.back().λ, ϖ + M),
-         /*.p = */ tg_½i * Sin(Ω),
-         /*.q = */ tg_½i * Cos(Ω),
-         /*.pʹ = */ cotg_½i * Sin(Ω),
-         /*.qʹ = */ cotg_½i * Cos(Ω)});
+  // Computes the elements for |points[begin_index, end_index[|.  The mean
+  // longitudes are not unwound, since this requires the previous element.
+  auto const compute = [first,
+                        &osculating,
+                        &points,
+                        &primary,
+                        &primary_dof,
+                        &secondary](std::int64_t const begin_index,
+                                    std::int64_t const end_index) {
+    for (std::int64_t index = begin_index; index < end_index; ++index) {
+      auto const& [time, degrees_of_freedom] = points[index];
+      auto const osculating_elements =
+          KeplerOrbit<PrimaryCentred>(primary,
+                                      secondary,
+                                      degrees_of_freedom - primary_dof,
+                                      time)
+              .elements_at_epoch();
+      double const& e = *osculating_elements.eccentricity;
+      Angle const& ϖ = *osculating_elements.longitude_of_periapsis;
+      Angle const& Ω = osculating_elements.longitude_of_ascending_node;
+      Angle const& M = *osculating_elements.mean_anomaly;
+      Angle const& i = osculating_elements.inclination;
+      double const tg_½i = Tan(i / 2);
+      double const cotg_½i = 1 / tg_½i;
+      osculating[first + index] = {
+          /*.t = */ time,
+          /*.a = */ *osculating_elements.semimajor_axis,
+          /*.h = */ e * Sin(ϖ),
+          /*.k = */ e * Cos(ϖ),
+          /*.λ = */ ϖ + M,
+          /*.p = */ tg_½i * Sin(Ω),
+          /*.q = */ tg_½i * Cos(Ω),
+          /*.pʹ = */ cotg_½i * Sin(Ω),
+          /*.qʹ = */ cotg_½i * Cos(Ω)};
+    }
+  };
+
+  std::int64_t const size = points.size();
+  if (size <= osculating_elements_chunk_size) {
+    compute(0, size);
+  } else {
+    ThreadPool<void>& pool = OsculatingElementsPool();
+    std::vector<std::future<void>> futures;
+    for (std::int64_t begin_index = 0;
+         begin_index < size;
+         begin_index += osculating_elements_chunk_size) {
+      std::int64_t const end_index =
+          std::min(begin_index + osculating_elements_chunk_size, size);
+      futures.push_back(pool.Add([begin_index, end_index, &compute]() {
+        compute(begin_index, end_index);
+      }));
+    }
+    for (auto& future : futures) {
+      future.wait();
+    }
+  }
+
+  // Unwind the mean longitudes sequentially.
+  for (std::int64_t i = std::max<std::int64_t>(first, 1);
+       i < osculating.size();
+       ++i) {
+    osculating[i].λ = UnwindFrom(osculating[i - 1].λ, osculating[i].λ);
   }
-  return result;
 }
 
 inline std::vector<OrbitalElements::EquinoctialElements> const&
@@ -180,11 +312,35 @@ inline Time OrbitalElements::SiderealPeriod(
   return 2 * π * Radian * Pow<3>(Δt) / (12 * ʃ_λt_dt);
 }
 
+inline void OrbitalElements::IntegrateEquinoctialElements(
+    std::vector<EquinoctialElements> const& osculating,
+    std::vector<IntegratedEquinoctialElements>& integrals) {
+  if (integrals.empty()) {
+    integrals.push_back({osculating.front().t});
+  }
+  for (auto previous = osculating.begin() + integrals.size() - 1,
+            it = osculating.begin() + integrals.size();
+       it != osculating.end();
+       previous = it, ++it) {
+    integrals.push_back(integrals.back());
+    integrals.back().t_max = it->t;
+    Time const dt = it->t - previous->t;
+    integrals.back().ʃ_a_dt += (it->a + previous->a) / 2 * dt;
+    integrals.back().ʃ_h_dt += (it->h + previous->h) / 2 * dt;
+    integrals.back().ʃ_k_dt += (it->k + previous->k) / 2 * dt;
+    integrals.back().ʃ_λ_dt += (it->λ + previous->λ) / 2 * dt;
+    integrals.back().ʃ_p_dt += (it->p + previous->p) / 2 * dt;
+    integrals.back().ʃ_q_dt += (it->q + previous->q) / 2 * dt;
+    integrals.back().ʃ_pʹ_dt += (it->pʹ + previous->pʹ) / 2 * dt;
+    integrals.back().ʃ_qʹ_dt += (it->qʹ + previous->qʹ) / 2 * dt;
+  }
+}
+
 inline std::vector<OrbitalElements::EquinoctialElements>
 OrbitalElements::MeanEquinoctialElements(
     std::vector<EquinoctialElements> const& osculating,
+    std::vector<IntegratedEquinoctialElements> const& integrals,
     Time const& period) {
-  Instant const& t_min = osculating.front().t;
   // This function averages the elements in |osculating| over |period|.
   // For each |EquinoctialElements osculating_elements = osculating[i]| in
   // |osculating| such that |osculating_elements.t <= osculating.back().t|, let
@@ -196,42 +352,13 @@ OrbitalElements::MeanEquinoctialElements(
   // |tᵢ + period|, divided by |period|.
 
   // Instead of computing the integral from |tᵢ| to |tᵢ + period| directly, we
-  // precompute the integrals from |t_min| to each of the |tᵢ|.
+  // use the |integrals| from |t_min = osculating.front().t| to each of the
+  // |tᵢ|.
   // The integral from |tᵢ| to |tᵢ + period| is then computed as the integral
   // from |tᵢ| to the last |tⱼ₋₁| before |tᵢ + period| (obtained by subtracting
   // the integrals to |tᵢ| and to |tⱼ₋₁|), plus the remainder integral from
   // |tⱼ₋₁| to |tᵢ + period| (a partial trapezoid on [tⱼ₋₁, tⱼ]).
-
-  // Precompute the integrals from |t_min| to each of the |tᵢ|.
-  struct IntegratedEquinoctialElements {
-    Instant t_max;
-    // The integrals are from t_min to t_max.
-    Product<Length, Time> ʃ_a_dt;
-    Time ʃ_h_dt;
-    Time ʃ_k_dt;
-    Product<Angle, Time> ʃ_λ_dt;
-    Time ʃ_p_dt;
-    Time ʃ_q_dt;
-    Time ʃ_pʹ_dt;
-    Time ʃ_qʹ_dt;
-  };
-  std::vector<IntegratedEquinoctialElements> integrals;
-  integrals.push_back({t_min});
-  for (auto previous = osculating.begin(), it = osculating.begin() + 1;
-       it != osculating.end();
-       previous = it, ++it) {
-    integrals.push_back(integrals.back());
-    integrals.back().t_max = it->t;
-    Time const dt = it->t - previous->t;
-    integrals.back().ʃ_a_dt += (it->a + previous->a) / 2 * dt;
-    integrals.back().ʃ_h_dt += (it->h + previous->h) / 2 * dt;
-    integrals.back().ʃ_k_dt += (it->k + previous->k) / 2 * dt;
-    integrals.back().ʃ_λ_dt += (it->λ + previous->λ) / 2 * dt;
-    integrals.back().ʃ_p_dt += (it->p + previous->p) / 2 * dt;
-    integrals.back().ʃ_q_dt += (it->q + previous->q) / 2 * dt;
-    integrals.back().ʃ_pʹ_dt += (it->pʹ + previous->pʹ) / 2 * dt;
-    integrals.back().ʃ_qʹ_dt += (it->qʹ + previous->qʹ) / 2 * dt;
-  }
+  CHECK_EQ(integrals.size(), osculating.size());
 
   // Now compute the averages.
   std::vector<EquinoctialElements> mean_elements;
@@ -52,6 +52,7 @@ using quantities::Pow;
 using quantities::Sqrt;
 using quantities::Time;
 using quantities::astronomy::JulianYear;
+using quantities::astronomy::TerrestrialGravitationalParameter;
 using quantities::si::ArcMinute;
 using quantities::si::ArcSecond;
 using quantities::si::Day;
@@ -413,6 +414,150 @@ TEST_F(OrbitalElementsTest, RealPerturbation) {
                            elements.mean_equinoctial_elements());
 }
 
+TEST_F(OrbitalElementsTest, Incremental) {
+  // A Keplerian trajectory sampled densely enough that the osculating elements
+  // are computed in parallel.
+  MassiveBody const earth(TerrestrialGravitationalParameter);
+  KeplerianElements<GCRS> initial_osculating;
+  initial_osculating.semimajor_axis = 7000 * Kilo(Metre);
+  initial_osculating.eccentricity = 1e-3;
+  initial_osculating.inclination = 60 * Degree;
+  initial_osculating.longitude_of_ascending_node = 10 * Degree;
+  initial_osculating.argument_of_periapsis = 20 * Degree;
+  initial_osculating.mean_anomaly = 30 * Degree;
+  KeplerOrbit<GCRS> const orbit(
+      earth, MasslessBody{}, initial_osculating, J2000);
+  DiscreteTrajectory<GCRS> trajectory;
+  DiscreteTrajectory<GCRS> first_days;
+  DiscreteTrajectory<GCRS> perturbed_first_days;
+  DiscreteTrajectory<GCRS> last_days;
+  for (Instant t = J2000; t <= J2000 + 3 * Day; t += 5 * Second) {
+    DegreesOfFreedom<GCRS> const degrees_of_freedom =
+        DegreesOfFreedom<GCRS>{GCRS::origin, Velocity<GCRS>{}} +
+        orbit.StateVectors(t);
+    trajectory.Append(t, degrees_of_freedom);
+    if (t <= J2000 + 2 * Day) {
+      first_days.Append(t, degrees_of_freedom);
+      // Only the first point differs.
+      perturbed_first_days.Append(
+          t,
+          t == J2000
+              ? DegreesOfFreedom<GCRS>(
+                    degrees_of_freedom.position(),
+                    degrees_of_freedom.velocity() +
+                        Velocity<GCRS>({1 * Metre / Second,
+                                        0 * Metre / Second,
+                                        0 * Metre / Second}))
+              : degrees_of_freedom);
+    }
+    if (t >= J2000 + 1 * Day) {
+      last_days.Append(t, degrees_of_freedom);
+    }
+  }
+
+  auto const status_or_elements =
+      OrbitalElements::ForTrajectory(trajectory, earth, MasslessBody{});
+  auto const status_or_first_days_elements =
+      OrbitalElements::ForTrajectory(first_days, earth, MasslessBody{});
+  ASSERT_THAT(status_or_elements, IsOk());
+  ASSERT_THAT(status_or_first_days_elements, IsOk());
+  OrbitalElements const& elements = status_or_elements.ValueOrDie();
+
+  // Extending the elements computed on a prefix of the trajectory gives the
+  // same results as a computation from scratch.
+  auto const status_or_extended_elements = OrbitalElements::ForTrajectory(
+      trajectory,
+      earth,
+      MasslessBody{},
+      status_or_first_days_elements.ValueOrDie());
+  ASSERT_THAT(status_or_extended_elements, IsOk());
+  OrbitalElements const& extended_elements =
+      status_or_extended_elements.ValueOrDie();
+  EXPECT_EQ(elements.sidereal_period(), extended_elements.sidereal_period());
+  EXPECT_EQ(elements.nodal_period(), extended_elements.nodal_period());
+  ASSERT_EQ(elements.osculating_equinoctial_elements().size(),
+            extended_elements.osculating_equinoctial_elements().size());
+  for (int i = 0; i < elements.osculating_equinoctial_elements().size(); ++i) {
+    auto const& expected = elements.osculating_equinoctial_elements()[i];
+    auto const& actual = extended_elements.osculating_equinoctial_elements()[i];
+    EXPECT_EQ(expected.t, actual.t);
+    EXPECT_EQ(expected.a, actual.a);
+    EXPECT_EQ(expected.λ, actual.λ);
+  }
+  ASSERT_EQ(elements.mean_elements().size(),
+            extended_elements.mean_elements().size());
+  for (int i = 0; i < elements.mean_elements().size(); ++i) {
+    auto const& expected = elements.mean_elements()[i];
+    auto const& actual = extended_elements.mean_elements()[i];
+    EXPECT_EQ(expected.time, actual.time);
+    EXPECT_EQ(expected.semimajor_axis, actual.semimajor_axis);
+    EXPECT_EQ(expected.eccentricity, actual.eccentricity);
+    EXPECT_EQ(expected.mean_anomaly, actual.mean_anomaly);
+  }
+
+  // The osculating elements at the first point are not reused, so the result
+  // is the same if that point differs.
+  auto const status_or_perturbed_first_days_elements =
+      OrbitalElements::ForTrajectory(perturbed_first_days,
+                                     earth,
+                                     MasslessBody{});
+  ASSERT_THAT(status_or_perturbed_first_days_elements, IsOk());
+  auto const status_or_unperturbed_elements = OrbitalElements::ForTrajectory(
+      trajectory,
+      earth,
+      MasslessBody{},
+      status_or_perturbed_first_days_elements.ValueOrDie());
+  ASSERT_THAT(status_or_unperturbed_elements, IsOk());
+  OrbitalElements const& unperturbed_elements =
+      status_or_unperturbed_elements.ValueOrDie();
+  EXPECT_EQ(elements.sidereal_period(), unperturbed_elements.sidereal_period());
+  ASSERT_EQ(elements.osculating_equinoctial_elements().size(),
+            unperturbed_elements.osculating_equinoctial_elements().size());
+  for (int i = 0; i < elements.osculating_equinoctial_elements().size(); ++i) {
+    auto const& expected = elements.osculating_equinoctial_elements()[i];
+    auto const& actual =
+        unperturbed_elements.osculating_equinoctial_elements()[i];
+    EXPECT_EQ(expected.a, actual.a);
+    EXPECT_EQ(expected.h, actual.h);
+    EXPECT_EQ(expected.λ, actual.λ);
+  }
+
+  // Reusing them for a trajectory that starts later gives the same results up
+  // to rounding, since the mean longitudes are unwound from a different
+  // origin.
+  auto const status_or_last_days_elements =
+      OrbitalElements::ForTrajectory(last_days, earth, MasslessBody{});
+  auto const status_or_reused_elements = OrbitalElements::ForTrajectory(
+      last_days,
+      earth,
+      MasslessBody{},
+      status_or_first_days_elements.ValueOrDie());
+  ASSERT_THAT(status_or_last_days_elements, IsOk());
+  ASSERT_THAT(status_or_reused_elements, IsOk());
+  OrbitalElements const& last_days_elements =
+      status_or_last_days_elements.ValueOrDie();
+  OrbitalElements const& reused_elements =
+      status_or_reused_elements.ValueOrDie();
+  EXPECT_THAT(RelativeError(last_days_elements.sidereal_period(),
+                            reused_elements.sidereal_period()),
+              Lt(1e-14));
+  ASSERT_EQ(last_days_elements.mean_elements().size(),
+            reused_elements.mean_elements().size());
+  for (int i = 0; i < last_days_elements.mean_elements().size(); ++i) {
+    auto const& expected = last_days_elements.mean_elements()[i];
+    auto const& actual = reused_elements.mean_elements()[i];
+    EXPECT_THAT(RelativeError(expected.semimajor_axis, actual.semimajor_axis),
+                Lt(1e-14));
+    EXPECT_THAT(RelativeError(expected.inclination, actual.inclination),
+                Lt(1e-14));
+  }
+
+  EXPECT_THAT(
+      elements.sidereal_period(),
+      AbsoluteErrorFrom(*orbit.elements_at_epoch().period,
+                        Lt(1 * Milli(Second))));
+}
+
 #endif
 
 }  // namespace astronomy
@@ -2,14 +2,19 @@
 
 #include <algorithm>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "astronomy/time_scales.hpp"
 #include "base/map_util.hpp"
+#include "base/thread_pool.hpp"
 #include "glog/logging.h"
 #include "numerics/finite_difference.hpp"
 
@@ -19,6 +24,7 @@ namespace internal_standard_product_3 {
 
 using base::FindOrDie;
 using base::make_not_null_unique;
+using base::ThreadPool;
 using geometry::Displacement;
 using numerics::FiniteDifference;
 using quantities::NaN;
@@ -75,98 +81,315 @@ not_null<std::unique_ptr<DiscreteTrajectory<ITRS>>> ComputeVelocities(
   return result;
 }
 
-StandardProduct3::StandardProduct3(
-    std::filesystem::path const& filename,
-    StandardProduct3::Dialect const dialect) {
-  std::ifstream file(filename);
+// The contents of an SP3 file, read in one go and split into lines.  The lines
+// are views into |contents_|, so that parsing never copies them.
+class StandardProduct3File {
+ public:
+  explicit StandardProduct3File(std::filesystem::path const& filename);
+
+  std::filesystem::path const& filename() const;
+  int number_of_lines() const;
+  std::string_view line(int index) const;
+
+ private:
+  std::filesystem::path const filename_;
+  std::string contents_;
+  std::vector<std::string_view> lines_;
+};
+
+// A cursor on the lines of a |StandardProduct3File|.  The specification uses
+// 1-based column indices, and column ranges with bounds included.  The location
+// used in error messages is only computed if a check fails.
+class LineCursor {
+ public:
+  LineCursor(StandardProduct3File const& file, int line_index);
+
+  // Whether the cursor is on a line, as opposed to at the end of the file.
+  bool has_line() const;
+  int line_index() const;
+  void Advance();
+
+  std::string location() const;
+
+  char column(int index) const;
+  std::string_view columns(int first, int last) const;
+  double float_columns(int first, int last) const;
+  int integer_columns(int first, int last) const;
+
+ private:
+  StandardProduct3File const& file_;
+  int line_index_;
+};
+
+// The data for one satellite at one epoch.  Bad or absent data are represented
+// by a |position| at |ITRS::origin| or a zero |velocity|, as in the file; the
+// velocity is NaN if the file does not provide velocities.
+struct SatelliteRecord {
+  Position<ITRS> position;
+  Velocity<ITRS> velocity;
+};
+
+// The data for all satellites at one epoch, in the order of the satellite ID
+// records.
+struct EpochRecord {
+  Instant epoch;
+  std::vector<SatelliteRecord> satellites;
+};
+
+StandardProduct3File::StandardProduct3File(
+    std::filesystem::path const& filename)
+    : filename_(filename) {
+  std::ifstream file(filename, std::ios::binary);
+  CHECK(file.good()) << filename;
+  file.seekg(0, std::ios::end);
+  contents_.resize(file.tellg());
+  file.seekg(0, std::ios::beg);
+  file.read(contents_.data(), contents_.size());
   CHECK(file.good()) << filename;
-  std::optional<std::string> line;
 
-  std::string location;
-  int line_number = 0;
-  auto const read_line = [&file, &filename, &line, &line_number, &location]() {
-    if (!line.has_value()) {
-      line.emplace();
+  std::string_view const contents(contents_);
+  std::size_t begin = 0;
+  while (begin < contents.size()) {
+    std::size_t end = contents.find('\n', begin);
+    if (end == std::string_view::npos) {
+      end = contents.size();
     }
-    std::getline(file, *line);
-    if (file.fail()) {
-      CHECK(file.eof()) << "Non-EOF failure after " << location;
-      line.reset();
-      location = absl::StrCat(filename.string(), " at end of file");
-    } else {
-      ++line_number;
-      location =
-          absl::StrCat(filename.string(), " line ", line_number, ": ", *line);
+    std::string_view line = contents.substr(begin, end - begin);
+    // Behave as |std::getline| on a file opened in text mode on Windows.
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
     }
-  };
-
-  // The specification uses 1-based column indices, and column ranges with
-  // bounds included.
-  auto const column = [&line, &location](int const index) {
-    CHECK(line.has_value()) << location;
-    CHECK_LT(index - 1, line->size()) << location;
-    return (*line)[index - 1];
-  };
-  auto const columns = [&line, &location](int const first, int const last) {
-    CHECK(line.has_value()) << location;
-    CHECK_LT(last - 1, line->size()) << location;
-    CHECK_LE(first, last) << location;
-    return std::string_view(&(*line)[first - 1], last - first + 1);
-  };
-  auto const float_columns = [&columns, &location](int const first,
-                                                   int const last) {
-    double result;
-    CHECK(absl::SimpleAtod(columns(first, last), &result))
-        << location << " columns " << first << "-" << last;
-    return result;
-  };
-  auto const integer_columns = [&columns, &location](int const first,
-                                                     int const last) {
-    int result;
-    CHECK(absl::SimpleAtoi(columns(first, last), &result))
-        << location << " columns " << first << "-" << last;
-    return result;
-  };
+    lines_.push_back(line);
+    begin = end + 1;
+  }
+}
+
+std::filesystem::path const& StandardProduct3File::filename() const {
+  return filename_;
+}
+
+int StandardProduct3File::number_of_lines() const {
+  return lines_.size();
+}
+
+std::string_view StandardProduct3File::line(int const index) const {
+  return lines_[index];
+}
+
+LineCursor::LineCursor(StandardProduct3File const& file, int const line_index)
+    : file_(file),
+      line_index_(line_index) {}
+
+bool LineCursor::has_line() const {
+  return line_index_ < file_.number_of_lines();
+}
+
+int LineCursor::line_index() const {
+  return line_index_;
+}
+
+void LineCursor::Advance() {
+  CHECK(has_line()) << location();
+  ++line_index_;
+}
+
+std::string LineCursor::location() const {
+  if (has_line()) {
+    return absl::StrCat(file_.filename().string(),
+                        " line ", line_index_ + 1, ": ",
+                        file_.line(line_index_));
+  } else {
+    return absl::StrCat(file_.filename().string(), " at end of file");
+  }
+}
+
+char LineCursor::column(int const index) const {
+  CHECK(has_line()) << location();
+  std::string_view const line = file_.line(line_index_);
+  CHECK_LT(index - 1, line.size()) << location();
+  return line[index - 1];
+}
+
+std::string_view LineCursor::columns(int const first, int const last) const {
+  CHECK(has_line()) << location();
+  std::string_view const line = file_.line(line_index_);
+  CHECK_LT(last - 1, line.size()) << location();
+  CHECK_LE(first, last) << location();
+  return line.substr(first - 1, last - first + 1);
+}
+
+double LineCursor::float_columns(int const first, int const last) const {
+  double result;
+  CHECK(absl::SimpleAtod(columns(first, last), &result))
+      << location() << " columns " << first << "-" << last;
+  return result;
+}
+
+int LineCursor::integer_columns(int const first, int const last) const {
+  int result;
+  CHECK(absl::SimpleAtoi(columns(first, last), &result))
+      << location() << " columns " << first << "-" << last;
+  return result;
+}
+
+// Parses the epoch block starting at the epoch header record denoted by
+// |cursor|, and leaves |cursor| on the line that follows the block.
+EpochRecord ParseEpoch(
+    StandardProduct3::Version const version,
+    StandardProduct3::Dialect const dialect,
+    bool const has_velocities,
+    std::function<Instant(std::string const&)> const& parse_time,
+    std::vector<StandardProduct3::SatelliteIdentifier> const& satellites,
+    LineCursor& cursor) {
+  using Dialect = StandardProduct3::Dialect;
+  using SatelliteGroup = StandardProduct3::SatelliteGroup;
+  using SatelliteIdentifier = StandardProduct3::SatelliteIdentifier;
+  using Version = StandardProduct3::Version;
+
+  EpochRecord result;
+
+  // *␣ record: the epoch header record.
+  CHECK_EQ(cursor.columns(1, 2), "* ") << cursor.location();
+  std::string epoch_string;
+  if (dialect == Dialect::ILRSB) {
+    int minutes = cursor.integer_columns(17, 18);
+    int hours = cursor.integer_columns(14, 15);
+    if (minutes == 60) {
+      minutes = 0;
+      ++hours;
+    }
+    epoch_string = absl::StrCat(
+        cursor.columns(3, 6), "-", cursor.columns(8, 9), "-",
+        cursor.columns(11, 12), "T", absl::Dec(hours, absl::kZeroPad2), ":",
+        absl::Dec(minutes, absl::kZeroPad2), ":", cursor.columns(20, 25));
+  } else {
+    // Note: the seconds field is an F11.8, spanning columns 21..31, but our
+    // time parser only supports milliseconds.
+    epoch_string = absl::StrCat(
+        cursor.columns(4, 7), "-", cursor.columns(9, 10), "-",
+        cursor.columns(12, 13), "T", cursor.columns(15, 16), ":",
+        cursor.columns(18, 19), ":", cursor.columns(21, 26));
+  }
+  for (char& c : epoch_string) {
+    if (c == ' ') {
+      c = '0';
+    }
+  }
+  result.epoch = parse_time(epoch_string);
+  cursor.Advance();
+
+  result.satellites.reserve(satellites.size());
+  for (int i = 0; i < satellites.size(); ++i) {
+    // P record: the position and clock record.
+    CHECK_EQ(cursor.column(1), 'P') << cursor.location();
+    SatelliteIdentifier id;
+    id.group = version == Version::A ? SatelliteGroup::GPS
+                                     : SatelliteGroup{cursor.column(2)};
+    id.index = cursor.integer_columns(3, 4);
+
+    // The SP3-c and SP3-d specification require that the satellite order of
+    // the P, EP, V, and EV records be the same as the order of the satellite
+    // ID records.
+    // This wording was added to the SP3-c specification by the 2006-09-27
+    // amendment, which describes it as a “clarification”, so the intent seems
+    // to be that this was required from the start for SP3-c, and perhaps for
+    // earlier versions as well.
+    // If this breaks for SP3-a or SP3-b, consider exempting these versions
+    // from the check.
+    CHECK_EQ(id, satellites[i]) << cursor.location();
+
+    SatelliteRecord& record = result.satellites.emplace_back();
+    record.position =
+        Displacement<ITRS>({cursor.float_columns(5, 18) * Kilo(Metre),
+                            cursor.float_columns(19, 32) * Kilo(Metre),
+                            cursor.float_columns(33, 46) * Kilo(Metre)}) +
+        ITRS::origin;
+    // If the file does not provide velocities, fill the trajectory with NaN
+    // velocities; we then replace it with another trajectory whose velocities
+    // are computed using a finite difference formula.
+    record.velocity = Velocity<ITRS>({NaN<Speed>(), NaN<Speed>(), NaN<Speed>()});
+
+    cursor.Advance();
+    if (version >= Version::C && cursor.has_line() &&
+        cursor.columns(1, 2) == "EP") {
+      // Ignore the optional EP record (the position and clock correlation
+      // record).
+      cursor.Advance();
+    }
+
+    if (has_velocities) {
+      // V record: the velocity and clock rate-of-change record.
+      CHECK_EQ(cursor.column(1), 'V') << cursor.location();
+      if (version > Version::A) {
+        CHECK_EQ(SatelliteGroup{cursor.column(2)}, id.group)
+            << cursor.location();
+      }
+      CHECK_EQ(cursor.integer_columns(3, 4), id.index) << cursor.location();
+      Speed const speed_unit =
+          dialect == Dialect::GRGS ? Metre / Second : Deci(Metre) / Second;
+      record.velocity =
+          Velocity<ITRS>({cursor.float_columns(5, 18) * speed_unit,
+                          cursor.float_columns(19, 32) * speed_unit,
+                          cursor.float_columns(33, 46) * speed_unit});
+
+      cursor.Advance();
+      if (version >= Version::C && cursor.has_line() &&
+          cursor.columns(1, 2) == "EV") {
+        // Ignore the optional EV record (the velocity and clock
+        // rate-of-change correlation record).
+        cursor.Advance();
+      }
+    }
+  }
+  return result;
+}
+
+StandardProduct3::StandardProduct3(
+    std::filesystem::path const& filename,
+    StandardProduct3::Dialect const dialect) {
+  StandardProduct3File const file(filename);
+  LineCursor cursor(file, /*line_index=*/0);
 
   int number_of_epochs;
   int number_of_satellites;
 
   // Header: # record.
-  read_line();
-  CHECK_EQ(column(1), '#') << location;
-  CHECK_GE(Version{column(2)}, Version::A) << location;
-  CHECK_LE(Version{column(2)}, Version::D) << location;
-  version_ = Version{column(2)};
-  CHECK(column(3) == 'P' || column(3) == 'V') << location;
-  has_velocities_ = column(3) == 'V';
-  number_of_epochs = integer_columns(33, 39);
+  CHECK_EQ(cursor.column(1), '#') << cursor.location();
+  CHECK_GE(Version{cursor.column(2)}, Version::A) << cursor.location();
+  CHECK_LE(Version{cursor.column(2)}, Version::D) << cursor.location();
+  version_ = Version{cursor.column(2)};
+  CHECK(cursor.column(3) == 'P' || cursor.column(3) == 'V')
+      << cursor.location();
+  has_velocities_ = cursor.column(3) == 'V';
+  number_of_epochs = cursor.integer_columns(33, 39);
   if (dialect == Dialect::ILRSB) {
     --number_of_epochs;
   }
 
   // Header: ## record.
-  read_line();
-  CHECK_EQ(columns(1, 2), "##") << location;
+  cursor.Advance();
+  CHECK_EQ(cursor.columns(1, 2), "##") << cursor.location();
 
   // Header: +␣ records.
-  read_line();
-  CHECK_EQ(columns(1, 2), "+ ") << location;
-  number_of_satellites = integer_columns(4, 6);
+  cursor.Advance();
+  CHECK_EQ(cursor.columns(1, 2), "+ ") << cursor.location();
+  number_of_satellites = cursor.integer_columns(4, 6);
 
   int number_of_satellite_id_records = 0;
-  while (columns(1, 2) == "+ ") {
+  while (cursor.columns(1, 2) == "+ ") {
     ++number_of_satellite_id_records;
     for (int c = 10; c <= 58; c += 3) {
-      auto const full_location =
-          absl::StrCat(location, " columns ", c, "-", c + 2);
+      auto const full_location = [&cursor, c]() {
+        return absl::StrCat(cursor.location(), " columns ", c, "-", c + 2);
+      };
       if (orbits_.size() != number_of_satellites) {
         SatelliteIdentifier id;
         if (version_ == Version::A) {
           // Satellite IDs are purely numeric (and implicitly GPS) in SP3-a.
-          CHECK_EQ(column(c), ' ') << full_location;
+          CHECK_EQ(cursor.column(c), ' ') << full_location();
           id.group = SatelliteGroup::GPS;
         } else {
-          id.group = SatelliteGroup{column(c)};
+          id.group = SatelliteGroup{cursor.column(c)};
           switch (id.group) {
             case SatelliteGroup::GPS:
             case SatelliteGroup::ГЛОНАСС:
@@ -178,58 +401,57 @@ StandardProduct3::StandardProduct3(
             case SatelliteGroup::北斗:
             case SatelliteGroup::みちびき:
             case SatelliteGroup::IRNSS:
-              CHECK_GE(version_, Version::C) << full_location;
+              CHECK_GE(version_, Version::C) << full_location();
               break;
             default:
               LOG(FATAL) << "Invalid satellite identifier " << id << ": "
-                         << full_location;
+                         << full_location();
           }
         }
-        id.index = integer_columns(c + 1, c + 2);
-        CHECK_GT(id.index, 0) << full_location;
+        id.index = cursor.integer_columns(c + 1, c + 2);
+        CHECK_GT(id.index, 0) << full_location();
         auto const [it, inserted] =
             orbits_.emplace(std::piecewise_construct,
                             std::forward_as_tuple(id),
                             std::forward_as_tuple());
         CHECK(inserted) << "Duplicate satellite identifier " << id << ": "
-                        << full_location;
-        it->second.push_back(make_not_null_unique<DiscreteTrajectory<ITRS>>());
+                        << full_location();
         satellites_.push_back(id);
       } else {
-        CHECK_EQ(columns(c, c + 2), "  0") << full_location;
+        CHECK_EQ(cursor.columns(c, c + 2), "  0") << full_location();
       }
     }
-    read_line();
+    cursor.Advance();
   }
   if (number_of_satellite_id_records < 5) {
-    LOG(FATAL) << u8"at least 5 +␣ records expected: " << location;
+    LOG(FATAL) << u8"at least 5 +␣ records expected: " << cursor.location();
   }
   if (version_ < Version::D && number_of_satellite_id_records > 5) {
     if (dialect == Dialect::ChineseMGEX) {
       CHECK_EQ(number_of_satellite_id_records, 10)
           << u8"exactly 10 +␣ records expected in the " << dialect << ": "
-          << location;
+          << cursor.location();
     } else {
       CHECK_EQ(number_of_satellite_id_records, 5)
           << u8"exactly 5 +␣ records expected in SP3-" << version_ << ": "
-          << location;
+          << cursor.location();
     }
   }
 
   // Header: ++ records.
   // Ignore the satellite accuracy exponents.
   for (int i = 0; i < number_of_satellite_id_records; ++i) {
-    CHECK_EQ(columns(1, 2), "++") << location;
-    read_line();
+    CHECK_EQ(cursor.columns(1, 2), "++") << cursor.location();
+    cursor.Advance();
   }
 
   // Header: first %c record.
   std::function<Instant(std::string const&)> parse_time;
-  CHECK_EQ(columns(1, 2), "%c") << location;
+  CHECK_EQ(cursor.columns(1, 2), "%c") << cursor.location();
   if (version_ < Version::C) {
     parse_time = &ParseGPSTime;
   } else {
-    auto const time_system = columns(10, 12);
+    auto const time_system = cursor.columns(10, 12);
     if (time_system == "GLO" || time_system == "UTC") {
       parse_time = &ParseUTC;
     } else if (time_system == "TAI") {
@@ -242,185 +464,173 @@ StandardProduct3::StandardProduct3(
       parse_time = &ParseGPSTime;
     } else {
       LOG(FATAL) << "Unexpected time system identifier " << time_system << ": "
-                 << location;
+                 << cursor.location();
     }
   }
 
   // Header: second %c record.
-  read_line();
-  CHECK_EQ(columns(1, 2), "%c") << location;
+  cursor.Advance();
+  CHECK_EQ(cursor.columns(1, 2), "%c") << cursor.location();
 
   // Header: %f records.
-  read_line();
-  CHECK_EQ(columns(1, 2), "%f") << location;
-  read_line();
-  CHECK_EQ(columns(1, 2), "%f") << location;
+  cursor.Advance();
+  CHECK_EQ(cursor.columns(1, 2), "%f") << cursor.location();
+  cursor.Advance();
+  CHECK_EQ(cursor.columns(1, 2), "%f") << cursor.location();
 
   // Header: %i records.
-  read_line();
-  CHECK_EQ(columns(1, 2), "%i") << location;
-  read_line();
-  CHECK_EQ(columns(1, 2), "%i") << location;
+  cursor.Advance();
+  CHECK_EQ(cursor.columns(1, 2), "%i") << cursor.location();
+  cursor.Advance();
+  CHECK_EQ(cursor.columns(1, 2), "%i") << cursor.location();
 
   // Header: /* records.
-  read_line();
+  cursor.Advance();
   int number_of_comment_records = 0;
   while ((dialect == Dialect::ILRSA || dialect == Dialect::ILRSB)
-             ? columns(1, 3) == "%/*"
-             : columns(1, 2) == "/*") {
+             ? cursor.columns(1, 3) == "%/*"
+             : cursor.columns(1, 2) == "/*") {
     ++number_of_comment_records;
-    read_line();
+    cursor.Advance();
   }
   if (number_of_comment_records < 4) {
-    LOG(FATAL) << "At least 4 /* records expected: " << location;
+    LOG(FATAL) << "At least 4 /* records expected: " << cursor.location();
   }
   if (version_ < Version::D && number_of_comment_records > 5) {
     LOG(FATAL) << "Exactly 4 /* records expected in SP3-"
-               << version_ << ": " << location;
+               << version_ << ": " << cursor.location();
   }
 
-  for (int i = 0; i < number_of_epochs; ++i) {
-    // *␣ record: the epoch header record.
-    CHECK_EQ(columns(1, 2), "* ") << location;
-    std::string epoch_string;
-    if (dialect == Dialect::ILRSB) {
-      int minutes = integer_columns(17, 18);
-      int hours = integer_columns(14, 15);
-      if (minutes == 60) {
-        minutes = 0;
-        ++hours;
-      }
-      epoch_string = absl::StrCat(
-          columns(3, 6), "-", columns(8, 9), "-", columns(11, 12),
-          "T", absl::Dec(hours, absl::kZeroPad2), ":",
-          absl::Dec(minutes, absl::kZeroPad2), ":", columns(20, 25));
-    } else {
-      // Note: the seconds field is an F11.8, spanning columns 21..31, but our
-      // time parser only supports milliseconds.
-      epoch_string = absl::StrCat(
-          columns(4, 7), "-", columns(9, 10), "-", columns(12, 13),
-          "T", columns(15, 16), ":", columns(18, 19), ":", columns(21, 26));
-    }
-    for (char& c : epoch_string) {
-      if (c == ' ') {
-        c = '0';
+  // Split the data into epoch blocks.  Each block starts with a *␣ record and
+  // extends until the next one, or until the EOF record (or the end of the
+  // file for ILRSA).
+  std::vector<int> epoch_block_starts;
+  if (number_of_epochs > 0) {
+    CHECK_EQ(cursor.columns(1, 2), "* ") << cursor.location();
+  }
+  int end_of_epoch_blocks = cursor.line_index();
+  for (; end_of_epoch_blocks < file.number_of_lines(); ++end_of_epoch_blocks) {
+    std::string_view const line = file.line(end_of_epoch_blocks);
+    if (line.substr(0, 2) == "* ") {
+      if (epoch_block_starts.size() == number_of_epochs) {
+        // Let the EOF check below report the unexpected epoch.
+        break;
       }
+      epoch_block_starts.push_back(end_of_epoch_blocks);
+    } else if (line.substr(0, 3) == "EOF") {
+      break;
     }
-    Instant const epoch = parse_time(epoch_string);
-    read_line();
-    for (int i = 0; i < orbits_.size(); ++i) {
-      // P record: the position and clock record.
-      CHECK_EQ(column(1), 'P') << location;
-      SatelliteIdentifier id;
-      id.group = version_ == Version::A ? SatelliteGroup::GPS
-                                        : SatelliteGroup{column(2)};
-      id.index = integer_columns(3, 4);
-      auto const it = orbits_.find(id);
-      CHECK(it != orbits_.end()) << "Unknown satellite identifier "
-                                 << id << ": " << location;
-
-      // The SP3-c and SP3-d specification require that the satellite order of
-      // the P, EP, V, and EV records be the same as the order of the satellite
-      // ID records.
-      // This wording was added to the SP3-c specification by the 2006-09-27
-      // amendment, which describes it as a “clarification”, so the intent seems
-      // to be that this was required from the start for SP3-c, and perhaps for
-      // earlier versions as well.
-      // If this breaks for SP3-a or SP3-b, consider exempting these versions
-      // from the check.
-      CHECK_EQ(id, satellites_[i]) << location;
-
-      std::vector<not_null<std::unique_ptr<DiscreteTrajectory<ITRS>>>>& orbit =
-          it->second;
-      DiscreteTrajectory<ITRS>& arc = *orbit.back();
-
-      Position<ITRS> const position =
-          Displacement<ITRS>({float_columns(5, 18) * Kilo(Metre),
-                              float_columns(19, 32) * Kilo(Metre),
-                              float_columns(33, 46) * Kilo(Metre)}) +
-          ITRS::origin;
-      // If the file does not provide velocities, fill the trajectory with NaN
-      // velocities; we then replace it with another trajectory whose velocities
-      // are computed using a finite difference formula.
-      Velocity<ITRS> velocity({NaN<Speed>(), NaN<Speed>(), NaN<Speed>()});
-
-      read_line();
-      if (version_ >= Version::C && line.has_value() && columns(1, 2) == "EP") {
-        // Ignore the optional EP record (the position and clock correlation
-        // record).
-        read_line();
-      }
-
-      if (has_velocities_) {
-        // V record: the velocity and clock rate-of-change record.
-        CHECK_EQ(column(1), 'V') << location;
-        if (version_ > Version::A) {
-          CHECK_EQ(SatelliteGroup{column(2)}, id.group) << location;
-        }
-        CHECK_EQ(integer_columns(3, 4), id.index) << location;
-        Speed const speed_unit =
-            dialect == Dialect::GRGS ? Metre / Second : Deci(Metre) / Second;
-        velocity = Velocity<ITRS>({float_columns(5, 18) * speed_unit,
-                                   float_columns(19, 32) * speed_unit,
-                                   float_columns(33, 46) * speed_unit});
-
-        read_line();
-        if (version_ >= Version::C && line.has_value() &&
-            columns(1, 2) == "EV") {
-          // Ignore the optional EV record (the velocity and clock
-          // rate-of-change correlation record).
-          read_line();
-        }
-      }
-
-      // Bad or absent positional and velocity values are to be set to 0.000000.
-      if (position == ITRS::origin || velocity == Velocity<ITRS>()) {
-        if (!arc.Empty()) {
-          orbit.push_back(make_not_null_unique<DiscreteTrajectory<ITRS>>());
+  }
+  CHECK_EQ(static_cast<int>(epoch_block_starts.size()), number_of_epochs)
+      << "Missing epochs: " << LineCursor(file, end_of_epoch_blocks).location();
+
+  // The epoch blocks are independent, so they are parsed in parallel.  Each
+  // task parses a contiguous range of blocks.
+  ThreadPool<void> pool(
+      std::max<int>(1, std::thread::hardware_concurrency()));
+  std::vector<EpochRecord> epochs(number_of_epochs);
+  {
+    constexpr int epochs_per_task = 64;
+    std::vector<std::future<void>> futures;
+    for (int first = 0; first < number_of_epochs; first += epochs_per_task) {
+      int const last = std::min(first + epochs_per_task, number_of_epochs);
+      futures.push_back(pool.Add([this,
+                                  dialect,
+                                  end_of_epoch_blocks,
+                                  first,
+                                  last,
+                                  &epoch_block_starts,
+                                  &epochs,
+                                  &file,
+                                  &parse_time]() {
+        for (int i = first; i < last; ++i) {
+          LineCursor epoch_cursor(file, epoch_block_starts[i]);
+          epochs[i] = ParseEpoch(version_,
+                                 dialect,
+                                 has_velocities_,
+                                 parse_time,
+                                 satellites_,
+                                 epoch_cursor);
+          int const next_block_start = i + 1 < epoch_block_starts.size()
+                                           ? epoch_block_starts[i + 1]
+                                           : end_of_epoch_blocks;
+          CHECK_EQ(epoch_cursor.line_index(), next_block_start)
+              << epoch_cursor.location();
         }
-      } else {
-        arc.Append(epoch, {position, velocity});
-      }
+      }));
+    }
+    for (auto& future : futures) {
+      future.wait();
     }
   }
+
+  LineCursor end_cursor(file, end_of_epoch_blocks);
   if (dialect != Dialect::ILRSA) {
-    CHECK_EQ(columns(1, 3), "EOF") << location;
-    read_line();
-  }
-  for (auto& [id, orbit] : orbits_) {
-    // Do not leave a final empty trajectory if the orbit ends with missing
-    // data.
-    if (orbit.back()->Empty()) {
-      orbit.pop_back();
-    }
+    CHECK_EQ(end_cursor.columns(1, 3), "EOF") << end_cursor.location();
+    end_cursor.Advance();
   }
-  CHECK(!line.has_value()) << location;
-  if (!has_velocities_) {
-    for (auto& [id, orbit] : orbits_) {
-      for (auto& arc : orbit) {
+  CHECK(!end_cursor.has_line()) << end_cursor.location();
+
+  // The orbits of the satellites are independent, so they are built in
+  // parallel.  Each task appends the points of one satellite in chronological
+  // order, which is the efficient order for |DiscreteTrajectory::Append|.
+  {
+    std::vector<std::future<void>> futures;
+    for (int s = 0; s < satellites_.size(); ++s) {
+      auto& orbit = orbits_.find(satellites_[s])->second;
+      futures.push_back(pool.Add([this, s, &epochs, &orbit]() {
+        orbit.push_back(make_not_null_unique<DiscreteTrajectory<ITRS>>());
+        for (auto const& epoch : epochs) {
+          SatelliteRecord const& record = epoch.satellites[s];
+          // Bad or absent positional and velocity values are to be set to
+          // 0.000000.
+          if (record.position == ITRS::origin ||
+              record.velocity == Velocity<ITRS>()) {
+            if (!orbit.back()->Empty()) {
+              orbit.push_back(
+                  make_not_null_unique<DiscreteTrajectory<ITRS>>());
+            }
+          } else {
+            orbit.back()->Append(epoch.epoch,
+                                 {record.position, record.velocity});
+          }
+        }
+        // Do not leave a final empty trajectory if the orbit ends with missing
+        // data.
+        if (orbit.back()->Empty()) {
+          orbit.pop_back();
+        }
+        if (!has_velocities_) {
+          for (auto& arc : orbit) {
 #define COMPUTE_VELOCITIES_CASE(n)            \
           case n:                             \
             arc = ComputeVelocities<n>(*arc); \
             break
 
-        switch (arc->Size()) {
-          COMPUTE_VELOCITIES_CASE(1);
-          COMPUTE_VELOCITIES_CASE(2);
-          COMPUTE_VELOCITIES_CASE(3);
-          COMPUTE_VELOCITIES_CASE(4);
-          COMPUTE_VELOCITIES_CASE(5);
-          COMPUTE_VELOCITIES_CASE(6);
-          COMPUTE_VELOCITIES_CASE(7);
-          COMPUTE_VELOCITIES_CASE(8);
-          default:
-            arc = ComputeVelocities<9>(*arc);
-            break;
-        }
+            switch (arc->Size()) {
+              COMPUTE_VELOCITIES_CASE(1);
+              COMPUTE_VELOCITIES_CASE(2);
+              COMPUTE_VELOCITIES_CASE(3);
+              COMPUTE_VELOCITIES_CASE(4);
+              COMPUTE_VELOCITIES_CASE(5);
+              COMPUTE_VELOCITIES_CASE(6);
+              COMPUTE_VELOCITIES_CASE(7);
+              COMPUTE_VELOCITIES_CASE(8);
+              default:
+                arc = ComputeVelocities<9>(*arc);
+                break;
+            }
 
 #undef COMPUTE_VELOCITIES_CASE
-      }
+          }
+        }
+      }));
+    }
+    for (auto& future : futures) {
+      future.wait();
     }
   }
+
   for (auto const& [id, orbit] : orbits_) {
     auto const [it, inserted] =
         const_orbits_.emplace(std::piecewise_construct,
@@ -18,6 +18,7 @@
 #include "base/graveyard.hpp"
 #include "base/not_null.hpp"
 #include "base/status.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/named_quantities.hpp"
 #include "geometry/sign.hpp"
@@ -45,6 +46,7 @@ using base::Graveyard;
 using base::not_null;
 using base::OFStream;
 using base::Status;
+using base::ThreadPool;
 using geometry::Displacement;
 using geometry::InnerProduct;
 using geometry::Instant;
@@ -94,6 +96,15 @@ using namespace std::chrono_literals;
 
 namespace astronomy {
 
+// The pool on which the individuals of the populations are evaluated.  It is
+// shared by all the populations, including those that evolve concurrently, so
+// that they don't oversubscribe the machine.
+ThreadPool<void>& EvaluationPool() {
+  static ThreadPool<void> pool(
+      std::max<int>(1, std::thread::hardware_concurrency()));
+  return pool;
+}
+
 namespace genetics {
 
 // The description of the characteristics of an individual, i.e., a
@@ -280,7 +291,7 @@ Population::Population(Genome const& luca,
 void Population::ComputeAllFitnesses() {
   // The fitness computation is expensive, do it in parallel on all genomes.
   {
-    Bundle bundle;
+    Bundle bundle(&EvaluationPool());
 
     fitnesses_.resize(current_.size(), 0.0);
     traces_.resize(current_.size(), "");
@@ -292,8 +303,6 @@ void Population::ComputeAllFitnesses() {
     }
     for (; i < current_.size(); ++i) {
       bundle.Add([this, i]() {
-        // Sleep a bit to reduce contention in new/delete.
-        std::this_thread::sleep_for(i * 1ms);
         fitnesses_[i] = compute_fitness_(current_[i], traces_[i]);
         return Status();
       });
@@ -560,7 +569,7 @@ std::vector<double> EvaluatePopulation(Population const& population,
                                        std::vector<std::string>& info) {
   std::vector<double> log_pdf(population.size());
   info.resize(population.size());
-  Bundle bundle;
+  Bundle bundle(&EvaluationPool());
   for (int i = 0; i < population.size(); ++i) {
     auto const& parameters = population[i];
     bundle.Add([&compute_log_pdf, i, &log_pdf, &parameters, &info]() {
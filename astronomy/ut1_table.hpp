@@ -0,0 +1,84 @@
+﻿
+#pragma once
+
+#include <vector>
+
+#include "geometry/named_quantities.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace astronomy {
+namespace internal_ut1_table {
+
+using geometry::Instant;
+using quantities::Angle;
+using quantities::Time;
+
+// A table of the EOP C04 series precomputed for the conversion of large numbers
+// of runtime instants from TT to UT1.  The functions of time_scales.hpp are
+// designed for constexpr evaluation, and perform a binary search and date
+// computations at each call; this class does the date computations once, and
+// finds the relevant entry in O(1) by indexing a uniform grid of days.
+// The results are identical to those of the functions of time_scales.hpp.
+class UT1Table final {
+ public:
+  // Builds the table.  This takes a few milliseconds; the table should be
+  // shared, e.g., by using |Get|.
+  UT1Table();
+
+  // Returns a table built on first use.
+  static UT1Table const& Get();
+
+  // The range covered by the table; the functions below must be called with
+  // instants in [t_min(), t_max()[.
+  Instant const& t_min() const;
+  Instant const& t_max() const;
+
+  // UT1 - TAI, linearly interpolated in TT between the entries of EOP C04.
+  Time UT1MinusTAI(Instant const& tt) const;
+
+  // Same as |astronomy::EarthRotationAngle(tt)|.
+  Angle EarthRotationAngle(Instant const& tt) const;
+
+  // Batch versions of the above.  The results are resized to the size of
+  // |tt|.  The lookups are cheaper if |tt| is sorted, but this is not
+  // required.
+  void UT1MinusTAI(std::vector<Instant> const& tt,
+                   std::vector<Time>& ut1_minus_tai) const;
+  void EarthRotationAngle(std::vector<Instant> const& tt,
+                          std::vector<Angle>& earth_rotation_angle) const;
+
+ private:
+  // Returns the index of the last entry whose TT is less than or equal to
+  // |tt|.  |hint| is a guess for the result, typically the result of the
+  // previous call; it must be a valid index below |tt_.size() - 1|.
+  int Lookup(Instant const& tt, int hint = 0) const;
+
+  // Fills |indices| with the results of |Lookup| for all the |tt|, reusing
+  // the previous result as a hint.
+  void Lookup(std::vector<Instant> const& tt, std::vector<int>& indices) const;
+
+  // Structure of arrays, one element per EOP C04 entry.
+  std::vector<Instant> tt_;
+  std::vector<Time> ut1_minus_utc_;
+  std::vector<Time> ut1_minus_tai_;
+  std::vector<int> jd_minus_2451545_;
+
+  // |entry_at_day_[d]| is the index of the last entry whose TT is less than
+  // or equal to |t_min_ + d * Day|.  Since the entries are (nearly) daily,
+  // the result of |Lookup| is at most a couple of entries away.
+  std::vector<int> entry_at_day_;
+
+  Instant t_min_;
+  Instant t_max_;
+};
+
+}  // namespace internal_ut1_table
+
+using internal_ut1_table::UT1Table;
+
+}  // namespace astronomy
+}  // namespace principia
+
+#include "astronomy/ut1_table_body.hpp"
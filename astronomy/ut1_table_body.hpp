@@ -0,0 +1,144 @@
+﻿
+#pragma once
+
+#include "astronomy/ut1_table.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "astronomy/time_scales.hpp"
+#include "glog/logging.h"
+#include "quantities/numbers.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace astronomy {
+namespace internal_ut1_table {
+
+using internal_time_scales::eop_c04;
+using quantities::si::Day;
+using quantities::si::Radian;
+
+inline UT1Table::UT1Table() {
+  tt_.reserve(eop_c04.size());
+  ut1_minus_utc_.reserve(eop_c04.size());
+  ut1_minus_tai_.reserve(eop_c04.size());
+  jd_minus_2451545_.reserve(eop_c04.size());
+  for (auto const& entry : eop_c04) {
+    tt_.push_back(entry.tt());
+    ut1_minus_utc_.push_back(entry.ut1_minus_utc);
+    ut1_minus_tai_.push_back(entry.ut1_minus_tai());
+    // See |InterpolatedEOPC04JulianDayFraction|.
+    jd_minus_2451545_.push_back(entry.utc().date().mjd() - 51545 + 1);
+  }
+  t_min_ = tt_.front();
+  t_max_ = tt_.back();
+
+  int const number_of_days = std::ceil((t_max_ - t_min_) / Day);
+  entry_at_day_.reserve(number_of_days);
+  int entry = 0;
+  for (int day = 0; day < number_of_days; ++day) {
+    Instant const t = t_min_ + day * Day;
+    while (tt_[entry + 1] <= t) {
+      ++entry;
+    }
+    entry_at_day_.push_back(entry);
+  }
+}
+
+inline UT1Table const& UT1Table::Get() {
+  static auto* const table = new UT1Table;
+  return *table;
+}
+
+inline Instant const& UT1Table::t_min() const {
+  return t_min_;
+}
+
+inline Instant const& UT1Table::t_max() const {
+  return t_max_;
+}
+
+inline Time UT1Table::UT1MinusTAI(Instant const& tt) const {
+  int const i = Lookup(tt);
+  double const λ = (tt - tt_[i]) / (tt_[i + 1] - tt_[i]);
+  return ut1_minus_tai_[i] + λ * (ut1_minus_tai_[i + 1] - ut1_minus_tai_[i]);
+}
+
+inline Angle UT1Table::EarthRotationAngle(Instant const& tt) const {
+  int const i = Lookup(tt);
+  // The same computation as |InterpolatedEOPC04JulianDayFraction| and
+  // |astronomy::EarthRotationAngle|, so that the results are identical.
+  double const λ = (tt - tt_[i]) / (tt_[i + 1] - tt_[i]);
+  double const ut1_julian_day_fraction =
+      (λ - 0.5) +
+      (ut1_minus_utc_[i] + λ * (ut1_minus_utc_[i + 1] - ut1_minus_utc_[i])) /
+          (1 * Day);
+  double const Tu = jd_minus_2451545_[i] + ut1_julian_day_fraction;
+  return 2 * π * Radian *
+         (ut1_julian_day_fraction + 0.7790572732640 +
+          0.00273781191135448 * Tu);
+}
+
+inline void UT1Table::UT1MinusTAI(std::vector<Instant> const& tt,
+                                  std::vector<Time>& ut1_minus_tai) const {
+  std::vector<int> indices;
+  Lookup(tt, indices);
+  ut1_minus_tai.resize(tt.size());
+  // No lookups in this loop, only arithmetic on contiguous arrays.
+  for (int k = 0; k < tt.size(); ++k) {
+    int const i = indices[k];
+    double const λ = (tt[k] - tt_[i]) / (tt_[i + 1] - tt_[i]);
+    ut1_minus_tai[k] =
+        ut1_minus_tai_[i] + λ * (ut1_minus_tai_[i + 1] - ut1_minus_tai_[i]);
+  }
+}
+
+inline void UT1Table::EarthRotationAngle(
+    std::vector<Instant> const& tt,
+    std::vector<Angle>& earth_rotation_angle) const {
+  std::vector<int> indices;
+  Lookup(tt, indices);
+  earth_rotation_angle.resize(tt.size());
+  for (int k = 0; k < tt.size(); ++k) {
+    int const i = indices[k];
+    double const λ = (tt[k] - tt_[i]) / (tt_[i + 1] - tt_[i]);
+    double const ut1_julian_day_fraction =
+        (λ - 0.5) +
+        (ut1_minus_utc_[i] + λ * (ut1_minus_utc_[i + 1] - ut1_minus_utc_[i])) /
+            (1 * Day);
+    double const Tu = jd_minus_2451545_[i] + ut1_julian_day_fraction;
+    earth_rotation_angle[k] = 2 * π * Radian *
+                              (ut1_julian_day_fraction + 0.7790572732640 +
+                               0.00273781191135448 * Tu);
+  }
+}
+
+inline int UT1Table::Lookup(Instant const& tt, int const hint) const {
+  CHECK_LE(t_min_, tt) << "UT1 is not tabulated before 1962";
+  CHECK_LT(tt, t_max_) << "UT1 is not tabulated after " << t_max_;
+  if (tt_[hint] <= tt && tt < tt_[hint + 1]) {
+    // Common case for sorted batches: same interval as the previous instant.
+    return hint;
+  }
+  int i = entry_at_day_[static_cast<int>((tt - t_min_) / Day)];
+  // The loop terminates because |tt < tt_.back()|.
+  while (tt_[i + 1] <= tt) {
+    ++i;
+  }
+  return i;
+}
+
+inline void UT1Table::Lookup(std::vector<Instant> const& tt,
+                             std::vector<int>& indices) const {
+  indices.resize(tt.size());
+  int hint = 0;
+  for (int k = 0; k < tt.size(); ++k) {
+    hint = Lookup(tt[k], hint);
+    indices[k] = hint;
+  }
+}
+
+}  // namespace internal_ut1_table
+}  // namespace astronomy
+}  // namespace principia
@@ -0,0 +1,107 @@
+﻿
+#include "astronomy/ut1_table.hpp"
+
+#include <vector>
+
+#include "astronomy/time_scales.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "quantities/si.hpp"
+#include "testing_utilities/numerics.hpp"
+
+namespace principia {
+namespace astronomy {
+namespace internal_ut1_table {
+
+using internal_time_scales::eop_c04;
+using internal_time_scales::FromTAI;
+using internal_time_scales::FromUT1;
+using quantities::Time;
+using quantities::si::Day;
+using quantities::si::Hour;
+using quantities::si::Micro;
+using quantities::si::Second;
+using testing_utilities::AbsoluteError;
+using ::testing::Eq;
+using ::testing::Lt;
+
+class UT1TableTest : public testing::Test {
+ protected:
+  UT1Table const& table_ = UT1Table::Get();
+};
+
+using UT1TableDeathTest = UT1TableTest;
+
+TEST_F(UT1TableTest, Range) {
+  EXPECT_THAT(table_.t_min(),
+              Eq(eop_c04.front().tt()));
+  EXPECT_THAT(table_.t_max(),
+              Eq(eop_c04.back().tt()));
+}
+
+TEST_F(UT1TableTest, EarthRotationAngle) {
+  // Irregularly spaced instants covering the entire table, including the
+  // entries themselves and the days of leap seconds.
+  std::vector<Instant> instants;
+  for (Instant t = table_.t_min();
+       t < table_.t_max();
+       t += 0.731 * Day + 17 * Second) {
+    instants.push_back(t);
+  }
+  instants.push_back("1962-01-01T00:00:00"_UTC);
+  instants.push_back("2000-01-01T12:00:00"_TT);
+  instants.push_back("2015-06-30T23:59:60"_UTC);
+  instants.push_back("2015-07-01T00:00:00"_UTC);
+  instants.push_back("2016-12-31T23:59:60,5"_UTC);
+
+  for (Instant const& tt : instants) {
+    EXPECT_THAT(table_.EarthRotationAngle(tt),
+                Eq(astronomy::EarthRotationAngle(tt))) << tt;
+  }
+
+  // The batch version gives the same results, whether or not the instants are
+  // sorted.
+  std::vector<Angle> angles;
+  table_.EarthRotationAngle(instants, angles);
+  ASSERT_THAT(angles.size(), Eq(instants.size()));
+  for (int i = 0; i < instants.size(); ++i) {
+    EXPECT_THAT(angles[i], Eq(table_.EarthRotationAngle(instants[i])))
+        << instants[i];
+  }
+}
+
+TEST_F(UT1TableTest, UT1MinusTAI) {
+  // At the entries, no interpolation takes place.
+  for (int i = 0; i < eop_c04.size() - 1; i += 97) {
+    auto const& entry = eop_c04[i];
+    EXPECT_THAT(table_.UT1MinusTAI(entry.tt()), Eq(entry.ut1_minus_tai()))
+        << entry.tt();
+  }
+
+  // Round-trip through UT1, whose conversion to TT uses an interpolation in
+  // UT1 rather than in TT.
+  std::vector<Instant> instants;
+  for (Instant t = "1980-01-01T00:00:00"_TT;
+       t < "2019-01-01T00:00:00"_TT;
+       t += 7 * Day + 5 * Hour) {
+    instants.push_back(t);
+  }
+  std::vector<Time> ut1_minus_tai;
+  table_.UT1MinusTAI(instants, ut1_minus_tai);
+  for (int i = 0; i < instants.size(); ++i) {
+    Instant const& tt = instants[i];
+    EXPECT_THAT(ut1_minus_tai[i], Eq(table_.UT1MinusTAI(tt)));
+    Time const ut1 = (tt - FromTAI(0 * Second)) + ut1_minus_tai[i];
+    EXPECT_THAT(AbsoluteError(FromUT1(ut1), tt), Lt(1 * Micro(Second))) << tt;
+  }
+}
+
+TEST_F(UT1TableDeathTest, Bounds) {
+  EXPECT_DEATH(table_.EarthRotationAngle(table_.t_min() - 1 * Second),
+               "before 1962");
+  EXPECT_DEATH(table_.UT1MinusTAI(table_.t_max()), "after");
+}
+
+}  // namespace internal_ut1_table
+}  // namespace astronomy
+}  // namespace principia
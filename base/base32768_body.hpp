@@ -204,6 +204,66 @@ constexpr std::int64_t bytes_per_code_point =
 static_assert(bytes_per_code_point == 3,
               "End of input padding below won't be correct");
 
+// The bulk of the input is processed by groups of 15 bytes, i.e., 8 code
+// points, so that the bit index is 0 at the beginning of each group.  The bits
+// of a group are held in two words: the first 8 bytes in |high| and the last 7
+// bytes in the low-order bits of |low|.
+constexpr std::int64_t bytes_per_group = 15;
+constexpr std::int64_t code_points_per_group = 8;
+static_assert(bytes_per_group * bits_per_byte ==
+                  code_points_per_group * bits_per_code_point,
+              "Groups don't have an integral number of code points");
+constexpr std::uint64_t code_point_mask = (1 << bits_per_code_point) - 1;
+
+// Big-endian loads and stores.
+inline std::uint64_t LoadBytes(std::uint8_t const* const bytes,
+                               int const count) {
+  std::uint64_t result = 0;
+  for (int i = 0; i < count; ++i) {
+    result = result << bits_per_byte | bytes[i];
+  }
+  return result;
+}
+
+inline void StoreBytes(std::uint64_t word,
+                       int const count,
+                       std::uint8_t* const bytes) {
+  for (int i = count - 1; i >= 0; --i) {
+    bytes[i] = static_cast<std::uint8_t>(word);
+    word >>= bits_per_byte;
+  }
+}
+
+inline void EncodeGroup(std::uint8_t const* const input,
+                        char16_t* const output) {
+  std::uint64_t const high = LoadBytes(&input[0], 8);
+  std::uint64_t const low = LoadBytes(&input[8], 7);
+  output[0] = fifteen_bits.Encode(high >> 49);
+  output[1] = fifteen_bits.Encode((high >> 34) & code_point_mask);
+  output[2] = fifteen_bits.Encode((high >> 19) & code_point_mask);
+  output[3] = fifteen_bits.Encode((high >> 4) & code_point_mask);
+  output[4] = fifteen_bits.Encode(((high & 0xF) << 11) | (low >> 45));
+  output[5] = fifteen_bits.Encode((low >> 30) & code_point_mask);
+  output[6] = fifteen_bits.Encode((low >> 15) & code_point_mask);
+  output[7] = fifteen_bits.Encode(low & code_point_mask);
+}
+
+inline void DecodeGroup(char16_t const* const input,
+                        std::uint8_t* const output) {
+  std::uint64_t code_points[code_points_per_group];
+  for (int i = 0; i < code_points_per_group; ++i) {
+    code_points[i] = fifteen_bits.Decode(input[i]);
+  }
+  std::uint64_t const high = code_points[0] << 49 | code_points[1] << 34 |
+                             code_points[2] << 19 | code_points[3] << 4 |
+                             code_points[4] >> 11;
+  std::uint64_t const low = (code_points[4] & 0x7FF) << 45 |
+                            code_points[5] << 30 | code_points[6] << 15 |
+                            code_points[7];
+  StoreBytes(high, 8, &output[0]);
+  StoreBytes(low, 7, &output[8]);
+}
+
 template<bool null_terminated>
 void Base32768Encoder<null_terminated>::Encode(Array<std::uint8_t const> input,
                                                Array<char16_t> output) {
@@ -211,6 +271,11 @@ void Base32768Encoder<null_terminated>::Encode(Array<std::uint8_t const> input,
   CHECK(input.size == 0 || output.data != nullptr);
 
   std::uint8_t const* const input_end = input.data + input.size;
+  for (; input_end - input.data >= bytes_per_group;
+       input.data += bytes_per_group, output.data += code_points_per_group) {
+    EncodeGroup(input.data, output.data);
+  }
+
   std::int64_t input_bit_index = 0;
   while (input.data < input_end) {
     std::int32_t data;
@@ -293,6 +358,14 @@ void Base32768Encoder<null_terminated>::Decode(Array<char16_t const> input,
 
   char16_t const* const input_end = input.data + input.size;
   std::uint8_t const* const output_end = output.data + output.size;
+  // The last code point may use the seven-bit repertoire, so it is never part
+  // of a group.
+  for (; input_end - input.data > code_points_per_group &&
+         output_end - output.data >= bytes_per_group;
+       input.data += code_points_per_group, output.data += bytes_per_group) {
+    DecodeGroup(input.data, output.data);
+  }
+
   std::int64_t output_bit_index = 0;
   while (input.data < input_end) {
     bool const at_end = input_end - input.data == 1;
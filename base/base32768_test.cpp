@@ -268,6 +268,39 @@ TEST_F(Base32768Test, EncodeHatetrisWr) {
   CheckDecoding(binary, base32768);
 }
 
+// The bulk of the input is encoded by groups of 15 bytes, the rest one code
+// point at a time.  Since there is no padding at the end of a group, encoding
+// the groups and the rest separately must give the same result.
+TEST_F(Base32768Test, Groups) {
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<int> bytes_distribution(0, 255);
+  for (std::int64_t size = 0; size < 100; ++size) {
+    UniqueArray<std::uint8_t> binary(size);
+    for (int i = 0; i < binary.size; ++i) {
+      binary.data[i] = bytes_distribution(random);
+    }
+    std::int64_t const grouped_size = size / 15 * 15;
+    Array<std::uint8_t const> const grouped(binary.data.get(), grouped_size);
+    Array<std::uint8_t const> const rest(&binary.data[grouped_size],
+                                         size - grouped_size);
+
+    UniqueArray<char16_t> const base32768 = encoder_.Encode(binary.get());
+    UniqueArray<char16_t> const grouped_base32768 = encoder_.Encode(grouped);
+    UniqueArray<char16_t> const rest_base32768 = encoder_.Encode(rest);
+    ASSERT_EQ(base32768.size, grouped_base32768.size + rest_base32768.size);
+    EXPECT_EQ(0,
+              std::char_traits<char16_t>::compare(base32768.data.get(),
+                                                  grouped_base32768.data.get(),
+                                                  grouped_base32768.size));
+    EXPECT_EQ(0,
+              std::char_traits<char16_t>::compare(
+                  &base32768.data[grouped_base32768.size],
+                  rest_base32768.data.get(),
+                  rest_base32768.size));
+    CheckDecoding(binary.get(), base32768.get());
+  }
+}
+
 TEST_F(Base32768Test, Random) {
   std::mt19937_64 random(42);
   std::uniform_int_distribution<std::uint64_t> length_distribution(100, 150);
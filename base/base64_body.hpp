@@ -3,9 +3,14 @@
 
 #include "base/base64.hpp"
 
+#include <emmintrin.h>
+
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 #include "absl/strings/escaping.h"
+#include "base/macros.hpp"
 
 namespace principia {
 namespace base {
@@ -14,10 +19,133 @@ namespace internal_base64 {
 constexpr std::int64_t bits_per_byte = 8;
 constexpr std::int64_t bits_per_char = 6;
 
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+// The vectorized code below encodes 12 bytes into 16 characters, or decodes 16
+// characters into 12 bytes, at a time using only SSE2.  Each 32-bit lane holds
+// a group of 3 bytes or 4 characters.  The remainder of the input is handled by
+// absl, which is also used if the input and the output overlap.
+
+constexpr std::int64_t bytes_per_block = 12;
+constexpr std::int64_t chars_per_block = 16;
+
+inline bool Overlap(void const* const input, std::int64_t const input_size,
+                    void const* const output, std::int64_t const output_size) {
+  auto const* const input_begin = static_cast<std::uint8_t const*>(input);
+  auto const* const output_begin = static_cast<std::uint8_t const*>(output);
+  return input_begin < output_begin + output_size &&
+         output_begin < input_begin + input_size;
+}
+
+// Returns, in each byte, |0xFF| if the corresponding byte of |x| is in
+// [lower, upper] and 0 otherwise.
+inline __m128i InRange(__m128i const x, char const lower, char const upper) {
+  return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(lower - 1)),
+                       _mm_cmplt_epi8(x, _mm_set1_epi8(upper + 1)));
+}
+
+// Maps the bytes of |sextets|, which must be in [0, 63], to the base64url
+// alphabet.
+inline __m128i SextetsToChars(__m128i const sextets) {
+  // Start from the upper-case letters and adjust for the other ranges.
+  __m128i chars = _mm_add_epi8(sextets, _mm_set1_epi8('A'));
+  auto const adjust = [&chars](__m128i const mask, char const offset) {
+    chars = _mm_add_epi8(chars, _mm_and_si128(mask, _mm_set1_epi8(offset)));
+  };
+  adjust(_mm_cmpgt_epi8(sextets, _mm_set1_epi8(25)), 'a' - 26 - 'A');
+  adjust(_mm_cmpgt_epi8(sextets, _mm_set1_epi8(51)), '0' - 52 - ('a' - 26));
+  adjust(_mm_cmpeq_epi8(sextets, _mm_set1_epi8(62)), '-' - 62 - ('0' - 52));
+  adjust(_mm_cmpeq_epi8(sextets, _mm_set1_epi8(63)), '_' - 63 - ('0' - 52));
+  return chars;
+}
+
+// Maps the bytes of |chars| to their values in the base64url alphabet, and sets
+// |valid| to false if some character is not in the alphabet.
+inline __m128i CharsToSextets(__m128i const chars, bool& valid) {
+  __m128i sextets = _mm_setzero_si128();
+  __m128i in_alphabet = _mm_setzero_si128();
+  auto const add_range =
+      [&chars, &sextets, &in_alphabet](__m128i const mask, char const offset) {
+        sextets = _mm_or_si128(
+            sextets,
+            _mm_and_si128(mask, _mm_add_epi8(chars, _mm_set1_epi8(offset))));
+        in_alphabet = _mm_or_si128(in_alphabet, mask);
+      };
+  add_range(InRange(chars, 'A', 'Z'), -'A');
+  add_range(InRange(chars, 'a', 'z'), 26 - 'a');
+  add_range(InRange(chars, '0', '9'), 52 - '0');
+  add_range(_mm_cmpeq_epi8(chars, _mm_set1_epi8('-')), 62 - '-');
+  add_range(_mm_cmpeq_epi8(chars, _mm_set1_epi8('_')), 63 - '_');
+  valid = _mm_movemask_epi8(in_alphabet) == 0xFFFF;
+  return sextets;
+}
+
+// Encodes the 12 bytes at |input| into the 16 characters at |output|.
+inline void EncodeBlock(std::uint8_t const* const input, char* const output) {
+  auto const group = [input](int const i) {
+    return input[3 * i] << 16 | input[3 * i + 1] << 8 | input[3 * i + 2];
+  };
+  __m128i const groups = _mm_setr_epi32(group(0), group(1), group(2), group(3));
+  // Put the first sextet of each group in the lowest byte of its lane, and so
+  // on.
+  __m128i const sextets = _mm_or_si128(
+      _mm_or_si128(_mm_srli_epi32(groups, 18),
+                   _mm_and_si128(_mm_srli_epi32(groups, 4),
+                                 _mm_set1_epi32(0x0000'3F00))),
+      _mm_or_si128(_mm_and_si128(_mm_slli_epi32(groups, 10),
+                                 _mm_set1_epi32(0x003F'0000)),
+                   _mm_and_si128(_mm_slli_epi32(groups, 24),
+                                 _mm_set1_epi32(0x3F00'0000))));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(output), SextetsToChars(sextets));
+}
+
+// Decodes the 16 characters at |input| into the 12 bytes at |output|.  Returns
+// false, without writing to |output|, if some character is not in the
+// alphabet.
+inline bool DecodeBlock(char const* const input, std::uint8_t* const output) {
+  bool valid;
+  __m128i const sextets = CharsToSextets(
+      _mm_loadu_si128(reinterpret_cast<__m128i const*>(input)), valid);
+  if (!valid) {
+    return false;
+  }
+  __m128i const groups = _mm_or_si128(
+      _mm_or_si128(_mm_slli_epi32(_mm_and_si128(sextets,
+                                                _mm_set1_epi32(0x0000'00FF)),
+                                  18),
+                   _mm_slli_epi32(_mm_and_si128(sextets,
+                                                _mm_set1_epi32(0x0000'FF00)),
+                                  4)),
+      _mm_or_si128(_mm_srli_epi32(_mm_and_si128(sextets,
+                                                _mm_set1_epi32(0x00FF'0000)),
+                                  10),
+                   _mm_srli_epi32(sextets, 24)));
+  alignas(16) std::uint32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), groups);
+  for (int i = 0; i < 4; ++i) {
+    output[3 * i] = lanes[i] >> 16;
+    output[3 * i + 1] = lanes[i] >> 8;
+    output[3 * i + 2] = lanes[i];
+  }
+  return true;
+}
+#endif
+
 template<bool null_terminated>
 void principia::base::internal_base64::Base64Encoder<null_terminated>::Encode(
     Array<std::uint8_t const> input,
     Array<char> output) {
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  if (!Overlap(input.data, input.size, output.data, EncodedLength(input))) {
+    std::int64_t const blocks = input.size / bytes_per_block;
+    for (std::int64_t i = 0; i < blocks; ++i) {
+      EncodeBlock(&input.data[i * bytes_per_block],
+                  &output.data[i * chars_per_block]);
+    }
+    input.data += blocks * bytes_per_block;
+    input.size -= blocks * bytes_per_block;
+    output.data += blocks * chars_per_block;
+  }
+#endif
   std::string_view const input_view(reinterpret_cast<const char*>(input.data),
                                     input.size);
   std::string output_string;
@@ -54,6 +182,18 @@ std::int64_t Base64Encoder<null_terminated>::EncodedLength(
 template<bool null_terminated>
 void Base64Encoder<null_terminated>::Decode(Array<char const> input,
                                             Array<std::uint8_t> output) {
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  if (!Overlap(input.data, input.size, output.data, DecodedLength(input))) {
+    // Stop at the first block that has invalid characters and let absl deal
+    // with it.
+    while (input.size >= chars_per_block &&
+           DecodeBlock(input.data, output.data)) {
+      input.data += chars_per_block;
+      input.size -= chars_per_block;
+      output.data += bytes_per_block;
+    }
+  }
+#endif
   std::string_view const input_view(input.data, input.size);
   std::string output_string;
   absl::WebSafeBase64Unescape(input_view, &output_string);
@@ -1,8 +1,11 @@
 
 #include "base/base64.hpp"
 
+#include <random>
 #include <string>
+#include <vector>
 
+#include "absl/strings/escaping.h"
 #include "gtest/gtest.h"
 
 namespace principia {
@@ -49,5 +52,44 @@ TEST_F(Base64Test, WellKnownData) {
   }
 }
 
+// Compares the encoder, which processes most of the input by blocks, with absl
+// for sizes that are and aren't multiples of the block size, and checks that
+// the results are the same when the input and output overlap.
+TEST_F(Base64Test, Random) {
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<int> bytes_distribution(0, 255);
+  for (std::int64_t size = 0; size < 200; ++size) {
+    std::string decoded_string;
+    for (std::int64_t i = 0; i < size; ++i) {
+      decoded_string += static_cast<char>(bytes_distribution(random));
+    }
+    std::string encoded_string;
+    absl::WebSafeBase64Escape(decoded_string, &encoded_string);
+
+    Array<std::uint8_t const> const decoded_array(
+        reinterpret_cast<std::uint8_t const*>(decoded_string.data()), size);
+    auto const encoded_array = encoder_.Encode(decoded_array);
+    EXPECT_EQ(encoded_string,
+              std::string(encoded_array.data.get(), encoded_array.size));
+
+    Array<char const> const encoded(encoded_string.data(),
+                                    encoded_string.size());
+    auto const decoded = encoder_.Decode(encoded);
+    EXPECT_EQ(decoded_string,
+              std::string(reinterpret_cast<char const*>(decoded.data.get()),
+                          decoded.size));
+
+    std::vector<char> buffer(encoded_string.size());
+    std::copy(decoded_string.begin(), decoded_string.end(), buffer.begin());
+    encoder_.Encode({reinterpret_cast<std::uint8_t const*>(buffer.data()),
+                     size},
+                    {buffer.data(), buffer.size()});
+    EXPECT_EQ(encoded_string, std::string(buffer.data(), buffer.size()));
+    encoder_.Decode({buffer.data(), buffer.size()},
+                    {reinterpret_cast<std::uint8_t*>(buffer.data()), size});
+    EXPECT_EQ(decoded_string, std::string(buffer.data(), size));
+  }
+}
+
 }  // namespace base
 }  // namespace principia
@@ -10,23 +10,29 @@
 namespace principia {
 namespace base {
 
+Bundle::Bundle(not_null<ThreadPool<void>*> const pool) : pool_(pool) {}
+
 void Bundle::Add(Task task) {
   absl::MutexLock l(&lock_);
   CHECK(!joining_);
   ++number_of_active_workers_;
-  workers_.emplace_back(&Bundle::Toil, this, std::move(task));
+  if (pool_ == nullptr) {
+    workers_.emplace_back(&Bundle::Toil, this, std::move(task));
+  } else {
+    // The future is not needed, |all_done_| tells us when the task completes.
+    pool_->Add([this, task = std::move(task)]() { Toil(task); });
+  }
 }
 
 Status Bundle::Join() {
-  joining_ = true;
-  all_done_.WaitForNotification();
+  StartJoining();
   JoinAll();
   absl::ReaderMutexLock status_lock(&status_lock_);
   return status_;
 }
 
 Status Bundle::JoinWithin(std::chrono::steady_clock::duration Δt) {
-  joining_ = true;
+  StartJoining();
   if (!all_done_.WaitForNotificationWithTimeout(absl::FromChrono(Δt))) {
     absl::MutexLock l(&status_lock_);
     status_ = Status(Error::DEADLINE_EXCEEDED, "bundle deadline exceeded");
@@ -37,7 +43,7 @@ Status Bundle::JoinWithin(std::chrono::steady_clock::duration Δt) {
 }
 
 Status Bundle::JoinBefore(std::chrono::system_clock::time_point t) {
-  joining_ = true;
+  StartJoining();
   if (!all_done_.WaitForNotificationWithDeadline(absl::FromChrono(t))) {
     absl::MutexLock l(&status_lock_);
     status_ = Status(Error::DEADLINE_EXCEEDED, "bundle deadline exceeded");
@@ -56,18 +62,28 @@ void Bundle::Toil(Task const& task) {
     status_.Update(status);
   }
 
-  // No locking, so as to avoid contention during joining.  Note that if
-  // |joining_| is true we know that |number_of_active_workers_| cannot
-  // increase.  Reading |number_of_active_workers_| independently from the
-  // decrement would be incorrect as we must ensure that exactly one thread sees
-  // that counter dropping to zero.
-  int const number_of_active_workers = --number_of_active_workers_;
-  if (joining_ && number_of_active_workers == 0) {
+  // No locking, so as to avoid contention during joining.  Note that if the
+  // counter drops to zero we know that |joining_| is true and that
+  // |number_of_active_workers_| cannot increase.  Reading
+  // |number_of_active_workers_| independently from the decrement would be
+  // incorrect as we must ensure that exactly one thread sees that counter
+  // dropping to zero.
+  if (--number_of_active_workers_ == 0) {
+    all_done_.Notify();
+  }
+}
+
+void Bundle::StartJoining() {
+  joining_ = true;
+  // This thread may be the one that sees the counter dropping to zero if all
+  // the tasks have already completed.
+  if (--number_of_active_workers_ == 0) {
     all_done_.Notify();
   }
 }
 
 void Bundle::JoinAll() {
+  all_done_.WaitForNotification();
   absl::ReaderMutexLock l(&lock_);
   for (auto& worker : workers_) {
     worker.join();
@@ -10,24 +10,37 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/notification.h"
 #include "absl/synchronization/mutex.h"
+#include "base/not_null.hpp"
 #include "base/status.hpp"
+#include "base/thread_pool.hpp"
 
 namespace principia {
 namespace base {
 
-// A bundle manages a number of threads that execute independently.  A thread is
-// created for each call to |Add|.  When one of the |Join*| is called, no more
-// calls to |Add| are allowed, and |Join*| returns the first error status (if
-// any) produced by the tasks.
+// A bundle manages a number of tasks that execute independently.  By default a
+// thread is created for each call to |Add|; alternatively, the tasks may be
+// executed by a pool of threads, which bounds their concurrency.  When one of
+// the |Join*| is called, no more calls to |Add| are allowed, and |Join*|
+// returns the first error status (if any) produced by the tasks.
 class Bundle final {
  public:
   using Task = std::function<Status()>;
 
+  // Creates a thread for each task.
+  Bundle() = default;
+
+  // Executes the tasks on |pool|, which may be shared by several bundles and
+  // must outlive the call to |Join*|.  A task executing on |pool| must not
+  // join a bundle that uses |pool|, as that may exhaust the threads of the pool
+  // and deadlock.
+  explicit Bundle(not_null<ThreadPool<void>*> pool);
+
   // If a |task| returns an erroneous |Status|, |Join| returns that status.
   void Add(Task task) LOCKS_EXCLUDED(lock_);
 
-  // Returns the first non-OK status encountered, or OK.  All worker threads are
-  // joined; no calls to member functions may follow this call.
+  // Returns the first non-OK status encountered, or OK.  All tasks are
+  // completed and all worker threads are joined; no calls to member functions
+  // may follow this call.
   Status Join() LOCKS_EXCLUDED(lock_, status_lock_);
   // Same as above, but returns |Error::DEADLINE_EXCEEDED| if it fails to
   // complete within the given interval.
@@ -41,8 +54,16 @@ class Bundle final {
   // Run on a separate thread to execute task and record its status.
   void Toil(Task const& task) LOCKS_EXCLUDED(lock_, status_lock_);
 
+  // Prevents further calls to |Add| and releases the count held on behalf of
+  // the caller of |Join*|.
+  void StartJoining();
+
+  // Waits for the completion of all tasks, irrespective of any deadline, and
+  // joins the worker threads.
   void JoinAll() LOCKS_EXCLUDED(lock_);
 
+  ThreadPool<void>* const pool_ = nullptr;
+
   absl::Mutex status_lock_;
   Status status_ GUARDED_BY(status_lock_);
 
@@ -53,9 +74,11 @@ class Bundle final {
   std::atomic_bool joining_ = false;
   absl::Notification all_done_;
 
-  // The number of workers currently executing.  Can only be incremented when
-  // |joining_| is false.
-  std::atomic_int number_of_active_workers_ = 0;
+  // The number of workers currently executing, plus one until |Join*| is
+  // called, so that it only drops to zero once the bundle is joining and all
+  // its tasks have completed, even if they completed before |Join*| was called.
+  // Can only be incremented when |joining_| is false.
+  std::atomic_int number_of_active_workers_ = 1;
   std::list<std::thread> workers_ GUARDED_BY(lock_);
 
   static_assert(std::atomic_bool::is_always_lock_free, "bool not lock-free");
@@ -4,6 +4,7 @@
 #include <atomic>
 #include <vector>
 
+#include "base/thread_pool.hpp"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "testing_utilities/matchers.hpp"
@@ -87,5 +88,55 @@ TEST_F(BundleTest, Deadline) {
   EXPECT_THAT(status.message(), Eq("bundle deadline exceeded"));
 }
 
+TEST_F(BundleTest, JoinAfterCompletion) {
+  bundle_.Add([]() { return Status::OK; });
+  std::this_thread::sleep_for(10ms);
+  EXPECT_OK(bundle_.Join());
+}
+
+TEST(BundlePoolTest, ShortTasks) {
+  ThreadPool<void> pool(workers);
+  std::atomic_int executed = 0;
+  for (int i = 0; i < 10; ++i) {
+    Bundle bundle(&pool);
+    for (int j = 0; j < 1000; ++j) {
+      bundle.Add([&executed]() {
+        ++executed;
+        return Status::OK;
+      });
+    }
+    EXPECT_OK(bundle.Join());
+    EXPECT_THAT(executed, Eq(1000 * (i + 1)));
+  }
+}
+
+TEST(BundlePoolTest, Error) {
+  ThreadPool<void> pool(workers);
+  Bundle bundle(&pool);
+  for (int i = 0; i < 100; ++i) {
+    bundle.Add([i]() {
+      return i == 42 ? Status(Error::CANCELLED, "cancelled") : Status::OK;
+    });
+  }
+  EXPECT_THAT(bundle.Join().error(), Eq(Error::CANCELLED));
+}
+
+TEST(BundlePoolTest, Deadline) {
+  ThreadPool<void> pool(workers);
+  std::atomic_int executed = 0;
+  Bundle bundle(&pool);
+  for (int i = 0; i < 2 * workers; ++i) {
+    bundle.Add([&executed]() {
+      std::this_thread::sleep_for(100ms);
+      ++executed;
+      return Status::OK;
+    });
+  }
+  auto const status = bundle.JoinWithin(10ms);
+  EXPECT_THAT(status.error(), Eq(Error::DEADLINE_EXCEEDED));
+  // The tasks have completed nonetheless.
+  EXPECT_THAT(executed, Eq(2 * workers));
+}
+
 }  // namespace base
 }  // namespace principia
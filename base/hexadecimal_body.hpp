@@ -3,9 +3,12 @@
 
 #include "base/hexadecimal.hpp"
 
+#include <emmintrin.h>
+
 #include <cstdint>
 #include <cstring>
 
+#include "base/macros.hpp"
 #include "glog/logging.h"
 
 namespace principia {
@@ -38,6 +41,41 @@ constexpr std::uint8_t const hexadecimal_digits_to_nibble[256] = {
 #undef SKIP_48
 #endif
 
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+// The vectorized functions below process 16 bytes at a time using only SSE2.
+// They produce the same results as the tables above.
+
+// Returns, in each byte, |0xFF| if the corresponding byte of |x| is in
+// [lower, upper] and 0 otherwise.  The comparisons are signed, so bytes greater
+// than 0x7F are never in the range.
+inline __m128i InRange(__m128i const x, char const lower, char const upper) {
+  return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(lower - 1)),
+                       _mm_cmplt_epi8(x, _mm_set1_epi8(upper + 1)));
+}
+
+// |nibbles| must have its bytes in [0, 15].
+inline __m128i NibblesToDigits(__m128i const nibbles) {
+  __m128i const letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles,
+                                                       _mm_set1_epi8(9)),
+                                        _mm_set1_epi8('A' - '0' - 10));
+  return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+// Invalid digits are mapped to 0.
+inline __m128i DigitsToNibbles(__m128i const digits) {
+  // Setting this bit maps upper-case letters to lower-case letters, and maps
+  // no other character to a lower-case letter in [a, f].
+  __m128i const lower_case = _mm_or_si128(digits, _mm_set1_epi8(0x20));
+  __m128i const decimal =
+      _mm_and_si128(InRange(digits, '0', '9'),
+                    _mm_sub_epi8(digits, _mm_set1_epi8('0')));
+  __m128i const letter =
+      _mm_and_si128(InRange(lower_case, 'a', 'f'),
+                    _mm_sub_epi8(lower_case, _mm_set1_epi8('a' - 10)));
+  return _mm_or_si128(decimal, letter);
+}
+#endif
+
 template<bool null_terminated>
 void HexadecimalEncoder<null_terminated>::Encode(
     Array<std::uint8_t const> input,
@@ -54,16 +92,33 @@ void HexadecimalEncoder<null_terminated>::Encode(
         static_cast<void*>(&output.data[input.size << 1]) <= input.data)
       << "bad overlap";
   CHECK_GE(output.size, EncodedLength(input)) << "output too small";
-  // We want the result to start at |output.data[0]|.
-  output.data += ((input.size - 1) << 1);
   if constexpr (null_terminated) {
-    output.data[2] = 0;
+    output.data[input.size << 1] = 0;
+  }
+  std::int64_t i = input.size;
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  // The 16 bytes of a block are read before its 32 digits are written, and the
+  // digits are written at or after the first byte of the block, so the above
+  // overlap condition also protects the blocks that remain to be read.
+  __m128i const low_nibble_mask = _mm_set1_epi8(0x0F);
+  for (; i >= 16; i -= 16) {
+    __m128i const bytes = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(&input.data[i - 16]));
+    __m128i const high_digits = NibblesToDigits(
+        _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble_mask));
+    __m128i const low_digits =
+        NibblesToDigits(_mm_and_si128(bytes, low_nibble_mask));
+    auto* const digits =
+        reinterpret_cast<__m128i*>(&output.data[(i - 16) << 1]);
+    _mm_storeu_si128(&digits[0], _mm_unpacklo_epi8(high_digits, low_digits));
+    _mm_storeu_si128(&digits[1], _mm_unpackhi_epi8(high_digits, low_digits));
   }
-  input.data += input.size - 1;
-  for (std::uint8_t const* const input_rend = input.data - input.size;
-       input.data != input_rend;
-       --input.data, output.data -= 2) {
-    std::memcpy(output.data, &byte_to_hexadecimal_digits[*input.data << 1], 2);
+#endif
+  // The remaining bytes are processed one at a time, still backward.
+  for (--i; i >= 0; --i) {
+    std::memcpy(&output.data[i << 1],
+                &byte_to_hexadecimal_digits[input.data[i] << 1],
+                2);
   }
 }
 
@@ -102,11 +157,32 @@ void HexadecimalEncoder<null_terminated>::Decode(Array<char const> input,
         &input.data[input.size] <= static_cast<void*>(output.data))
       << "bad overlap";
   CHECK_GE(output.size, input.size / 2) << "output too small";
-  for (char const* const input_end = input.data + input.size;
-       input.data != input_end;
-       input.data += 2, ++output.data) {
-    *output.data = (hexadecimal_digits_to_nibble[*input.data] << 4) |
-                   hexadecimal_digits_to_nibble[*(input.data + 1)];
+  std::int64_t i = 0;
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  // The 16 bytes of a block are written before the 32 digits of the next block
+  // are read, and they don't reach these digits.
+  __m128i const low_byte_mask = _mm_set1_epi16(0x00FF);
+  for (; (i + 16) << 1 <= input.size; i += 16) {
+    auto* const digits =
+        reinterpret_cast<__m128i const*>(&input.data[i << 1]);
+    // In each 16-bit lane, the low byte holds the high nibble.
+    __m128i const nibbles0 = DigitsToNibbles(_mm_loadu_si128(&digits[0]));
+    __m128i const nibbles1 = DigitsToNibbles(_mm_loadu_si128(&digits[1]));
+    __m128i const bytes0 =
+        _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles0, low_byte_mask), 4),
+                     _mm_srli_epi16(nibbles0, 8));
+    __m128i const bytes1 =
+        _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles1, low_byte_mask), 4),
+                     _mm_srli_epi16(nibbles1, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output.data[i]),
+                     _mm_packus_epi16(bytes0, bytes1));
+  }
+#endif
+  for (; i << 1 < input.size; ++i) {
+    auto const* const digits =
+        reinterpret_cast<std::uint8_t const*>(&input.data[i << 1]);
+    output.data[i] = (hexadecimal_digits_to_nibble[digits[0]] << 4) |
+                     hexadecimal_digits_to_nibble[digits[1]];
   }
 }
 
@@ -2,6 +2,7 @@
 #include "base/hexadecimal.hpp"
 
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -165,5 +166,68 @@ TEST_F(HexadecimalTest, Invalid) {
   EXPECT_THAT(bytes, ElementsAre('\x0A', '\x0C', '\xDE'));
 }
 
+// Compares the encoder, which processes most of the input by blocks, with a
+// character-by-character reference, for sizes that are and aren't multiples of
+// the block size, and for in-place encoding and decoding.
+TEST_F(HexadecimalTest, Random) {
+  auto const digit = [](int const nibble) {
+    return "0123456789ABCDEF"[nibble];
+  };
+  auto const nibble = [](char const digit) {
+    if (digit >= '0' && digit <= '9') {
+      return digit - '0';
+    } else if (digit >= 'A' && digit <= 'F') {
+      return digit - 'A' + 10;
+    } else if (digit >= 'a' && digit <= 'f') {
+      return digit - 'a' + 10;
+    } else {
+      return 0;
+    }
+  };
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<int> bytes_distribution(0, 255);
+  std::uniform_int_distribution<int> digits_distribution(0, 21);
+  for (std::int64_t size = 0; size < 100; ++size) {
+    std::vector<std::uint8_t> bytes(size);
+    std::string expected_digits;
+    for (auto& byte : bytes) {
+      byte = bytes_distribution(random);
+      expected_digits += digit(byte >> 4);
+      expected_digits += digit(byte & 0xF);
+    }
+    auto const digits = encoder_.Encode(bytes);
+    EXPECT_EQ(expected_digits, std::string(digits.data.get(), digits.size));
+
+    // Decode valid and invalid digits.
+    std::string mixed_digits;
+    std::vector<std::uint8_t> expected_bytes;
+    for (std::int64_t i = 0; i < size; ++i) {
+      char const high = "0123456789abcdefABCDEF"[digits_distribution(random)];
+      char const low = static_cast<char>(bytes_distribution(random));
+      mixed_digits += high;
+      mixed_digits += low;
+      expected_bytes.push_back(nibble(high) << 4 | nibble(low));
+    }
+    auto const decoded = encoder_.Decode(
+        Array<char const>(mixed_digits.data(), mixed_digits.size()));
+    EXPECT_EQ(Array<std::uint8_t const>(expected_bytes), decoded.get());
+
+    // In place, with the input at the beginning of the buffer or one byte
+    // after.
+    for (int const offset : {0, 1}) {
+      std::vector<std::uint8_t> buffer(2 * size + 1);
+      auto const buffer_characters = reinterpret_cast<char*>(buffer.data());
+      std::copy(bytes.begin(), bytes.end(), &buffer[offset]);
+      encoder_.Encode({&buffer[offset], size},
+                      {&buffer_characters[0], 2 * size});
+      EXPECT_EQ(expected_digits, std::string(buffer_characters, 2 * size));
+      encoder_.Decode({&buffer_characters[0], 2 * size},
+                      {&buffer[offset], size});
+      EXPECT_EQ(Array<std::uint8_t const>(bytes),
+                Array<std::uint8_t const>(&buffer[offset], size));
+    }
+  }
+}
+
 }  // namespace base
 }  // namespace principia
@@ -144,6 +144,18 @@ inline void noreturn() { std::exit(0); }
 // 64-bit architectures.
 #define PRINCIPIA_USE_SSE3_INTRINSICS !_DEBUG
 
+// AVX2 and FMA are only used if the build targets them (/arch:AVX2 with MSVC,
+// -mavx2 -mfma with Clang), as the resulting binaries don't run on processors
+// older than Haswell.  MSVC doesn't define |__FMA__|, but /arch:AVX2 implies
+// FMA.  FMAs are only emitted explicitly: the compiler must not contract
+// expressions.
+#if PRINCIPIA_USE_SSE3_INTRINSICS && defined(__AVX2__) && \
+    (defined(__FMA__) || PRINCIPIA_COMPILER_MSVC)
+#  define PRINCIPIA_USE_AVX2_FMA_INTRINSICS 1
+#else
+#  define PRINCIPIA_USE_AVX2_FMA_INTRINSICS 0
+#endif
+
 // Thread-safety analysis.
 #if PRINCIPIA_COMPILER_CLANG || PRINCIPIA_COMPILER_CLANG_CL
 #  define THREAD_ANNOTATION_ATTRIBUTE__(x) __attribute__((x))
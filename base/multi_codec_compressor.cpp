@@ -0,0 +1,268 @@
+﻿
+#include "base/multi_codec_compressor.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "glog/logging.h"
+#include "lz4.h"
+#include "zstd.h"
+
+namespace principia {
+namespace base {
+namespace internal_multi_codec_compressor {
+
+namespace {
+
+// A good compromise between speed and ratio for chunks of some tens of KiB.
+constexpr int zstd_compression_level = 6;
+
+// The zstd contexts are expensive to create, so each thread keeps its own.
+ZSTD_CCtx* ThreadCompressionContext() {
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(
+      ZSTD_createCCtx(), &ZSTD_freeCCtx);
+  return context.get();
+}
+
+ZSTD_DCtx* ThreadDecompressionContext() {
+  thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(
+      ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  return context.get();
+}
+
+// Returns a pointer to the entire contents of |source|.  If they are not
+// contiguous, they are copied to |buffer| and |source| is consumed.  The caller
+// must skip whatever remains available in |source| once it is done with the
+// data.
+char const* PeekAll(Source& source, std::string& buffer) {
+  std::size_t const size = source.Available();
+  std::size_t peeked;
+  char const* const data = source.Peek(&peeked);
+  if (peeked >= size) {
+    return data;
+  }
+  buffer.clear();
+  buffer.reserve(size);
+  while (source.Available() > 0) {
+    char const* const fragment = source.Peek(&peeked);
+    buffer.append(fragment, peeked);
+    source.Skip(peeked);
+  }
+  return buffer.data();
+}
+
+}  // namespace
+
+MultiCodecCompressor::MultiCodecCompressor(Codec const codec)
+    : codec_(codec) {}
+
+std::size_t MultiCodecCompressor::Compress(std::string const& input,
+                                           std::string* const output) {
+  output->resize(MaxCompressedLength(input.size()));
+  std::size_t const size =
+      CompressBlock(input.data(), input.size(), &(*output)[0]);
+  output->resize(size);
+  return size;
+}
+
+bool MultiCodecCompressor::Uncompress(std::string const& compressed,
+                                      std::string* const uncompressed) {
+  std::size_t uncompressed_size;
+  if (!GetUncompressedLength(compressed, &uncompressed_size)) {
+    return false;
+  }
+  uncompressed->resize(uncompressed_size);
+  return UncompressBlock(compressed.data(),
+                         compressed.size(),
+                         &(*uncompressed)[0],
+                         uncompressed_size);
+}
+
+std::size_t MultiCodecCompressor::MaxCompressedLength(
+    std::size_t const nbytes) {
+  return header_size + nbytes;
+}
+
+bool MultiCodecCompressor::GetUncompressedLength(
+    std::string const& compressed,
+    std::size_t* const result) {
+  Codec codec;
+  return ReadHeader(compressed.data(), compressed.size(), codec, *result);
+}
+
+std::size_t MultiCodecCompressor::CompressStream(Source* const source,
+                                                 Sink* const sink) {
+  std::size_t const input_size = source->Available();
+  std::string input_buffer;
+  char const* const input = PeekAll(*source, input_buffer);
+
+  std::size_t const max_compressed_size = MaxCompressedLength(input_size);
+  std::string scratch(max_compressed_size, '\0');
+  std::size_t allocated_size;
+  char* output = sink->GetAppendBuffer(max_compressed_size,
+                                       max_compressed_size,
+                                       &scratch[0],
+                                       scratch.size(),
+                                       &allocated_size);
+  if (allocated_size < max_compressed_size) {
+    output = &scratch[0];
+  }
+  std::size_t const size = CompressBlock(input, input_size, output);
+  source->Skip(source->Available());
+  sink->Append(output, size);
+  return size;
+}
+
+bool MultiCodecCompressor::GetUncompressedLengthStream(
+    Source* const compressed,
+    std::size_t* const result) {
+  char header[header_size];
+  std::size_t peeked;
+  char const* const data = compressed->Peek(&peeked);
+  if (peeked < header_size) {
+    return false;
+  }
+  std::copy(data, data + header_size, header);
+  Codec codec;
+  return ReadHeader(header, header_size, codec, *result);
+}
+
+bool MultiCodecCompressor::UncompressStream(Source* const source,
+                                            Sink* const sink) {
+  std::size_t const input_size = source->Available();
+  std::string input_buffer;
+  char const* const input = PeekAll(*source, input_buffer);
+
+  Codec codec;
+  std::size_t uncompressed_size;
+  if (!ReadHeader(input, input_size, codec, uncompressed_size)) {
+    return false;
+  }
+  std::string scratch;
+  std::size_t allocated_size;
+  char* output = sink->GetAppendBuffer(uncompressed_size,
+                                       uncompressed_size,
+                                       nullptr,
+                                       0,
+                                       &allocated_size);
+  if (allocated_size < uncompressed_size) {
+    scratch.resize(uncompressed_size);
+    output = &scratch[0];
+  }
+  bool const uncompressed =
+      UncompressBlock(input, input_size, output, uncompressed_size);
+  source->Skip(source->Available());
+  if (!uncompressed) {
+    return false;
+  }
+  sink->Append(output, uncompressed_size);
+  return true;
+}
+
+std::size_t MultiCodecCompressor::CompressBlock(char const* const input,
+                                                std::size_t const size,
+                                                char* const output) const {
+  CHECK_LE(size, std::numeric_limits<std::uint32_t>::max());
+  char* const payload = output + header_size;
+  // A compressed payload is only useful if it is shorter than |size|, so we
+  // don't give the codecs more room than that.
+  std::size_t const capacity = size == 0 ? 0 : size - 1;
+  std::size_t compressed_size = 0;
+  switch (codec_) {
+    case Codec::Stored:
+      break;
+    case Codec::LZ4: {
+      int const result = LZ4_compress_default(input,
+                                              payload,
+                                              static_cast<int>(size),
+                                              static_cast<int>(capacity));
+      compressed_size = result > 0 ? result : 0;
+      break;
+    }
+    case Codec::Zstd: {
+      std::size_t const result = ZSTD_compressCCtx(ThreadCompressionContext(),
+                                                   payload,
+                                                   capacity,
+                                                   input,
+                                                   size,
+                                                   zstd_compression_level);
+      compressed_size = ZSTD_isError(result) ? 0 : result;
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected codec " << static_cast<int>(codec_);
+  }
+
+  Codec codec = codec_;
+  if (compressed_size == 0) {
+    codec = Codec::Stored;
+    std::copy(input, input + size, payload);
+    compressed_size = size;
+  }
+  output[0] = static_cast<char>(codec);
+  for (int i = 0; i < header_size - 1; ++i) {
+    output[1 + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+  }
+  return header_size + compressed_size;
+}
+
+bool MultiCodecCompressor::UncompressBlock(
+    char const* const input,
+    std::size_t const size,
+    char* const output,
+    std::size_t const uncompressed_size) {
+  Codec codec;
+  std::size_t block_uncompressed_size;
+  if (!ReadHeader(input, size, codec, block_uncompressed_size) ||
+      block_uncompressed_size != uncompressed_size) {
+    return false;
+  }
+  char const* const payload = input + header_size;
+  std::size_t const payload_size = size - header_size;
+  switch (codec) {
+    case Codec::Stored:
+      if (payload_size != uncompressed_size) {
+        return false;
+      }
+      std::copy(payload, payload + payload_size, output);
+      return true;
+    case Codec::LZ4:
+      return LZ4_decompress_safe(payload,
+                                 output,
+                                 static_cast<int>(payload_size),
+                                 static_cast<int>(uncompressed_size)) ==
+             static_cast<int>(uncompressed_size);
+    case Codec::Zstd:
+      return ZSTD_decompressDCtx(ThreadDecompressionContext(),
+                                 output,
+                                 uncompressed_size,
+                                 payload,
+                                 payload_size) == uncompressed_size;
+  }
+  return false;
+}
+
+bool MultiCodecCompressor::ReadHeader(char const* const input,
+                                      std::size_t const size,
+                                      Codec& codec,
+                                      std::size_t& uncompressed_size) {
+  if (size < header_size) {
+    return false;
+  }
+  auto const* const header = reinterpret_cast<unsigned char const*>(input);
+  if (header[0] > static_cast<unsigned char>(Codec::Zstd)) {
+    return false;
+  }
+  codec = static_cast<Codec>(header[0]);
+  uncompressed_size = 0;
+  for (int i = 0; i < header_size - 1; ++i) {
+    uncompressed_size |= static_cast<std::size_t>(header[1 + i]) << (8 * i);
+  }
+  return true;
+}
+
+}  // namespace internal_multi_codec_compressor
+}  // namespace base
+}  // namespace principia
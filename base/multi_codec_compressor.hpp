@@ -0,0 +1,86 @@
+﻿
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "gipfeli/compression.h"
+
+namespace principia {
+namespace base {
+namespace internal_multi_codec_compressor {
+
+using google::compression::Compressor;
+using google::compression::Sink;
+using google::compression::Source;
+
+// The codecs supported by |MultiCodecCompressor|.  The values are written in
+// the compressed blocks and must not change.
+enum class Codec : std::uint8_t {
+  // The block is not compressed.
+  Stored = 0,
+  // Fast compression with a moderate ratio.
+  LZ4 = 1,
+  // Slower compression with a high ratio; decompression is still fast.
+  Zstd = 2,
+};
+
+// A compressor that prefixes each block with a header identifying the codec
+// that compressed it and the uncompressed length.  Compression uses the codec
+// given at construction, except that a block that doesn't shrink is stored
+// uncompressed, so that compression never expands the data by more than the
+// header.  Decompression accepts blocks compressed with any codec, so a
+// serialization may be read irrespective of the codec with which it was
+// written.  Unlike the gipfeli compressor, this class is thread-safe: a
+// |PullSerializer| may use it to compress several chunks in parallel.
+class MultiCodecCompressor : public Compressor {
+ public:
+  explicit MultiCodecCompressor(Codec codec);
+
+  std::size_t Compress(std::string const& input, std::string* output) override;
+  bool Uncompress(std::string const& compressed,
+                  std::string* uncompressed) override;
+
+  std::size_t MaxCompressedLength(std::size_t nbytes) override;
+  bool GetUncompressedLength(std::string const& compressed,
+                             std::size_t* result) override;
+
+  std::size_t CompressStream(Source* source, Sink* sink) override;
+  bool GetUncompressedLengthStream(Source* compressed,
+                                   std::size_t* result) override;
+  bool UncompressStream(Source* source, Sink* sink) override;
+
+  // The size of the header of each block: the codec and the little-endian
+  // uncompressed length.
+  static constexpr int header_size = 5;
+
+ private:
+  // Compresses the |size| bytes at |input| into |output|, which must have room
+  // for |MaxCompressedLength(size)| bytes.  Returns the size of the block.
+  std::size_t CompressBlock(char const* input,
+                            std::size_t size,
+                            char* output) const;
+
+  // Returns false if |input| is not a valid block of |size| bytes or if its
+  // uncompressed length is not |uncompressed_size|.
+  static bool UncompressBlock(char const* input,
+                              std::size_t size,
+                              char* output,
+                              std::size_t uncompressed_size);
+
+  // Returns false if |input| doesn't start with a valid header.
+  static bool ReadHeader(char const* input,
+                         std::size_t size,
+                         Codec& codec,
+                         std::size_t& uncompressed_size);
+
+  Codec const codec_;
+};
+
+}  // namespace internal_multi_codec_compressor
+
+using internal_multi_codec_compressor::Codec;
+using internal_multi_codec_compressor::MultiCodecCompressor;
+
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,134 @@
+﻿
+#include "base/multi_codec_compressor.hpp"
+
+#include <random>
+#include <string>
+
+#include "base/array.hpp"
+#include "base/sink_source.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+namespace internal_multi_codec_compressor {
+
+class MultiCodecCompressorTest : public ::testing::Test {
+ protected:
+  MultiCodecCompressorTest() {
+    // Repetitive text compresses well.
+    for (int i = 0; compressible_.size() < 10'000; ++i) {
+      compressible_ += "Principia " + std::to_string(i % 37) + " ";
+    }
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<int> bytes_distribution(0, 255);
+    for (int i = 0; i < 10'000; ++i) {
+      incompressible_.push_back(static_cast<char>(bytes_distribution(random)));
+    }
+  }
+
+  std::string compressible_;
+  std::string incompressible_;
+};
+
+TEST_F(MultiCodecCompressorTest, RoundTrip) {
+  for (Codec const codec : {Codec::Stored, Codec::LZ4, Codec::Zstd}) {
+    MultiCodecCompressor compressor(codec);
+    std::string compressed;
+    std::size_t const compressed_size =
+        compressor.Compress(compressible_, &compressed);
+    EXPECT_EQ(compressed_size, compressed.size());
+    EXPECT_EQ(static_cast<char>(codec), compressed[0]);
+    if (codec == Codec::Stored) {
+      EXPECT_EQ(MultiCodecCompressor::header_size + compressible_.size(),
+                compressed.size());
+    } else {
+      EXPECT_GT(compressible_.size() / 4, compressed.size());
+    }
+
+    std::size_t uncompressed_size;
+    EXPECT_TRUE(compressor.GetUncompressedLength(compressed,
+                                                 &uncompressed_size));
+    EXPECT_EQ(compressible_.size(), uncompressed_size);
+    std::string uncompressed;
+    EXPECT_TRUE(compressor.Uncompress(compressed, &uncompressed));
+    EXPECT_EQ(compressible_, uncompressed);
+  }
+}
+
+TEST_F(MultiCodecCompressorTest, Incompressible) {
+  for (Codec const codec : {Codec::LZ4, Codec::Zstd}) {
+    MultiCodecCompressor compressor(codec);
+    std::string compressed;
+    compressor.Compress(incompressible_, &compressed);
+    // The block is stored, so it is only expanded by the header.
+    EXPECT_EQ(static_cast<char>(Codec::Stored), compressed[0]);
+    EXPECT_EQ(compressor.MaxCompressedLength(incompressible_.size()),
+              compressed.size());
+    std::string uncompressed;
+    EXPECT_TRUE(compressor.Uncompress(compressed, &uncompressed));
+    EXPECT_EQ(incompressible_, uncompressed);
+  }
+}
+
+TEST_F(MultiCodecCompressorTest, MixedCodecs) {
+  // A compressor reads the blocks produced with any codec.
+  MultiCodecCompressor lz4(Codec::LZ4);
+  MultiCodecCompressor zstd(Codec::Zstd);
+  std::string compressed;
+  std::string uncompressed;
+  zstd.Compress(compressible_, &compressed);
+  EXPECT_TRUE(lz4.Uncompress(compressed, &uncompressed));
+  EXPECT_EQ(compressible_, uncompressed);
+  lz4.Compress(compressible_, &compressed);
+  EXPECT_TRUE(zstd.Uncompress(compressed, &uncompressed));
+  EXPECT_EQ(compressible_, uncompressed);
+}
+
+TEST_F(MultiCodecCompressorTest, Stream) {
+  MultiCodecCompressor compressor(Codec::Zstd);
+  Array<char> const input(compressible_);
+  UniqueArray<char> compressed(
+      compressor.MaxCompressedLength(compressible_.size()));
+  UniqueArray<char> uncompressed(compressible_.size());
+
+  ArraySource<char> compression_source(input);
+  ArraySink<char> compression_sink(compressed.get());
+  std::size_t const compressed_size =
+      compressor.CompressStream(&compression_source, &compression_sink);
+  EXPECT_EQ(0, compression_source.Available());
+  EXPECT_EQ(compressed_size, compression_sink.array().size);
+
+  ArraySource<char> uncompression_source(compression_sink.array());
+  ArraySink<char> uncompression_sink(uncompressed.get());
+  EXPECT_TRUE(compressor.UncompressStream(&uncompression_source,
+                                          &uncompression_sink));
+  EXPECT_EQ(0, uncompression_source.Available());
+  EXPECT_EQ(compressible_,
+            std::string(uncompression_sink.array().data,
+                        uncompression_sink.array().size));
+}
+
+TEST_F(MultiCodecCompressorTest, Corrupted) {
+  MultiCodecCompressor compressor(Codec::LZ4);
+  std::string compressed;
+  std::string uncompressed;
+  compressor.Compress(compressible_, &compressed);
+
+  // Unknown codec.
+  std::string corrupted = compressed;
+  corrupted[0] = 42;
+  EXPECT_FALSE(compressor.Uncompress(corrupted, &uncompressed));
+
+  // Truncated payload.
+  corrupted = compressed.substr(0, compressed.size() / 2);
+  EXPECT_FALSE(compressor.Uncompress(corrupted, &uncompressed));
+
+  // Truncated header.
+  corrupted = compressed.substr(0, MultiCodecCompressor::header_size - 1);
+  EXPECT_FALSE(compressor.Uncompress(corrupted, &uncompressed));
+}
+
+}  // namespace internal_multi_codec_compressor
+}  // namespace base
+}  // namespace principia
@@ -2,16 +2,19 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "base/array.hpp"
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "gipfeli/compression.h"
 #include "google/protobuf/message.h"
 #include "google/protobuf/io/zero_copy_stream.h"
@@ -69,6 +72,16 @@ class PullSerializer final {
   PullSerializer(int chunk_size,
                  int number_of_chunks,
                  std::unique_ptr<Compressor> compressor);
+  // Same as above, but up to |compression_threads| chunks are compressed in
+  // parallel, which requires a |compressor| that is thread-safe (e.g., a
+  // |MultiCodecCompressor|, but not a gipfeli compressor).  Each chunk being
+  // compressed holds two of the |number_of_chunks| chunks, so the parallelism
+  // is also limited to |(number_of_chunks - 2) / 2|.  The data returned by
+  // |Pull| are the same irrespective of |compression_threads|.
+  PullSerializer(int chunk_size,
+                 int number_of_chunks,
+                 std::unique_ptr<Compressor> compressor,
+                 int compression_threads);
   ~PullSerializer();
 
   // Starts the serializer, which will proceed to serialize |message|.  This
@@ -76,6 +89,13 @@ class PullSerializer final {
   void Start(
       not_null<std::unique_ptr<google::protobuf::Message const>> message);
   void Start(not_null<google::protobuf::Message const*> message);
+  // Same as above, but the top-level fields of |message| whose numbers appear
+  // in |leading_fields| are serialized first, in that order, and the other
+  // fields follow by increasing number.  The result is a valid serialization of
+  // |message|, since parsers accept the fields in any order, but it lets a
+  // streaming deserializer see some fields before others.
+  void Start(not_null<google::protobuf::Message const*> message,
+             std::vector<int> const& leading_fields);
 
   // Obtain the next chunk of data from the serializer.  Blocks if no data is
   // available.  Returns a |Array<std::uint8_t>| object of |size| 0 at the end
@@ -94,6 +114,15 @@ class PullSerializer final {
   // underlying |DelegatingArrayOutputStream|.
   Array<std::uint8_t> Push(Array<std::uint8_t> bytes);
 
+  // Same as |Push|, but the compression of |bytes| is delegated to the
+  // |compression_pool_|.  The compressed chunk is enqueued immediately, but
+  // |Pull| waits until its compression has completed.
+  Array<std::uint8_t> PushForParallelCompression(Array<std::uint8_t> bytes);
+
+  // Serializes |message_| to |stream_| with the given |leading_fields|, see
+  // |Start|.
+  void SerializeWithLeadingFields(std::vector<int> const& leading_fields);
+
   // |owned_message_| is null if this object doesn't own the message.
   // |message_| is non-null after Start.
   std::unique_ptr<google::protobuf::Message const> owned_message_;
@@ -130,13 +159,24 @@ class PullSerializer final {
   // and not yet consumed by |Pull|.  If a |Array<std::uint8_t>| object has been
   // handed over to the caller by |Pull| it stays in the queue until the next
   // call to |Pull|, to make sure that the pointer is not reused while the
-  // caller processes it.
-  std::queue<Array<std::uint8_t>> queue_ GUARDED_BY(lock_);
+  // caller processes it.  The chunks being compressed in parallel have a size
+  // of |compression_pending|.
+  std::deque<Array<std::uint8_t>> queue_ GUARDED_BY(lock_);
 
   // The |free_| queue contains the start addresses of chunks that are not yet
   // ready to be returned by |Pull|.  That includes the chunk currently being
   // filled by the stream.
   std::queue<not_null<std::uint8_t*>> free_ GUARDED_BY(lock_);
+
+  // The number of uncompressed chunks held by the compressions in progress.
+  // These chunks are neither in |queue_| nor in |free_|.
+  int compressions_in_flight_ GUARDED_BY(lock_) = 0;
+
+  static constexpr std::int64_t compression_pending = -1;
+
+  // Null unless chunks are compressed in parallel.  Declared last so that the
+  // compressions complete before the other members are destroyed.
+  std::unique_ptr<ThreadPool<void>> compression_pool_;
 };
 
 }  // namespace internal_pull_serializer
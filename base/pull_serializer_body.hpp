@@ -4,13 +4,19 @@
 #include "base/pull_serializer.hpp"
 
 #include <algorithm>
+#include <vector>
 
 #include "base/sink_source.hpp"
+#include "glog/logging.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format.h"
 
 namespace principia {
 namespace base {
 namespace internal_pull_serializer {
 
+using google::protobuf::FieldDescriptor;
+using google::protobuf::internal::WireFormat;
 using std::placeholders::_1;
 using std::swap;
 
@@ -65,6 +71,15 @@ inline std::int64_t DelegatingArrayOutputStream::ByteCount() const {
 inline PullSerializer::PullSerializer(int const chunk_size,
                                       int const number_of_chunks,
                                       std::unique_ptr<Compressor> compressor)
+    : PullSerializer(chunk_size,
+                     number_of_chunks,
+                     std::move(compressor),
+                     /*compression_threads=*/1) {}
+
+inline PullSerializer::PullSerializer(int const chunk_size,
+                                      int const number_of_chunks,
+                                      std::unique_ptr<Compressor> compressor,
+                                      int const compression_threads)
     : compressor_(std::move(compressor)),
       chunk_size_(chunk_size),
       compressed_chunk_size_(
@@ -88,8 +103,15 @@ inline PullSerializer::PullSerializer(int const chunk_size,
   for (int i = 0; i < number_of_chunks_ - 1; ++i) {
     free_.push(data_.get() + i * compressed_chunk_size_);
   }
-  queue_.push(Array<std::uint8_t>(
-      data_.get() + (number_of_chunks_ - 1) * compressed_chunk_size_, 0));
+  queue_.emplace_back(
+      data_.get() + (number_of_chunks_ - 1) * compressed_chunk_size_, 0);
+
+  CHECK_LE(1, compression_threads);
+  if (compressor_ != nullptr && compression_threads > 1) {
+    compression_pool_ =
+        std::make_unique<ThreadPool<void>>(std::min(
+            compression_threads, (number_of_chunks_ - 2) / 2));
+  }
 }
 
 inline PullSerializer::~PullSerializer() {
@@ -106,10 +128,20 @@ inline void PullSerializer::Start(
 
 inline void PullSerializer::Start(
     not_null<google::protobuf::Message const*> const message) {
+  Start(message, /*leading_fields=*/{});
+}
+
+inline void PullSerializer::Start(
+    not_null<google::protobuf::Message const*> const message,
+    std::vector<int> const& leading_fields) {
   CHECK(thread_ == nullptr);
   message_ = message;
-  thread_ = std::make_unique<std::thread>([this](){
-    CHECK(message_->SerializeToZeroCopyStream(&stream_));
+  thread_ = std::make_unique<std::thread>([this, leading_fields](){
+    if (leading_fields.empty()) {
+      CHECK(message_->SerializeToZeroCopyStream(&stream_));
+    } else {
+      SerializeWithLeadingFields(leading_fields);
+    }
     // Put a sentinel at the end of the serialized stream so that the client
     // knows that this is the end.
     Array<std::uint8_t> bytes;
@@ -128,15 +160,19 @@ inline Array<std::uint8_t> PullSerializer::Pull() {
     absl::MutexLock l(&lock_);
 
     // The element at the front of the queue is the one that was last returned
-    // by |Pull| and must be dropped and freed.
-    auto const queue_has_elements = [this]() { return queue_.size() > 1; };
+    // by |Pull| and must be dropped and freed.  The next one may still be in
+    // the process of being compressed.
+    auto const queue_has_elements = [this]() {
+      return queue_.size() > 1 && queue_[1].size != compression_pending;
+    };
     lock_.Await(absl::Condition(&queue_has_elements));
 
     CHECK_LE(2, queue_.size());
     free_.push(queue_.front().data);
-    queue_.pop();
+    queue_.pop_front();
     result = queue_.front();
-    CHECK_EQ(number_of_chunks_, queue_.size() + free_.size());
+    CHECK_EQ(number_of_chunks_,
+             queue_.size() + free_.size() + compressions_in_flight_);
   }
   return result;
 }
@@ -144,6 +180,9 @@ inline Array<std::uint8_t> PullSerializer::Pull() {
 inline Array<std::uint8_t> PullSerializer::Push(Array<std::uint8_t> bytes) {
   Array<std::uint8_t> result;
   CHECK_GE(chunk_size_, bytes.size);
+  if (bytes.size > 0 && compression_pool_ != nullptr) {
+    return PushForParallelCompression(bytes);
+  }
   if (bytes.size > 0 && compressor_ != nullptr) {
     Array<std::uint8_t> compressed_bytes;
     {
@@ -170,22 +209,107 @@ inline Array<std::uint8_t> PullSerializer::Push(Array<std::uint8_t> bytes) {
     auto const queue_has_room = [this]() {
       // -1 here is because we want to ensure that there is an entry in the
       // free list, in addition to |result| and to
-      // |number_of_compression_chunks_| (if present).
+      // |number_of_compression_chunks_| (if present).  The second condition
+      // only matters when chunks are compressed in parallel, since the chunks
+      // being compressed are not in the free list.
       return queue_.size() < static_cast<std::size_t>(number_of_chunks_) -
-                                 number_of_compression_chunks_ - 1;
+                                 number_of_compression_chunks_ - 1 &&
+             free_.size() >= static_cast<std::size_t>(
+                                 2 + number_of_compression_chunks_);
     };
     lock_.Await(absl::Condition(&queue_has_room));
 
-    queue_.emplace(bytes.data, bytes.size);
+    queue_.emplace_back(bytes.data, bytes.size);
     CHECK_LE(2 + number_of_compression_chunks_, free_.size());
     CHECK_EQ(free_.front(), bytes.data);
     free_.pop();
     result = Array<std::uint8_t>(free_.front(), chunk_size_);
-    CHECK_EQ(number_of_chunks_, queue_.size() + free_.size());
+    CHECK_EQ(number_of_chunks_,
+             queue_.size() + free_.size() + compressions_in_flight_);
+  }
+  return result;
+}
+
+inline Array<std::uint8_t> PullSerializer::PushForParallelCompression(
+    Array<std::uint8_t> const bytes) {
+  Array<std::uint8_t> compressed_bytes;
+  Array<std::uint8_t> result;
+  {
+    absl::MutexLock l(&lock_);
+
+    // We need a chunk for the compressed data and a chunk for the stream to
+    // fill next, in addition to |bytes|, which is at the front of |free_|.
+    auto const has_free_chunks = [this]() { return free_.size() >= 3; };
+    lock_.Await(absl::Condition(&has_free_chunks));
+
+    CHECK_EQ(free_.front(), bytes.data);
+    free_.pop();
+    compressed_bytes =
+        Array<std::uint8_t>(free_.front(), compressed_chunk_size_);
+    free_.pop();
+    queue_.emplace_back(compressed_bytes.data, compression_pending);
+    ++compressions_in_flight_;
+    result = Array<std::uint8_t>(free_.front(), chunk_size_);
+    CHECK_EQ(number_of_chunks_,
+             queue_.size() + free_.size() + compressions_in_flight_);
   }
+
+  compression_pool_->Add([this, bytes, compressed_bytes]() {
+    ArraySource<std::uint8_t> source(bytes);
+    ArraySink<std::uint8_t> sink(compressed_bytes);
+    compressor_->CompressStream(&source, &sink);
+
+    absl::MutexLock l(&lock_);
+    auto const it = std::find_if(
+        queue_.begin(),
+        queue_.end(),
+        [data = compressed_bytes.data](Array<std::uint8_t> const& chunk) {
+          return chunk.data == data;
+        });
+    CHECK(it != queue_.end());
+    CHECK_EQ(compression_pending, it->size);
+    it->size = sink.array().size;
+    free_.push(bytes.data);
+    --compressions_in_flight_;
+  });
   return result;
 }
 
+inline void PullSerializer::SerializeWithLeadingFields(
+    std::vector<int> const& leading_fields) {
+  auto const* const descriptor = message_->GetDescriptor();
+  auto const* const reflection = message_->GetReflection();
+
+  // |ListFields| returns the fields that are present by increasing number.
+  std::vector<FieldDescriptor const*> present_fields;
+  reflection->ListFields(*message_, &present_fields);
+  std::vector<FieldDescriptor const*> fields;
+  for (int const number : leading_fields) {
+    FieldDescriptor const* const field = descriptor->FindFieldByNumber(number);
+    CHECK(field != nullptr) << number;
+    if (std::find(present_fields.begin(), present_fields.end(), field) !=
+        present_fields.end()) {
+      fields.push_back(field);
+    }
+  }
+  for (FieldDescriptor const* const field : present_fields) {
+    if (std::find(fields.begin(), fields.end(), field) == fields.end()) {
+      fields.push_back(field);
+    }
+  }
+
+  // This caches the sizes of all the submessages, which is a prerequisite for
+  // |SerializeFieldWithCachedSizes|.
+  message_->ByteSizeLong();
+  google::protobuf::io::CodedOutputStream output(&stream_);
+  for (FieldDescriptor const* const field : fields) {
+    WireFormat::SerializeFieldWithCachedSizes(field, *message_, &output);
+  }
+  WireFormat::SerializeUnknownFields(reflection->GetUnknownFields(*message_),
+                                     &output);
+  CHECK(!output.HadError());
+}
+
 }  // namespace internal_pull_serializer
 }  // namespace base
 }  // namespace principia
@@ -6,10 +6,13 @@
 #include <string>
 #include <vector>
 
+#include "base/multi_codec_compressor.hpp"
+#include "base/push_deserializer.hpp"
 #include "gipfeli/compression.h"
 #include "gipfeli/gipfeli.h"
 #include "gmock/gmock.h"
 #include "serialization/physics.pb.h"
+#include "testing_utilities/matchers.hpp"
 
 namespace principia {
 namespace base {
@@ -20,6 +23,7 @@ using serialization::DiscreteTrajectory;
 using serialization::Pair;
 using serialization::Point;
 using serialization::Quantity;
+using testing_utilities::EqualsProto;
 using ::std::placeholders::_1;
 using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
@@ -167,6 +171,100 @@ TEST_F(PullSerializerTest, SerializationGipfeli) {
   EXPECT_EQ(uncompressed1, uncompressed2);
 }
 
+TEST_F(PullSerializerTest, ParallelCompression) {
+  auto const trajectory = BuildTrajectory();
+  std::string sequential_serialized;
+  {
+    PullSerializer sequential_pull_serializer(
+        chunk_size,
+        /*number_of_chunks=*/8,
+        std::make_unique<MultiCodecCompressor>(Codec::Zstd));
+    sequential_pull_serializer.Start(trajectory.get());
+    for (;;) {
+      Array<std::uint8_t> const bytes = sequential_pull_serializer.Pull();
+      if (bytes.size == 0) {
+        break;
+      }
+      sequential_serialized.append(reinterpret_cast<char const*>(bytes.data),
+                                   static_cast<std::size_t>(bytes.size));
+    }
+  }
+
+  // Run this test repeatedly to detect threading issues.  The chunks must come
+  // out in order, and be identical to those produced sequentially.
+  for (int i = 0; i < runs_per_test / 10; ++i) {
+    PullSerializer parallel_pull_serializer(
+        chunk_size,
+        /*number_of_chunks=*/8,
+        std::make_unique<MultiCodecCompressor>(Codec::Zstd),
+        /*compression_threads=*/3);
+    parallel_pull_serializer.Start(trajectory.get());
+    std::vector<std::string> chunks;
+    std::string parallel_serialized;
+    for (;;) {
+      Array<std::uint8_t> const bytes = parallel_pull_serializer.Pull();
+      if (bytes.size == 0) {
+        break;
+      }
+      chunks.emplace_back(reinterpret_cast<char const*>(bytes.data),
+                          static_cast<std::size_t>(bytes.size));
+      parallel_serialized.append(chunks.back());
+    }
+    ASSERT_EQ(sequential_serialized, parallel_serialized);
+
+    // The chunks can be deserialized.
+    DiscreteTrajectory read_trajectory;
+    {
+      PushDeserializer push_deserializer(
+          chunk_size,
+          /*number_of_chunks=*/8,
+          std::make_unique<MultiCodecCompressor>(Codec::LZ4));
+      push_deserializer.Start(&read_trajectory, /*done=*/nullptr);
+      for (auto& chunk : chunks) {
+        push_deserializer.Push(
+            Array<std::uint8_t>(reinterpret_cast<std::uint8_t*>(&chunk[0]),
+                                chunk.size()),
+            /*done=*/nullptr);
+      }
+      push_deserializer.Push(Array<std::uint8_t>(), /*done=*/nullptr);
+    }
+    EXPECT_THAT(read_trajectory, EqualsProto(*trajectory));
+  }
+}
+
+TEST_F(PullSerializerTest, LeadingFields) {
+  DiscreteTrajectory trajectory = *BuildTrajectory();
+  trajectory.add_fork_position(3);
+  auto* const downsampling = trajectory.mutable_downsampling();
+  downsampling->set_max_dense_intervals(10);
+  downsampling->mutable_tolerance()->set_dimensions(1);
+  downsampling->mutable_tolerance()->set_magnitude(2);
+
+  pull_serializer_->Start(
+      &trajectory,
+      /*leading_fields=*/{DiscreteTrajectory::kDownsamplingFieldNumber,
+                          DiscreteTrajectory::kForkPositionFieldNumber});
+  std::string serialized;
+  for (;;) {
+    Array<std::uint8_t> const bytes = pull_serializer_->Pull();
+    if (bytes.size == 0) {
+      break;
+    }
+    serialized.append(reinterpret_cast<char const*>(bytes.data),
+                      static_cast<std::size_t>(bytes.size));
+  }
+
+  // The serialization has the same size but starts with the downsampling,
+  // followed by the fork position.
+  EXPECT_EQ(trajectory.ByteSizeLong(), serialized.size());
+  EXPECT_EQ((DiscreteTrajectory::kDownsamplingFieldNumber << 3) | 2,
+            serialized[0]);
+  DiscreteTrajectory read_trajectory;
+  EXPECT_TRUE(read_trajectory.ParseFromString(serialized));
+  EXPECT_THAT(read_trajectory, EqualsProto(trajectory));
+  EXPECT_NE(trajectory.SerializeAsString(), serialized);
+}
+
 TEST_F(PullSerializerTest, SerializationThreading) {
   DiscreteTrajectory read_trajectory;
   auto const trajectory = BuildTrajectory();
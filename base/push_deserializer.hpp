@@ -13,6 +13,7 @@
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
 #include "gipfeli/compression.h"
+#include "google/protobuf/arena.h"
 #include "google/protobuf/message.h"
 #include "google/protobuf/io/zero_copy_stream.h"
 
@@ -76,6 +77,23 @@ class PushDeserializer final {
   void Start(not_null<google::protobuf::Message*> message,
              std::function<void(google::protobuf::Message const&)> done);
 
+  // Starts the deserializer in streaming mode.  Instead of deserializing an
+  // entire message, the deserializer parses the top-level fields of a message
+  // of the type of |prototype| one at a time (one element at a time for
+  // repeated fields).  Each of them is parsed into a new message allocated on
+  // |arena|, which has only that field set and is passed to |on_field|.  If
+  // |on_field| returns true, none of the messages passed to it so far are used
+  // anymore and the |arena| is reset.  Thus, the memory used by the messages
+  // may be bounded by the size of the largest field, not by that of the entire
+  // message.  The |done| callback is called once deserialization has
+  // completed.  This method must be called at most once for each deserializer
+  // object, and not in addition to |Start|.
+  void StartStreaming(
+      not_null<google::protobuf::Message const*> prototype,
+      not_null<google::protobuf::Arena*> arena,
+      std::function<bool(google::protobuf::Message const&)> on_field,
+      std::function<void()> done);
+
   // Pushes in the internal queue chunks of data that will be extracted by
   // |Pull|.  Splits |bytes| into chunks of at most |chunk_size|.  May block to
   // stay within the maximum size of the queue.  The caller must push an object
@@ -94,6 +112,10 @@ class PushDeserializer final {
   // |DelegatingArrayOutputStream|.
   Array<std::uint8_t> Pull();
 
+  // Runs the callback of the last chunk of data, which is still pending when
+  // the parsing completes.
+  void RunLastChunkCallback();
+
   // |owned_message_| is null if this object doesn't own the message.
   // |message_| is non-null after Start.
   std::unique_ptr<google::protobuf::Message> owned_message_;
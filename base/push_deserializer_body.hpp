@@ -8,11 +8,16 @@
 #include "base/sink_source.hpp"
 #include "glog/logging.h"
 #include "google/protobuf/io/coded_stream_inl.h"
+#include "google/protobuf/wire_format.h"
+#include "google/protobuf/wire_format_lite.h"
 
 namespace principia {
 namespace base {
 namespace internal_push_deserializer {
 
+using google::protobuf::internal::WireFormat;
+using google::protobuf::internal::WireFormatLite;
+
 inline DelegatingArrayInputStream::DelegatingArrayInputStream(
     std::function<Array<std::uint8_t>()> on_empty)
     : on_empty_(std::move(on_empty)),
@@ -119,14 +124,7 @@ inline void PushDeserializer::Start(
     CHECK(message_->ParseFromCodedStream(&decoder));
     CHECK(decoder.ConsumedEntireMessage());
 
-    // Run any remainining chunk callback.
-    absl::MutexLock l(&lock_);
-    CHECK_EQ(1, done_.size());
-    auto const done_front = done_.front();
-    if (done_front != nullptr) {
-      done_front();
-    }
-    done_.pop();
+    RunLastChunkCallback();
 
     // Run the final callback.
     if (done != nullptr) {
@@ -135,6 +133,48 @@ inline void PushDeserializer::Start(
   });
 }
 
+inline void PushDeserializer::StartStreaming(
+    not_null<google::protobuf::Message const*> const prototype,
+    not_null<google::protobuf::Arena*> const arena,
+    std::function<bool(google::protobuf::Message const&)> on_field,
+    std::function<void()> done) {
+  CHECK(thread_ == nullptr);
+  thread_ = std::make_unique<std::thread>([this,
+                                           prototype,
+                                           arena,
+                                           on_field = std::move(on_field),
+                                           done = std::move(done)]() {
+    google::protobuf::io::CodedInputStream decoder(&stream_);
+    decoder.SetTotalBytesLimit(1 << 29, 1 << 29);
+    auto const* const descriptor = prototype->GetDescriptor();
+    for (;;) {
+      std::uint32_t const tag = decoder.ReadTag();
+      if (tag == 0) {
+        break;
+      }
+      // An unknown field yields a null |FieldDescriptor| and is parsed into
+      // the unknown fields of |field|.
+      not_null<google::protobuf::Message*> const field = prototype->New(arena);
+      CHECK(WireFormat::ParseAndMergeField(
+          tag,
+          descriptor->FindFieldByNumber(WireFormatLite::GetTagFieldNumber(tag)),
+          field,
+          &decoder));
+      if (on_field(*field)) {
+        arena->Reset();
+      }
+    }
+    CHECK(decoder.ConsumedEntireMessage());
+
+    RunLastChunkCallback();
+
+    // Run the final callback.
+    if (done != nullptr) {
+      done();
+    }
+  });
+}
+
 inline void PushDeserializer::Push(Array<std::uint8_t> const bytes,
                                    std::function<void()> done) {
   // Slice the incoming data in chunks of size at most |chunk_size|.  Release
@@ -217,6 +257,16 @@ inline Array<std::uint8_t> PushDeserializer::Pull() {
   return result;
 }
 
+inline void PushDeserializer::RunLastChunkCallback() {
+  absl::MutexLock l(&lock_);
+  CHECK_EQ(1, done_.size());
+  auto const done_front = done_.front();
+  if (done_front != nullptr) {
+    done_front();
+  }
+  done_.pop();
+}
+
 }  // namespace internal_push_deserializer
 }  // namespace base
 }  // namespace principia
@@ -307,6 +307,40 @@ TEST_F(PushDeserializerTest, SerializationDeserialization) {
       /*deserializer_compressor=*/google::compression::NewGipfeliCompressor());
 }
 
+TEST_F(PushDeserializerTest, Streaming) {
+  auto const written_trajectory = BuildTrajectory();
+  std::string serialized_trajectory = written_trajectory->SerializeAsString();
+  google::protobuf::Arena arena;
+
+  DiscreteTrajectory read_trajectory;
+  int fields = 0;
+  bool done = false;
+  push_deserializer_->StartStreaming(
+      &DiscreteTrajectory::default_instance(),
+      &arena,
+      [&fields, &read_trajectory](google::protobuf::Message const& field) {
+        auto const& trajectory_field =
+            static_cast<DiscreteTrajectory const&>(field);
+        // Each field is a single element of the timeline.
+        EXPECT_EQ(1, trajectory_field.timeline_size());
+        read_trajectory.MergeFrom(trajectory_field);
+        ++fields;
+        return true;
+      },
+      [&done]() { done = true; });
+  Array<std::uint8_t> const bytes(
+      reinterpret_cast<std::uint8_t*>(&serialized_trajectory[0]),
+      serialized_trajectory.size());
+  push_deserializer_->Push(bytes, /*done=*/nullptr);
+  push_deserializer_->Push(Array<std::uint8_t>(), /*done=*/nullptr);
+
+  // Destroying the deserializer waits until deserialization is done.
+  push_deserializer_.reset();
+  EXPECT_TRUE(done);
+  EXPECT_EQ(100, fields);
+  EXPECT_THAT(read_trajectory, EqualsProto(*written_trajectory));
+}
+
 // Check that deserialization fails if we stomp on one extra byte.
 TEST_F(PushDeserializerDeathTest, Stomp) {
   EXPECT_DEATH({
@@ -0,0 +1,72 @@
+
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=Bundle  // NOLINT(whitespace/line_length)
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+
+#include "base/bundle.hpp"
+#include "base/status.hpp"
+#include "base/thread_pool.hpp"
+#include "benchmark/benchmark.h"
+
+namespace principia {
+namespace base {
+
+namespace {
+
+double ConsumeCpu(std::int64_t const n) {
+  double result = 0;
+  for (int i = 0; i < n; ++i) {
+    result += std::sqrt(i);
+  }
+  return result;
+}
+
+}  // namespace
+
+// Executes 1000 short tasks in a bundle.  The first argument is the size of the
+// pool on which the bundle executes its tasks, or 0 to create a thread per
+// task.  The second argument is the number of iterations of each task.  The
+// pool is created outside of the measurement loop, as it would be shared by
+// many bundles in practice.
+void BM_Bundle(benchmark::State& state) {
+  std::int64_t const pool_size = state.range(0);
+  std::int64_t const task_size = state.range(1);
+  std::optional<ThreadPool<void>> pool;
+  if (pool_size > 0) {
+    pool.emplace(pool_size);
+  }
+  for (auto _ : state) {
+    std::optional<Bundle> bundle;
+    if (pool.has_value()) {
+      bundle.emplace(&*pool);
+    } else {
+      bundle.emplace();
+    }
+    for (int i = 0; i < 1000; ++i) {
+      bundle->Add([task_size]() {
+        double const result = ConsumeCpu(task_size);
+        benchmark::DoNotOptimize(result);
+        return Status::OK;
+      });
+    }
+    CHECK_OK(bundle->Join());
+  }
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+BENCHMARK(BM_Bundle)
+    ->ArgPair(0, 1e2)
+    ->ArgPair(1, 1e2)
+    ->ArgPair(4, 1e2)
+    ->ArgPair(8, 1e2)
+    ->ArgPair(0, 1e4)
+    ->ArgPair(1, 1e4)
+    ->ArgPair(4, 1e4)
+    ->ArgPair(8, 1e4)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,84 @@
+
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=10 --benchmark_min_time=2 --benchmark_filter=Cbrt  // NOLINT(whitespace/line_length)
+
+#include "numerics/cbrt.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+namespace principia {
+namespace numerics {
+
+namespace {
+
+// The signs of the values of the benchmarks.
+enum Signs {
+  Positive = 0,
+  // Negative values at the odd indices, i.e., in the high lanes of the pairs
+  // processed by the array function.
+  NegativeOdd = 1,
+  Random = 2,
+};
+
+std::vector<double> Values(int const size, std::int64_t const signs) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(1.0, 1e6);
+  std::bernoulli_distribution sign_distribution;
+  std::vector<double> values;
+  for (int i = 0; i < size; ++i) {
+    double const value = distribution(random);
+    bool const negative = signs == NegativeOdd ? i % 2 == 1
+                        : signs == Random      ? sign_distribution(random)
+                                               : false;
+    values.push_back(negative ? -value : value);
+  }
+  return values;
+}
+
+}  // namespace
+
+// The first argument selects the |Signs| of the values, the second is the
+// number of values per batch.  The scalar function applied to each element of
+// the batch, for comparison with the array function below.
+void BM_CbrtBatchScalar(benchmark::State& state) {
+  int const size = state.range(1);
+  std::vector<double> const y = Values(size, state.range(0));
+  std::vector<double> cbrt_y(size);
+
+  for (auto _ : state) {
+    for (int i = 0; i < size; ++i) {
+      cbrt_y[i] = Cbrt(y[i]);
+    }
+    benchmark::DoNotOptimize(cbrt_y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+void BM_CbrtBatch(benchmark::State& state) {
+  int const size = state.range(1);
+  std::vector<double> const y = Values(size, state.range(0));
+  std::vector<double> cbrt_y(size);
+
+  for (auto _ : state) {
+    Cbrt(y.data(), size, cbrt_y.data());
+    benchmark::DoNotOptimize(cbrt_y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(BM_CbrtBatchScalar)
+    ->ArgPair(Positive, 4096)
+    ->ArgPair(NegativeOdd, 4096)
+    ->ArgPair(Random, 4096);
+BENCHMARK(BM_CbrtBatch)
+    ->ArgPair(Positive, 4096)
+    ->ArgPair(NegativeOdd, 4096)
+    ->ArgPair(Random, 4096);
+
+}  // namespace numerics
+}  // namespace principia
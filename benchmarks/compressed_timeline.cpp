@@ -0,0 +1,122 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=CompressedTimeline  // NOLINT(whitespace/line_length)
+
+#include "physics/compressed_timeline.hpp"
+
+#include <map>
+
+#include "astronomy/epoch.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/named_quantities.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace physics {
+
+using astronomy::J2000;
+using geometry::Displacement;
+using geometry::Instant;
+using geometry::Velocity;
+using ksp_plugin::World;
+using quantities::AngularFrequency;
+using quantities::Cos;
+using quantities::Length;
+using quantities::Sin;
+using quantities::Speed;
+using quantities::Time;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Radian;
+using quantities::si::Second;
+
+namespace {
+
+constexpr std::int64_t number_of_points = 1'000'000;
+
+// A circular low orbit, sampled every 10 s by |FillTrajectory|, which is the
+// kind of history that remains after downsampling.
+DegreesOfFreedom<World> CircularOrbit(Time const& t) {
+  Length const r = 7000 * Kilo(Metre);
+  AngularFrequency const ω = 1e-3 * Radian / Second;
+  Speed const v = ω * r / Radian;
+  return DegreesOfFreedom<World>(
+      World::origin + Displacement<World>({r * Cos(ω * t),
+                                           r * Sin(ω * t),
+                                           0 * Metre}),
+      Velocity<World>({-v * Sin(ω * t),
+                       v * Cos(ω * t),
+                       0 * Metre / Second}));
+}
+
+void FillTrajectory(DiscreteTrajectory<World>& trajectory) {
+  for (std::int64_t i = 0; i < number_of_points; ++i) {
+    Time const t = i * 10 * Second;
+    trajectory.Append(J2000 + t, CircularOrbit(t));
+  }
+}
+
+}  // namespace
+
+void BM_CompressedTimelineAppend(benchmark::State& state) {
+  DiscreteTrajectory<World> trajectory;
+  FillTrajectory(trajectory);
+  std::int64_t encoded_bytes;
+  for (auto _ : state) {
+    CompressedTimeline<World> timeline;
+    for (auto const& [time, degrees_of_freedom] : trajectory.Points()) {
+      timeline.Append(time, degrees_of_freedom);
+    }
+    encoded_bytes = timeline.encoded_bytes();
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_points);
+  state.counters["bytes_per_point"] =
+      static_cast<double>(encoded_bytes) / number_of_points;
+}
+
+void BM_CompressedTimelineIterate(benchmark::State& state) {
+  DiscreteTrajectory<World> trajectory;
+  FillTrajectory(trajectory);
+  CompressedTimeline<World> timeline;
+  for (auto const& [time, degrees_of_freedom] : trajectory.Points()) {
+    timeline.Append(time, degrees_of_freedom);
+  }
+  for (auto _ : state) {
+    Time total;
+    for (auto const& [time, degrees_of_freedom] : timeline) {
+      total += time - J2000;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_points);
+  state.counters["bytes_per_point"] =
+      static_cast<double>(timeline.encoded_bytes()) / number_of_points;
+}
+
+// For comparison, the iteration over a |DiscreteTrajectory|.  The memory is
+// estimated as that of the nodes of a red-black tree.
+void BM_CompressedTimelineUncompressed(benchmark::State& state) {
+  DiscreteTrajectory<World> trajectory;
+  FillTrajectory(trajectory);
+  for (auto _ : state) {
+    Time total;
+    for (auto const& [time, degrees_of_freedom] : trajectory.Points()) {
+      total += time - J2000;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_points);
+  state.counters["bytes_per_point"] =
+      sizeof(std::map<Instant, DegreesOfFreedom<World>>::value_type) +
+      4 * sizeof(void*);
+}
+
+BENCHMARK(BM_CompressedTimelineAppend)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CompressedTimelineIterate)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CompressedTimelineUncompressed)->Unit(benchmark::kMillisecond);
+
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,115 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=ContinuousTrajectory  // NOLINT(whitespace/line_length)
+
+#include "physics/continuous_trajectory.hpp"
+
+#include <vector>
+
+#include "astronomy/epoch.hpp"
+#include "base/not_null.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/named_quantities.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace physics {
+
+using astronomy::J2000;
+using base::make_not_null_unique;
+using base::not_null;
+using geometry::Displacement;
+using geometry::Instant;
+using geometry::Velocity;
+using ksp_plugin::World;
+using quantities::AngularFrequency;
+using quantities::Cos;
+using quantities::Length;
+using quantities::Sin;
+using quantities::Speed;
+using quantities::Time;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Milli;
+using quantities::si::Radian;
+using quantities::si::Second;
+
+namespace {
+
+constexpr Time step = 10 * Second;
+
+// Returns a trajectory for a circular orbit with |number_of_steps| steps.
+not_null<std::unique_ptr<ContinuousTrajectory<World>>> CircularTrajectory(
+    int const number_of_steps) {
+  Length const r = 7000 * Kilo(Metre);
+  AngularFrequency const ω = 1e-3 * Radian / Second;
+  Speed const v = ω * r / Radian;
+  auto trajectory = make_not_null_unique<ContinuousTrajectory<World>>(
+      step, /*tolerance=*/1 * Milli(Metre));
+  for (int i = 0; i <= number_of_steps; ++i) {
+    Time const t = i * step;
+    CHECK_OK(trajectory->Append(
+        J2000 + t,
+        DegreesOfFreedom<World>(
+            World::origin + Displacement<World>({r * Cos(ω * t),
+                                                 r * Sin(ω * t),
+                                                 0 * Metre}),
+            Velocity<World>({-v * Sin(ω * t),
+                             v * Cos(ω * t),
+                             0 * Metre / Second}))));
+  }
+  return trajectory;
+}
+
+// Returns |samples_per_step| equally-spaced times in each step of
+// |trajectory|.
+std::vector<Instant> EvaluationTimes(
+    ContinuousTrajectory<World> const& trajectory,
+    int const samples_per_step) {
+  std::vector<Instant> times;
+  Time const Δt = step / samples_per_step;
+  for (Instant t = trajectory.t_min(); t <= trajectory.t_max(); t += Δt) {
+    times.push_back(t);
+  }
+  return times;
+}
+
+}  // namespace
+
+// The arguments are the number of steps of the trajectory and the number of
+// evaluations per step.
+void BM_ContinuousTrajectoryEvaluate(benchmark::State& state) {
+  auto const trajectory = CircularTrajectory(state.range(0));
+  auto const times = EvaluationTimes(*trajectory, state.range(1));
+  for (auto _ : state) {
+    for (Instant const& t : times) {
+      benchmark::DoNotOptimize(trajectory->EvaluateDegreesOfFreedom(t));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+void BM_ContinuousTrajectoryEvaluateBatch(benchmark::State& state) {
+  auto const trajectory = CircularTrajectory(state.range(0));
+  auto const times = EvaluationTimes(*trajectory, state.range(1));
+  std::vector<DegreesOfFreedom<World>> degrees_of_freedom;
+  for (auto _ : state) {
+    trajectory->EvaluateDegreesOfFreedom(times, degrees_of_freedom);
+    benchmark::DoNotOptimize(degrees_of_freedom.data());
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+BENCHMARK(BM_ContinuousTrajectoryEvaluate)
+    ->Args({1'000, 1})
+    ->Args({1'000, 10})
+    ->Args({10'000, 1});
+BENCHMARK(BM_ContinuousTrajectoryEvaluateBatch)
+    ->Args({1'000, 1})
+    ->Args({1'000, 10})
+    ->Args({10'000, 1});
+
+}  // namespace physics
+}  // namespace principia
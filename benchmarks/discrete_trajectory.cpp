@@ -0,0 +1,243 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=DiscreteTrajectory  // NOLINT(whitespace/line_length)
+
+#include "physics/discrete_trajectory.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "astronomy/epoch.hpp"
+#include "base/not_null.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/frame.hpp"
+#include "geometry/named_quantities.hpp"
+#include "glog/logging.h"
+#include "ksp_plugin/frames.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+#include "serialization/physics.pb.h"
+
+namespace principia {
+namespace physics {
+
+using astronomy::J2000;
+using base::make_not_null_unique;
+using base::not_null;
+using geometry::Displacement;
+using geometry::Instant;
+using geometry::Velocity;
+using ksp_plugin::World;
+using quantities::AngularFrequency;
+using quantities::Cos;
+using quantities::Length;
+using quantities::Sin;
+using quantities::Speed;
+using quantities::Time;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Radian;
+using quantities::si::Second;
+
+namespace {
+
+// Returns a root trajectory with a chain of |depth| nested forks, each fork
+// (and the root) having |points_per_fork| points.  The most deeply nested fork
+// is returned through |leaf|.
+not_null<std::unique_ptr<DiscreteTrajectory<World>>> ForkedTrajectory(
+    int const depth,
+    int const points_per_fork,
+    DiscreteTrajectory<World>*& leaf) {
+  auto root = make_not_null_unique<DiscreteTrajectory<World>>();
+  DiscreteTrajectory<World>* trajectory = root.get();
+  Instant t = J2000;
+  for (int i = 0; i <= depth; ++i) {
+    if (i > 0) {
+      trajectory = trajectory->NewForkAtLast();
+    }
+    for (int j = 0; j < points_per_fork; ++j) {
+      t += 1 * Second;
+      trajectory->Append(
+          t,
+          DegreesOfFreedom<World>(
+              World::origin +
+                  Displacement<World>({(t - J2000) / Second * Metre,
+                                       0 * Metre,
+                                       0 * Metre}),
+              Velocity<World>()));
+    }
+  }
+  leaf = trajectory;
+  return root;
+}
+
+// Returns |samples_per_point| equally-spaced times in each interval between
+// consecutive points of |trajectory|.
+std::vector<Instant> EvaluationTimes(DiscreteTrajectory<World> const& trajectory,
+                                     int const samples_per_point) {
+  std::vector<Instant> times;
+  Time const Δt = 1 * Second / samples_per_point;
+  for (Instant t = trajectory.t_min(); t < trajectory.t_max(); t += Δt) {
+    times.push_back(t);
+  }
+  return times;
+}
+
+// Returns a trajectory on a circular orbit with |points| points.
+not_null<std::unique_ptr<DiscreteTrajectory<World>>> CircularTrajectory(
+    int const points) {
+  Length const r = 7000 * Kilo(Metre);
+  AngularFrequency const ω = 1e-3 * Radian / Second;
+  Speed const v = ω * r / Radian;
+  auto trajectory = make_not_null_unique<DiscreteTrajectory<World>>();
+  for (int i = 0; i < points; ++i) {
+    Time const t = i * 10 * Second;
+    trajectory->Append(
+        J2000 + t,
+        DegreesOfFreedom<World>(
+            World::origin + Displacement<World>({r * Cos(ω * t),
+                                                 r * Sin(ω * t),
+                                                 0 * Metre}),
+            Velocity<World>({-v * Sin(ω * t),
+                             v * Cos(ω * t),
+                             0 * Metre / Second})));
+  }
+  return trajectory;
+}
+
+// Writes the root |trajectory| to a string, with a packed timeline if |packed|
+// is true, otherwise as a pre-Frobenius sequence of messages.
+std::string SerializeTrajectory(DiscreteTrajectory<World> const& trajectory,
+                                bool const packed) {
+  serialization::DiscreteTrajectory message;
+  if (packed) {
+    trajectory.WriteToMessage(&message, /*forks=*/{});
+  } else {
+    for (auto const& [time, degrees_of_freedom] : trajectory) {
+      auto* const instantaneous_degrees_of_freedom = message.add_timeline();
+      time.WriteToMessage(instantaneous_degrees_of_freedom->mutable_instant());
+      degrees_of_freedom.WriteToMessage(
+          instantaneous_degrees_of_freedom->mutable_degrees_of_freedom());
+    }
+  }
+  return message.SerializeAsString();
+}
+
+}  // namespace
+
+// The arguments are the depth of the fork chain and the number of points per
+// fork.
+void BM_DiscreteTrajectoryIterator(benchmark::State& state) {
+  DiscreteTrajectory<World>* leaf;
+  auto const root = ForkedTrajectory(state.range(0), state.range(1), leaf);
+  for (auto _ : state) {
+    Time total;
+    for (auto it = leaf->begin(); it != leaf->end(); ++it) {
+      total += it->time - J2000;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * (state.range(0) + 1) *
+                          state.range(1));
+}
+
+void BM_DiscreteTrajectoryPoints(benchmark::State& state) {
+  DiscreteTrajectory<World>* leaf;
+  auto const root = ForkedTrajectory(state.range(0), state.range(1), leaf);
+  for (auto _ : state) {
+    Time total;
+    for (auto const& [time, degrees_of_freedom] : leaf->Points()) {
+      total += time - J2000;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * (state.range(0) + 1) *
+                          state.range(1));
+}
+
+void BM_DiscreteTrajectoryEvaluate(benchmark::State& state) {
+  DiscreteTrajectory<World>* leaf;
+  auto const root = ForkedTrajectory(state.range(0), state.range(1), leaf);
+  auto const times = EvaluationTimes(*leaf, /*samples_per_point=*/4);
+  for (auto _ : state) {
+    for (Instant const& t : times) {
+      benchmark::DoNotOptimize(leaf->EvaluateDegreesOfFreedom(t));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+void BM_DiscreteTrajectoryEvaluateBatch(benchmark::State& state) {
+  DiscreteTrajectory<World>* leaf;
+  auto const root = ForkedTrajectory(state.range(0), state.range(1), leaf);
+  auto const times = EvaluationTimes(*leaf, /*samples_per_point=*/4);
+  std::vector<DegreesOfFreedom<World>> degrees_of_freedom;
+  for (auto _ : state) {
+    leaf->EvaluateDegreesOfFreedom(times, degrees_of_freedom);
+    benchmark::DoNotOptimize(degrees_of_freedom.data());
+  }
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+// The arguments are whether the timeline is packed and the number of points.
+void BM_DiscreteTrajectorySerialization(benchmark::State& state) {
+  bool const packed = state.range(0);
+  auto const trajectory = CircularTrajectory(state.range(1));
+  std::int64_t size = 0;
+  for (auto _ : state) {
+    size = SerializeTrajectory(*trajectory, packed).size();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+  state.SetBytesProcessed(state.iterations() * size);
+  state.counters["bytes_per_point"] =
+      static_cast<double>(size) / state.range(1);
+  state.SetLabel(packed ? "packed" : "pre-Frobenius");
+}
+
+void BM_DiscreteTrajectoryDeserialization(benchmark::State& state) {
+  bool const packed = state.range(0);
+  std::string const bytes =
+      SerializeTrajectory(*CircularTrajectory(state.range(1)), packed);
+  for (auto _ : state) {
+    serialization::DiscreteTrajectory message;
+    CHECK(message.ParseFromString(bytes));
+    auto const trajectory =
+        DiscreteTrajectory<World>::ReadFromMessage(message, /*forks=*/{});
+    benchmark::DoNotOptimize(trajectory.get());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+  state.counters["bytes_per_point"] =
+      static_cast<double>(bytes.size()) / state.range(1);
+  state.SetLabel(packed ? "packed" : "pre-Frobenius");
+}
+
+BENCHMARK(BM_DiscreteTrajectoryIterator)
+    ->Args({0, 100'000})
+    ->Args({10, 10'000})
+    ->Args({100, 1'000});
+BENCHMARK(BM_DiscreteTrajectoryPoints)
+    ->Args({0, 100'000})
+    ->Args({10, 10'000})
+    ->Args({100, 1'000});
+BENCHMARK(BM_DiscreteTrajectoryEvaluate)
+    ->Args({0, 10'000})
+    ->Args({10, 1'000})
+    ->Args({100, 100});
+BENCHMARK(BM_DiscreteTrajectoryEvaluateBatch)
+    ->Args({0, 10'000})
+    ->Args({10, 1'000})
+    ->Args({100, 100});
+BENCHMARK(BM_DiscreteTrajectorySerialization)
+    ->Args({false, 100'000})
+    ->Args({true, 100'000})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DiscreteTrajectoryDeserialization)
+    ->Args({false, 100'000})
+    ->Args({true, 100'000})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace physics
+}  // namespace principia
@@ -68,8 +68,58 @@ void BM_JacobiSNCNDN(benchmark::State& state) {
   }
 }
 
+void BM_JacobiAmplitudeBatch(benchmark::State& state) {
+  constexpr int size = 100;
+
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution_u(-10.0, 10.0);
+  std::uniform_real_distribution<> distribution_mc(0.0, 1.0);
+  std::vector<Angle> us;
+  std::vector<double> mcs;
+  for (int i = 0; i < size; ++i) {
+    us.push_back(distribution_u(random) * Radian);
+    mcs.push_back(distribution_mc(random));
+  }
+
+  std::vector<Angle> a;
+  while (state.KeepRunningBatch(size * size)) {
+    for (double const mc : mcs) {
+      JacobiAmplitude(us, mc, a);
+    }
+    benchmark::DoNotOptimize(a.data());
+  }
+}
+
+void BM_JacobiSNCNDNBatch(benchmark::State& state) {
+  constexpr int size = 100;
+
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution_u(-10.0, 10.0);
+  std::uniform_real_distribution<> distribution_mc(0.0, 1.0);
+  std::vector<Angle> us;
+  std::vector<double> mcs;
+  for (int i = 0; i < size; ++i) {
+    us.push_back(distribution_u(random) * Radian);
+    mcs.push_back(distribution_mc(random));
+  }
+
+  std::vector<double> s;
+  std::vector<double> c;
+  std::vector<double> d;
+  while (state.KeepRunningBatch(size * size)) {
+    for (double const mc : mcs) {
+      JacobiSNCNDN(us, mc, s, c, d);
+    }
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(c.data());
+    benchmark::DoNotOptimize(d.data());
+  }
+}
+
 BENCHMARK(BM_JacobiAmplitude);
 BENCHMARK(BM_JacobiSNCNDN);
+BENCHMARK(BM_JacobiAmplitudeBatch);
+BENCHMARK(BM_JacobiSNCNDNBatch);
 
 }  // namespace numerics
 }  // namespace principia
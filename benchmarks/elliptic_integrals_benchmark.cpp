@@ -84,8 +84,79 @@ void BM_FukushimaEllipticBDJ(benchmark::State& state) {
   }
 }
 
+// The argument is the upper bound of the amplitudes, in units of π / 2.  Beyond
+// 1 the complete integrals are needed.  For comparison with the batched
+// function, the scalar function is called for amplitudes sharing n and mc.
+void BM_EllipticFEΠSameParameters(benchmark::State& state) {
+  constexpr int size = 20;
+
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution_φ(0.0,
+                                                  state.range(0) * π / 2);
+  std::uniform_real_distribution<> distribution_n(0.0, 1.0);
+  std::uniform_real_distribution<> distribution_mc(0.0, 1.0);
+  std::vector<Angle> φs;
+  std::vector<double> ns;
+  std::vector<double> mcs;
+  for (int i = 0; i < size; ++i) {
+    φs.push_back(distribution_φ(random) * Radian);
+    ns.push_back(distribution_n(random));
+    mcs.push_back(distribution_mc(random));
+  }
+
+  while (state.KeepRunningBatch(size * size * size)) {
+    Angle e{uninitialized};
+    Angle f{uninitialized};
+    Angle ᴨ{uninitialized};
+    for (double const n : ns) {
+      for (double const mc : mcs) {
+        for (Angle const φ : φs) {
+          EllipticFEΠ(φ, n, mc, f, e, ᴨ);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(e);
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(ᴨ);
+  }
+}
+
+void BM_EllipticFEΠBatch(benchmark::State& state) {
+  constexpr int size = 20;
+
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution_φ(0.0,
+                                                  state.range(0) * π / 2);
+  std::uniform_real_distribution<> distribution_n(0.0, 1.0);
+  std::uniform_real_distribution<> distribution_mc(0.0, 1.0);
+  std::vector<Angle> φs;
+  std::vector<double> ns;
+  std::vector<double> mcs;
+  for (int i = 0; i < size; ++i) {
+    φs.push_back(distribution_φ(random) * Radian);
+    ns.push_back(distribution_n(random));
+    mcs.push_back(distribution_mc(random));
+  }
+
+  std::vector<Angle> e;
+  std::vector<Angle> f;
+  std::vector<Angle> ᴨ;
+  while (state.KeepRunningBatch(size * size * size)) {
+    for (double const n : ns) {
+      for (double const mc : mcs) {
+        EllipticFEΠ(φs, n, mc, f, e, ᴨ);
+      }
+    }
+    benchmark::DoNotOptimize(e.data());
+    benchmark::DoNotOptimize(f.data());
+    benchmark::DoNotOptimize(ᴨ.data());
+  }
+}
+
 BENCHMARK(BM_EllipticFEΠ);
 BENCHMARK(BM_FukushimaEllipticBDJ);
+BENCHMARK(BM_EllipticFEΠSameParameters)->Arg(1)->Arg(10);
+BENCHMARK(BM_EllipticFEΠBatch)->Arg(1)->Arg(10);
 
 }  // namespace numerics
 }  // namespace principia
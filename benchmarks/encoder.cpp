@@ -1,5 +1,5 @@
 
-// .\Release\x64\benchmarks.exe --benchmark_min_time=2 --benchmark_repetitions=10 --benchmark_filter=Base32768  // NOLINT(whitespace/line_length)
+// .\Release\x64\benchmarks.exe --benchmark_min_time=2 --benchmark_repetitions=10 --benchmark_filter=(En|De)code  // NOLINT(whitespace/line_length)
 
 #include "base/encoder.hpp"
 
@@ -11,96 +11,80 @@
 #include "base/hexadecimal.hpp"
 #include "benchmark/benchmark.h"
 
-// Clang doesn't have a correct |std::array| yet, and we don't actually use this
-// code, so let's get rid of the entire body.
-#if PRINCIPIA_COMPILER_MSVC
-
 namespace principia {
 namespace base {
 
-template<typename Encoder>
-void BM_Encode(benchmark::State& state) {
-  constexpr int preallocated_size = 1 << 20;
-  constexpr int min_input_size = 20'000;
-  constexpr int max_input_size = 50'000;
+namespace {
 
-  Encoder encoder;
-  std::mt19937_64 random(42);
-  std::uniform_int_distribution<int> bytes_distribution(0, 256);
+// The argument of the benchmarks is the size of the binary data, from 1 KiB to
+// 64 MiB.  The throughput is reported in bytes of binary data per second.
+constexpr std::int64_t min_binary_size = 1 << 10;
+constexpr std::int64_t max_binary_size = 1 << 26;
 
-  UniqueArray<std::uint8_t> preallocated_binary(preallocated_size);
-  for (int i = 0; i < preallocated_binary.size; ++i) {
-    preallocated_binary.data[i] = bytes_distribution(random);
+UniqueArray<std::uint8_t> RandomBinary(std::int64_t const size) {
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<int> bytes_distribution(0, 255);
+  UniqueArray<std::uint8_t> binary(size);
+  for (int i = 0; i < binary.size; ++i) {
+    binary.data[i] = bytes_distribution(random);
   }
+  return binary;
+}
+
+}  // namespace
 
-  std::uniform_int_distribution<std::uint64_t> start_distribution(
-      0, preallocated_binary.size - max_input_size);
-  std::uniform_int_distribution<std::uint64_t> size_distribution(
-      min_input_size, max_input_size);
+template<typename Encoder>
+void BM_Encode(benchmark::State& state) {
+  Encoder encoder;
+  UniqueArray<std::uint8_t> const binary = RandomBinary(state.range(0));
+  UniqueArray<typename Encoder::Char> encoded(
+      encoder.EncodedLength(binary.get()));
 
-  std::int64_t bytes_processed = 0;
   for (auto _ : state) {
-    state.PauseTiming();
-    auto const start = start_distribution(random);
-    auto const size = size_distribution(random);
-    Array<std::uint8_t> binary(&preallocated_binary.data[start], size);
-    bytes_processed += binary.size;
-    state.ResumeTiming();
-
-    UniqueArray<typename Encoder::Char> const encoded = encoder.Encode(binary);
-    benchmark::DoNotOptimize(encoded);
+    encoder.Encode(binary.get(), encoded.get());
+    benchmark::DoNotOptimize(encoded.data.get());
+    benchmark::ClobberMemory();
   }
-  state.SetBytesProcessed(bytes_processed);
+  state.SetBytesProcessed(state.iterations() * binary.size);
 }
 
 template<typename Encoder>
 void BM_Decode(benchmark::State& state) {
-  constexpr int preallocated_size = 1 << 20;
-  constexpr int min_input_size = 10'000;
-  constexpr int max_input_size = 25'000;
-
   Encoder encoder;
-  std::mt19937_64 random(42);
-  std::uniform_int_distribution<int> bytes_distribution(0, 256);
-
-  // We need correct input data for the decoder.  Create it by enconding a large
-  // chunk of data.
-  UniqueArray<std::uint8_t> preallocated_binary(preallocated_size);
-  for (int i = 0; i < preallocated_binary.size; ++i) {
-    preallocated_binary.data[i] = bytes_distribution(random);
-  }
-  UniqueArray<typename Encoder::Char> const preallocated_encoded =
-      encoder.Encode(preallocated_binary.get());
+  // We need correct input data for the decoder.  Create it by encoding random
+  // data.
+  UniqueArray<std::uint8_t> binary = RandomBinary(state.range(0));
+  UniqueArray<typename Encoder::Char> const encoded =
+      encoder.Encode(binary.get());
 
-  std::uniform_int_distribution<std::uint64_t> start_distribution(
-      0, preallocated_encoded.size - max_input_size);
-  std::uniform_int_distribution<std::uint64_t> size_distribution(
-      min_input_size, max_input_size);
-
-  std::int64_t bytes_processed = 0;
   for (auto _ : state) {
-    state.PauseTiming();
-    auto const start = start_distribution(random);
-    auto const size = size_distribution(random);
-    Array<typename Encoder::Char> const encoded(
-        &preallocated_encoded.data[start], size);
-    state.ResumeTiming();
-
-    UniqueArray<std::uint8_t> const binary = encoder.Decode(encoded);
-    bytes_processed += binary.size;
-    benchmark::DoNotOptimize(binary);
+    encoder.Decode(encoded.get(), binary.get());
+    benchmark::DoNotOptimize(binary.data.get());
+    benchmark::ClobberMemory();
   }
-  state.SetBytesProcessed(bytes_processed);
+  state.SetBytesProcessed(state.iterations() * binary.size);
 }
 
 using Encoder16 = HexadecimalEncoder</*null_terminated=*/false>;
 using Encoder64 = Base64Encoder</*null_terminated=*/false>;
 using Encoder32768 = Base32768Encoder</*null_terminated=*/false>;
 
-BENCHMARK_TEMPLATE(BM_Encode, Encoder16);
-BENCHMARK_TEMPLATE(BM_Decode, Encoder16);
-BENCHMARK_TEMPLATE(BM_Encode, Encoder64);
-BENCHMARK_TEMPLATE(BM_Decode, Encoder64);
+BENCHMARK_TEMPLATE(BM_Encode, Encoder16)
+    ->RangeMultiplier(8)
+    ->Range(min_binary_size, max_binary_size);
+BENCHMARK_TEMPLATE(BM_Decode, Encoder16)
+    ->RangeMultiplier(8)
+    ->Range(min_binary_size, max_binary_size);
+BENCHMARK_TEMPLATE(BM_Encode, Encoder64)
+    ->RangeMultiplier(8)
+    ->Range(min_binary_size, max_binary_size);
+BENCHMARK_TEMPLATE(BM_Decode, Encoder64)
+    ->RangeMultiplier(8)
+    ->Range(min_binary_size, max_binary_size);
+// Clang doesn't have a correct |std::array| yet, and we don't actually use this
+// code, so let's get rid of the entire body.
+#if PRINCIPIA_COMPILER_MSVC
+
 #if !PRINCIPIA_COMPILER_MSVC || \
     !(_MSC_FULL_VER == 191'526'608 || \
       _MSC_FULL_VER == 191'526'731 || \
@@ -108,11 +92,15 @@ BENCHMARK_TEMPLATE(BM_Decode, Encoder64);
       _MSC_FULL_VER == 191'627'025 || \
       _MSC_FULL_VER == 191'627'027 || \
       _MSC_FULL_VER == 192'027'508)
-BENCHMARK_TEMPLATE(BM_Encode, Encoder32768);
-BENCHMARK_TEMPLATE(BM_Decode, Encoder32768);
+BENCHMARK_TEMPLATE(BM_Encode, Encoder32768)
+    ->RangeMultiplier(8)
+    ->Range(min_binary_size, max_binary_size);
+BENCHMARK_TEMPLATE(BM_Decode, Encoder32768)
+    ->RangeMultiplier(8)
+    ->Range(min_binary_size, max_binary_size);
+#endif
+
 #endif
 
 }  // namespace base
 }  // namespace principia
-
-#endif
@@ -0,0 +1,155 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=EnsemblePropagator  // NOLINT(whitespace/line_length)
+
+#include "physics/ensemble_propagator.hpp"
+
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "integrators/embedded_explicit_runge_kutta_nyström_integrator.hpp"
+#include "integrators/methods.hpp"
+#include "integrators/symmetric_linear_multistep_integrator.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace physics {
+
+using base::not_null;
+using geometry::Displacement;
+using geometry::Instant;
+using geometry::Position;
+using geometry::Velocity;
+using integrators::EmbeddedExplicitRungeKuttaNyströmIntegrator;
+using integrators::SymmetricLinearMultistepIntegrator;
+using integrators::methods::DormandالمكاوىPrince1986RKN434FM;
+using integrators::methods::QuinlanTremaine1990Order12;
+using ksp_plugin::Barycentric;
+using quantities::GravitationalParameter;
+using quantities::Length;
+using quantities::Pow;
+using quantities::Speed;
+using quantities::Sqrt;
+using quantities::si::Hour;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Milli;
+using quantities::si::Minute;
+using quantities::si::Second;
+
+namespace {
+
+constexpr int number_of_members = 1000;
+
+GravitationalParameter const μ = 398600.4418 * Pow<3>(Kilo(Metre)) /
+                                 Pow<2>(Second);
+
+not_null<std::unique_ptr<Ephemeris<Barycentric>>> MakeEphemeris() {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  bodies.emplace_back(std::make_unique<MassiveBody const>(μ));
+  return std::make_unique<Ephemeris<Barycentric>>(
+      std::move(bodies),
+      std::vector<DegreesOfFreedom<Barycentric>>{
+          {Barycentric::origin, Velocity<Barycentric>()}},
+      Instant(),
+      Ephemeris<Barycentric>::AccuracyParameters(
+          /*fitting_tolerance=*/1 * Milli(Metre),
+          /*geopotential_tolerance=*/0x1p-24),
+      Ephemeris<Barycentric>::FixedStepParameters(
+          SymmetricLinearMultistepIntegrator<QuinlanTremaine1990Order12,
+                                             Position<Barycentric>>(),
+          10 * Minute));
+}
+
+// A low orbit, with velocities dispersed by about 1 m/s.
+std::vector<DegreesOfFreedom<Barycentric>> DispersedInitialStates() {
+  Length const r = 7000 * Kilo(Metre);
+  Speed const v = 0.95 * Sqrt(μ / r);
+  std::mt19937_64 random(42);
+  std::normal_distribution<> distribution;
+  std::vector<DegreesOfFreedom<Barycentric>> initial_states;
+  for (int i = 0; i < number_of_members; ++i) {
+    initial_states.emplace_back(
+        Barycentric::origin +
+            Displacement<Barycentric>({r, 0 * Metre, 0 * Metre}),
+        Velocity<Barycentric>({distribution(random) * Metre / Second,
+                               v + distribution(random) * Metre / Second,
+                               distribution(random) * Metre / Second}));
+  }
+  return initial_states;
+}
+
+Ephemeris<Barycentric>::AdaptiveStepParameters const& Parameters() {
+  static Ephemeris<Barycentric>::AdaptiveStepParameters const parameters(
+      EmbeddedExplicitRungeKuttaNyströmIntegrator<
+          DormandالمكاوىPrince1986RKN434FM,
+          Position<Barycentric>>(),
+      std::numeric_limits<std::int64_t>::max(),
+      1 * Milli(Metre),
+      1 * Milli(Metre) / Second);
+  return parameters;
+}
+
+}  // namespace
+
+// For comparison, one |FlowWithAdaptiveStep| per member.
+void BM_EnsemblePropagatorSequentialFlows(benchmark::State& state) {
+  auto const ephemeris = MakeEphemeris();
+  auto const initial_states = DispersedInitialStates();
+  Instant const t = Instant() + 3 * Hour;
+  for (auto _ : state) {
+    for (auto const& initial_state : initial_states) {
+      DiscreteTrajectory<Barycentric> trajectory;
+      trajectory.Append(Instant(), initial_state);
+      CHECK_OK(ephemeris->FlowWithAdaptiveStep(
+          &trajectory,
+          Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+          t,
+          Parameters(),
+          Ephemeris<Barycentric>::unlimited_max_ephemeris_steps));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_members);
+}
+
+// The argument is the number of members per system.
+void BM_EnsemblePropagator(benchmark::State& state) {
+  auto const ephemeris = MakeEphemeris();
+  auto const initial_states = DispersedInitialStates();
+  Instant const t = Instant() + 3 * Hour;
+  EnsemblePropagator<Barycentric> const propagator(
+      ephemeris.get(),
+      Parameters(),
+      /*members_per_system=*/state.range(0),
+      /*number_of_threads=*/std::thread::hardware_concurrency());
+  std::vector<not_null<MassiveBody const*>> const targets =
+      ephemeris->bodies();
+  for (auto _ : state) {
+    auto const statistics =
+        propagator.Propagate(Instant(),
+                             initial_states,
+                             Ephemeris<Barycentric>::NoIntrinsicAccelerations,
+                             t,
+                             targets);
+    CHECK_OK(statistics.status());
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_members);
+}
+
+BENCHMARK(BM_EnsemblePropagatorSequentialFlows)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EnsemblePropagator)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace physics
+}  // namespace principia
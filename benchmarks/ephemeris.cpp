@@ -1,7 +1,9 @@
 ﻿
 // .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=Ephemeris                                                                     // NOLINT(whitespace/line_length)
 
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <list>
 #include <memory>
@@ -22,6 +24,9 @@
 #include "integrators/symmetric_linear_multistep_integrator.hpp"
 #include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "numerics/polynomial.hpp"
+#include "numerics/polynomial_evaluators.hpp"
+#include "physics/continuous_trajectory.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
@@ -32,6 +37,7 @@
 #include "quantities/numbers.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
+#include "serialization/physics.pb.h"
 #include "testing_utilities/solar_system_factory.hpp"
 
 namespace principia {
@@ -59,6 +65,8 @@ using integrators::methods::McLachlanAtela1992Order5Optimal;
 using integrators::methods::Quinlan1999Order8A;
 using integrators::methods::QuinlanTremaine1990Order12;
 using ksp_plugin::Barycentric;
+using numerics::EstrinEvaluator;
+using numerics::Polynomial;
 using quantities::DebugString;
 using quantities::Frequency;
 using quantities::Length;
@@ -179,6 +187,170 @@ void BM_EphemerisSolarSystem(benchmark::State& state) {
   state.SetLabel(quantities::DebugString(error / AstronomicalUnit) + " ua");
 }
 
+// Reads an ephemeris of the solar system covering |state.range(0)| years and
+// reintegrates it from its checkpoint, as is done when loading a save.  The
+// time spent in each stage is reported in the counters.
+void BM_EphemerisDeserialization(benchmark::State& state) {
+  auto const at_спутник_1_launch = SolarSystemAtСпутник1Launch(
+      SolarSystemFactory::Accuracy::MajorBodiesOnly);
+  Instant const final_time =
+      at_спутник_1_launch->epoch() + state.range(0) * JulianYear;
+  serialization::Ephemeris message;
+  {
+    auto const ephemeris = at_спутник_1_launch->MakeEphemeris(
+        SolarSystemFactory::MakeAccuracyParameters<Barycentric>(
+            FittingTolerance(-3),
+            SolarSystemFactory::Accuracy::MajorBodiesOnly),
+        EphemerisParameters());
+    ephemeris->Prolong(final_time);
+    ephemeris->WriteToMessage(&message);
+  }
+
+  double deserialization = 0;
+  double reintegration = 0;
+  for (auto _ : state) {
+    auto const start = std::chrono::steady_clock::now();
+    auto const ephemeris = Ephemeris<Barycentric>::ReadFromMessage(message);
+    auto const deserialized = std::chrono::steady_clock::now();
+    ephemeris->Prolong(final_time);
+    auto const reintegrated = std::chrono::steady_clock::now();
+    deserialization +=
+        std::chrono::duration<double>(deserialized - start).count();
+    reintegration +=
+        std::chrono::duration<double>(reintegrated - deserialized).count();
+  }
+  state.counters["deserialization_s"] =
+      benchmark::Counter(deserialization, benchmark::Counter::kAvgIterations);
+  state.counters["reintegration_s"] =
+      benchmark::Counter(reintegration, benchmark::Counter::kAvgIterations);
+  state.SetLabel(std::to_string(message.ByteSizeLong()) + " bytes");
+}
+
+// Returns the serializations of the trajectories of the bodies of the solar
+// system over |years|.  The trajectories are fitted to an ephemeris and
+// checkpointed at their end, so that all their polynomials are serialized.  A
+// century of polynomials would not fit in a single message.
+std::vector<std::string> SerializedTrajectories(int const years) {
+  auto const at_спутник_1_launch = SolarSystemAtСпутник1Launch(
+      SolarSystemFactory::Accuracy::MajorBodiesOnly);
+  auto const ephemeris = at_спутник_1_launch->MakeEphemeris(
+      SolarSystemFactory::MakeAccuracyParameters<Barycentric>(
+          FittingTolerance(-3),
+          SolarSystemFactory::Accuracy::MajorBodiesOnly),
+      EphemerisParameters());
+  Time const step = EphemerisParameters().step();
+  std::vector<not_null<std::unique_ptr<ContinuousTrajectory<Barycentric>>>>
+      trajectories;
+  for (int i = 0; i < ephemeris->bodies().size(); ++i) {
+    trajectories.push_back(
+        make_not_null_unique<ContinuousTrajectory<Barycentric>>(
+            step, FittingTolerance(-3)));
+  }
+
+  // Prolong the ephemeris one year at a time to bound its size.
+  Instant t = at_спутник_1_launch->epoch();
+  for (int year = 1; year <= years; ++year) {
+    Instant const t_final = at_спутник_1_launch->epoch() + year * JulianYear;
+    ephemeris->Prolong(t_final);
+    for (; t <= t_final; t += step) {
+      for (int i = 0; i < trajectories.size(); ++i) {
+        CHECK_OK(trajectories[i]->Append(
+            t,
+            ephemeris->trajectory(ephemeris->bodies()[i])
+                ->EvaluateDegreesOfFreedom(t)));
+      }
+    }
+    ephemeris->EventuallyForgetBefore(t - step);
+  }
+
+  std::vector<std::string> serialized_trajectories;
+  for (auto const& trajectory : trajectories) {
+    trajectory->checkpointer().CreateUnconditionally(trajectory->t_max());
+    serialization::ContinuousTrajectory message;
+    trajectory->WriteToMessage(&message);
+    serialized_trajectories.push_back(message.SerializeAsString());
+  }
+  return serialized_trajectories;
+}
+
+// Rewrites the polynomials of |message| in the format used before Frobenius,
+// where each one is a separate message along with its |t_max|.
+void ConvertToPreFrobenius(
+    not_null<serialization::ContinuousTrajectory*> const message) {
+  int block_index = 0;
+  for (int i = 0; i < message->polynomial_t_max_size(); ++i) {
+    auto const polynomial = Polynomial<Displacement<Barycentric>, Instant>::
+        ReadFromMessage<EstrinEvaluator>(
+            message->polynomials(), i, block_index);
+    auto* const pair = message->add_instant_polynomial_pair();
+    (Instant() + message->polynomial_t_max(i) * Second).WriteToMessage(
+        pair->mutable_t_max());
+    polynomial->WriteToMessage(pair->mutable_polynomial());
+  }
+  message->clear_polynomial_t_max();
+  message->clear_polynomials();
+}
+
+// Serializes the trajectories of the solar system covering |state.range(0)|
+// years.  Their size in the pre-Frobenius format is reported in the counters.
+void BM_EphemerisPolynomialSerialization(benchmark::State& state) {
+  std::vector<not_null<std::unique_ptr<ContinuousTrajectory<Barycentric>>>>
+      trajectories;
+  std::int64_t pre_frobenius_size = 0;
+  for (auto const& bytes : SerializedTrajectories(state.range(0))) {
+    serialization::ContinuousTrajectory message;
+    message.ParseFromString(bytes);
+    trajectories.push_back(
+        ContinuousTrajectory<Barycentric>::ReadFromMessage(message));
+    ConvertToPreFrobenius(&message);
+    pre_frobenius_size += message.ByteSizeLong();
+  }
+
+  std::int64_t size = 0;
+  for (auto _ : state) {
+    size = 0;
+    for (auto const& trajectory : trajectories) {
+      serialization::ContinuousTrajectory message;
+      trajectory->WriteToMessage(&message);
+      size += message.SerializeAsString().size();
+    }
+  }
+  state.counters["pre_frobenius_bytes"] = pre_frobenius_size;
+  state.SetBytesProcessed(state.iterations() * size);
+  state.SetLabel(std::to_string(size) + " bytes");
+}
+
+// Reads the trajectories of the solar system covering |state.range(0)| years,
+// serialized in the current format if |state.range(1)| is 0 and in the
+// pre-Frobenius format otherwise.
+void BM_EphemerisPolynomialDeserialization(benchmark::State& state) {
+  std::vector<std::string> serialized_trajectories =
+      SerializedTrajectories(state.range(0));
+  std::int64_t size = 0;
+  for (auto& bytes : serialized_trajectories) {
+    if (state.range(1) != 0) {
+      serialization::ContinuousTrajectory message;
+      message.ParseFromString(bytes);
+      ConvertToPreFrobenius(&message);
+      bytes = message.SerializeAsString();
+    }
+    size += bytes.size();
+  }
+
+  for (auto _ : state) {
+    for (auto const& bytes : serialized_trajectories) {
+      serialization::ContinuousTrajectory message;
+      message.ParseFromString(bytes);
+      auto const trajectory =
+          ContinuousTrajectory<Barycentric>::ReadFromMessage(message);
+      benchmark::DoNotOptimize(trajectory);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+  state.SetLabel(std::to_string(size) + " bytes" +
+                 (state.range(1) == 0 ? "" : " (pre-Frobenius)"));
+}
+
 template<SolarSystemFactory::Accuracy accuracy, Flow* flow>
 void BM_EphemerisLEOProbe(benchmark::State& state) {
   Length sun_error;
@@ -520,6 +692,15 @@ void BM_EphemerisL4Probe1Year(benchmark::State& state) {
       /*integration_duration=*/1 * JulianYear, state);
 }
 
+// A multi-year coast, measured in wall-clock time to show the effect of the
+// parallelism of |FlowWithParareal|.
+template<Flow* flow>
+void BM_EphemerisL4Probe10Years(benchmark::State& state) {
+  EphemerisL4ProbeBenchmark<SolarSystemFactory::Accuracy::MajorBodiesOnly,
+                            flow>(/*integration_duration=*/10 * JulianYear,
+                                  state);
+}
+
 template<Flow* flow>
 void BM_EphemerisFittingTolerance(benchmark::State& state) {
   EphemerisL4ProbeBenchmark<SolarSystemFactory::Accuracy::MajorBodiesOnly,
@@ -552,6 +733,26 @@ void FlowEphemerisWithAdaptiveStep(
       Ephemeris<Barycentric>::unlimited_max_ephemeris_steps));
 }
 
+template<int number_of_slices>
+void FlowEphemerisWithParareal(
+    not_null<DiscreteTrajectory<Barycentric>*> const trajectory,
+    Instant const& t,
+    Ephemeris<Barycentric>& ephemeris) {
+  CHECK_OK(ephemeris.FlowWithParareal(
+      trajectory,
+      Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+      t,
+      Ephemeris<Barycentric>::AdaptiveStepParameters(
+          EmbeddedExplicitRungeKuttaNyströmIntegrator<
+              DormandالمكاوىPrince1986RKN434FM,
+              Position<Barycentric>>(),
+          /*max_steps=*/std::numeric_limits<std::int64_t>::max(),
+          /*length_integration_tolerance=*/1 * Metre,
+          /*speed_integration_tolerance=*/1 * Metre / Second),
+      Ephemeris<Barycentric>::unlimited_max_ephemeris_steps,
+      {number_of_slices, /*coarse_tolerance_factor=*/1e3}));
+}
+
 void FlowEphemerisWithFixedStepSLMS(
     not_null<DiscreteTrajectory<Barycentric>*> const trajectory,
     Instant const& t,
@@ -596,6 +797,17 @@ BENCHMARK_TEMPLATE(BM_EphemerisSolarSystem,
 BENCHMARK_TEMPLATE(BM_EphemerisSolarSystem,
                    SolarSystemFactory::Accuracy::AllBodiesAndDampedOblateness)
     ->Arg(-3);
+BENCHMARK(BM_EphemerisDeserialization)
+    ->Arg(50)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_EphemerisPolynomialSerialization)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EphemerisPolynomialDeserialization)
+    ->ArgPair(100, 0)
+    ->ArgPair(100, 1)
+    ->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(BM_EphemerisL4Probe,
                    SolarSystemFactory::Accuracy::MajorBodiesOnly,
                    &FlowEphemerisWithAdaptiveStep)
@@ -669,6 +881,23 @@ BENCHMARK_TEMPLATE(BM_EphemerisL4Probe1Year,
                    &FlowEphemerisWithFixedStepSLMS)
     ->Arg(-3);
 
+BENCHMARK_TEMPLATE(BM_EphemerisL4Probe10Years, &FlowEphemerisWithAdaptiveStep)
+    ->Arg(-3)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EphemerisL4Probe10Years, &FlowEphemerisWithParareal<2>)
+    ->Arg(-3)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EphemerisL4Probe10Years, &FlowEphemerisWithParareal<4>)
+    ->Arg(-3)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EphemerisL4Probe10Years, &FlowEphemerisWithParareal<8>)
+    ->Arg(-3)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
 BENCHMARK_TEMPLATE(BM_EphemerisFittingTolerance, &FlowEphemerisWithAdaptiveStep)
     ->DenseRange(-4, 4);
 
@@ -83,9 +83,55 @@ void BM_FastSinCos2πThroughput(benchmark::State& state) {
   }
 }
 
+// The argument is the number of values per batch.  The scalar function applied
+// to each element of the batch, for comparison with the array function below.
+void BM_FastSinCos2πBatchScalar(benchmark::State& state) {
+  int const size = state.range(0);
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1.0, 1.0);
+  std::vector<double> input;
+  for (int i = 0; i < size; ++i) {
+    input.push_back(distribution(random));
+  }
+  std::vector<double> sin(size);
+  std::vector<double> cos(size);
+
+  for (auto _ : state) {
+    for (int i = 0; i < size; ++i) {
+      FastSinCos2π(input[i], sin[i], cos[i]);
+    }
+    benchmark::DoNotOptimize(sin.data());
+    benchmark::DoNotOptimize(cos.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+void BM_FastSinCos2πBatch(benchmark::State& state) {
+  int const size = state.range(0);
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1.0, 1.0);
+  std::vector<double> input;
+  for (int i = 0; i < size; ++i) {
+    input.push_back(distribution(random));
+  }
+  std::vector<double> sin(size);
+  std::vector<double> cos(size);
+
+  for (auto _ : state) {
+    FastSinCos2π(input.data(), size, sin.data(), cos.data());
+    benchmark::DoNotOptimize(sin.data());
+    benchmark::DoNotOptimize(cos.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
 BENCHMARK(BM_FastSinCos2πPoorlyPredictedLatency);
 BENCHMARK(BM_FastSinCos2πWellPredictedLatency);
 BENCHMARK(BM_FastSinCos2πThroughput);
+BENCHMARK(BM_FastSinCos2πBatchScalar)->RangeMultiplier(4)->Range(1, 4096);
+BENCHMARK(BM_FastSinCos2πBatch)->RangeMultiplier(4)->Range(1, 4096);
 
 }  // namespace numerics
 }  // namespace principia
@@ -92,6 +92,142 @@ void BM_NewhallApproximationDisplacement(benchmark::State& state) {
   }
 }
 
+// The Newhall approximations of all the bodies of an ephemeris step, computed
+// one by one or with a |NewhallBatch|.  The arguments are the degree and the
+// number of bodies.
+
+std::vector<std::vector<Displacement<ICRS>>> RandomDisplacements(
+    int const number_of_bodies,
+    std::mt19937_64& random) {
+  std::vector<std::vector<Displacement<ICRS>>> p(number_of_bodies);
+  for (auto& p_body : p) {
+    for (int i = 0; i <= 8; ++i) {
+      p_body.push_back(
+          Displacement<ICRS>({static_cast<double>(random()) * Metre,
+                              static_cast<double>(random()) * Metre,
+                              static_cast<double>(random()) * Metre}));
+    }
+  }
+  return p;
+}
+
+std::vector<std::vector<Variation<Displacement<ICRS>>>> RandomVelocities(
+    int const number_of_bodies,
+    std::mt19937_64& random) {
+  std::vector<std::vector<Variation<Displacement<ICRS>>>> v(number_of_bodies);
+  for (auto& v_body : v) {
+    for (int i = 0; i <= 8; ++i) {
+      v_body.push_back(Variation<Displacement<ICRS>>(
+          {static_cast<double>(random()) * Metre / Second,
+           static_cast<double>(random()) * Metre / Second,
+           static_cast<double>(random()) * Metre / Second}));
+    }
+  }
+  return v;
+}
+
+void BM_NewhallApproximationBodies(benchmark::State& state) {
+  int const degree = state.range(0);
+  int const number_of_bodies = state.range(1);
+  std::mt19937_64 random(42);
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  auto const p = RandomDisplacements(number_of_bodies, random);
+  auto const v = RandomVelocities(number_of_bodies, random);
+
+  Displacement<ICRS> error_estimate;
+  for (auto _ : state) {
+    for (int b = 0; b < number_of_bodies; ++b) {
+      auto const polynomial =
+          NewhallApproximationInMonomialBasis<Displacement<ICRS>,
+                                              EstrinEvaluator>(
+              degree, p[b], v[b], t_min, t_max, error_estimate);
+      benchmark::DoNotOptimize(polynomial.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_bodies);
+}
+
+void BM_NewhallBatch(benchmark::State& state) {
+  int const degree = state.range(0);
+  int const number_of_bodies = state.range(1);
+  std::mt19937_64 random(42);
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  auto const p = RandomDisplacements(number_of_bodies, random);
+  auto const v = RandomVelocities(number_of_bodies, random);
+
+  // The batch is reused across iterations, as it would be across steps.
+  NewhallBatch<Displacement<ICRS>> batch(t_min, t_max);
+  Displacement<ICRS> error_estimate;
+  for (auto _ : state) {
+    batch.Reset(t_min, t_max);
+    for (int b = 0; b < number_of_bodies; ++b) {
+      batch.Add(p[b], v[b]);
+    }
+    for (int b = 0; b < number_of_bodies; ++b) {
+      auto const polynomial =
+          batch.ApproximationInMonomialBasis<EstrinEvaluator>(
+              b, degree, error_estimate);
+      benchmark::DoNotOptimize(polynomial.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_bodies);
+}
+
+// The search for the degree of a body, as done by |ContinuousTrajectory|:
+// starting from degree 3 until the argument is reached.  For comparison, the
+// approximation is either computed for each degree, or only for the last one
+// after looking at the error estimates.
+
+void BM_NewhallDegreeSearchRefitting(benchmark::State& state) {
+  int const final_degree = state.range(0);
+  std::mt19937_64 random(42);
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  auto const p = RandomDisplacements(1, random);
+  auto const v = RandomVelocities(1, random);
+
+  Displacement<ICRS> error_estimate;
+  for (auto _ : state) {
+    for (int degree = 3; degree <= final_degree; ++degree) {
+      auto const polynomial =
+          NewhallApproximationInMonomialBasis<Displacement<ICRS>,
+                                              EstrinEvaluator>(
+              degree, p[0], v[0], t_min, t_max, error_estimate);
+      benchmark::DoNotOptimize(polynomial.get());
+    }
+  }
+}
+
+void BM_NewhallDegreeSearchErrorEstimates(benchmark::State& state) {
+  int const final_degree = state.range(0);
+  std::mt19937_64 random(42);
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  auto const p = RandomDisplacements(1, random);
+  auto const v = RandomVelocities(1, random);
+
+  // The batch is reused across iterations, as it would be across steps.
+  NewhallBatch<Displacement<ICRS>> batch(t_min, t_max);
+  Displacement<ICRS> error_estimate;
+  for (auto _ : state) {
+    batch.Reset(t_min, t_max);
+    batch.Add(p[0], v[0]);
+    for (int degree = 3; degree <= final_degree; ++degree) {
+      error_estimate = batch.ErrorEstimate(0, degree);
+      benchmark::DoNotOptimize(error_estimate);
+    }
+    auto const polynomial = batch.ApproximationInMonomialBasis<EstrinEvaluator>(
+        0, final_degree, error_estimate);
+    benchmark::DoNotOptimize(polynomial.get());
+  }
+}
+
 using ResultЧебышёвDouble = ЧебышёвSeries<double>;
 using ResultЧебышёвDisplacement = ЧебышёвSeries<Displacement<ICRS>>;
 using ResultMonomialDouble =
@@ -121,5 +257,14 @@ BENCHMARK_TEMPLATE(
                                           EstrinEvaluator>))
     ->Arg(4)->Arg(8)->Arg(16);
 
+BENCHMARK(BM_NewhallApproximationBodies)
+    ->ArgPair(4, 1)->ArgPair(8, 1)->ArgPair(16, 1)
+    ->ArgPair(4, 20)->ArgPair(8, 20)->ArgPair(16, 20);
+BENCHMARK(BM_NewhallBatch)
+    ->ArgPair(4, 1)->ArgPair(8, 1)->ArgPair(16, 1)
+    ->ArgPair(4, 20)->ArgPair(8, 20)->ArgPair(16, 20);
+BENCHMARK(BM_NewhallDegreeSearchRefitting)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK(BM_NewhallDegreeSearchErrorEstimates)->Arg(4)->Arg(8)->Arg(16);
+
 }  // namespace numerics
 }  // namespace principia
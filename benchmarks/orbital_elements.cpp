@@ -0,0 +1,144 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=OrbitalElements  // NOLINT(whitespace/line_length)
+
+#include "astronomy/orbital_elements.hpp"
+
+#include <memory>
+
+#include "astronomy/epoch.hpp"
+#include "astronomy/frames.hpp"
+#include "base/not_null.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/named_quantities.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/kepler_orbit.hpp"
+#include "physics/massive_body.hpp"
+#include "physics/massless_body.hpp"
+#include "quantities/astronomy.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace astronomy {
+
+using base::make_not_null_unique;
+using base::not_null;
+using geometry::Instant;
+using geometry::Velocity;
+using physics::DegreesOfFreedom;
+using physics::DiscreteTrajectory;
+using physics::KeplerianElements;
+using physics::KeplerOrbit;
+using physics::MassiveBody;
+using physics::MasslessBody;
+using quantities::Angle;
+using quantities::Length;
+using quantities::Time;
+using quantities::astronomy::TerrestrialGravitationalParameter;
+using quantities::si::Day;
+using quantities::si::Degree;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Second;
+
+namespace {
+
+// Returns a Keplerian trajectory sampled every |step| over |duration|, with
+// elements similar to those of the orbits of orbit_analysis_test.cpp.
+not_null<std::unique_ptr<DiscreteTrajectory<GCRS>>> EarthCentredTrajectory(
+    MassiveBody const& earth,
+    Length const& semimajor_axis,
+    Angle const& inclination,
+    Time const& duration,
+    Time const& step) {
+  KeplerianElements<GCRS> elements;
+  elements.semimajor_axis = semimajor_axis;
+  elements.eccentricity = 1e-3;
+  elements.inclination = inclination;
+  elements.longitude_of_ascending_node = 10 * Degree;
+  elements.argument_of_periapsis = 20 * Degree;
+  elements.mean_anomaly = 30 * Degree;
+  KeplerOrbit<GCRS> const orbit(earth, MasslessBody{}, elements, J2000);
+  auto trajectory = make_not_null_unique<DiscreteTrajectory<GCRS>>();
+  for (Instant t = J2000; t <= J2000 + duration; t += step) {
+    trajectory->Append(t,
+                       DegreesOfFreedom<GCRS>{GCRS::origin, Velocity<GCRS>{}} +
+                           orbit.StateVectors(t));
+  }
+  return trajectory;
+}
+
+// TOPEX/Poséidon.
+constexpr Length low_earth_orbit_semimajor_axis = 7714 * Kilo(Metre);
+constexpr Angle low_earth_orbit_inclination = 66 * Degree;
+// GPS.
+constexpr Length medium_earth_orbit_semimajor_axis = 26'560 * Kilo(Metre);
+constexpr Angle medium_earth_orbit_inclination = 55 * Degree;
+
+}  // namespace
+
+// The arguments are the duration of the trajectory in days and the orbit: 0 for
+// LEO, with points every 10 s, and 1 for MEO, with points every minute.
+void BM_OrbitalElements(benchmark::State& state) {
+  MassiveBody const earth(TerrestrialGravitationalParameter);
+  bool const low_earth_orbit = state.range(1) == 0;
+  auto const trajectory = EarthCentredTrajectory(
+      earth,
+      low_earth_orbit ? low_earth_orbit_semimajor_axis
+                      : medium_earth_orbit_semimajor_axis,
+      low_earth_orbit ? low_earth_orbit_inclination
+                      : medium_earth_orbit_inclination,
+      state.range(0) * Day,
+      low_earth_orbit ? 10 * Second : 60 * Second);
+  for (auto _ : state) {
+    auto const elements =
+        OrbitalElements::ForTrajectory(*trajectory, earth, MasslessBody{});
+    benchmark::DoNotOptimize(elements.ValueOrDie().mean_elements());
+  }
+  state.SetItemsProcessed(state.iterations() * trajectory->Size());
+}
+
+// Extends the elements computed for the first |state.range(0)| days of the
+// trajectory by one day, as the orbit analyser does when a mission is
+// lengthened.
+void BM_OrbitalElementsIncremental(benchmark::State& state) {
+  MassiveBody const earth(TerrestrialGravitationalParameter);
+  Time const duration = state.range(0) * Day;
+  auto const trajectory =
+      EarthCentredTrajectory(earth,
+                             low_earth_orbit_semimajor_axis,
+                             low_earth_orbit_inclination,
+                             duration + 1 * Day,
+                             10 * Second);
+  auto const prefix = make_not_null_unique<DiscreteTrajectory<GCRS>>();
+  for (auto const& [time, degrees_of_freedom] : *trajectory) {
+    if (time <= J2000 + duration) {
+      prefix->Append(time, degrees_of_freedom);
+    }
+  }
+  auto const previous =
+      OrbitalElements::ForTrajectory(*prefix, earth, MasslessBody{})
+          .ValueOrDie();
+  for (auto _ : state) {
+    auto const elements = OrbitalElements::ForTrajectory(
+        *trajectory, earth, MasslessBody{}, previous);
+    benchmark::DoNotOptimize(elements.ValueOrDie().mean_elements());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          (trajectory->Size() - prefix->Size()));
+}
+
+BENCHMARK(BM_OrbitalElements)
+    ->Args({1, 0})
+    ->Args({30, 0})
+    ->Args({365, 0})
+    ->Args({30, 1})
+    ->Args({365, 1})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OrbitalElementsIncremental)
+    ->Arg(1)
+    ->Arg(30)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace astronomy
+}  // namespace principia
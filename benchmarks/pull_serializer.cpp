@@ -0,0 +1,203 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=(PullSerializer|PushDeserializer)  // NOLINT(whitespace/line_length)
+
+#include "base/pull_serializer.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "astronomy/epoch.hpp"
+#include "base/array.hpp"
+#include "base/multi_codec_compressor.hpp"
+#include "base/not_null.hpp"
+#include "base/push_deserializer.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/named_quantities.hpp"
+#include "gipfeli/gipfeli.h"
+#include "ksp_plugin/frames.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "quantities/si.hpp"
+#include "serialization/physics.pb.h"
+
+namespace principia {
+namespace base {
+
+using astronomy::J2000;
+using geometry::Displacement;
+using geometry::Instant;
+using geometry::Velocity;
+using google::compression::Compressor;
+using ksp_plugin::World;
+using physics::DegreesOfFreedom;
+using physics::DiscreteTrajectory;
+using quantities::AngularFrequency;
+using quantities::Cos;
+using quantities::Length;
+using quantities::Sin;
+using quantities::Speed;
+using quantities::Time;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Radian;
+using quantities::si::Second;
+
+namespace {
+
+// The first argument of the benchmarks selects one of these codecs.
+enum BenchmarkedCodec {
+  None = 0,
+  Gipfeli = 1,
+  LZ4 = 2,
+  Zstd = 3,
+};
+
+// A trajectory on a circular orbit, about 3.7 MB once serialized, which is
+// typical of the large trajectories found in saves.
+not_null<std::unique_ptr<serialization::DiscreteTrajectory const>>
+TrajectoryMessage() {
+  Length const r = 7000 * Kilo(Metre);
+  AngularFrequency const ω = 1e-3 * Radian / Second;
+  Speed const v = ω * r / Radian;
+  DiscreteTrajectory<World> trajectory;
+  for (int i = 0; i < 100'000; ++i) {
+    Time const t = i * 10 * Second;
+    trajectory.Append(
+        J2000 + t,
+        DegreesOfFreedom<World>(
+            World::origin + Displacement<World>({r * Cos(ω * t),
+                                                 r * Sin(ω * t),
+                                                 0 * Metre}),
+            Velocity<World>({-v * Sin(ω * t),
+                             v * Cos(ω * t),
+                             0 * Metre / Second})));
+  }
+  auto message = make_not_null_unique<serialization::DiscreteTrajectory>();
+  trajectory.WriteToMessage(message.get(), /*forks=*/{});
+  return std::move(message);
+}
+
+std::unique_ptr<Compressor> NewCompressor(std::int64_t const codec) {
+  switch (codec) {
+    case None:
+      return nullptr;
+    case Gipfeli:
+      return google::compression::NewGipfeliCompressor();
+    case LZ4:
+      return std::make_unique<MultiCodecCompressor>(Codec::LZ4);
+    case Zstd:
+      return std::make_unique<MultiCodecCompressor>(Codec::Zstd);
+    default:
+      LOG(FATAL) << "Unexpected codec " << codec;
+  }
+  return nullptr;
+}
+
+// The gipfeli compressor is not thread-safe.
+int CompressionThreads(std::int64_t const codec) {
+  return codec == LZ4 || codec == Zstd
+             ? std::max(1u, std::thread::hardware_concurrency())
+             : 1;
+}
+
+std::vector<std::string> Serialize(
+    serialization::DiscreteTrajectory const& message,
+    std::int64_t const codec,
+    int const chunk_size,
+    int const number_of_chunks) {
+  std::vector<std::string> chunks;
+  PullSerializer serializer(chunk_size,
+                            number_of_chunks,
+                            NewCompressor(codec),
+                            CompressionThreads(codec));
+  serializer.Start(&message);
+  for (;;) {
+    Array<std::uint8_t> const bytes = serializer.Pull();
+    if (bytes.size == 0) {
+      break;
+    }
+    chunks.emplace_back(reinterpret_cast<char const*>(bytes.data),
+                        static_cast<std::size_t>(bytes.size));
+  }
+  return chunks;
+}
+
+void SetCodecLabel(benchmark::State& state) {
+  static char const* const names[] = {"none", "gipfeli", "lz4", "zstd"};
+  state.SetLabel(names[state.range(0)]);
+}
+
+}  // namespace
+
+// The arguments are the codec, the chunk size, and the number of chunks.  The
+// throughput is reported in bytes of uncompressed data per second of real time,
+// since most of the work happens on other threads.
+void BM_PullSerializer(benchmark::State& state) {
+  auto const message = TrajectoryMessage();
+  std::int64_t compressed_size = 0;
+  for (auto _ : state) {
+    compressed_size = 0;
+    for (auto const& chunk : Serialize(*message,
+                                       state.range(0),
+                                       state.range(1),
+                                       state.range(2))) {
+      compressed_size += chunk.size();
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * message->ByteSizeLong());
+  state.counters["compression_ratio"] =
+      static_cast<double>(message->ByteSizeLong()) / compressed_size;
+  SetCodecLabel(state);
+}
+
+void BM_PushDeserializer(benchmark::State& state) {
+  auto const message = TrajectoryMessage();
+  auto chunks = Serialize(*message,
+                          state.range(0),
+                          state.range(1),
+                          state.range(2));
+  for (auto _ : state) {
+    serialization::DiscreteTrajectory read_message;
+    {
+      PushDeserializer deserializer(state.range(1),
+                                    state.range(2),
+                                    NewCompressor(state.range(0)));
+      deserializer.Start(&read_message, /*done=*/nullptr);
+      for (auto& chunk : chunks) {
+        deserializer.Push(
+            Array<std::uint8_t>(reinterpret_cast<std::uint8_t*>(&chunk[0]),
+                                chunk.size()),
+            /*done=*/nullptr);
+      }
+      deserializer.Push(Array<std::uint8_t>(), /*done=*/nullptr);
+    }
+    benchmark::DoNotOptimize(read_message);
+  }
+  state.SetBytesProcessed(state.iterations() * message->ByteSizeLong());
+  SetCodecLabel(state);
+}
+
+void CodecChunkSizeNumberOfChunks(benchmark::internal::Benchmark* benchmark) {
+  for (int const codec : {None, Gipfeli, LZ4, Zstd}) {
+    for (int const chunk_size : {16 << 10, 64 << 10, 256 << 10}) {
+      for (int const number_of_chunks : {4, 8, 16}) {
+        benchmark->Args({codec, chunk_size, number_of_chunks});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_PullSerializer)
+    ->Apply(CodecChunkSizeNumberOfChunks)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PushDeserializer)
+    ->Apply(CodecChunkSizeNumberOfChunks)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace base
+}  // namespace principia
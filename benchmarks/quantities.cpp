@@ -1,7 +1,16 @@
 ﻿
 #include "benchmarks/quantities.hpp"
 
-#include<vector>
+#include <random>
+#include <vector>
+
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
+#include "geometry/named_quantities.hpp"
+#include "geometry/r3_element.hpp"
+#include "numerics/double_precision.hpp"
+#include "quantities/si.hpp"
+#include "serialization/geometry.pb.h"
 
 // Must come last to avoid conflicts when defining the CHECK macros.
 #include "benchmark/benchmark.h"
@@ -9,6 +18,26 @@
 namespace principia {
 namespace quantities {
 
+using geometry::Displacement;
+using geometry::Frame;
+using geometry::Position;
+using geometry::R3Element;
+using numerics::DoublePrecision;
+using numerics::TwoProduct;
+using si::Kilogram;
+using si::Metre;
+using si::Second;
+
+namespace {
+
+constexpr int number_of_values = 1000;
+
+using World = Frame<serialization::Frame::TestTag,
+                    serialization::Frame::TEST,
+                    /*inertial=*/false>;
+
+}  // namespace
+
 void BM_DimensionfulDiscreteCosineTransform(benchmark::State& state) {
   std::vector<Momentum> output;
   while (state.KeepRunning()) {
@@ -25,5 +54,69 @@ void BM_DoubleDiscreteCosineTransform(benchmark::State& state) {
 }
 BENCHMARK(BM_DoubleDiscreteCosineTransform);
 
+// The micro-benchmarks below exercise the arithmetic that depends on the
+// choice of SIMD backend, see |PRINCIPIA_USE_AVX2_FMA_INTRINSICS|.
+
+void BM_R3ElementLinearCombination(benchmark::State& state) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1.0, 1.0);
+  std::vector<R3Element<Length>> input;
+  for (int i = 0; i < number_of_values; ++i) {
+    input.emplace_back(distribution(random) * Metre,
+                       distribution(random) * Metre,
+                       distribution(random) * Metre);
+  }
+  for (auto _ : state) {
+    R3Element<Length> result;
+    for (int i = 1; i < number_of_values; ++i) {
+      result += 3 * input[i] - input[i - 1] / 7;
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * (number_of_values - 1));
+}
+BENCHMARK(BM_R3ElementLinearCombination);
+
+// Each addition performs a |TwoSum| and a |QuickTwoSum|.
+void BM_DoublePrecisionPositionSum(benchmark::State& state) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1.0, 1.0);
+  std::vector<DoublePrecision<Displacement<World>>> input;
+  for (int i = 0; i < number_of_values; ++i) {
+    input.emplace_back(Displacement<World>({distribution(random) * Metre,
+                                            distribution(random) * Metre,
+                                            distribution(random) * Metre}));
+  }
+  for (auto _ : state) {
+    DoublePrecision<Position<World>> result;
+    for (auto const& displacement : input) {
+      result += displacement;
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_values);
+}
+BENCHMARK(BM_DoublePrecisionPositionSum);
+
+void BM_TwoProduct(benchmark::State& state) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1.0, 1.0);
+  std::vector<Mass> masses;
+  std::vector<Speed> speeds;
+  for (int i = 0; i < number_of_values; ++i) {
+    masses.push_back(distribution(random) * Kilogram);
+    speeds.push_back(distribution(random) * Metre / Second);
+  }
+  for (auto _ : state) {
+    Momentum error;
+    for (int i = 0; i < number_of_values; ++i) {
+      error += TwoProduct(masses[i], speeds[i]).error;
+    }
+    benchmark::DoNotOptimize(error);
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_values);
+}
+BENCHMARK(BM_TwoProduct);
+
 }  // namespace quantities
 }  // namespace principia
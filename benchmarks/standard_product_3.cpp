@@ -0,0 +1,165 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=StandardProduct3  // NOLINT(whitespace/line_length)
+
+#include "astronomy/standard_product_3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "glog/logging.h"
+#include "quantities/numbers.hpp"
+
+namespace principia {
+namespace astronomy {
+
+namespace {
+
+constexpr int epochs_per_day = 24 * 60 / 5;
+
+struct Constellation {
+  char group;
+  int number_of_satellites;
+  double radius_in_km;
+  double inclination_in_degrees;
+};
+
+// Roughly the sizes and orbits of the actual constellations.
+constexpr Constellation constellations[] = {
+    {'G', 32, 26'560, 55},
+    {'R', 24, 25'510, 64.8},
+    {'E', 24, 29'600, 56},
+    {'C', 35, 27'900, 55},
+    {'J', 4, 42'164, 41},
+};
+
+int NumberOfSatellites() {
+  int result = 0;
+  for (auto const& constellation : constellations) {
+    result += constellation.number_of_satellites;
+  }
+  return result;
+}
+
+// Writes an SP3-d file covering |number_of_days| days (at most 28) at 5-minute
+// epochs, for satellites of several constellations on circular orbits, and
+// returns its path.
+std::filesystem::path WriteSyntheticFile(int const number_of_days) {
+  CHECK_LE(number_of_days, 28);
+  auto const path = std::filesystem::temp_directory_path() /
+                    ("synthetic_" + std::to_string(number_of_days) + ".sp3");
+  std::ofstream file(path, std::ios::binary);
+  CHECK(file.good()) << path;
+
+  int const number_of_epochs = number_of_days * epochs_per_day;
+  int const number_of_satellites = NumberOfSatellites();
+  int const number_of_satellite_id_records =
+      std::max(5, (number_of_satellites + 16) / 17);
+
+  char buffer[100];
+  std::snprintf(buffer, sizeof(buffer),
+                "#dP2019  1  1  0  0  0.00000000 %7d ORBIT IGS14 FIT  PRI\n",
+                number_of_epochs);
+  file << buffer;
+  file << "## 2034      0.00000000   300.00000000 58484 0.0000000000000\n";
+
+  std::vector<std::string> identifiers;
+  for (auto const& constellation : constellations) {
+    for (int i = 1; i <= constellation.number_of_satellites; ++i) {
+      std::snprintf(buffer, sizeof(buffer), "%c%02d", constellation.group, i);
+      identifiers.push_back(buffer);
+    }
+  }
+  for (int record = 0; record < number_of_satellite_id_records; ++record) {
+    if (record == 0) {
+      std::snprintf(buffer, sizeof(buffer), "+  %3d   ", number_of_satellites);
+      file << buffer;
+    } else {
+      file << "+        ";
+    }
+    for (int i = 17 * record; i < 17 * (record + 1); ++i) {
+      file << (i < identifiers.size() ? identifiers[i] : "  0");
+    }
+    file << "\n";
+  }
+  for (int record = 0; record < number_of_satellite_id_records; ++record) {
+    file << "++       ";
+    for (int i = 0; i < 17; ++i) {
+      file << "  5";
+    }
+    file << "\n";
+  }
+  file << "%c M  cc GPS ccc cccc cccc cccc cccc ccccc ccccc ccccc ccccc\n"
+       << "%c cc cc ccc ccc cccc cccc cccc cccc ccccc ccccc ccccc ccccc\n"
+       << "%f  1.2500000  1.025000000  0.00000000000  0.000000000000000\n"
+       << "%f  0.0000000  0.000000000  0.00000000000  0.000000000000000\n"
+       << "%i    0    0    0    0      0      0      0      0         0\n"
+       << "%i    0    0    0    0      0      0      0      0         0\n"
+       << "/* Synthetic multi-constellation orbits                     \n"
+       << "/* for benchmarking                                         \n"
+       << "/*                                                          \n"
+       << "/*                                                          \n";
+
+  for (int epoch = 0; epoch < number_of_epochs; ++epoch) {
+    int const minutes = 5 * epoch;
+    std::snprintf(buffer, sizeof(buffer),
+                  "*  2019  1 %2d %2d %2d  0.00000000\n",
+                  1 + minutes / (24 * 60),
+                  (minutes / 60) % 24,
+                  minutes % 60);
+    file << buffer;
+    double const t = minutes * 60.0;
+    for (auto const& constellation : constellations) {
+      double const r = constellation.radius_in_km;
+      double const i = constellation.inclination_in_degrees * π / 180;
+      // Kepler's third law with GM = 398600.4418 km³/s².
+      double const n = std::sqrt(398600.4418 / (r * r * r));
+      for (int s = 1; s <= constellation.number_of_satellites; ++s) {
+        double const θ =
+            n * t + 2 * π * s / constellation.number_of_satellites;
+        std::snprintf(buffer, sizeof(buffer),
+                      "P%c%02d%14.6f%14.6f%14.6f%14.6f\n",
+                      constellation.group,
+                      s,
+                      r * std::cos(θ),
+                      r * std::sin(θ) * std::cos(i),
+                      r * std::sin(θ) * std::sin(i),
+                      100.0 * s);
+        file << buffer;
+      }
+    }
+  }
+  file << "EOF\n";
+  return path;
+}
+
+}  // namespace
+
+void BM_StandardProduct3(benchmark::State& state) {
+  int const number_of_days = state.range(0);
+  auto const path = WriteSyntheticFile(number_of_days);
+  for (auto _ : state) {
+    StandardProduct3 const sp3(path, StandardProduct3::Dialect::Standard);
+    benchmark::DoNotOptimize(sp3.satellites());
+  }
+  // One item is one satellite position at one epoch.
+  state.SetItemsProcessed(state.iterations() * number_of_days *
+                          epochs_per_day * NumberOfSatellites());
+  state.SetBytesProcessed(state.iterations() *
+                          std::filesystem::file_size(path));
+  std::filesystem::remove(path);
+}
+
+BENCHMARK(BM_StandardProduct3)
+    ->Arg(1)
+    ->Arg(3)
+    ->Arg(7)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace astronomy
+}  // namespace principia
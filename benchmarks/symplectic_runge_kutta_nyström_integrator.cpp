@@ -18,6 +18,7 @@
 #include "integrators/ordinary_differential_equations.hpp"
 #include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
 #include "glog/logging.h"
+#include "numerics/double_precision.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/si.hpp"
@@ -33,6 +34,7 @@ using geometry::Instant;
 using geometry::Position;
 using geometry::Vector;
 using geometry::Velocity;
+using numerics::DoublePrecision;
 using quantities::Abs;
 using quantities::Acceleration;
 using quantities::AngularFrequency;
@@ -204,6 +206,51 @@ void BM_SymplecticRungeKuttaNyströmIntegratorSolveHarmonicOscillator3D(
   state.SetLabel(ss.str());
 }
 
+// Measures the number of steps per second for a system of |state.range(0)|
+// uncoupled 3D harmonic oscillators, without the cost of building a solution.
+// Most of the time goes to the |R3Element| arithmetic and to the compensated
+// summation of the positions and velocities, so this shows the effect of the
+// choice of SIMD backend.
+template<typename Method>
+void BM_SymplecticRungeKuttaNyströmIntegratorStepThroughput3D(
+    benchmark::State& state) {
+  using ODE = SpecialSecondOrderDifferentialEquation<Position<World>>;
+  int const number_of_oscillators = state.range(0);
+  Instant const t_initial;
+  Time const step = 3.0e-4 * Second;
+  constexpr int steps = 1000;
+
+  ODE harmonic_oscillators;
+  harmonic_oscillators.compute_acceleration =
+      [](Instant const& t,
+         std::vector<Position<World>> const& q,
+         std::vector<Vector<Acceleration, World>>& result) {
+        for (int i = 0; i < q.size(); ++i) {
+          result[i] = (World::origin - q[i]) *
+                      (SIUnit<Stiffness>() / SIUnit<Mass>());
+        }
+        return Status::OK;
+      };
+  IntegrationProblem<ODE> problem;
+  problem.equation = harmonic_oscillators;
+  problem.initial_state.time = DoublePrecision<Instant>(t_initial);
+  for (int i = 0; i < number_of_oscillators; ++i) {
+    problem.initial_state.positions.emplace_back(
+        World::origin +
+        Displacement<World>({(i + 1) * Metre, 0 * Metre, 0 * Metre}));
+    problem.initial_state.velocities.emplace_back(Velocity<World>());
+  }
+  auto const append_state = [](ODE::SystemState const& state) {};
+  auto const& integrator =
+      SymplecticRungeKuttaNyströmIntegrator<Method, Position<World>>();
+
+  for (auto _ : state) {
+    auto const instance = integrator.NewInstance(problem, append_state, step);
+    instance->Solve(t_initial + steps * step);
+  }
+  state.SetItemsProcessed(state.iterations() * steps);
+}
+
 BENCHMARK_TEMPLATE2(
     BM_SymplecticRungeKuttaNyströmIntegratorSolveHarmonicOscillator1D,
     methods::McLachlanAtela1992Order4Optimal, Length);
@@ -254,5 +301,11 @@ BENCHMARK_TEMPLATE2(
     BM_SymplecticRungeKuttaNyströmIntegratorSolveHarmonicOscillator3D,
     methods::BlanesMoan2002SRKN14A, Position<World>);
 
+BENCHMARK_TEMPLATE(BM_SymplecticRungeKuttaNyströmIntegratorStepThroughput3D,
+                   methods::BlanesMoan2002SRKN14A)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100);
+
 }  // namespace integrators
 }  // namespace principia
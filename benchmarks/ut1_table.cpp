@@ -0,0 +1,91 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=EarthRotationAngle  // NOLINT(whitespace/line_length)
+
+#include "astronomy/ut1_table.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "astronomy/time_scales.hpp"
+#include "benchmark/benchmark.h"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace astronomy {
+
+using geometry::Instant;
+using quantities::Angle;
+using quantities::si::Day;
+
+namespace {
+
+// |number_of_instants| sorted instants over a year, as for the evaluation of
+// the orientation of the Earth along a trajectory.
+std::vector<Instant> SortedInstants(int const number_of_instants) {
+  Instant const t0 = "2010-01-01T00:00:00"_TT;
+  std::vector<Instant> instants;
+  for (int i = 0; i < number_of_instants; ++i) {
+    instants.push_back(t0 + 365 * Day * i / number_of_instants);
+  }
+  return instants;
+}
+
+// The instants for a benchmark whose arguments are the number of instants and
+// whether they are shuffled.  All the benchmarks evaluate the same sequence for
+// the same arguments.
+std::vector<Instant> Instants(benchmark::State const& state) {
+  auto instants = SortedInstants(state.range(0));
+  if (state.range(1)) {
+    std::mt19937_64 random(42);
+    std::shuffle(instants.begin(), instants.end(), random);
+  }
+  return instants;
+}
+
+}  // namespace
+
+void BM_EarthRotationAngleTimeScales(benchmark::State& state) {
+  auto const instants = Instants(state);
+  for (auto _ : state) {
+    for (Instant const& tt : instants) {
+      benchmark::DoNotOptimize(EarthRotationAngle(tt));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * instants.size());
+}
+
+void BM_EarthRotationAngleUT1Table(benchmark::State& state) {
+  auto const& table = UT1Table::Get();
+  auto const instants = Instants(state);
+  for (auto _ : state) {
+    for (Instant const& tt : instants) {
+      benchmark::DoNotOptimize(table.EarthRotationAngle(tt));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * instants.size());
+}
+
+void BM_EarthRotationAngleUT1TableBatch(benchmark::State& state) {
+  auto const& table = UT1Table::Get();
+  auto const instants = Instants(state);
+  std::vector<Angle> angles;
+  for (auto _ : state) {
+    table.EarthRotationAngle(instants, angles);
+    benchmark::DoNotOptimize(angles.data());
+  }
+  state.SetItemsProcessed(state.iterations() * instants.size());
+}
+
+BENCHMARK(BM_EarthRotationAngleTimeScales)
+    ->ArgPair(1000, false)->ArgPair(100'000, false)
+    ->ArgPair(1000, true)->ArgPair(100'000, true);
+BENCHMARK(BM_EarthRotationAngleUT1Table)
+    ->ArgPair(1000, false)->ArgPair(100'000, false)
+    ->ArgPair(1000, true)->ArgPair(100'000, true);
+BENCHMARK(BM_EarthRotationAngleUT1TableBatch)
+    ->ArgPair(1000, false)->ArgPair(100'000, false)
+    ->ArgPair(1000, true)->ArgPair(100'000, true);
+
+}  // namespace astronomy
+}  // namespace principia
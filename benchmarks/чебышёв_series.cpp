@@ -205,6 +205,123 @@ void BM_EvaluateDisplacement(benchmark::State& state) {
   state.SetLabel(ss.str().substr(0, 0));
 }
 
+namespace {
+
+template<typename Vector>
+Vector RandomCoefficient(std::mt19937_64& random);
+
+template<>
+double RandomCoefficient<double>(std::mt19937_64& random) {
+  return static_cast<double>(random());
+}
+
+template<>
+Displacement<ICRS> RandomCoefficient<Displacement<ICRS>>(
+    std::mt19937_64& random) {
+  return Displacement<ICRS>({static_cast<double>(random()) * Metre,
+                             static_cast<double>(random()) * Metre,
+                             static_cast<double>(random()) * Metre});
+}
+
+// The arguments are the degree and the number of times evaluated at once.
+void BatchArguments(benchmark::internal::Benchmark* benchmark) {
+  for (int const degree : {3, 5, 9, 13, 17}) {
+    for (int const batch_size : {1, 2, 4, 8, 16, 32, 64}) {
+      benchmark->Args({degree, batch_size});
+    }
+  }
+}
+
+}  // namespace
+
+// Evaluates the series at each time of a batch, one at a time.
+template<typename Vector>
+void BM_EvaluateOneByOne(benchmark::State& state) {
+  int const degree = state.range(0);
+  int const batch_size = state.range(1);
+  std::mt19937_64 random(42);
+  std::vector<Vector> coefficients;
+  for (int i = 0; i <= degree; ++i) {
+    coefficients.push_back(RandomCoefficient<Vector>(random));
+  }
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  ЧебышёвSeries<Vector> const series(coefficients, t_min, t_max);
+
+  std::vector<Instant> times;
+  for (int i = 0; i < batch_size; ++i) {
+    times.push_back(t_min + (t_max - t_min) * (i + 0.5) / batch_size);
+  }
+  std::vector<Vector> values(batch_size);
+
+  for (auto _ : state) {
+    for (int i = 0; i < batch_size; ++i) {
+      values[i] = series.Evaluate(times[i]);
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+// Evaluates the series at all the times of a batch at once.
+template<typename Vector>
+void BM_EvaluateBatch(benchmark::State& state) {
+  int const degree = state.range(0);
+  int const batch_size = state.range(1);
+  std::mt19937_64 random(42);
+  std::vector<Vector> coefficients;
+  for (int i = 0; i <= degree; ++i) {
+    coefficients.push_back(RandomCoefficient<Vector>(random));
+  }
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  ЧебышёвSeries<Vector> const series(coefficients, t_min, t_max);
+
+  std::vector<Instant> times;
+  for (int i = 0; i < batch_size; ++i) {
+    times.push_back(t_min + (t_max - t_min) * (i + 0.5) / batch_size);
+  }
+  std::vector<Vector> values;
+  values.reserve(batch_size);
+
+  for (auto _ : state) {
+    series.Evaluate(times, values);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+// Same as above, for the derivative.
+template<typename Vector>
+void BM_EvaluateDerivativeBatch(benchmark::State& state) {
+  int const degree = state.range(0);
+  int const batch_size = state.range(1);
+  std::mt19937_64 random(42);
+  std::vector<Vector> coefficients;
+  for (int i = 0; i <= degree; ++i) {
+    coefficients.push_back(RandomCoefficient<Vector>(random));
+  }
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  ЧебышёвSeries<Vector> const series(coefficients, t_min, t_max);
+
+  std::vector<Instant> times;
+  for (int i = 0; i < batch_size; ++i) {
+    times.push_back(t_min + (t_max - t_min) * (i + 0.5) / batch_size);
+  }
+  std::vector<Variation<Vector>> derivatives;
+  derivatives.reserve(batch_size);
+
+  for (auto _ : state) {
+    series.EvaluateDerivative(times, derivatives);
+    benchmark::DoNotOptimize(derivatives.data());
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
 BENCHMARK(BM_EvaluateDouble)->
     Arg(4)->Arg(8)->Arg(15)->Arg(16)->Arg(17)->Arg(18)->Arg(19);
 BENCHMARK(BM_EvaluateQuantity)->
@@ -215,6 +332,14 @@ BENCHMARK(BM_EvaluateVectorDouble)->
     Arg(4)->Arg(8)->Arg(15)->Arg(16)->Arg(17)->Arg(18)->Arg(19);
 BENCHMARK(BM_EvaluateDisplacement)->
     Arg(4)->Arg(8)->Arg(15)->Arg(16)->Arg(17)->Arg(18)->Arg(19);
+BENCHMARK_TEMPLATE(BM_EvaluateOneByOne, double)->Apply(BatchArguments);
+BENCHMARK_TEMPLATE(BM_EvaluateBatch, double)->Apply(BatchArguments);
+BENCHMARK_TEMPLATE(BM_EvaluateOneByOne, Displacement<ICRS>)->
+    Apply(BatchArguments);
+BENCHMARK_TEMPLATE(BM_EvaluateBatch, Displacement<ICRS>)->
+    Apply(BatchArguments);
+BENCHMARK_TEMPLATE(BM_EvaluateDerivativeBatch, Displacement<ICRS>)->
+    Apply(BatchArguments);
 
 }  // namespace numerics
 }  // namespace principia
@@ -3,6 +3,7 @@
 
 #include "geometry/r3_element.hpp"
 
+#include <immintrin.h>
 #include <pmmintrin.h>
 
 #include <string>
@@ -30,6 +31,38 @@ using quantities::SIUnit;
 using quantities::ToM128D;
 
 // We want zero initialization here, so the default constructor won't do.
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+template<typename Scalar>
+R3Element<Scalar>::R3Element() : xyzt(_mm256_setzero_pd()) {
+  static_assert(std::is_standard_layout<R3Element>::value,
+                "R3Element has a nonstandard layout");
+}
+
+template<typename Scalar>
+R3Element<Scalar>::R3Element(Scalar const& x,
+                             Scalar const& y,
+                             Scalar const& z)
+    : xyzt(_mm256_setr_pd(_mm_cvtsd_f64(ToM128D(x)),
+                          _mm_cvtsd_f64(ToM128D(y)),
+                          _mm_cvtsd_f64(ToM128D(z)),
+                          0)) {
+  static_assert(std::is_standard_layout<R3Element>::value,
+                "R3Element has a nonstandard layout");
+}
+
+template<typename Scalar>
+R3Element<Scalar>::R3Element(__m128d const xy, __m128d const zt)
+    : xyzt(_mm256_set_m128d(_mm_move_sd(_mm_setzero_pd(), zt), xy)) {
+  static_assert(std::is_standard_layout<R3Element>::value,
+                "R3Element has a nonstandard layout");
+}
+
+template<typename Scalar>
+R3Element<Scalar>::R3Element(__m256d const xyzt) : xyzt(xyzt) {
+  static_assert(std::is_standard_layout<R3Element>::value,
+                "R3Element has a nonstandard layout");
+}
+#else
 template<typename Scalar>
 R3Element<Scalar>::R3Element() : x(), y(), z() {
   static_assert(std::is_standard_layout<R3Element>::value,
@@ -50,6 +83,7 @@ R3Element<Scalar>::R3Element(__m128d const xy, __m128d const zt)
   static_assert(std::is_standard_layout<R3Element>::value,
                 "R3Element has a nonstandard layout");
 }
+#endif
 
 template<typename Scalar>
 Scalar& R3Element<Scalar>::operator[](int const index) {
@@ -85,7 +119,9 @@ Scalar const& R3Element<Scalar>::operator[](
 template<typename Scalar>
 R3Element<Scalar>& R3Element<Scalar>::operator+=(
     R3Element<Scalar> const& right) {
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  xyzt = _mm256_add_pd(xyzt, right.xyzt);
+#elif PRINCIPIA_USE_SSE3_INTRINSICS
   xy = _mm_add_pd(xy, right.xy);
   zt = _mm_add_sd(zt, right.zt);
 #else
@@ -99,7 +135,9 @@ R3Element<Scalar>& R3Element<Scalar>::operator+=(
 template<typename Scalar>
 R3Element<Scalar>& R3Element<Scalar>::operator-=(
     R3Element<Scalar> const& right) {
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  xyzt = _mm256_sub_pd(xyzt, right.xyzt);
+#elif PRINCIPIA_USE_SSE3_INTRINSICS
   xy = _mm_sub_pd(xy, right.xy);
   zt = _mm_sub_sd(zt, right.zt);
 #else
@@ -112,7 +150,9 @@ R3Element<Scalar>& R3Element<Scalar>::operator-=(
 
 template<typename Scalar>
 R3Element<Scalar>& R3Element<Scalar>::operator*=(double const right) {
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  xyzt = _mm256_mul_pd(xyzt, _mm256_broadcastsd_pd(ToM128D(right)));
+#elif PRINCIPIA_USE_SSE3_INTRINSICS
   __m128d const right_128d = ToM128D(right);
   xy = _mm_mul_pd(xy, right_128d);
   zt = _mm_mul_sd(zt, right_128d);
@@ -126,7 +166,9 @@ R3Element<Scalar>& R3Element<Scalar>::operator*=(double const right) {
 
 template<typename Scalar>
 R3Element<Scalar>& R3Element<Scalar>::operator/=(double const right) {
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  xyzt = _mm256_div_pd(xyzt, _mm256_broadcastsd_pd(ToM128D(right)));
+#elif PRINCIPIA_USE_SSE3_INTRINSICS
   __m128d const right_128d = ToM128D(right);
   xy = _mm_div_pd(xy, right_128d);
   zt = _mm_div_sd(zt, right_128d);
@@ -220,7 +262,9 @@ R3Element<Scalar> operator-(R3Element<Scalar> const& right) {
 template<typename Scalar>
 R3Element<Scalar> operator+(R3Element<Scalar> const& left,
                             R3Element<Scalar> const& right) {
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  return R3Element<Scalar>(_mm256_add_pd(left.xyzt, right.xyzt));
+#elif PRINCIPIA_USE_SSE3_INTRINSICS
   return R3Element<Scalar>(_mm_add_pd(left.xy, right.xy),
                            _mm_add_sd(left.zt, right.zt));
 #else
@@ -233,7 +277,9 @@ R3Element<Scalar> operator+(R3Element<Scalar> const& left,
 template<typename Scalar>
 R3Element<Scalar> operator-(R3Element<Scalar> const& left,
                             R3Element<Scalar> const& right) {
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  return R3Element<Scalar>(_mm256_sub_pd(left.xyzt, right.xyzt));
+#elif PRINCIPIA_USE_SSE3_INTRINSICS
   return R3Element<Scalar>(_mm_sub_pd(left.xy, right.xy),
                            _mm_sub_sd(left.zt, right.zt));
 #else
@@ -247,7 +293,10 @@ template<typename LScalar, typename RScalar, typename>
 R3Element<Product<LScalar, RScalar>> operator*(
     LScalar const& left,
     R3Element<RScalar> const& right) {
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  return R3Element<Product<LScalar, RScalar>>(
+      _mm256_mul_pd(right.xyzt, _mm256_broadcastsd_pd(ToM128D(left))));
+#elif PRINCIPIA_USE_SSE3_INTRINSICS
   __m128d const left_128d = ToM128D(left);
   return R3Element<Product<LScalar, RScalar>>(_mm_mul_pd(right.xy, left_128d),
                                               _mm_mul_sd(right.zt, left_128d));
@@ -261,7 +310,10 @@ R3Element<Product<LScalar, RScalar>> operator*(
 template<typename LScalar, typename RScalar, typename>
 R3Element<Product<LScalar, RScalar>> operator*(R3Element<LScalar> const& left,
                                                RScalar const& right) {
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  return R3Element<Product<LScalar, RScalar>>(
+      _mm256_mul_pd(left.xyzt, _mm256_broadcastsd_pd(ToM128D(right))));
+#elif PRINCIPIA_USE_SSE3_INTRINSICS
   __m128d const right_128d = ToM128D(right);
   return R3Element<Product<LScalar, RScalar>>(_mm_mul_pd(left.xy, right_128d),
                                               _mm_mul_sd(left.zt, right_128d));
@@ -275,7 +327,10 @@ R3Element<Product<LScalar, RScalar>> operator*(R3Element<LScalar> const& left,
 template<typename LScalar, typename RScalar, typename>
 R3Element<Quotient<LScalar, RScalar>> operator/(R3Element<LScalar> const& left,
                                                 RScalar const& right) {
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  return R3Element<Quotient<LScalar, RScalar>>(
+      _mm256_div_pd(left.xyzt, _mm256_broadcastsd_pd(ToM128D(right))));
+#elif PRINCIPIA_USE_SSE3_INTRINSICS
   __m128d const right_128d = ToM128D(right);
   return R3Element<Quotient<LScalar, RScalar>>(_mm_div_pd(left.xy, right_128d),
                                                _mm_div_sd(left.zt, right_128d));
@@ -115,6 +115,29 @@ TEST_F(R3ElementTest, Dumb3Vector) {
       Dot<Speed, Speed>, u_, v_, w_, a_, 42.0, 0, 1);
 }
 
+// The vectorized operations give the same results as the operations on the
+// components, whichever SIMD backend is used.
+TEST_F(R3ElementTest, Componentwise) {
+  static_assert(alignof(R3Element<Speed>) ==
+                    (PRINCIPIA_USE_AVX2_FMA_INTRINSICS ? 32 : 16),
+                "Unexpected alignment");
+  Time const t = -3 * Second;
+  R3Element<Length> const sum = u_ * t + v_ * t;
+  R3Element<Speed> const difference = w_ - a_;
+  R3Element<Speed> const quotient = v_ / 7;
+  R3Element<Speed> accumulator = u_;
+  accumulator += v_;
+  accumulator -= w_;
+  accumulator *= 3;
+  accumulator /= 7;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(u_[i] * t + v_[i] * t, sum[i]);
+    EXPECT_EQ(w_[i] - a_[i], difference[i]);
+    EXPECT_EQ(v_[i] / 7, quotient[i]);
+    EXPECT_EQ((u_[i] + v_[i] - w_[i]) * 3 / 7, accumulator[i]);
+  }
+}
+
 TEST_F(R3ElementTest, MixedProduct) {
   testing_utilities::TestBilinearMap(
       std::multiplies<>(), 1 * Second, 1 * JulianYear, u_, v_, 42.0, 0, 1);
@@ -60,10 +60,22 @@ struct PointOrMultivectorSerializer : not_constructible {};
 template<typename T, typename Message>
 struct QuantityOrMultivectorSerializer : not_constructible {};
 
+// A helper class that serializes a |double|, a |Quantity|, a |Point|, an
+// |R3Element| or a |Multivector| as its coordinates in SI units, appended to a
+// field like:
+//
+// repeated double field = 1 [packed = true];
+//
+// The type is not serialized, so it must be known to the reader.  |size| is
+// the number of doubles used by an object of type |T|.
+template<typename T>
+struct PackedSerializer : not_constructible {};
+
 }  // namespace internal_serialization
 
 using internal_serialization::DoubleOrQuantityOrPointOrMultivectorSerializer;
 using internal_serialization::DoubleOrQuantityOrMultivectorSerializer;
+using internal_serialization::PackedSerializer;
 using internal_serialization::PointOrMultivectorSerializer;
 using internal_serialization::QuantityOrMultivectorSerializer;
 
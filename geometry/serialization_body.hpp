@@ -3,9 +3,13 @@
 
 #include "geometry/serialization.hpp"
 
+#include <type_traits>
+
 #include "base/not_null.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/point.hpp"
+#include "geometry/r3_element.hpp"
+#include "google/protobuf/repeated_field.h"
 #include "quantities/quantities.hpp"
 #include "quantities/serialization.hpp"
 
@@ -14,8 +18,10 @@ namespace geometry {
 namespace internal_serialization {
 
 using base::not_null;
+using google::protobuf::RepeatedField;
 using quantities::DoubleOrQuantitySerializer;
 using quantities::Quantity;
+using quantities::SIUnit;
 
 template<typename Message>
 class DoubleOrQuantityOrPointOrMultivectorSerializer<double, Message>
@@ -87,6 +93,83 @@ template<typename Dimensions, typename Message>
 class QuantityOrMultivectorSerializer<Quantity<Dimensions>, Message>
     : public DoubleOrQuantitySerializer<Quantity<Dimensions>, Message> {};
 
+template<>
+struct PackedSerializer<double> : not_constructible {
+  static constexpr int size = 1;
+  static void WriteToField(double const t,
+                           not_null<RepeatedField<double>*> const field) {
+    field->Add(t);
+  }
+
+  // Reads the object at |index| in |field| and advances |index| past it.
+  static double ReadFromField(RepeatedField<double> const& field, int& index) {
+    return field.Get(index++);
+  }
+};
+
+template<typename Dimensions>
+struct PackedSerializer<Quantity<Dimensions>> : not_constructible {
+  using T = Quantity<Dimensions>;
+  static constexpr int size = 1;
+  static void WriteToField(T const& t,
+                           not_null<RepeatedField<double>*> const field) {
+    field->Add(t / SIUnit<T>());
+  }
+
+  static T ReadFromField(RepeatedField<double> const& field, int& index) {
+    return field.Get(index++) * SIUnit<T>();
+  }
+};
+
+template<typename Scalar>
+struct PackedSerializer<R3Element<Scalar>> : not_constructible {
+  using T = R3Element<Scalar>;
+  static constexpr int size = 3 * PackedSerializer<Scalar>::size;
+  static void WriteToField(T const& t,
+                           not_null<RepeatedField<double>*> const field) {
+    PackedSerializer<Scalar>::WriteToField(t.x, field);
+    PackedSerializer<Scalar>::WriteToField(t.y, field);
+    PackedSerializer<Scalar>::WriteToField(t.z, field);
+  }
+
+  static T ReadFromField(RepeatedField<double> const& field, int& index) {
+    // The order of evaluation of function arguments is unspecified.
+    Scalar const x = PackedSerializer<Scalar>::ReadFromField(field, index);
+    Scalar const y = PackedSerializer<Scalar>::ReadFromField(field, index);
+    Scalar const z = PackedSerializer<Scalar>::ReadFromField(field, index);
+    return T(x, y, z);
+  }
+};
+
+template<typename Scalar, typename Frame, int rank>
+struct PackedSerializer<Multivector<Scalar, Frame, rank>> : not_constructible {
+  using T = Multivector<Scalar, Frame, rank>;
+  using Coordinates = std::decay_t<decltype(std::declval<T>().coordinates())>;
+  static constexpr int size = PackedSerializer<Coordinates>::size;
+  static void WriteToField(T const& t,
+                           not_null<RepeatedField<double>*> const field) {
+    PackedSerializer<Coordinates>::WriteToField(t.coordinates(), field);
+  }
+
+  static T ReadFromField(RepeatedField<double> const& field, int& index) {
+    return T(PackedSerializer<Coordinates>::ReadFromField(field, index));
+  }
+};
+
+template<typename Vector>
+struct PackedSerializer<Point<Vector>> : not_constructible {
+  using T = Point<Vector>;
+  static constexpr int size = PackedSerializer<Vector>::size;
+  static void WriteToField(T const& t,
+                           not_null<RepeatedField<double>*> const field) {
+    PackedSerializer<Vector>::WriteToField(t - T(), field);
+  }
+
+  static T ReadFromField(RepeatedField<double> const& field, int& index) {
+    return T() + PackedSerializer<Vector>::ReadFromField(field, index);
+  }
+};
+
 }  // namespace internal_serialization
 }  // namespace geometry
 }  // namespace principia
@@ -72,6 +72,28 @@ git pull
 make
 popd
 
+if [ ! -d "lz4" ]; then
+  git clone "https://github.com/lz4/lz4"
+fi
+pushd lz4
+# Pinned, as we don't maintain a fork; keep in sync with
+# rebuild_all_solutions.ps1.
+git fetch --tags
+git checkout v1.9.2
+make -C lib CC=clang CFLAGS="$C_FLAGS" liblz4.a
+popd
+
+if [ ! -d "zstd" ]; then
+  git clone "https://github.com/facebook/zstd"
+fi
+pushd zstd
+# Pinned, as we don't maintain a fork; keep in sync with
+# rebuild_all_solutions.ps1.
+git fetch --tags
+git checkout v1.4.4
+make -C lib CC=clang CFLAGS="$C_FLAGS" libzstd.a
+popd
+
 if [ ! -d "abseil-cpp" ]; then
   git clone "https://github.com/mockingbirdnest/abseil-cpp"
 fi
@@ -1,15 +1,19 @@
 ﻿
 #pragma once
 
-#include <functional>
 #include <memory>
+#include <optional>
 #include <type_traits>
 
 #include "base/not_constructible.hpp"
 #include "base/not_null.hpp"
+#include "serialization/journal.pb.h"
 
 namespace principia {
 namespace journal {
+
+class Recorder;
+
 namespace internal_method {
 
 using base::not_constructible;
@@ -55,6 +59,34 @@ template<typename P>
 struct has_return<P, std::void_t<typename P::Return>> : std::true_type,
                                                         not_constructible {};
 
+// The types of the |Out| parameters and of the result of |P|, or an empty type
+// if the profile has none.  They let |Method| hold the values to journal at
+// destruction without type erasure.
+struct Nothing final {};
+
+template<typename P, typename = void>
+struct out_type : not_constructible {
+  using type = Nothing;
+};
+template<typename P>
+struct out_type<P, std::void_t<typename P::Out>> : not_constructible {
+  using type = typename P::Out;
+};
+
+template<typename P, typename = void>
+struct return_type : not_constructible {
+  using type = Nothing;
+};
+template<typename P>
+struct return_type<P, std::void_t<typename P::Return>> : not_constructible {
+  using type = typename P::Return;
+};
+
+// A |Method| is constructed on entry to each function of the interface, so it
+// must be cheap when no recorder is active: in that case it doesn't allocate
+// and its only cost is a test of |Recorder::active_recorder_|.  When a recorder
+// is active, the messages are built on an arena backed by a buffer on the
+// stack.
 template<typename Profile>
 class Method final {
  public:
@@ -91,9 +123,26 @@ class Method final {
   typename P::Return Return(typename P::Return const& result);
 
  private:
-  std::function<void(not_null<typename Profile::Message*> message)> out_filler_;
-  std::function<void(not_null<typename Profile::Message*> message)>
-      return_filler_;
+  using Out = typename out_type<Profile>::type;
+  using Result = typename return_type<Profile>::type;
+
+  // Builds a |serialization::Method| on an arena, calls |fill| on its
+  // |Profile| extension and passes it to |write| of the |recorder_|.
+  template<typename Fill>
+  void Write(Fill const& fill,
+             void (Recorder::*write)(serialization::Method const& method));
+
+  // The size of the stack buffer used by the arena of |Write|, which is enough
+  // for all the messages that don't carry large strings.
+  static constexpr int arena_initial_block_size = 1 << 10;
+
+  // The recorder that was active at construction, if any.  The writes at
+  // construction and destruction must go to the same recorder, as they lock and
+  // unlock it.
+  Recorder* const recorder_;
+  // Only set if |recorder_| is not null.
+  std::optional<Out> out_;
+  std::optional<Result> result_;
   bool returned_ = false;
 };
 
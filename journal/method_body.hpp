@@ -3,81 +3,73 @@
 
 #include "journal/method.hpp"
 
-#include <list>
-
+#include "google/protobuf/arena.h"
 #include "journal/recorder.hpp"
 
 namespace principia {
 namespace journal {
 namespace internal_method {
 
+using ::google::protobuf::Arena;
+using ::google::protobuf::ArenaOptions;
+
 template<typename Profile>
-Method<Profile>::Method() {
-  if (Recorder::active_recorder_ != nullptr) {
-    serialization::Method method;
-    auto* const message_in =
-        method.MutableExtension(Profile::Message::extension);
-    Recorder::active_recorder_->WriteAtConstruction(method);
+Method<Profile>::Method() : recorder_(Recorder::active_recorder_) {
+  if (recorder_ != nullptr) {
+    Write([](not_null<typename Profile::Message*> const message) {},
+          &Recorder::WriteAtConstruction);
   }
 }
 
 template<typename Profile>
 template<typename P, typename>
-Method<Profile>::Method(typename P::In const& in) {
-  if (Recorder::active_recorder_ != nullptr) {
-    serialization::Method method;
-    auto* const message_in =
-        method.MutableExtension(Profile::Message::extension);
-    Profile::Fill(in, message_in);
-    Recorder::active_recorder_->WriteAtConstruction(method);
+Method<Profile>::Method(typename P::In const& in)
+    : recorder_(Recorder::active_recorder_) {
+  if (recorder_ != nullptr) {
+    Write([&in](not_null<typename Profile::Message*> const message) {
+            Profile::Fill(in, message);
+          },
+          &Recorder::WriteAtConstruction);
   }
 }
 
 template<typename Profile>
 template<typename P, typename>
-Method<Profile>::Method(typename P::Out const& out) {
-  if (Recorder::active_recorder_ != nullptr) {
-    serialization::Method method;
-    auto* const message_in =
-        method.MutableExtension(Profile::Message::extension);
-    Recorder::active_recorder_->WriteAtConstruction(method);
-    out_filler_ = [this, out](
-        not_null<typename Profile::Message*> const message) {
-      Profile::Fill(out, message);
-    };
+Method<Profile>::Method(typename P::Out const& out)
+    : recorder_(Recorder::active_recorder_) {
+  if (recorder_ != nullptr) {
+    Write([](not_null<typename Profile::Message*> const message) {},
+          &Recorder::WriteAtConstruction);
+    out_.emplace(out);
   }
 }
 
 template<typename Profile>
 template<typename P, typename>
-Method<Profile>::Method(typename P::In const& in, typename P::Out const& out) {
-  if (Recorder::active_recorder_ != nullptr) {
-    serialization::Method method;
-    auto* const message_in =
-        method.MutableExtension(Profile::Message::extension);
-    Profile::Fill(in, message_in);
-    Recorder::active_recorder_->WriteAtConstruction(method);
-    out_filler_ = [this, out](
-        not_null<typename Profile::Message*> const message) {
-      Profile::Fill(out, message);
-    };
+Method<Profile>::Method(typename P::In const& in, typename P::Out const& out)
+    : recorder_(Recorder::active_recorder_) {
+  if (recorder_ != nullptr) {
+    Write([&in](not_null<typename Profile::Message*> const message) {
+            Profile::Fill(in, message);
+          },
+          &Recorder::WriteAtConstruction);
+    out_.emplace(out);
   }
 }
 
 template<typename Profile>
 Method<Profile>::~Method() {
   CHECK(returned_);
-  if (Recorder::active_recorder_ != nullptr) {
-    serialization::Method method;
-    auto* const extension =
-        method.MutableExtension(Profile::Message::extension);
-    if (out_filler_ != nullptr) {
-      out_filler_(extension);
-    }
-    if (return_filler_ != nullptr) {
-      return_filler_(extension);
-    }
-    Recorder::active_recorder_->WriteAtDestruction(method);
+  if (recorder_ != nullptr) {
+    Write([this](not_null<typename Profile::Message*> const message) {
+            if constexpr (has_out<Profile>::value) {
+              Profile::Fill(*out_, message);
+            }
+            if constexpr (has_return<Profile>::value) {
+              Profile::Fill(*result_, message);
+            }
+          },
+          &Recorder::WriteAtDestruction);
   }
 }
 
@@ -94,15 +86,27 @@ typename P::Return Method<Profile>::Return(
     typename P::Return const& result) {
   CHECK(!returned_);
   returned_ = true;
-  if (Recorder::active_recorder_ != nullptr) {
-    return_filler_ =
-        [result](not_null<typename Profile::Message*> const message) {
-          Profile::Fill(result, message);
-        };
+  if (recorder_ != nullptr) {
+    result_.emplace(result);
   }
   return result;
 }
 
+template<typename Profile>
+template<typename Fill>
+void Method<Profile>::Write(
+    Fill const& fill,
+    void (Recorder::*const write)(serialization::Method const& method)) {
+  alignas(std::max_align_t) char initial_block[arena_initial_block_size];
+  ArenaOptions options;
+  options.initial_block = initial_block;
+  options.initial_block_size = sizeof(initial_block);
+  Arena arena(options);
+  auto* const method = Arena::CreateMessage<serialization::Method>(&arena);
+  fill(method->MutableExtension(Profile::Message::extension));
+  (recorder_->*write)(*method);
+}
+
 }  // namespace internal_method
 }  // namespace journal
 }  // namespace principia
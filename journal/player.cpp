@@ -44,14 +44,18 @@ bool Player::Play(int const index) {
                                  << method_out_return->ShortDebugString();
 #endif
 
-  auto const before = std::chrono::system_clock::now();
+  last_method_name_ = nullptr;
+  auto const before = std::chrono::steady_clock::now();
 
 #include "journal/player.generated.cc"
 
-  auto const after = std::chrono::system_clock::now();
+  auto const after = std::chrono::steady_clock::now();
   if (after - before > std::chrono::milliseconds(100)) {
     LOG(ERROR) << "Long method:\n" << method_in->DebugString();
   }
+  if (last_method_name_ != nullptr) {
+    durations_[*last_method_name_].push_back(after - before);
+  }
 
   last_method_in_.swap(method_in);
   last_method_out_return_.swap(method_out_return);
@@ -67,6 +71,10 @@ serialization::Method const& Player::last_method_out_return() const {
   return *last_method_out_return_;
 }
 
+ReplayStatistics Player::statistics() const {
+  return ComputeReplayStatistics(durations_);
+}
+
 std::unique_ptr<serialization::Method> Player::Read() {
   std::string const line = GetLine(stream_);
   if (line.empty()) {
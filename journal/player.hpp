@@ -1,11 +1,15 @@
 ﻿
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "journal/replay_statistics.hpp"
 #include "serialization/journal.pb.h"
 
 namespace principia {
@@ -25,6 +29,9 @@ class Player final {
   serialization::Method const& last_method_in() const;
   serialization::Method const& last_method_out_return() const;
 
+  // Returns the timing statistics of the methods replayed so far.
+  ReplayStatistics statistics() const;
+
  private:
   // Reads one message from the stream.  Returns a |nullptr| at end of stream.
   std::unique_ptr<serialization::Method> Read();
@@ -39,6 +46,11 @@ class Player final {
   std::unique_ptr<serialization::Method> last_method_in_;
   std::unique_ptr<serialization::Method> last_method_out_return_;
 
+  // The name of the last method run by |RunIfAppropriate|, and the durations
+  // of all the replayed methods, indexed by name.
+  std::string const* last_method_name_ = nullptr;
+  std::map<std::string, std::vector<std::chrono::nanoseconds>> durations_;
+
   friend class PlayerTest;
   friend class RecorderTest;
 };
@@ -22,6 +22,7 @@ bool Player::RunIfAppropriate(serialization::Method const& method_in,
     merged_method.MergeFrom(method_out_return);
     Profile::Run(merged_method.GetExtension(Profile::Message::extension),
                  pointer_map_);
+    last_method_name_ = &Profile::Message::descriptor()->name();
     return true;
   }
   return false;
@@ -1,22 +1,30 @@
 ﻿
 #include "journal/player.hpp"
 
+#include <fstream>
 #include <list>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "benchmark/benchmark.h"
 #include "glog/logging.h"
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "journal/method.hpp"
 #include "journal/profiles.hpp"
 #include "journal/recorder.hpp"
+#include "journal/replay_statistics.hpp"
 #include "ksp_plugin/interface.hpp"
 #include "serialization/journal.pb.h"
 
 namespace principia {
 namespace journal {
 
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using namespace std::chrono_literals;
+
 void BM_PlayForReal(benchmark::State& state) {
   while (state.KeepRunning()) {
     Player player(
@@ -80,10 +88,127 @@ TEST_F(PlayerTest, PlayTiny) {
   EXPECT_EQ(2, count);
 }
 
+TEST_F(PlayerTest, Statistics) {
+  {
+    Recorder* const r(new Recorder(test_name_ + ".journal.hex"));
+    Recorder::Activate(r);
+
+    {
+      Method<NewPlugin> m({"MJD1", "MJD2", 3});
+      m.Return(plugin_.get());
+    }
+    for (int i = 0; i < 3; ++i) {
+      interface::principia__GetVerboseLogging();
+    }
+    {
+      const ksp_plugin::Plugin* plugin = plugin_.get();
+      Method<DeletePlugin> m({&plugin}, {&plugin});
+      m.Return();
+    }
+    Recorder::Deactivate();
+  }
+
+  Player player(test_name_ + ".journal.hex");
+  int count = 0;
+  while (player.Play(count)) {
+    ++count;
+  }
+  EXPECT_EQ(5, count);
+
+  ReplayStatistics const statistics = player.statistics();
+  EXPECT_EQ(3, statistics.size());
+  EXPECT_EQ(1, statistics.at("NewPlugin").count);
+  EXPECT_EQ(3, statistics.at("GetVerboseLogging").count);
+  EXPECT_EQ(1, statistics.at("DeletePlugin").count);
+  for (auto const& [method, method_statistics] : statistics) {
+    EXPECT_LE(method_statistics.p50, method_statistics.p99) << method;
+    EXPECT_LE(method_statistics.p99, method_statistics.total) << method;
+  }
+}
+
+TEST_F(PlayerTest, ReplayStatistics) {
+  ReplayStatistics const baseline = ComputeReplayStatistics(
+      {{"AdvanceTime", {4ns, 1ns, 3ns, 2ns}},
+       {"FlightPlanCreate", {10ns}}});
+  EXPECT_EQ(4, baseline.at("AdvanceTime").count);
+  EXPECT_EQ(10ns, baseline.at("AdvanceTime").total);
+  EXPECT_EQ(2ns, baseline.at("AdvanceTime").p50);
+  EXPECT_EQ(4ns, baseline.at("AdvanceTime").p99);
+  EXPECT_EQ(10ns, baseline.at("FlightPlanCreate").p50);
+
+  std::stringstream report;
+  WriteReplayStatistics(baseline, report);
+  EXPECT_EQ("method,count,total_ns,p50_ns,p99_ns\n"
+            "AdvanceTime,4,10,2,4\n"
+            "FlightPlanCreate,1,10,10,10\n",
+            report.str());
+  ReplayStatistics const read = ReadReplayStatistics(report);
+  EXPECT_EQ(2, read.size());
+  EXPECT_EQ(2ns, read.at("AdvanceTime").p50);
+  EXPECT_EQ(10ns, read.at("FlightPlanCreate").total);
+
+  std::stringstream comparison;
+  EXPECT_THAT(
+      CompareReplayStatistics(baseline, read, 0.1, 1, comparison), IsEmpty());
+
+  ReplayStatistics candidate = baseline;
+  candidate["AdvanceTime"].p99 = 5ns;
+  candidate["FlightPlanCreate"].p50 = 20ns;
+  EXPECT_THAT(
+      CompareReplayStatistics(baseline, candidate, 0.1, 1, comparison),
+      ElementsAre("AdvanceTime", "FlightPlanCreate"));
+  // Too few calls to FlightPlanCreate for its timings to be meaningful.
+  EXPECT_THAT(
+      CompareReplayStatistics(baseline, candidate, 0.1, 2, comparison),
+      ElementsAre("AdvanceTime"));
+}
+
 TEST_F(PlayerTest, DISABLED_SECULAR_Benchmarks) {
   benchmark::RunSpecifiedBenchmarks();
 }
 
+// Replays a journal from a real game session and writes the timing statistics
+// of each method type to a CSV file next to the journal.  Run it with the
+// builds to compare, and compare the reports with the test below.
+TEST_F(PlayerTest, DISABLED_SECULAR_Replay) {
+  std::filesystem::path const path =
+      R"(P:\Public Mockingbird\Principia\Journals\JOURNAL.20180311-192733)";
+  Player player(path);
+  int count = 0;
+  while (player.Play(count)) {
+    ++count;
+    LOG_IF(ERROR, (count % 100'000) == 0)
+        << count << " journal entries replayed";
+  }
+  LOG(ERROR) << count << " journal entries in total";
+
+  std::filesystem::path report_path = path;
+  report_path += ".replay.csv";
+  std::ofstream report(report_path);
+  CHECK(report.good()) << report_path;
+  WriteReplayStatistics(player.statistics(), report);
+}
+
+// Compares the reports produced by two replays of the same journal and fails if
+// any method type has regressed by more than 10%.
+TEST_F(PlayerTest, DISABLED_SECULAR_CompareReplays) {
+  std::ifstream baseline_report(
+      R"(P:\Public Mockingbird\Principia\Journals\baseline.replay.csv)");
+  std::ifstream candidate_report(
+      R"(P:\Public Mockingbird\Principia\Journals\candidate.replay.csv)");
+  CHECK(baseline_report.good());
+  CHECK(candidate_report.good());
+  std::stringstream comparison;
+  auto const regressions =
+      CompareReplayStatistics(ReadReplayStatistics(baseline_report),
+                              ReadReplayStatistics(candidate_report),
+                              /*tolerance=*/0.1,
+                              /*min_count=*/100,
+                              comparison);
+  LOG(ERROR) << "Replay comparison:\n" << comparison.str();
+  EXPECT_THAT(regressions, IsEmpty());
+}
+
 TEST_F(PlayerTest, DISABLED_SECULAR_Debug) {
   // An example of how journaling may be used for debugging.  You must set
   // |path| and fill the |method_in| and |method_out_return| protocol buffers.
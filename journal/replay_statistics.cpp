@@ -0,0 +1,134 @@
+﻿
+#include "journal/replay_statistics.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace journal {
+
+namespace {
+
+constexpr char header[] = "method,count,total_ns,p50_ns,p99_ns";
+
+// Returns the element of rank ⌈percentile n / 100⌉ of |durations|, which is
+// partially reordered.
+std::chrono::nanoseconds Percentile(
+    std::vector<std::chrono::nanoseconds>& durations,
+    int const percentile) {
+  std::int64_t const n = durations.size();
+  std::int64_t const rank = std::max<std::int64_t>(
+      (percentile * n + 99) / 100, 1);
+  auto const nth = durations.begin() + (rank - 1);
+  std::nth_element(durations.begin(), nth, durations.end());
+  return *nth;
+}
+
+double Ratio(std::chrono::nanoseconds const candidate,
+             std::chrono::nanoseconds const baseline) {
+  return static_cast<double>(candidate.count()) /
+         std::max<std::chrono::nanoseconds::rep>(baseline.count(), 1);
+}
+
+}  // namespace
+
+ReplayStatistics ComputeReplayStatistics(
+    std::map<std::string, std::vector<std::chrono::nanoseconds>> durations) {
+  ReplayStatistics statistics;
+  for (auto& [method, method_durations] : durations) {
+    if (method_durations.empty()) {
+      continue;
+    }
+    MethodStatistics& method_statistics = statistics[method];
+    method_statistics.count = method_durations.size();
+    method_statistics.total = std::accumulate(method_durations.begin(),
+                                              method_durations.end(),
+                                              std::chrono::nanoseconds{});
+    method_statistics.p50 = Percentile(method_durations, 50);
+    method_statistics.p99 = Percentile(method_durations, 99);
+  }
+  return statistics;
+}
+
+void WriteReplayStatistics(ReplayStatistics const& statistics,
+                           std::ostream& out) {
+  out << header << "\n";
+  for (auto const& [method, method_statistics] : statistics) {
+    out << method << ","
+        << method_statistics.count << ","
+        << method_statistics.total.count() << ","
+        << method_statistics.p50.count() << ","
+        << method_statistics.p99.count() << "\n";
+  }
+}
+
+ReplayStatistics ReadReplayStatistics(std::istream& in) {
+  std::string line;
+  CHECK(std::getline(in, line)) << "Empty replay statistics";
+  CHECK_EQ(header, line);
+  ReplayStatistics statistics;
+  while (std::getline(in, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string method;
+    std::string field;
+    std::vector<std::int64_t> values;
+    CHECK(std::getline(fields, method, ',')) << line;
+    while (std::getline(fields, field, ',')) {
+      values.push_back(std::stoll(field));
+    }
+    CHECK_EQ(4, values.size()) << line;
+    MethodStatistics& method_statistics = statistics[method];
+    method_statistics.count = values[0];
+    method_statistics.total = std::chrono::nanoseconds(values[1]);
+    method_statistics.p50 = std::chrono::nanoseconds(values[2]);
+    method_statistics.p99 = std::chrono::nanoseconds(values[3]);
+  }
+  return statistics;
+}
+
+std::vector<std::string> CompareReplayStatistics(
+    ReplayStatistics const& baseline,
+    ReplayStatistics const& candidate,
+    double const tolerance,
+    std::int64_t const min_count,
+    std::ostream& out) {
+  std::vector<std::string> regressions;
+  out << "method,baseline_count,candidate_count,p50_ratio,p99_ratio,"
+      << "regression\n";
+  for (auto const& [method, baseline_statistics] : baseline) {
+    auto const it = candidate.find(method);
+    if (it == candidate.end()) {
+      continue;
+    }
+    MethodStatistics const& candidate_statistics = it->second;
+    double const p50_ratio =
+        Ratio(candidate_statistics.p50, baseline_statistics.p50);
+    double const p99_ratio =
+        Ratio(candidate_statistics.p99, baseline_statistics.p99);
+    bool const regressed =
+        baseline_statistics.count >= min_count &&
+        (p50_ratio > 1 + tolerance || p99_ratio > 1 + tolerance);
+    if (regressed) {
+      regressions.push_back(method);
+    }
+    out << method << ","
+        << baseline_statistics.count << ","
+        << candidate_statistics.count << ","
+        << std::fixed << std::setprecision(3)
+        << p50_ratio << ","
+        << p99_ratio << ","
+        << (regressed ? "yes" : "no") << "\n";
+  }
+  return regressions;
+}
+
+}  // namespace journal
+}  // namespace principia
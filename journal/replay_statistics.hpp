@@ -0,0 +1,53 @@
+﻿
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace principia {
+namespace journal {
+
+// Timing statistics for the replay of all the methods of a given type.
+struct MethodStatistics final {
+  std::int64_t count = 0;
+  std::chrono::nanoseconds total{};
+  std::chrono::nanoseconds p50{};
+  std::chrono::nanoseconds p99{};
+};
+
+// The statistics of a replay, indexed by the name of the extension of
+// |serialization::Method|, e.g., "AdvanceTime" or "FlightPlanCreate".
+using ReplayStatistics = std::map<std::string, MethodStatistics>;
+
+// Computes the statistics from the durations of the individual replays.  The
+// percentiles use the nearest-rank method.
+ReplayStatistics ComputeReplayStatistics(
+    std::map<std::string, std::vector<std::chrono::nanoseconds>> durations);
+
+// Writes and reads the statistics as CSV, with one line per method type and
+// all durations in nanoseconds.  This is the format of the report produced by
+// a replay, suitable for consumption by spreadsheets and scripts.
+void WriteReplayStatistics(ReplayStatistics const& statistics,
+                           std::ostream& out);
+ReplayStatistics ReadReplayStatistics(std::istream& in);
+
+// Compares the statistics of two builds replaying the same journal and writes
+// to |out| the ratios candidate/baseline of the p50 and p99 of each method type
+// present in both.  Returns the names of the methods whose p50 or p99 exceeds
+// that of the baseline by more than the fraction |tolerance|.  Method types
+// with fewer than |min_count| calls in the baseline are reported but never
+// considered as regressions, as their percentiles are mostly noise.
+std::vector<std::string> CompareReplayStatistics(
+    ReplayStatistics const& baseline,
+    ReplayStatistics const& candidate,
+    double tolerance,
+    std::int64_t min_count,
+    std::ostream& out);
+
+}  // namespace journal
+}  // namespace principia
@@ -220,6 +220,13 @@ Status FlightPlan::SetAdaptiveStepParameters(
   return RecomputeAllSegments();
 }
 
+Status FlightPlan::SetCoastPararealParameters(
+    std::optional<Ephemeris<Barycentric>::PararealParameters> const&
+        coast_parareal_parameters) {
+  coast_parareal_parameters_ = coast_parareal_parameters;
+  return RecomputeAllSegments();
+}
+
 Ephemeris<Barycentric>::AdaptiveStepParameters const&
 FlightPlan::adaptive_step_parameters() const {
   return adaptive_step_parameters_;
@@ -383,6 +390,15 @@ Status FlightPlan::BurnSegment(
 Status FlightPlan::CoastSegment(
     Instant const& desired_final_time,
     not_null<DiscreteTrajectory<Barycentric>*> const segment) {
+  if (coast_parareal_parameters_.has_value()) {
+    return ephemeris_->FlowWithParareal(
+                           segment,
+                           Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+                           desired_final_time,
+                           adaptive_step_parameters_,
+                           max_ephemeris_steps_per_frame,
+                           *coast_parareal_parameters_);
+  }
   return ephemeris_->FlowWithAdaptiveStep(
                          segment,
                          Ephemeris<Barycentric>::NoIntrinsicAcceleration,
@@ -1,6 +1,7 @@
 ﻿
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "base/not_null.hpp"
@@ -110,6 +111,13 @@ class FlightPlan {
       Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters const&
           generalized_adaptive_step_parameters);
 
+  // Sets the parameters used to compute the coasts in parallel, or clears them
+  // to compute the coasts sequentially, and recomputes all the trajectories.
+  // These parameters are not serialized.  Returns the integration status.
+  virtual Status SetCoastPararealParameters(
+      std::optional<Ephemeris<Barycentric>::PararealParameters> const&
+          coast_parareal_parameters);
+
   virtual Ephemeris<Barycentric>::AdaptiveStepParameters const&
   adaptive_step_parameters() const;
   virtual Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters const&
@@ -212,6 +220,8 @@ class FlightPlan {
   Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters_;
   Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters
       generalized_adaptive_step_parameters_;
+  std::optional<Ephemeris<Barycentric>::PararealParameters>
+      coast_parareal_parameters_;
 };
 
 }  // namespace internal_flight_plan
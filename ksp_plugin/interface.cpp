@@ -1,6 +1,7 @@
 ﻿
 #include "ksp_plugin/interface.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <cmath>
 #include <cstring>
@@ -11,6 +12,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #if OS_WIN
@@ -26,6 +28,7 @@
 #include "base/fingerprint2011.hpp"
 #include "base/hexadecimal.hpp"
 #include "base/macros.hpp"
+#include "base/multi_codec_compressor.hpp"
 #include "base/not_null.hpp"
 #include "base/optional_logging.hpp"
 #include "base/pull_serializer.hpp"
@@ -56,10 +59,12 @@ using astronomy::ParseTT;
 using base::Array;
 using base::Base64Encoder;
 using base::check_not_null;
+using base::Codec;
 using base::Encoder;
 using base::Fingerprint2011;
 using base::HexadecimalEncoder;
 using base::make_not_null_unique;
+using base::MultiCodecCompressor;
 using base::PullSerializer;
 using base::PushDeserializer;
 using base::SerializeAsBytes;
@@ -108,6 +113,11 @@ using ::google::protobuf::ArenaOptions;
 namespace {
 
 constexpr char gipfeli_compressor[] = "gipfeli";
+// These compressors tag each chunk with its codec, so they can read each
+// other's output.  They are thread-safe, so the chunks are compressed in
+// parallel.
+constexpr char lz4_compressor[] = "lz4";
+constexpr char zstd_compressor[] = "zstd";
 
 constexpr char base64_encoder[] = "base64";
 constexpr char hexadecimal_encoder[] = "hexadecimal";
@@ -262,11 +272,23 @@ std::unique_ptr<google::compression::Compressor> NewCompressor(
     return nullptr;
   } else if (compressor == gipfeli_compressor) {
     return google::compression::NewGipfeliCompressor();
+  } else if (compressor == lz4_compressor) {
+    return std::make_unique<MultiCodecCompressor>(Codec::LZ4);
+  } else if (compressor == zstd_compressor) {
+    return std::make_unique<MultiCodecCompressor>(Codec::Zstd);
   } else {
     LOG(FATAL) << "Unknown compressor " << compressor;
   }
 }
 
+int CompressionThreads(std::string_view const compressor) {
+  if (compressor == lz4_compressor || compressor == zstd_compressor) {
+    return std::max(1u, std::thread::hardware_concurrency());
+  } else {
+    return 1;
+  }
+}
+
 Encoder<char, /*null_terminated=*/true>*
 NewEncoder(std::string_view const encoder) {
   if (encoder == hexadecimal_encoder) {
@@ -470,13 +492,18 @@ void principia__DeserializePlugin(
     *deserializer = new PushDeserializer(chunk_size,
                                          number_of_chunks,
                                          NewCompressor(compressor));
-    not_null<serialization::Plugin*> const message =
-        Arena::CreateMessage<serialization::Plugin>(arena);
-    (*deserializer)->Start(
-        message,
-        [plugin](google::protobuf::Message const& message) {
-          *plugin = Plugin::ReadFromMessage(
-              static_cast<serialization::Plugin const&>(message)).release();
+    // The top-level fields are converted as they are parsed, and the arena is
+    // reset once the reader no longer needs them, so the entire message never
+    // resides in memory (except for saves in the old field order).
+    auto const reader = std::make_shared<Plugin::StreamingReader>();
+    (*deserializer)->StartStreaming(
+        &serialization::Plugin::default_instance(),
+        arena,
+        [reader](google::protobuf::Message const& field) {
+          return reader->Read(static_cast<serialization::Plugin const&>(field));
+        },
+        [plugin, reader]() {
+          *plugin = reader->Finish().release();
         });
   }
 
@@ -962,11 +989,12 @@ char const* principia__SerializePlugin(
     LOG(INFO) << "Begin plugin serialization";
     *serializer = new PullSerializer(chunk_size,
                                      number_of_chunks,
-                                     NewCompressor(compressor));
+                                     NewCompressor(compressor),
+                                     CompressionThreads(compressor));
     not_null<serialization::Plugin*> const message =
         Arena::CreateMessage<serialization::Plugin>(arena);
     plugin->WriteToMessage(message);
-    (*serializer)->Start(message);
+    (*serializer)->Start(message, Plugin::StreamingFieldOrder());
   }
 
   // Pull a chunk.
@@ -5,23 +5,39 @@
 #include <vector>
 
 #include "physics/body_centred_non_rotating_dynamic_frame.hpp"
-#include "physics/discrete_trajectory.hpp"
+#include "quantities/si.hpp"
 
 namespace principia {
 namespace ksp_plugin {
 namespace internal_orbit_analyser {
 
-using geometry::Frame;
-using physics::DiscreteTrajectory;
+using base::make_not_null_unique;
 using physics::MasslessBody;
 using physics::BodyCentredNonRotatingDynamicFrame;
 using quantities::IsFinite;
+using quantities::Length;
+using quantities::Speed;
+using quantities::si::Metre;
+using quantities::si::Milli;
+using quantities::si::Second;
+
+// A request may reuse the trajectory of the previous analysis if its initial
+// degrees of freedom are within these tolerances of that trajectory.  They are
+// far below anything that would be visible in the analysis, but large enough
+// to accommodate the drift between the vessel's history and the analysed
+// trajectory over a few frames.
+constexpr Length reuse_position_tolerance = 1 * Metre;
+constexpr Speed reuse_velocity_tolerance = 1 * Milli(Metre) / Second;
 
 OrbitAnalyser::OrbitAnalyser(not_null<Ephemeris<Barycentric>*> const ephemeris,
                              Ephemeris<Barycentric>::FixedStepParameters const&
                                  analysed_trajectory_parameters)
     : ephemeris_(ephemeris),
-      analysed_trajectory_parameters_(analysed_trajectory_parameters) {}
+      analysed_trajectory_parameters_(analysed_trajectory_parameters),
+      analysed_trajectory_(
+          make_not_null_unique<DiscreteTrajectory<Barycentric>>()),
+      primary_centred_trajectory_(
+          make_not_null_unique<DiscreteTrajectory<PrimaryCentred>>()) {}
 
 OrbitAnalyser::~OrbitAnalyser() {
   if (analyser_.joinable()) {
@@ -87,56 +103,103 @@ void OrbitAnalyser::RepeatedlyAnalyseOrbit() {
       std::swap(parameters, parameters_);
     }
 
-    Analysis analysis{parameters->first_time,
-                      parameters->primary};
-    DiscreteTrajectory<Barycentric> trajectory;
-    trajectory.Append(parameters->first_time,
-                      parameters->first_degrees_of_freedom);
+    auto const start_of_analysis = std::chrono::steady_clock::now();
+    Instant const& first_time = parameters->first_time;
+    Instant const last_time = first_time + parameters->mission_duration;
+
+    Analysis analysis{first_time, parameters->primary};
+    BodyCentredNonRotatingDynamicFrame<Barycentric, PrimaryCentred>
+        primary_centred(ephemeris_, parameters->primary);
+
+    auto trajectory = make_not_null_unique<DiscreteTrajectory<Barycentric>>();
+    auto primary_centred_trajectory =
+        make_not_null_unique<DiscreteTrajectory<PrimaryCentred>>();
+    trajectory->Append(first_time, parameters->first_degrees_of_freedom);
+    primary_centred_trajectory->Append(
+        first_time,
+        primary_centred.ToThisFrameAtTime(first_time)(
+            parameters->first_degrees_of_freedom));
+
+    // If the request starts on the previously analysed trajectory, copy the
+    // part of it that lies within the new mission, both in |Barycentric| and
+    // in |PrimaryCentred|; the two trajectories have the same times.
+    bool const reuse = CanReuseAnalysedTrajectory(*parameters);
+    if (reuse) {
+      auto primary_centred_it =
+          primary_centred_trajectory_->LowerBound(first_time);
+      for (auto it = analysed_trajectory_->LowerBound(first_time);
+           it != analysed_trajectory_->end() && it->time <= last_time;
+           ++it, ++primary_centred_it) {
+        if (it->time == first_time) {
+          continue;
+        }
+        trajectory->Append(it->time, it->degrees_of_freedom);
+        primary_centred_trajectory->Append(
+            primary_centred_it->time, primary_centred_it->degrees_of_freedom);
+      }
+    }
+    analysis.reused_duration_ = trajectory->back().time - first_time;
+    progress_of_next_analysis_ =
+        analysis.reused_duration_ / parameters->mission_duration;
+
     std::vector<not_null<DiscreteTrajectory<Barycentric>*>> trajectories = {
-        &trajectory};
+        trajectory.get()};
     auto instance = ephemeris_->NewInstance(
         trajectories,
         Ephemeris<Barycentric>::NoIntrinsicAccelerations,
         analysed_trajectory_parameters_);
-    for (Instant t =
-             parameters->first_time + parameters->mission_duration / 0x1p10;
-         trajectory.back().time <
-         parameters->first_time + parameters->mission_duration;
+    for (Instant t = first_time + parameters->mission_duration / 0x1p10;
+         trajectory->back().time < last_time;
          t += parameters->mission_duration / 0x1p10) {
+      if (t <= trajectory->back().time) {
+        // This part of the mission was reused.
+        continue;
+      }
       if (!ephemeris_->FlowWithFixedStep(t, *instance).ok()) {
         break;
       }
       progress_of_next_analysis_ =
-          (trajectory.back().time - parameters->first_time) /
+          (trajectory->back().time - first_time) /
           parameters->mission_duration;
       if (!keep_analysing_) {
         return;
       }
     }
-    analysis.mission_duration_ =
-        trajectory.back().time - parameters->first_time;
+    analysis.mission_duration_ = trajectory->back().time - first_time;
 
     // TODO(egg): |next_analysis_percentage_| only reflects the progress of the
     // integration, but the analysis itself can take a while; this results in
     // the progress bar being stuck at 100% while the elements and nodes are
     // being computed.
 
-    enum class PrimaryCentredTag { tag };
-    using PrimaryCentred = Frame<PrimaryCentredTag,
-                                 PrimaryCentredTag::tag,
-                                 /*frame_is_inertial=*/false>;
-    BodyCentredNonRotatingDynamicFrame<Barycentric, PrimaryCentred>
-        primary_centred(ephemeris_, parameters->primary);
-    DiscreteTrajectory<PrimaryCentred> primary_centred_trajectory;
-    for (auto const& [time, degrees_of_freedom] : trajectory) {
-      primary_centred_trajectory.Append(
+    // Only the points that were just integrated need to be transformed.
+    for (auto it = trajectory->LowerBound(
+             primary_centred_trajectory->back().time);
+         it != trajectory->end();
+         ++it) {
+      auto const& [time, degrees_of_freedom] = *it;
+      if (time == primary_centred_trajectory->back().time) {
+        continue;
+      }
+      primary_centred_trajectory->Append(
           time, primary_centred.ToThisFrameAtTime(time)(degrees_of_freedom));
     }
 
-    auto const elements = OrbitalElements::ForTrajectory(
-        primary_centred_trajectory, *parameters->primary, MasslessBody{});
+    // The osculating elements of the reused part of the trajectory need not be
+    // recomputed.
+    auto const elements =
+        reuse && analysed_elements_.has_value()
+            ? OrbitalElements::ForTrajectory(*primary_centred_trajectory,
+                                             *parameters->primary,
+                                             MasslessBody{},
+                                             *analysed_elements_)
+            : OrbitalElements::ForTrajectory(*primary_centred_trajectory,
+                                             *parameters->primary,
+                                             MasslessBody{});
+    analysed_elements_.reset();
     if (elements.ok()) {
       analysis.elements_ = elements.ValueOrDie();
+      analysed_elements_ = analysis.elements_;
       // TODO(egg): max_abs_Cᴛₒ should probably depend on the number of
       // revolutions.
       analysis.closest_recurrence_ = OrbitRecurrence::ClosestRecurrence(
@@ -145,11 +208,16 @@ void OrbitAnalyser::RepeatedlyAnalyseOrbit() {
           *parameters->primary,
           /*max_abs_Cᴛₒ=*/100);
       analysis.ground_track_ =
-          OrbitGroundTrack::ForTrajectory(primary_centred_trajectory,
+          OrbitGroundTrack::ForTrajectory(*primary_centred_trajectory,
                                           *parameters->primary,
                                           /*mean_sun=*/std::nullopt);
       analysis.ResetRecurrence();
     }
+    analysis.latency_ = std::chrono::steady_clock::now() - start_of_analysis;
+
+    analysed_trajectory_ = std::move(trajectory);
+    primary_centred_trajectory_ = std::move(primary_centred_trajectory);
+    analysed_primary_ = parameters->primary;
 
     {
       absl::MutexLock l(&lock_);
@@ -160,6 +228,24 @@ void OrbitAnalyser::RepeatedlyAnalyseOrbit() {
   }
 }
 
+bool OrbitAnalyser::CanReuseAnalysedTrajectory(
+    Parameters const& parameters) const {
+  if (analysed_primary_ != parameters.primary ||
+      analysed_trajectory_->Empty() ||
+      parameters.first_time < analysed_trajectory_->front().time ||
+      parameters.first_time > analysed_trajectory_->back().time) {
+    return false;
+  }
+  DegreesOfFreedom<Barycentric> const analysed_degrees_of_freedom =
+      analysed_trajectory_->EvaluateDegreesOfFreedom(parameters.first_time);
+  return (analysed_degrees_of_freedom.position() -
+          parameters.first_degrees_of_freedom.position()).Norm() <=
+             reuse_position_tolerance &&
+         (analysed_degrees_of_freedom.velocity() -
+          parameters.first_degrees_of_freedom.velocity()).Norm() <=
+             reuse_velocity_tolerance;
+}
+
 Instant const& OrbitAnalyser::Analysis::first_time() const {
   return first_time_;
 }
@@ -192,6 +278,15 @@ OrbitAnalyser::Analysis::equatorial_crossings() const {
   return equatorial_crossings_;
 }
 
+Time const& OrbitAnalyser::Analysis::reused_duration() const {
+  return reused_duration_;
+}
+
+std::chrono::steady_clock::duration const& OrbitAnalyser::Analysis::latency()
+    const {
+  return latency_;
+}
+
 void OrbitAnalyser::Analysis::SetRecurrence(
     OrbitRecurrence const& recurrence) {
   if (recurrence_ != recurrence) {
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <memory>
 #include <optional>
 #include <thread>
 
@@ -9,9 +11,11 @@
 #include "astronomy/orbit_recurrence.hpp"
 #include "astronomy/orbital_elements.hpp"
 #include "base/not_null.hpp"
+#include "geometry/frame.hpp"
 #include "geometry/named_quantities.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/rotating_body.hpp"
 #include "quantities/named_quantities.hpp"
@@ -24,15 +28,18 @@ using astronomy::OrbitalElements;
 using astronomy::OrbitGroundTrack;
 using astronomy::OrbitRecurrence;
 using base::not_null;
+using geometry::Frame;
 using geometry::Instant;
 using physics::DegreesOfFreedom;
+using physics::DiscreteTrajectory;
 using physics::Ephemeris;
 using physics::RotatingBody;
 using quantities::Time;
 
 // The |OrbitAnalyser| asynchronously integrates a trajectory, and computes
 // orbital elements, recurrence, and ground track properties of the resulting
-// orbit.
+// orbit.  When a request starts on the trajectory integrated for the previous
+// analysis, that trajectory is reused and only its tail is integrated.
 class OrbitAnalyser {
  public:
   // The analysis stores the computed orbital characteristics.  It is publicly
@@ -59,6 +66,14 @@ class OrbitAnalyser {
     std::optional<OrbitGroundTrack::EquatorCrossingLongitudes> const&
     equatorial_crossings() const;
 
+    // The part of |mission_duration()| over which the trajectory of the
+    // previous analysis was reused instead of being integrated anew; zero if
+    // this analysis was computed from scratch.
+    Time const& reused_duration() const;
+    // The wall-clock time elapsed between the moment the analyser picked up
+    // the request for this analysis and the moment the analysis was complete.
+    std::chrono::steady_clock::duration const& latency() const;
+
     // Sets |recurrence|, updating |equatorial_crossings| if needed.
     void SetRecurrence(OrbitRecurrence const& recurrence);
     // Resets |recurrence| to a value deduced from |*elements| by
@@ -79,6 +94,8 @@ class OrbitAnalyser {
     std::optional<OrbitGroundTrack> ground_track_;
     std::optional<OrbitGroundTrack::EquatorCrossingLongitudes>
         equatorial_crossings_;
+    Time reused_duration_;
+    std::chrono::steady_clock::duration latency_{};
 
     friend class OrbitAnalyser;
   };
@@ -116,8 +133,20 @@ class OrbitAnalyser {
     not_null<RotatingBody<Barycentric> const*> primary;
   };
 
+  enum class PrimaryCentredTag { tag };
+  using PrimaryCentred = Frame<PrimaryCentredTag,
+                               PrimaryCentredTag::tag,
+                               /*frame_is_inertial=*/false>;
+
   void RepeatedlyAnalyseOrbit();
 
+  // Returns true if |parameters| describe an orbit that starts on
+  // |analysed_trajectory_|, within the tolerances given in the implementation,
+  // and around the same primary, so that the points of |analysed_trajectory_|
+  // and |primary_centred_trajectory_| after |parameters.first_time| may be
+  // reused.  Must only be called on the |analyser_| thread.
+  bool CanReuseAnalysedTrajectory(Parameters const& parameters) const;
+
   not_null<Ephemeris<Barycentric>*> const ephemeris_;
   Ephemeris<Barycentric>::FixedStepParameters const
       analysed_trajectory_parameters_;
@@ -139,6 +168,18 @@ class OrbitAnalyser {
   // aborts if it is false; it is set at construction, and cleared by the main
   // thread at destruction.
   std::atomic_bool keep_analysing_ = true;
+
+  // The following members are only accessed by the |analyser_| thread.  They
+  // hold the trajectory integrated for the last analysis, in |Barycentric| and
+  // in the frame centred on |analysed_primary_|, as well as its orbital
+  // elements if they could be computed, so that subsequent requests can reuse
+  // them.
+  not_null<std::unique_ptr<DiscreteTrajectory<Barycentric>>>
+      analysed_trajectory_;
+  not_null<std::unique_ptr<DiscreteTrajectory<PrimaryCentred>>>
+      primary_centred_trajectory_;
+  RotatingBody<Barycentric> const* analysed_primary_ = nullptr;
+  std::optional<OrbitalElements> analysed_elements_;
 };
 
 }  // namespace internal_orbit_analyser
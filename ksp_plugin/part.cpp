@@ -2,6 +2,7 @@
 #include "ksp_plugin/part.hpp"
 
 #include <list>
+#include <memory>
 #include <string>
 
 #include "base/array.hpp"
@@ -28,6 +29,7 @@ Part::Part(
       mass_(mass),
       degrees_of_freedom_(degrees_of_freedom),
       prehistory_(make_not_null_unique<DiscreteTrajectory<Barycentric>>()),
+      segment_offset_(Displacement<Barycentric>(), Velocity<Barycentric>()),
       subset_node_(make_not_null_unique<Subset<Part>::Node>()),
       deletion_callback_(std::move(deletion_callback)) {
   CHECK_GT(mass_, Mass{}) << ShortDebugString();
@@ -80,16 +82,19 @@ Part::degrees_of_freedom() const {
 }
 
 DiscreteTrajectory<Barycentric>::Iterator Part::history_begin() {
+  CopySegment();
   // Make sure that we skip the point of the prehistory.
   auto it = history_->Fork();
   return ++it;
 }
 
 DiscreteTrajectory<Barycentric>::Iterator Part::history_end() {
+  CopySegment();
   return history_->end();
 }
 
 DiscreteTrajectory<Barycentric>::Iterator Part::psychohistory_begin() {
+  CopySegment();
   if (psychohistory_ == nullptr) {
     psychohistory_ = history_->NewForkAtLast();
   }
@@ -99,6 +104,7 @@ DiscreteTrajectory<Barycentric>::Iterator Part::psychohistory_begin() {
 }
 
 DiscreteTrajectory<Barycentric>::Iterator Part::psychohistory_end() {
+  CopySegment();
   if (psychohistory_ == nullptr) {
     psychohistory_ = history_->NewForkAtLast();
   }
@@ -108,6 +114,7 @@ DiscreteTrajectory<Barycentric>::Iterator Part::psychohistory_end() {
 void Part::AppendToHistory(
     Instant const& time,
     DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+  CopySegment();
   if (psychohistory_ != nullptr) {
     history_->DeleteFork(psychohistory_);
   }
@@ -117,13 +124,42 @@ void Part::AppendToHistory(
 void Part::AppendToPsychohistory(
     Instant const& time,
     DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+  CopySegment();
   if (psychohistory_ == nullptr) {
     psychohistory_ = history_->NewForkAtLast();
   }
   psychohistory_->Append(time, degrees_of_freedom);
 }
 
+void Part::AppendSegment(
+    not_null<std::shared_ptr<PileUp::Segment const>> const& segment,
+    RelativeDegreesOfFreedom<Barycentric> const& offset) {
+  CopySegment();
+  segment_ = segment;
+  segment_offset_ = offset;
+  // Skip the point of the prehistory and the fork of the psychohistory.
+  auto history_it = history_->Fork();
+  bool const history_is_empty = ++history_it == history_->end();
+  bool psychohistory_is_empty = true;
+  if (psychohistory_ != nullptr) {
+    auto psychohistory_it = psychohistory_->Fork();
+    psychohistory_is_empty = ++psychohistory_it == psychohistory_->end();
+  }
+  if (!history_is_empty || !psychohistory_is_empty) {
+    CopySegment();
+  }
+}
+
+PileUp::Segment const* Part::segment() const {
+  return segment_.get();
+}
+
+RelativeDegreesOfFreedom<Barycentric> const& Part::segment_offset() const {
+  return segment_offset_;
+}
+
 void Part::ClearHistory() {
+  segment_.reset();
   if (psychohistory_ != nullptr) {
     history_->DeleteFork(psychohistory_);
   }
@@ -157,6 +193,7 @@ void Part::reset_containing_pile_up() {
 void Part::WriteToMessage(not_null<serialization::Part*> const message,
                           PileUp::SerializationIndexForPileUp const&
                               serialization_index_for_pile_up) const {
+  CopySegment();
   message->set_part_id(part_id_);
   message->set_name(name_);
   mass_.WriteToMessage(message->mutable_mass());
@@ -225,6 +262,27 @@ std::string Part::ShortDebugString() const {
   return name_ + " (" + hex_id.data.get() + ")";
 }
 
+void Part::CopySegment() const {
+  if (segment_ == nullptr) {
+    return;
+  }
+  auto const segment = std::move(segment_);
+  // Same as |AppendToHistory| and |AppendToPsychohistory|, which are not
+  // |const|.
+  if (!segment->history.empty() && psychohistory_ != nullptr) {
+    history_->DeleteFork(psychohistory_);
+  }
+  for (auto const& [time, degrees_of_freedom] : segment->history) {
+    history_->Append(time, degrees_of_freedom + segment_offset_);
+  }
+  for (auto const& [time, degrees_of_freedom] : segment->psychohistory) {
+    if (psychohistory_ == nullptr) {
+      psychohistory_ = history_->NewForkAtLast();
+    }
+    psychohistory_->Append(time, degrees_of_freedom + segment_offset_);
+  }
+}
+
 std::ostream& operator<<(std::ostream& out, Part const& part) {
   return out << "{"
              << part.part_id() << ", "
@@ -25,12 +25,14 @@ namespace internal_part {
 
 using base::not_null;
 using base::Subset;
+using geometry::Displacement;
 using geometry::Instant;
 using geometry::Position;
 using geometry::Vector;
 using geometry::Velocity;
 using physics::DegreesOfFreedom;
 using physics::DiscreteTrajectory;
+using physics::RelativeDegreesOfFreedom;
 using quantities::Force;
 using quantities::Mass;
 
@@ -89,6 +91,21 @@ class Part final {
       Instant const& time,
       DegreesOfFreedom<Barycentric> const& degrees_of_freedom);
 
+  // Appends the points of the |segment|, offset by |offset|, to the history and
+  // psychohistory of this part, as |AppendToHistory| and
+  // |AppendToPsychohistory| would.  If the history and psychohistory of this
+  // part are empty, the points are not copied until they are accessed.
+  void AppendSegment(
+      not_null<std::shared_ptr<PileUp::Segment const>> const& segment,
+      RelativeDegreesOfFreedom<Barycentric> const& offset);
+
+  // If the history and psychohistory of this part are made of the points of a
+  // segment that have not been copied yet, returns that segment, otherwise
+  // returns null.  The points of the part are those of the segment offset by
+  // |segment_offset|.
+  PileUp::Segment const* segment() const;
+  RelativeDegreesOfFreedom<Barycentric> const& segment_offset() const;
+
   // Clears the history and psychohistory.
   void ClearHistory();
 
@@ -121,6 +138,11 @@ class Part final {
   std::string ShortDebugString() const;
 
  private:
+  // Copies the points of the |segment_|, if any, to the history and
+  // psychohistory.  This doesn't change the points of this part, so it may be
+  // called by the |const| functions that read them.
+  void CopySegment() const;
+
   PartId const part_id_;
   std::string const name_;
   Mass mass_;
@@ -143,7 +165,16 @@ class Part final {
   // The |psychohistory_| is destroyed by |AppendToHistory| and is recreated
   // as needed by |AppendToPsychohistory| or by |tail|.  That's because
   // |NewForkAtLast| is relatively expensive so we only call it when necessary.
-  DiscreteTrajectory<Barycentric>* psychohistory_ = nullptr;
+  // Mutable because it may be created by |CopySegment|.
+  mutable DiscreteTrajectory<Barycentric>* psychohistory_ = nullptr;
+
+  // The points of the history and psychohistory that have not been copied to
+  // the trajectories above, and their offset.  When |segment_| is not null the
+  // trajectories above are empty.  Mutable because the points are only copied
+  // when they are read, possibly by a |const| function such as
+  // |WriteToMessage|.
+  mutable std::shared_ptr<PileUp::Segment const> segment_;
+  RelativeDegreesOfFreedom<Barycentric> segment_offset_;
 
   // TODO(egg): we may want to keep track of the moment of inertia, angular
   // momentum, etc.
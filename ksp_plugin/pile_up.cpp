@@ -4,6 +4,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <memory>
 
 #include "base/map_util.hpp"
 #include "geometry/identity.hpp"
@@ -376,38 +377,40 @@ Status PileUp::AdvanceTime(Instant const& t) {
   CHECK_NOTNULL(psychohistory_);
 
   // Append the |history_| authoritatively to the parts' tails and the
-  // |psychohistory_| non-authoritatively.
+  // |psychohistory_| non-authoritatively.  The points are copied once into a
+  // segment shared by all the parts.
+  auto segment = std::make_shared<Segment>();
   auto const history_end = history_->end();
   auto const psychohistory_end = psychohistory_->end();
   auto it = history_last;
   for (++it; it != history_end; ++it) {
-    AppendToPart<&Part::AppendToHistory>(it);
+    segment->history.emplace_back(it->time, it->degrees_of_freedom);
   }
   it = psychohistory_->Fork();
   for (++it; it != psychohistory_end; ++it) {
-    AppendToPart<&Part::AppendToPsychohistory>(it);
+    segment->psychohistory.emplace_back(it->time, it->degrees_of_freedom);
   }
+  AppendToParts(std::move(segment));
   history_->ForgetBefore(psychohistory_->Fork()->time);
 
   return status;
 }
 
-template<PileUp::AppendToPartTrajectory append_to_part_trajectory>
-void PileUp::AppendToPart(DiscreteTrajectory<Barycentric>::Iterator it) const {
-  auto const& pile_up_dof = it->degrees_of_freedom;
-  RigidMotion<Barycentric, RigidPileUp> const barycentric_to_pile_up(
-      RigidTransformation<Barycentric, RigidPileUp>(
-          pile_up_dof.position(),
-          RigidPileUp::origin,
-          Identity<Barycentric, RigidPileUp>().Forget()),
-      AngularVelocity<Barycentric>{},
-      pile_up_dof.velocity());
-  auto const pile_up_to_barycentric = barycentric_to_pile_up.Inverse();
+void PileUp::AppendToParts(
+    not_null<std::shared_ptr<Segment const>> const& segment) const {
+  // The axes of |RigidPileUp| are those of |Barycentric| and it doesn't
+  // rotate, so the offset of a part is its degrees of freedom in the pile-up.
+  Identity<RigidPileUp, Barycentric> const pile_up_to_barycentric;
   for (not_null<Part*> const part : parts_) {
-    (static_cast<Part*>(part)->*append_to_part_trajectory)(
-        it->time,
-        pile_up_to_barycentric(
-            FindOrDie(actual_part_degrees_of_freedom_, part)));
+    auto const& actual_part_degrees_of_freedom =
+        FindOrDie(actual_part_degrees_of_freedom_, part);
+    part->AppendSegment(
+        segment,
+        RelativeDegreesOfFreedom<Barycentric>(
+            pile_up_to_barycentric(actual_part_degrees_of_freedom.position() -
+                                   RigidPileUp::origin),
+            pile_up_to_barycentric(
+                actual_part_degrees_of_freedom.velocity())));
   }
 }
 
@@ -5,6 +5,9 @@
 #include <future>
 #include <list>
 #include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "absl/synchronization/mutex.h"
 #include "base/not_null.hpp"
@@ -64,6 +67,20 @@ class PileUp {
 
   std::list<not_null<Part*>> const& parts() const;
 
+  // The points computed by one call to |DeformAndAdvanceTime|.  During the
+  // call each part is at a fixed offset from the centre of mass of the
+  // pile-up, so the trajectory of a part is obtained by offsetting these
+  // points.  A segment is immutable and shared by all the parts of the pile-up,
+  // which only copy its points if they need trajectories of their own.
+  struct Segment {
+    using Points =
+        std::vector<std::pair<Instant, DegreesOfFreedom<Barycentric>>>;
+    // The points appended to the history of the pile-up.
+    Points history;
+    // The points of the psychohistory of the pile-up after its fork.
+    Points psychohistory;
+  };
+
   // Set the |degrees_of_freedom| for the given |part|.  These degrees of
   // freedom are *apparent* in the sense that they were reported by the game but
   // we know better since we are doing science.
@@ -94,11 +111,6 @@ class PileUp {
       std::function<void()> deletion_callback);
 
  private:
-  // A pointer to a member function of |Part| used to append a point to either
-  // trajectory (history or psychohistory).
-  using AppendToPartTrajectory =
-      void (Part::*)(Instant const&, DegreesOfFreedom<Barycentric> const&);
-
   // For deserialization.
   PileUp(std::list<not_null<Part*>>&& parts,
          Ephemeris<Barycentric>::AdaptiveStepParameters const&
@@ -133,8 +145,10 @@ class PileUp {
   // |DeformPileUpIfNeeded|.
   void NudgeParts() const;
 
-  template<AppendToPartTrajectory append_to_part_trajectory>
-  void AppendToPart(DiscreteTrajectory<Barycentric>::Iterator it) const;
+  // Appends the |segment| to the trajectories of all the parts, offset by
+  // their |RigidPileUp| degrees of freedom.
+  void AppendToParts(
+      not_null<std::shared_ptr<Segment const>> const& segment) const;
 
   // Wrapped in a |unique_ptr| to be moveable.
   not_null<std::unique_ptr<absl::Mutex>> lock_;
@@ -2,9 +2,11 @@
 #include "ksp_plugin/plugin.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <ios>
 #include <limits>
 #include <list>
@@ -55,6 +57,7 @@ namespace principia {
 namespace ksp_plugin {
 namespace internal_plugin {
 
+using astronomy::InfinitePast;
 using astronomy::KSPStabilizedSystemFingerprint;
 using astronomy::KSPStockSystemFingerprint;
 using astronomy::ParseTT;
@@ -88,6 +91,7 @@ using physics::BodySurfaceDynamicFrame;
 using physics::BodySurfaceFrameField;
 using physics::ComputeApsides;
 using physics::ComputeNodes;
+using physics::ContinuousTrajectory;
 using physics::CoordinateFrameField;
 using physics::DynamicFrame;
 using physics::Frenet;
@@ -101,6 +105,7 @@ using quantities::Length;
 using quantities::si::Kilogram;
 using quantities::si::Milli;
 using quantities::si::Minute;
+using quantities::si::Nano;
 using quantities::si::Radian;
 using ::operator<<;
 
@@ -531,6 +536,9 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
       loaded_vessels_.erase(vessel);
       LOG(INFO) << "Removing vessel " << vessel->ShortDebugString();
       renderer_->ClearTargetVesselIf(vessel);
+      if (next_delta_omissions_.has_value()) {
+        next_delta_omissions_->vessel_history_t_maxes.erase(vessel->guid());
+      }
       it = vessels_.erase(it);
     }
   }
@@ -572,6 +580,9 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
       loaded_vessels_.erase(vessel);
       LOG(INFO) << "Removing grounded vessel " << vessel->ShortDebugString();
       renderer_->ClearTargetVesselIf(vessel);
+      if (next_delta_omissions_.has_value()) {
+        next_delta_omissions_->vessel_history_t_maxes.erase(vessel->guid());
+      }
       CHECK_EQ(vessels_.erase(vessel->guid()), 1);
     }
   }
@@ -1215,7 +1226,77 @@ Renderer const& Plugin::renderer() const {
 void Plugin::WriteToMessage(
     not_null<serialization::Plugin*> const message) const {
   LOG(INFO) << __FUNCTION__;
+  WriteToMessage(message, /*omissions=*/{});
+}
+
+void Plugin::WriteDeltaToMessage(
+    not_null<serialization::PluginDelta*> const message) {
+  LOG(INFO) << __FUNCTION__;
+  if (deltas_since_full_save_ >= deltas_between_full_saves) {
+    next_delta_omissions_.reset();
+  }
+  DeltaOmissions const omissions =
+      next_delta_omissions_.value_or(DeltaOmissions{});
+  next_delta_omissions_ = WriteToMessage(message->mutable_plugin(), omissions);
+  if (omissions.ephemeris_trajectory_t_maxes.empty()) {
+    deltas_since_full_save_ = 0;
+  } else {
+    ++deltas_since_full_save_;
+  }
+
+  for (int i = 0; i < omissions.ephemeris_trajectory_t_maxes.size(); ++i) {
+    auto* const omission = message->add_ephemeris_trajectory_omission();
+    omission->set_index(i);
+    omissions.ephemeris_trajectory_t_maxes[i].WriteToMessage(
+        omission->mutable_t_max());
+  }
+  for (auto const& [guid, t_max] : omissions.vessel_history_t_maxes) {
+    auto* const omission = message->add_vessel_history_omission();
+    omission->set_guid(guid);
+    // The psychohistory starts at the beginning of the history.
+    FindOrDie(vessels_, guid)->psychohistory().t_min().WriteToMessage(
+        omission->mutable_t_min());
+    t_max.WriteToMessage(omission->mutable_t_max());
+  }
+}
+
+void Plugin::ReplayDelta(not_null<serialization::PluginDelta*> const delta,
+                         not_null<serialization::Plugin*> const message) {
+  LOG(INFO) << __FUNCTION__;
+  not_null<serialization::Plugin*> const plugin = delta->mutable_plugin();
+  for (auto const& omission : delta->ephemeris_trajectory_omission()) {
+    CHECK_LT(omission.index(), message->ephemeris().trajectory_size());
+    ContinuousTrajectory<Barycentric>::RestoreOmissions(
+        message->mutable_ephemeris()->mutable_trajectory(omission.index()),
+        Instant::ReadFromMessage(omission.t_max()),
+        plugin->mutable_ephemeris()->mutable_trajectory(omission.index()));
+  }
+  if (delta->vessel_history_omission_size() > 0) {
+    std::map<std::string, not_null<serialization::Vessel*>> previous_vessels;
+    for (auto& vessel_message : *message->mutable_vessel()) {
+      previous_vessels.emplace(vessel_message.guid(),
+                               vessel_message.mutable_vessel());
+    }
+    std::map<std::string, not_null<serialization::Vessel*>> vessels;
+    for (auto& vessel_message : *plugin->mutable_vessel()) {
+      vessels.emplace(vessel_message.guid(), vessel_message.mutable_vessel());
+    }
+    for (auto const& omission : delta->vessel_history_omission()) {
+      DiscreteTrajectory<Barycentric>::RestoreOmissions(
+          FindOrDie(previous_vessels, omission.guid())->mutable_history(),
+          Instant::ReadFromMessage(omission.t_min()),
+          Instant::ReadFromMessage(omission.t_max()),
+          FindOrDie(vessels, omission.guid())->mutable_history());
+    }
+  }
+  message->Swap(plugin);
+}
+
+Plugin::DeltaOmissions Plugin::WriteToMessage(
+    not_null<serialization::Plugin*> const message,
+    DeltaOmissions const& omissions) const {
   CHECK(!initializing_);
+  DeltaOmissions next_omissions;
   ephemeris_->Prolong(current_time_);
   std::map<not_null<Celestial const*>, Index const> celestial_to_index;
   for (auto const& pair : celestials_) {
@@ -1253,8 +1334,14 @@ void Plugin::WriteToMessage(
     vessel_to_guid.emplace(vessel.get(), guid);
     auto* const vessel_message = message->add_vessel();
     vessel_message->set_guid(guid);
-    vessel->WriteToMessage(vessel_message->mutable_vessel(),
-                           serialization_index_for_pile_up);
+    auto const it = omissions.vessel_history_t_maxes.find(guid);
+    next_omissions.vessel_history_t_maxes.emplace(
+        guid,
+        vessel->WriteDeltaToMessage(
+            vessel_message->mutable_vessel(),
+            serialization_index_for_pile_up,
+            it == omissions.vessel_history_t_maxes.end() ? InfinitePast
+                                                         : it->second));
     Index const parent_index = FindOrDie(celestial_to_index, vessel->parent());
     vessel_message->set_parent_index(parent_index);
     vessel_message->set_loaded(Contains(loaded_vessels_, vessel.get()));
@@ -1266,7 +1353,9 @@ void Plugin::WriteToMessage(
     (*message->mutable_part_id_to_vessel())[part_id] = vessel_to_guid[vessel];
   }
 
-  ephemeris_->WriteToMessage(message->mutable_ephemeris());
+  next_omissions.ephemeris_trajectory_t_maxes =
+      ephemeris_->WriteDeltaToMessage(message->mutable_ephemeris(),
+                                      omissions.ephemeris_trajectory_t_maxes);
 
   history_parameters_.WriteToMessage(message->mutable_history_parameters());
   psychohistory_parameters_.WriteToMessage(
@@ -1282,12 +1371,200 @@ void Plugin::WriteToMessage(
   for (auto* const pile_up : pile_ups_) {
     pile_up->WriteToMessage(message->add_pile_up());
   }
+  return next_omissions;
 }
 
 not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
     serialization::Plugin const& message) {
   LOG(INFO) << __FUNCTION__;
+  auto const elapsed = [start = std::chrono::steady_clock::now()]() {
+    return std::chrono::nanoseconds(
+               std::chrono::steady_clock::now() - start).count() *
+           Nano(Second);
+  };
+
+  not_null<std::unique_ptr<Plugin>> plugin =
+      ReadParametersFromMessage(message);
+
+  // The reintegration from the checkpoint overlaps with the deserialization of
+  // the vessels.  The vessels that need the ephemeris wait in |Prolong|.
+  std::future<Status> prolongation =
+      plugin->ReadEphemerisFromMessage(message.ephemeris());
+  Time const ephemeris_deserialized = elapsed();
+
+  plugin->ReadCelestialsFromMessage(message);
+  plugin->ReadRendererFromMessage(message);
+  for (auto const& vessel_message : message.vessel()) {
+    plugin->ReadVesselFromMessage(vessel_message);
+  }
+  Time const vessels_deserialized = elapsed();
+
+  plugin->ReadPartIdToVesselFromMessage(message);
+  for (auto const& pile_up_message : message.pile_up()) {
+    plugin->ReadPileUpFromMessage(pile_up_message);
+  }
+  plugin->FillContainingPileUpsFromMessages(message.vessel());
+
+  Time const pile_ups_deserialized = elapsed();
+  CHECK_OK(prolongation.get());
+  Time const total = elapsed();
+  LOG(INFO) << "Plugin deserialized in " << total << ": ephemeris "
+            << ephemeris_deserialized << ", vessels "
+            << vessels_deserialized - ephemeris_deserialized
+            << ", pile-ups "
+            << pile_ups_deserialized - vessels_deserialized
+            << ", waiting for the reintegration "
+            << total - pile_ups_deserialized;
+
+  plugin->initializing_.Flop();
+  return plugin;
+}
 
+bool Plugin::StreamingReader::Read(serialization::Plugin const& field) {
+  std::vector<google::protobuf::FieldDescriptor const*> fields;
+  field.GetReflection()->ListFields(field, &fields);
+  CHECK_LE(fields.size(), 1);
+  if (fields.empty()) {
+    // Unknown fields are ignored, as they are by |ParseFromArray|.
+    return ephemeris_message_ == nullptr && vessel_messages_.empty() &&
+           pile_up_messages_.empty();
+  }
+
+  // Repeated fields are contiguous in the stream, so the celestials are
+  // complete as soon as another field is read after them.
+  int const field_number = fields.front()->number();
+  if (field_number != field_number_ &&
+      field_number_ == serialization::Plugin::kCelestialFieldNumber) {
+    celestials_complete_ = true;
+  }
+  field_number_ = field_number;
+
+  switch (field_number) {
+    case serialization::Plugin::kEphemerisFieldNumber:
+      CHECK(plugin_ == nullptr);
+      ephemeris_message_ = &field.ephemeris();
+      break;
+    case serialization::Plugin::kVesselFieldNumber:
+      CHECK(!part_id_to_vessel_read_);
+      vessel_messages_.push_back(&field.vessel(0));
+      break;
+    case serialization::Plugin::kPileUpFieldNumber:
+      pile_up_messages_.push_back(&field.pile_up(0));
+      break;
+    default:
+      CHECK(!celestials_read_ || field.celestial_size() == 0);
+      CHECK(!part_id_to_vessel_read_ || field.part_id_to_vessel().empty());
+      message_.MergeFrom(field);
+  }
+
+  Convert(/*finished=*/false);
+  return ephemeris_message_ == nullptr && vessel_messages_.empty() &&
+         pile_up_messages_.empty();
+}
+
+not_null<std::unique_ptr<Plugin>> Plugin::StreamingReader::Finish() {
+  Convert(/*finished=*/true);
+  CHECK(plugin_ != nullptr);
+  plugin_->ReadRendererFromMessage(message_);
+  plugin_->FillContainingPileUpsFromMessages(message_.vessel());
+  CHECK_OK(prolongation_.get());
+  plugin_->initializing_.Flop();
+  return std::move(plugin_);
+}
+
+void Plugin::StreamingReader::Convert(bool const finished) {
+  if (plugin_ == nullptr) {
+    bool const has_parameters = message_.has_history_parameters() &&
+                                message_.has_psychohistory_parameters() &&
+                                message_.has_game_epoch() &&
+                                message_.has_current_time() &&
+                                message_.has_planetarium_rotation();
+    if (ephemeris_message_ == nullptr || !(finished || has_parameters)) {
+      return;
+    }
+    plugin_ = ReadParametersFromMessage(message_);
+    prolongation_ = plugin_->ReadEphemerisFromMessage(*ephemeris_message_);
+    ephemeris_message_ = nullptr;
+  }
+
+  if (!celestials_read_) {
+    if (!(finished || celestials_complete_)) {
+      return;
+    }
+    plugin_->ReadCelestialsFromMessage(message_);
+    celestials_read_ = true;
+  }
+
+  for (auto const* const vessel_message : vessel_messages_) {
+    plugin_->ReadVesselFromMessage(*vessel_message);
+
+    // Only retain what |FillContainingPileUpsFromMessages| needs.
+    auto* const retained_message = message_.add_vessel();
+    retained_message->set_guid(vessel_message->guid());
+    for (auto const& part_message : vessel_message->vessel().parts()) {
+      auto* const retained_part_message =
+          retained_message->mutable_vessel()->add_parts();
+      retained_part_message->set_part_id(part_message.part_id());
+      if (part_message.has_containing_pile_up()) {
+        retained_part_message->set_containing_pile_up(
+            part_message.containing_pile_up());
+      }
+    }
+  }
+  vessel_messages_.clear();
+
+  // The vessels and the parts-to-vessels map precede the pile-ups in both the
+  // streaming order and the field number order.
+  if (!(finished || !pile_up_messages_.empty())) {
+    return;
+  }
+  if (!part_id_to_vessel_read_) {
+    plugin_->ReadPartIdToVesselFromMessage(message_);
+    part_id_to_vessel_read_ = true;
+  }
+  for (auto const* const pile_up_message : pile_up_messages_) {
+    plugin_->ReadPileUpFromMessage(*pile_up_message);
+  }
+  pile_up_messages_.clear();
+}
+
+std::vector<int> Plugin::StreamingFieldOrder() {
+  // The vessels, the parts-to-vessels map, and the pile-ups come last, in that
+  // order, since they depend on all the other fields.
+  return {serialization::Plugin::kHistoryParametersFieldNumber,
+          serialization::Plugin::kPsychohistoryParametersFieldNumber,
+          serialization::Plugin::kGameEpochFieldNumber,
+          serialization::Plugin::kCurrentTimeFieldNumber,
+          serialization::Plugin::kPlanetariumRotationFieldNumber,
+          serialization::Plugin::kSunIndexFieldNumber,
+          serialization::Plugin::kEphemerisFieldNumber,
+          serialization::Plugin::kCelestialFieldNumber,
+          serialization::Plugin::kPreCauchyPlottingFrameFieldNumber,
+          serialization::Plugin::kRendererFieldNumber};
+}
+
+Plugin::Plugin(
+    Ephemeris<Barycentric>::FixedStepParameters const& history_parameters,
+    Ephemeris<Barycentric>::AdaptiveStepParameters const&
+        psychohistory_parameters)
+    : history_parameters_(history_parameters),
+      psychohistory_parameters_(psychohistory_parameters),
+      vessel_thread_pool_(
+          /*pool_size=*/2 * std::thread::hardware_concurrency()) {}
+
+void Plugin::InitializeIndices(std::string const& name,
+                               Index const celestial_index,
+                               std::optional<Index> const& parent_index) {
+  bool inserted = name_to_index_.emplace(name, celestial_index).second;
+  CHECK(inserted) << name;
+  inserted = index_to_name_.emplace(celestial_index, name).second;
+  CHECK(inserted) << celestial_index;
+  inserted = parents_.emplace(celestial_index, parent_index).second;
+  CHECK(inserted) << celestial_index;
+}
+
+not_null<std::unique_ptr<Plugin>> Plugin::ReadParametersFromMessage(
+    serialization::Plugin const& message) {
   auto const history_parameters =
       Ephemeris<Barycentric>::FixedStepParameters::ReadFromMessage(
           message.history_parameters());
@@ -1302,97 +1579,121 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
   plugin->current_time_ = Instant::ReadFromMessage(message.current_time());
   plugin->planetarium_rotation_ =
       Angle::ReadFromMessage(message.planetarium_rotation());
+  return plugin;
+}
 
+std::future<Status> Plugin::ReadEphemerisFromMessage(
+    serialization::Ephemeris const& message) {
   // The ephemeris constructed here is *not* prolonged and needs to be
   // explicitly prolonged to cover all the instants that we care about.
-  plugin->ephemeris_ =
-      Ephemeris<Barycentric>::ReadFromMessage(message.ephemeris());
-  plugin->ephemeris_->Prolong(plugin->game_epoch_);
-  plugin->ephemeris_->Prolong(plugin->current_time_);
+  ephemeris_ = Ephemeris<Barycentric>::ReadFromMessage(message);
+  return vessel_thread_pool_.Add(
+      [ephemeris = ephemeris_.get(),
+       game_epoch = game_epoch_,
+       current_time = current_time_]() {
+        auto const start = std::chrono::steady_clock::now();
+        ephemeris->Prolong(game_epoch);
+        ephemeris->Prolong(current_time);
+        LOG(INFO) << "Ephemeris reintegrated in "
+                  << std::chrono::nanoseconds(
+                         std::chrono::steady_clock::now() - start).count() *
+                         Nano(Second);
+        return Status::OK;
+      });
+}
 
-  ReadCelestialsFromMessages(*plugin->ephemeris_,
+void Plugin::ReadCelestialsFromMessage(serialization::Plugin const& message) {
+  ReadCelestialsFromMessages(*ephemeris_,
                              message.celestial(),
-                             plugin->celestials_,
-                             plugin->name_to_index_);
+                             celestials_,
+                             name_to_index_);
 
-  for (auto const& vessel_message : message.vessel()) {
-    not_null<Celestial const*> const parent =
-        FindOrDie(plugin->celestials_, vessel_message.parent_index()).get();
-    not_null<std::unique_ptr<Vessel>> vessel = Vessel::ReadFromMessage(
-        vessel_message.vessel(),
-        parent,
-        plugin->ephemeris_.get(),
-        [&part_id_to_vessel = plugin->part_id_to_vessel_](
-            PartId const part_id) {
-          CHECK_NE(part_id_to_vessel.erase(part_id), 0) << part_id;
-        });
-
-    if (vessel_message.loaded()) {
-      plugin->loaded_vessels_.insert(vessel.get());
-    }
-    if (vessel_message.kept()) {
-      plugin->kept_vessels_.insert(vessel.get());
-    }
-    bool const inserted = plugin->vessels_.emplace(
-        vessel_message.guid(), std::move(vessel)).second;
-    CHECK(inserted);
-  }
-
-  for (auto const& pair : message.part_id_to_vessel()) {
-    PartId const part_id = pair.first;
-    GUID const guid = pair.second;
-    auto const& vessel = FindOrDie(plugin->vessels_, guid);
-    plugin->part_id_to_vessel_.emplace(part_id, vessel.get());
-  }
-
-  plugin->sun_ = FindOrDie(plugin->celestials_, message.sun_index()).get();
-  plugin->main_body_ = plugin->sun_->body();
-  plugin->UpdatePlanetariumRotation();
+  sun_ = FindOrDie(celestials_, message.sun_index()).get();
+  main_body_ = sun_->body();
+  UpdatePlanetariumRotation();
+}
 
+void Plugin::ReadRendererFromMessage(serialization::Plugin const& message) {
   bool const is_pre_cauchy = message.has_pre_cauchy_plotting_frame();
   if (is_pre_cauchy) {
-    plugin->renderer_ =
+    renderer_ =
         std::make_unique<Renderer>(
-            plugin->sun_,
+            sun_,
             NavigationFrame::ReadFromMessage(
                 message.pre_cauchy_plotting_frame(),
-                plugin->ephemeris_.get()));
+                ephemeris_.get()));
   } else {
-    plugin->renderer_ = Renderer::ReadFromMessage(message.renderer(),
-                                                  plugin->sun_,
-                                                  plugin->ephemeris_.get());
+    renderer_ = Renderer::ReadFromMessage(message.renderer(),
+                                          sun_,
+                                          ephemeris_.get());
   }
+}
 
+void Plugin::ReadVesselFromMessage(
+    serialization::Plugin::VesselAndProperties const& message) {
+  not_null<Celestial const*> const parent =
+      FindOrDie(celestials_, message.parent_index()).get();
+  not_null<std::unique_ptr<Vessel>> vessel = Vessel::ReadFromMessage(
+      message.vessel(),
+      parent,
+      ephemeris_.get(),
+      [&part_id_to_vessel = part_id_to_vessel_](PartId const part_id) {
+        CHECK_NE(part_id_to_vessel.erase(part_id), 0) << part_id;
+      });
+
+  if (message.loaded()) {
+    loaded_vessels_.insert(vessel.get());
+  }
+  if (message.kept()) {
+    kept_vessels_.insert(vessel.get());
+  }
+  bool const inserted = vessels_.emplace(
+      message.guid(), std::move(vessel)).second;
+  CHECK(inserted);
+}
+
+void Plugin::ReadPartIdToVesselFromMessage(
+    serialization::Plugin const& message) {
+  for (auto const& pair : message.part_id_to_vessel()) {
+    PartId const part_id = pair.first;
+    GUID const guid = pair.second;
+    auto const& vessel = FindOrDie(vessels_, guid);
+    part_id_to_vessel_.emplace(part_id, vessel.get());
+  }
+}
+
+void Plugin::ReadPileUpFromMessage(serialization::PileUp const& message) {
   // Note that for proper deserialization of parts this list must be
   // reconstructed in its original order.
   auto const part_id_to_part =
-      [&part_id_to_vessel =
-            plugin->part_id_to_vessel_](PartId const part_id) {
+      [&part_id_to_vessel = part_id_to_vessel_](PartId const part_id) {
         not_null<Vessel*> const vessel = part_id_to_vessel.at(part_id);
         not_null<Part*> const part = vessel->part(part_id);
         return part;
       };
-  for (auto const& pile_up_message : message.pile_up()) {
-    // First push a nullptr to be able to capture an iterator to the new
-    // location in the list in the deletion callback.
-    plugin->pile_ups_.push_back(nullptr);
-    auto deletion_callback = [it = std::prev(plugin->pile_ups_.end()),
-                              &pile_ups = plugin->pile_ups_]() {
-      pile_ups.erase(it);
-    };
-    auto const pile_up = PileUp::ReadFromMessage(pile_up_message,
-                                                 part_id_to_part,
-                                                 plugin->ephemeris_.get(),
-                                                 std::move(deletion_callback))
-                             .release();
-    *plugin->pile_ups_.rbegin() = pile_up;
-  }
+  // First push a nullptr to be able to capture an iterator to the new location
+  // in the list in the deletion callback.
+  pile_ups_.push_back(nullptr);
+  auto deletion_callback = [it = std::prev(pile_ups_.end()),
+                            &pile_ups = pile_ups_]() {
+    pile_ups.erase(it);
+  };
+  auto const pile_up = PileUp::ReadFromMessage(message,
+                                               part_id_to_part,
+                                               ephemeris_.get(),
+                                               std::move(deletion_callback))
+                           .release();
+  *pile_ups_.rbegin() = pile_up;
+}
 
+void Plugin::FillContainingPileUpsFromMessages(
+    google::protobuf::RepeatedPtrField<
+        serialization::Plugin::VesselAndProperties> const& messages) {
   // Now fill the containing pile-up of all the parts.  This gives ownership of
   // the pile-ups to the parts.  To do that, we first build shared pointers for
   // all the pile-ups.
   std::vector<not_null<std::shared_ptr<PileUp>>> shared_pile_ups;
-  for (auto* const pile_up : plugin->pile_ups_) {
+  for (auto* const pile_up : pile_ups_) {
     shared_pile_ups.emplace_back(check_not_null(pile_up));
   }
   auto const pile_up_for_serialization_index =
@@ -1400,35 +1701,12 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
     return shared_pile_ups.at(serialization_index);
   };
 
-  for (auto const& vessel_message : message.vessel()) {
+  for (auto const& vessel_message : messages) {
     GUID const guid = vessel_message.guid();
-    auto const& vessel = FindOrDie(plugin->vessels_, guid);
+    auto const& vessel = FindOrDie(vessels_, guid);
     vessel->FillContainingPileUpsFromMessage(vessel_message.vessel(),
                                              pile_up_for_serialization_index);
   }
-
-  plugin->initializing_.Flop();
-  return plugin;
-}
-
-Plugin::Plugin(
-    Ephemeris<Barycentric>::FixedStepParameters const& history_parameters,
-    Ephemeris<Barycentric>::AdaptiveStepParameters const&
-        psychohistory_parameters)
-    : history_parameters_(history_parameters),
-      psychohistory_parameters_(psychohistory_parameters),
-      vessel_thread_pool_(
-          /*pool_size=*/2 * std::thread::hardware_concurrency()) {}
-
-void Plugin::InitializeIndices(std::string const& name,
-                               Index const celestial_index,
-                               std::optional<Index> const& parent_index) {
-  bool inserted = name_to_index_.emplace(name, celestial_index).second;
-  CHECK(inserted) << name;
-  inserted = index_to_name_.emplace(celestial_index, name).second;
-  CHECK(inserted) << celestial_index;
-  inserted = parents_.emplace(celestial_index, parent_index).second;
-  CHECK(inserted) << celestial_index;
 }
 
 void Plugin::UpdatePlanetariumRotation() {
@@ -424,6 +424,78 @@ class Plugin {
   static not_null<std::unique_ptr<Plugin>> ReadFromMessage(
       serialization::Plugin const& message);
 
+  // Reads a plugin from the top-level fields of a |serialization::Plugin|,
+  // passed one at a time as they are parsed from a stream (one element at a
+  // time for repeated fields).  The ephemeris, the vessels and the pile-ups are
+  // converted to live objects as soon as the fields they depend upon have been
+  // read; until then, the reader retains a pointer to the field.  If the stream
+  // starts with the fields listed by |StreamingFieldOrder|, in that order,
+  // nothing is ever retained, so the messages may be discarded as soon as they
+  // have been read and the serialized plugin is never held in memory in its
+  // entirety.  Older saves, which are in field number order, are read without
+  // copying the large fields.
+  class StreamingReader final {
+   public:
+    // |field| must have at most one top-level field set.  Returns true if none
+    // of the fields passed so far are retained by this object, i.e., if they
+    // may be destroyed.
+    bool Read(serialization::Plugin const& field);
+
+    // Must be called once, after all the fields have been read.
+    not_null<std::unique_ptr<Plugin>> Finish();
+
+   private:
+    // Converts the retained fields whose dependencies have been read.  If
+    // |finished| is true, all the fields have been read.
+    void Convert(bool finished);
+
+    // The small fields.  The vessels only contain what is needed to fill the
+    // containing pile-ups of the parts.
+    serialization::Plugin message_;
+    // The number of the last field read.
+    int field_number_ = 0;
+    bool celestials_complete_ = false;
+
+    // The retained fields.
+    serialization::Ephemeris const* ephemeris_message_ = nullptr;
+    std::vector<serialization::Plugin::VesselAndProperties const*>
+        vessel_messages_;
+    std::vector<serialization::PileUp const*> pile_up_messages_;
+
+    // Not null once the ephemeris has been converted.
+    std::unique_ptr<Plugin> plugin_;
+    std::future<Status> prolongation_;
+    bool celestials_read_ = false;
+    bool part_id_to_vessel_read_ = false;
+  };
+
+  // The numbers of the fields of |serialization::Plugin| that must come first,
+  // in that order, for a |StreamingReader| to convert the ephemeris, the
+  // vessels and the pile-ups as soon as they are read.  This is what
+  // |principia__SerializePlugin| passes to |PullSerializer::Start|.
+  static std::vector<int> StreamingFieldOrder();
+
+  // Writes an incremental save to |message|.  The first call, and the first
+  // call after |deltas_between_full_saves| deltas, write a full save.  The
+  // other calls write a delta, which omits the parts of the trajectories that
+  // were written by the previous call and haven't changed since: the
+  // polynomials of the ephemeris up to its checkpoint and the points of the
+  // vessel histories that are no longer subject to downsampling.  Must be
+  // called after initialization.
+  virtual void WriteDeltaToMessage(
+      not_null<serialization::PluginDelta*> message);
+  // Replays a |delta| written by |WriteDeltaToMessage| on |message|, which must
+  // be the result of replaying all the deltas since the last full save.  On
+  // return |message| is what |WriteToMessage| would have written when |delta|
+  // was written, and may be passed to |ReadFromMessage|.  |delta| is left in
+  // an unspecified state.
+  static void ReplayDelta(not_null<serialization::PluginDelta*> delta,
+                          not_null<serialization::Plugin*> message);
+
+  // The number of deltas written by |WriteDeltaToMessage| between two full
+  // saves.  This bounds the number of deltas to replay when reading.
+  static constexpr int deltas_between_full_saves = 15;
+
  private:
   using GUIDToOwnedVessel = std::map<GUID, not_null<std::unique_ptr<Vessel>>>;
   using IndexToOwnedCelestial =
@@ -431,6 +503,15 @@ class Plugin {
   using NewtonianMotionEquation =
       Ephemeris<Barycentric>::NewtonianMotionEquation;
 
+  // The parts of the trajectories that a delta may omit because they were
+  // written by the previous call to |WriteDeltaToMessage|.
+  struct DeltaOmissions {
+    // Indexed like the trajectories of the serialized ephemeris; empty if
+    // nothing is omitted.
+    std::vector<Instant> ephemeris_trajectory_t_maxes;
+    std::map<GUID, Instant> vessel_history_t_maxes;
+  };
+
   // This constructor should only be used during deserialization.
   Plugin(Ephemeris<Barycentric>::FixedStepParameters const& history_parameters,
          Ephemeris<Barycentric>::AdaptiveStepParameters const&
@@ -441,6 +522,29 @@ class Plugin {
       Index celestial_index,
       std::optional<Index> const& parent_index);
 
+  // The steps of |ReadFromMessage|, also used by |StreamingReader|.  The first
+  // one constructs the plugin using the parameters and times in |message|.
+  // |ReadEphemerisFromMessage| starts the reintegration of the ephemeris in
+  // the background and returns its future.  Must be called in this order.
+  static not_null<std::unique_ptr<Plugin>> ReadParametersFromMessage(
+      serialization::Plugin const& message);
+  std::future<Status> ReadEphemerisFromMessage(
+      serialization::Ephemeris const& message);
+  void ReadCelestialsFromMessage(serialization::Plugin const& message);
+  void ReadRendererFromMessage(serialization::Plugin const& message);
+  void ReadVesselFromMessage(
+      serialization::Plugin::VesselAndProperties const& message);
+  void ReadPartIdToVesselFromMessage(serialization::Plugin const& message);
+  void ReadPileUpFromMessage(serialization::PileUp const& message);
+  void FillContainingPileUpsFromMessages(
+      google::protobuf::RepeatedPtrField<
+          serialization::Plugin::VesselAndProperties> const& messages);
+
+  // Implementation of |WriteToMessage| and |WriteDeltaToMessage|.  Returns the
+  // |omissions| to use for the next delta.
+  DeltaOmissions WriteToMessage(not_null<serialization::Plugin*> message,
+                                DeltaOmissions const& omissions) const;
+
   // Computes the value returned by |PlanetariumRotation|.  Must be called
   // whenever |main_body_| or |planetarium_rotation_| changes.
   void UpdatePlanetariumRotation();
@@ -526,6 +630,14 @@ class Plugin {
   // The vessels that will be kept during the next call to |AdvanceTime|.
   VesselConstSet kept_vessels_;
 
+  // What the next call to |WriteDeltaToMessage| may omit; absent if it must
+  // write a full save.  A vessel is removed from the omissions when it is
+  // destroyed, as a new vessel with the same GUID would have a different
+  // history.
+  std::optional<DeltaOmissions> next_delta_omissions_;
+  // The number of deltas written since the last full save.
+  int deltas_since_full_save_ = 0;
+
   friend class NavballFrameField;
   friend class TestablePlugin;
 };
@@ -19,12 +19,14 @@ namespace ksp_plugin {
 namespace internal_vessel {
 
 using astronomy::InfiniteFuture;
+using astronomy::InfinitePast;
 using base::Contains;
 using base::Error;
 using base::FindOrDie;
 using base::make_not_null_unique;
 using geometry::BarycentreCalculator;
 using geometry::Position;
+using geometry::Velocity;
 using quantities::IsFinite;
 using quantities::Length;
 using quantities::Time;
@@ -181,6 +183,10 @@ void Vessel::DisableDownsampling() {
   history_->ClearDownsampling();
 }
 
+void Vessel::set_history_compression_age(Time const& age) {
+  history_compression_age_ = age;
+}
+
 not_null<Part*> Vessel::part(PartId const id) const {
   return FindOrDie(parts_, id).get();
 }
@@ -235,13 +241,37 @@ void Vessel::AdvanceTime() {
   auto prediction = prediction_->DetachFork();
 
   history_->DeleteFork(psychohistory_);
-  AppendToVesselTrajectory(&Part::history_begin,
-                           &Part::history_end,
-                           *history_);
-  psychohistory_ = history_->NewForkAtLast();
-  AppendToVesselTrajectory(&Part::psychohistory_begin,
-                           &Part::psychohistory_end,
-                           *psychohistory_);
+  if (PileUp::Segment const* const segment = SharedSegment();
+      segment == nullptr) {
+    AppendToVesselTrajectory(&Part::history_begin,
+                             &Part::history_end,
+                             *history_);
+    psychohistory_ = history_->NewForkAtLast();
+    AppendToVesselTrajectory(&Part::psychohistory_begin,
+                             &Part::psychohistory_end,
+                             *psychohistory_);
+  } else {
+    // The parts move rigidly with the pile-up, so the centre of mass of the
+    // vessel is at a fixed offset from the points of the segment.
+    BarycentreCalculator<DegreesOfFreedom<Barycentric>, Mass> calculator;
+    DegreesOfFreedom<Barycentric> const origin(Barycentric::origin,
+                                               Velocity<Barycentric>());
+    for (auto const& [_, part] : parts_) {
+      calculator.Add(origin + part->segment_offset(), part->mass());
+    }
+    auto const offset = calculator.Get() - origin;
+    for (auto const& [time, degrees_of_freedom] : segment->history) {
+      history_->Append(time, degrees_of_freedom + offset);
+    }
+    psychohistory_ = history_->NewForkAtLast();
+    for (auto const& [time, degrees_of_freedom] : segment->psychohistory) {
+      psychohistory_->Append(time, degrees_of_freedom + offset);
+    }
+  }
+  if (history_compression_age_.has_value()) {
+    history_->CompressBefore(history_->back().time -
+                             *history_compression_age_);
+  }
   {
     absl::MutexLock l(&prognosticator_lock_);
     if (prognostication_ == nullptr) {
@@ -335,6 +365,15 @@ std::string Vessel::ShortDebugString() const {
 void Vessel::WriteToMessage(not_null<serialization::Vessel*> const message,
                             PileUp::SerializationIndexForPileUp const&
                                 serialization_index_for_pile_up) const {
+  WriteDeltaToMessage(message,
+                      serialization_index_for_pile_up,
+                      /*history_omitted_t_max=*/InfinitePast);
+}
+
+Instant Vessel::WriteDeltaToMessage(
+    not_null<serialization::Vessel*> const message,
+    PileUp::SerializationIndexForPileUp const& serialization_index_for_pile_up,
+    Instant const& history_omitted_t_max) const {
   message->set_guid(guid_);
   message->set_name(name_);
   body_.WriteToMessage(message->mutable_body());
@@ -347,11 +386,13 @@ void Vessel::WriteToMessage(not_null<serialization::Vessel*> const message,
     CHECK(Contains(parts_, part_id));
     message->add_kept_parts(part_id);
   }
-  history_->WriteToMessage(message->mutable_history(),
-                           /*forks=*/{psychohistory_, prediction_});
+  history_->WriteDeltaToMessage(message->mutable_history(),
+                                /*forks=*/{psychohistory_, prediction_},
+                                history_omitted_t_max);
   if (flight_plan_ != nullptr) {
     flight_plan_->WriteToMessage(message->mutable_flight_plan());
   }
+  return history_->settled_t_max();
 }
 
 not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
@@ -572,6 +613,17 @@ void Vessel::SwapPrognostication(
   }
 }
 
+PileUp::Segment const* Vessel::SharedSegment() const {
+  CHECK(!parts_.empty());
+  PileUp::Segment const* const segment = parts_.begin()->second->segment();
+  for (auto const& [_, part] : parts_) {
+    if (part->segment() != segment) {
+      return nullptr;
+    }
+  }
+  return segment;
+}
+
 void Vessel::AppendToVesselTrajectory(
     TrajectoryIterator const part_trajectory_begin,
     TrajectoryIterator const part_trajectory_end,
@@ -4,6 +4,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -107,6 +108,14 @@ class Vessel {
   // trouble.
   virtual void DisableDownsampling();
 
+  // From now on, the points of the history that are older than |age|, relative
+  // to the last point of the history, are moved by |AdvanceTime| to the
+  // compressed timeline of the history, see
+  // |DiscreteTrajectory::CompressBefore|.  They are no longer part of the
+  // |psychohistory()| but they are still serialized.  By default the history is
+  // not compressed.
+  virtual void set_history_compression_age(Time const& age);
+
   // Returns the part with the given ID.  Such a part must have been added using
   // |AddPart|.
   virtual not_null<Part*> part(PartId id) const;
@@ -166,6 +175,14 @@ class Vessel {
   virtual void WriteToMessage(not_null<serialization::Vessel*> message,
                               PileUp::SerializationIndexForPileUp const&
                                   serialization_index_for_pile_up) const;
+  // Same as |WriteToMessage|, but the points of the history at or before
+  // |history_omitted_t_max| are not written.  Returns the
+  // |history_omitted_t_max| to use for the next delta.
+  virtual Instant WriteDeltaToMessage(
+      not_null<serialization::Vessel*> message,
+      PileUp::SerializationIndexForPileUp const&
+          serialization_index_for_pile_up,
+      Instant const& history_omitted_t_max) const;
   static not_null<std::unique_ptr<Vessel>> ReadFromMessage(
       serialization::Vessel const& message,
       not_null<Celestial const*> parent,
@@ -228,6 +245,10 @@ class Vessel {
                                 TrajectoryIterator part_trajectory_end,
                                 DiscreteTrajectory<Barycentric>& trajectory);
 
+  // If the history and psychohistory of all the parts are made of the points
+  // of the same segment, returns that segment.  Otherwise returns null.
+  PileUp::Segment const* SharedSegment() const;
+
   // Attaches the given |trajectory| to the end of the |psychohistory_| to
   // become the new |prediction_|.
   void AttachPrediction(
@@ -258,6 +279,7 @@ class Vessel {
   // See the comments in pile_up.hpp for an explanation of the terminology.
   not_null<std::unique_ptr<DiscreteTrajectory<Barycentric>>> history_;
   DiscreteTrajectory<Barycentric>* psychohistory_ = nullptr;
+  std::optional<Time> history_compression_age_;
 
   // The |prediction_| is forked off the end of the |psychohistory_|.
   DiscreteTrajectory<Barycentric>* prediction_ = nullptr;
@@ -1,36 +1,88 @@
 
 #include "ksp_plugin/plugin.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
+#if OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
 
+#include "astronomy/epoch.hpp"
+#include "base/hexadecimal.hpp"
+#include "base/macros.hpp"
+#include "base/pull_serializer.hpp"
 #include "base/push_deserializer.hpp"
 #include "base/serialization.hpp"
 #include "benchmark/benchmark.h"
+#include "gipfeli/gipfeli.h"
 #include "geometry/named_quantities.hpp"
 #include "gtest/gtest.h"
+#include "journal/recorder.hpp"
+#include "ksp_plugin/celestial.hpp"
+#include "ksp_plugin/integrators.hpp"
 #include "ksp_plugin/interface.hpp"
+#include "ksp_plugin/iterators.hpp"
+#include "ksp_plugin/part.hpp"
+#include "ksp_plugin/pile_up.hpp"
+#include "ksp_plugin/vessel.hpp"
+#include "physics/ephemeris.hpp"
+#include "physics/massive_body.hpp"
+#include "physics/rotating_body.hpp"
 #include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
 #include "serialization/ksp_plugin.pb.h"
 #include "testing_utilities/serialization.hpp"
 
 namespace principia {
 
+using base::Array;
+using base::dynamic_cast_not_null;
+using base::HexadecimalEncoder;
+using base::make_not_null_shared;
+using base::make_not_null_unique;
 using base::ParseFromBytes;
 using base::PullSerializer;
 using base::PushDeserializer;
+using base::UniqueArray;
+using geometry::Displacement;
 using geometry::Instant;
+using geometry::Velocity;
 using interface::principia__AdvanceTime;
 using interface::principia__DeletePlugin;
 using interface::principia__DeserializePlugin;
 using interface::principia__FutureCatchUpVessel;
 using interface::principia__FutureWaitForVesselToCatchUp;
 using interface::principia__IteratorDelete;
+using interface::principia__IteratorIncrement;
 using interface::principia__SerializePlugin;
+using physics::DegreesOfFreedom;
+using physics::Ephemeris;
+using physics::MassiveBody;
+using physics::RotatingBody;
 using quantities::Frequency;
+using quantities::Length;
+using quantities::Sqrt;
+using quantities::Speed;
 using quantities::Time;
+using quantities::si::Degree;
 using quantities::si::Hertz;
+using quantities::si::Kilo;
+using quantities::si::Kilogram;
+using quantities::si::Metre;
+using quantities::si::Radian;
 using quantities::si::Second;
+using quantities::si::Tonne;
 using testing_utilities::ReadFromBinaryFile;
 using testing_utilities::ReadLinesFromHexadecimalFile;
 
@@ -64,6 +116,102 @@ std::unique_ptr<Plugin const> DeserializePluginFromLines(
   return std::unique_ptr<Plugin const>(plugin);
 }
 
+// Samples the resident memory of the process until destroyed and records the
+// peak increase over the resident memory at construction.  Unlike the peak of
+// the process, this excludes the setup of the benchmark.
+class ResidentMemorySampler final {
+ public:
+  ResidentMemorySampler()
+      : initial_(ResidentMemory()),
+        peak_(initial_),
+        thread_([this]() {
+          using namespace std::chrono_literals;
+          while (!done_) {
+            std::int64_t const resident = ResidentMemory();
+            std::int64_t peak = peak_;
+            while (resident > peak &&
+                   !peak_.compare_exchange_weak(peak, resident)) {}
+            std::this_thread::sleep_for(1ms);
+          }
+        }) {}
+
+  ~ResidentMemorySampler() {
+    done_ = true;
+    thread_.join();
+  }
+
+  std::int64_t peak_increase() const {
+    return std::max<std::int64_t>(peak_ - initial_, 0);
+  }
+
+ private:
+  static std::int64_t ResidentMemory() {
+#if OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.WorkingSetSize;
+#else
+    // Returns 0 if /proc is not available.
+    std::int64_t size = 0;
+    std::int64_t resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+#endif
+  }
+
+  std::int64_t const initial_;
+  std::atomic<std::int64_t> peak_;
+  std::atomic<bool> done_ = false;
+  std::thread thread_;
+};
+
+// Parses the |lines| of a plugin serialized with gipfeli compression and
+// hexadecimal encoding, and serializes it again in the same format.  The
+// fields are in |Plugin::StreamingFieldOrder| if |streaming| is true, and by
+// increasing number, like in saves predating that order, otherwise.
+std::vector<std::string> ReserializePlugin(
+    std::vector<std::string> const& lines,
+    bool const streaming) {
+  // Same as in interface.cpp, so that the compressed chunks may be passed to
+  // |principia__DeserializePlugin|.
+  constexpr int chunk_size = 64 << 10;
+  constexpr int number_of_chunks = 8;
+  HexadecimalEncoder</*null_terminated=*/false> encoder;
+
+  serialization::Plugin message;
+  {
+    PushDeserializer deserializer(chunk_size,
+                                  number_of_chunks,
+                                  google::compression::NewGipfeliCompressor());
+    deserializer.Start(&message, /*done=*/nullptr);
+    for (auto const& line : lines) {
+      deserializer.Push(encoder.Decode({line.c_str(), line.size()}));
+    }
+    deserializer.Push(UniqueArray<std::uint8_t>());
+  }
+
+  std::vector<std::string> reserialized_lines;
+  PullSerializer serializer(chunk_size,
+                            number_of_chunks,
+                            google::compression::NewGipfeliCompressor());
+  if (streaming) {
+    serializer.Start(&message, Plugin::StreamingFieldOrder());
+  } else {
+    serializer.Start(&message);
+  }
+  for (;;) {
+    Array<std::uint8_t> const bytes = serializer.Pull();
+    if (bytes.size == 0) {
+      break;
+    }
+    auto const hexadecimal = encoder.Encode(bytes);
+    reserialized_lines.emplace_back(hexadecimal.data.get(),
+                                    hexadecimal.data.get() + hexadecimal.size);
+  }
+  return reserialized_lines;
+}
+
 void BM_PluginIntegrationBenchmark(benchmark::State& state) {
   auto const plugin = Plugin::ReadFromMessage(
       ParseFromBytes<serialization::Plugin>(ReadFromBinaryFile(
@@ -131,28 +279,217 @@ void BM_PluginSerializationBenchmark(benchmark::State& state) {
   state.SetBytesProcessed(bytes_processed);
 }
 
+// The argument is 1 if the fields of the save are in the streaming order, which
+// lets the vessels and pile-ups be converted as they are parsed, and 0 if they
+// are in the order of older saves, which requires holding the entire message in
+// memory.  Run the two arguments in separate processes for the most reliable
+// memory measurements.
 void BM_PluginDeserializationBenchmark(benchmark::State& state) {
   char const compressor[] = "gipfeli";
   char const encoder[] = "hexadecimal";
-  auto const gipfeli_plugin(
+  bool const streaming = state.range(0) != 0;
+  auto const gipfeli_plugin = ReserializePlugin(
       ReadLinesFromHexadecimalFile(
-          SOLUTION_DIR / "ksp_plugin_test" / "large_plugin.proto.gipfeli.hex"));
+          SOLUTION_DIR / "ksp_plugin_test" / "large_plugin.proto.gipfeli.hex"),
+      streaming);
 
   int bytes_processed = 0;
+  std::int64_t peak_resident_memory = 0;
   for (auto _ : state) {
-    PushDeserializer* deserializer = nullptr;
+    ResidentMemorySampler sampler;
     auto const plugin = DeserializePluginFromLines(gipfeli_plugin,
                                                    compressor,
                                                    encoder,
                                                    bytes_processed);
     benchmark::DoNotOptimize(plugin);
+    peak_resident_memory =
+        std::max(peak_resident_memory, sampler.peak_increase());
+  }
+  state.SetBytesProcessed(bytes_processed);
+  state.counters["peak_resident_mib"] =
+      static_cast<double>(peak_resident_memory) / (1 << 20);
+}
+
+// The argument is 0 for full saves and 1 for deltas.  Between two saves the
+// plugin advances by one frame at high warp, which is not timed.
+void BM_PluginDeltaSerializationBenchmark(benchmark::State& state) {
+  bool const delta = state.range(0) != 0;
+  auto const plugin = Plugin::ReadFromMessage(
+      ParseFromBytes<serialization::Plugin>(ReadFromBinaryFile(
+          SOLUTION_DIR / "ksp_plugin_test" / "3 vessels.proto.bin")));
+
+  static constexpr int warp_factor = 6'000'000;
+  static constexpr Frequency refresh_frequency = 50 * Hertz;
+  static constexpr Time step = warp_factor / refresh_frequency;
+  std::int64_t bytes_processed = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    principia__AdvanceTime(
+        plugin.get(),
+        (plugin->CurrentTime() + step - plugin->GameEpoch()) / Second,
+        /*planetarium_rotation=*/45);
+    VesselSet collided_vessels;
+    plugin->CatchUpLaggingVessels(collided_vessels);
+    state.ResumeTiming();
+    if (delta) {
+      serialization::PluginDelta message;
+      plugin->WriteDeltaToMessage(&message);
+      bytes_processed += message.ByteSizeLong();
+    } else {
+      serialization::Plugin message;
+      plugin->WriteToMessage(&message);
+      bytes_processed += message.ByteSizeLong();
+    }
   }
   state.SetBytesProcessed(bytes_processed);
+  state.counters["bytes_per_save"] = benchmark::Counter(
+      bytes_processed, benchmark::Counter::kAvgIterations);
+}
+
+// The per-call overhead of journalling on a function of the interface called
+// at high frequency.  The argument is 0 if journalling is off and 1 if it is
+// on.
+void BM_JournalIteratorIncrement(benchmark::State& state) {
+  bool const journalling = state.range(0) != 0;
+  TypedIterator<std::vector<int>> iterator(std::vector<int>(1 << 20));
+  if (journalling) {
+    journal::Recorder::Activate(new journal::Recorder(
+        std::filesystem::temp_directory_path() / "benchmark.journal.hex"));
+  }
+  for (auto _ : state) {
+    if (iterator.AtEnd()) {
+      state.PauseTiming();
+      iterator.Reset();
+      state.ResumeTiming();
+    }
+    principia__IteratorIncrement(&iterator);
+  }
+  if (journalling) {
+    journal::Recorder::Deactivate();
+  }
+}
+
+// The first argument is the number of parts of a vessel alone in its pile-up in
+// low orbit.  The second argument is 0 if the parts share the points computed
+// by the pile-up, and 1 if each part copies them, as happens when their
+// trajectories are accessed.  Each frame is one second of game time.  The
+// counters report the points inserted per frame in the trajectories of the
+// parts and of the vessel, each of which is an allocation, and the points of
+// the segments shared by the parts.
+void BM_VesselAdvanceTime(benchmark::State& state) {
+  int const number_of_parts = state.range(0);
+  bool const copy = state.range(1) != 0;
+  Instant t = astronomy::J2000;
+
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  bodies.emplace_back(make_not_null_unique<RotatingBody<Barycentric>>(
+      MassiveBody::Parameters(5.972e24 * Kilogram),
+      RotatingBody<Barycentric>::Parameters(
+          /*mean_radius=*/6371 * Kilo(Metre),
+          /*reference_angle=*/0 * Degree,
+          /*reference_instant=*/t,
+          /*angular_frequency=*/7.292e-5 * Radian / Second,
+          /*right_ascension_of_pole=*/0 * Degree,
+          /*declination_of_pole=*/90 * Degree)));
+  Ephemeris<Barycentric> ephemeris(
+      std::move(bodies),
+      {DegreesOfFreedom<Barycentric>(Barycentric::origin,
+                                     Velocity<Barycentric>())},
+      t,
+      DefaultEphemerisAccuracyParameters(),
+      DefaultEphemerisFixedStepParameters());
+  auto const earth = dynamic_cast_not_null<RotatingBody<Barycentric> const*>(
+      ephemeris.bodies()[0]);
+  Celestial const celestial(earth);
+
+  Length const r = 7000 * Kilo(Metre);
+  Speed const v = Sqrt(earth->gravitational_parameter() / r);
+  Vessel vessel("guid",
+                "vessel",
+                &celestial,
+                &ephemeris,
+                DefaultPredictionParameters());
+  std::list<not_null<Part*>> parts;
+  for (int i = 0; i < number_of_parts; ++i) {
+    auto part = make_not_null_unique<Part>(
+        i,
+        "part",
+        1 * Tonne,
+        DegreesOfFreedom<Barycentric>(
+            Barycentric::origin + Displacement<Barycentric>(
+                                      {r + i * Metre, 0 * Metre, 0 * Metre}),
+            Velocity<Barycentric>(
+                {0 * Metre / Second, v, 0 * Metre / Second})),
+        /*deletion_callback=*/nullptr);
+    parts.push_back(part.get());
+    vessel.AddPart(std::move(part));
+  }
+  auto const pile_up = make_not_null_shared<PileUp>(
+      std::move(parts),
+      t,
+      DefaultPsychohistoryParameters(),
+      DefaultHistoryParameters(),
+      &ephemeris,
+      /*deletion_callback=*/nullptr);
+  vessel.ForAllParts([&pile_up](Part& part) {
+    part.set_containing_pile_up(pile_up);
+  });
+  vessel.PrepareHistory(t);
+
+  std::int64_t part_points = 0;
+  std::int64_t vessel_points = 0;
+  std::int64_t segment_points = 0;
+  for (auto _ : state) {
+    t += 1 * Second;
+    ephemeris.Prolong(t);
+    CHECK_OK(pile_up->DeformAndAdvanceTime(t));
+    if (copy) {
+      vessel.ForAllParts([&part_points](Part& part) {
+        for (auto it = part.history_begin(); it != part.history_end(); ++it) {
+          ++part_points;
+        }
+        for (auto it = part.psychohistory_begin();
+             it != part.psychohistory_end();
+             ++it) {
+          ++part_points;
+        }
+      });
+    } else {
+      vessel.ForSomePart([&segment_points](Part& part) {
+        segment_points += part.segment()->history.size() +
+                          part.segment()->psychohistory.size();
+      });
+    }
+    // The psychohistory of the vessel is rebuilt at each frame, so its points
+    // are inserted again in addition to those appended to its history.
+    auto const& psychohistory = vessel.psychohistory();
+    vessel_points -= psychohistory.Size();
+    for (auto it = psychohistory.Fork(); ++it != psychohistory.end();) {
+      ++vessel_points;
+    }
+    vessel.AdvanceTime();
+    vessel_points += vessel.psychohistory().Size();
+  }
+  state.counters["part_points"] =
+      benchmark::Counter(part_points, benchmark::Counter::kAvgIterations);
+  state.counters["vessel_points"] =
+      benchmark::Counter(vessel_points, benchmark::Counter::kAvgIterations);
+  state.counters["segment_points"] =
+      benchmark::Counter(segment_points, benchmark::Counter::kAvgIterations);
 }
 
 BENCHMARK(BM_PluginSerializationBenchmark);
-BENCHMARK(BM_PluginDeserializationBenchmark);
+BENCHMARK(BM_PluginDeserializationBenchmark)->Arg(0)->Arg(1);
 BENCHMARK(BM_PluginIntegrationBenchmark);
+BENCHMARK(BM_PluginDeltaSerializationBenchmark)->Arg(0)->Arg(1);
+BENCHMARK(BM_JournalIteratorIncrement)->Arg(0)->Arg(1);
+BENCHMARK(BM_VesselAdvanceTime)
+    ->ArgPair(10, 0)
+    ->ArgPair(10, 1)
+    ->ArgPair(100, 0)
+    ->ArgPair(100, 1)
+    ->ArgPair(1000, 0)
+    ->ArgPair(1000, 1);
 
 // .\Release\x64\ksp_plugin_test_tests.exe --gtest_filter=PluginBenchmark.DISABLED_All --gtest_also_run_disabled_tests  // NOLINT
 TEST(PluginBenchmark, DISABLED_All) {
@@ -519,6 +519,34 @@ TEST_F(FlightPlanTest, SetAdaptiveStepParameter) {
   EXPECT_EQ(t0_ + 42 * Second, end->time);
 }
 
+TEST_F(FlightPlanTest, SetCoastPararealParameters) {
+  DiscreteTrajectory<Barycentric>::Iterator begin;
+  DiscreteTrajectory<Barycentric>::Iterator end;
+  flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second);
+  EXPECT_OK(flight_plan_->Append(MakeFirstBurn()));
+  EXPECT_OK(flight_plan_->Append(MakeSecondBurn()));
+  flight_plan_->GetSegment(4, begin, end);
+  --end;
+  DegreesOfFreedom<Barycentric> const sequential_degrees_of_freedom =
+      end->degrees_of_freedom;
+
+  EXPECT_OK(flight_plan_->SetCoastPararealParameters(
+      Ephemeris<Barycentric>::PararealParameters{
+          /*number_of_slices=*/4, /*coarse_tolerance_factor=*/1e3}));
+  EXPECT_EQ(5, flight_plan_->number_of_segments());
+  flight_plan_->GetSegment(4, begin, end);
+  --end;
+  EXPECT_EQ(t0_ + 42 * Second, end->time);
+  EXPECT_THAT(AbsoluteError(sequential_degrees_of_freedom.position(),
+                            end->degrees_of_freedom.position()),
+              Lt(1 * Metre));
+
+  EXPECT_OK(flight_plan_->SetCoastPararealParameters(std::nullopt));
+  flight_plan_->GetSegment(4, begin, end);
+  --end;
+  EXPECT_EQ(sequential_degrees_of_freedom, end->degrees_of_freedom);
+}
+
 TEST_F(FlightPlanTest, GuidedBurn) {
   flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second);
   auto unguided_burn = MakeFirstBurn();
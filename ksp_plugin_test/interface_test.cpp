@@ -1,6 +1,7 @@
 ﻿
 #include "ksp_plugin/interface.hpp"
 
+#include <cstring>
 #include <limits>
 #include <optional>
 #include <string>
@@ -8,6 +9,7 @@
 
 #include "astronomy/time_scales.hpp"
 #include "base/file.hpp"
+#include "base/hexadecimal.hpp"
 #include "base/not_null.hpp"
 #include "base/pull_serializer.hpp"
 #include "base/push_deserializer.hpp"
@@ -37,6 +39,7 @@ namespace interface {
 
 using astronomy::operator""_TT;
 using base::check_not_null;
+using base::HexadecimalEncoder;
 using base::make_not_null_unique;
 using base::OFStream;
 using base::ParseFromBytes;
@@ -637,7 +640,14 @@ TEST_F(InterfaceTest, SerializePlugin) {
                                  &serializer,
                                  /*compressor=*/"",
                                  "hexadecimal");
-  EXPECT_STREQ(hexadecimal_simple_plugin_.c_str(), serialization);
+  // The fields are serialized in |Plugin::StreamingFieldOrder|, so the bytes
+  // differ from those of the file but represent the same message.
+  HexadecimalEncoder</*null_terminated=*/true> encoder;
+  auto const bytes =
+      encoder.Decode({serialization, std::strlen(serialization)});
+  EXPECT_EQ(hexadecimal_simple_plugin_.size(), std::strlen(serialization));
+  EXPECT_THAT(ParseFromBytes<principia::serialization::Plugin>(bytes.get()),
+              EqualsProto(message));
   EXPECT_EQ(nullptr,
             principia__SerializePlugin(plugin_.get(),
                                        &serializer,
@@ -667,6 +677,62 @@ TEST_F(InterfaceTest, DeserializePlugin) {
   principia__DeletePlugin(&plugin);
 }
 
+TEST_F(InterfaceTest, SerializeAndDeserializeCompressedPlugin) {
+  auto const message = ParseFromBytes<principia::serialization::Plugin>(
+      serialized_simple_plugin_);
+
+  // Compress with zstd.
+  std::vector<std::string> chunks;
+  {
+    PullSerializer* serializer = nullptr;
+    EXPECT_CALL(*plugin_, WriteToMessage(_))
+        .WillOnce(SetArgPointee<0>(message));
+    for (;;) {
+      char const* serialization =
+          principia__SerializePlugin(plugin_.get(),
+                                     &serializer,
+                                     /*compressor=*/"zstd",
+                                     "base64");
+      if (serialization == nullptr) {
+        break;
+      }
+      chunks.emplace_back(serialization);
+      principia__DeleteString(&serialization);
+    }
+  }
+
+  // The chunks are tagged with their codec, so the lz4 compressor can read
+  // them.
+  Plugin const* plugin = nullptr;
+  {
+    PushDeserializer* deserializer = nullptr;
+    for (std::string const& chunk : chunks) {
+      principia__DeserializePlugin(chunk.c_str(),
+                                   chunk.size(),
+                                   &deserializer,
+                                   &plugin,
+                                   /*compressor=*/"lz4",
+                                   "base64");
+    }
+    principia__DeserializePlugin(chunks.front().c_str(),
+                                 0,
+                                 &deserializer,
+                                 &plugin,
+                                 /*compressor=*/"lz4",
+                                 "base64");
+  }
+  ASSERT_THAT(plugin, NotNull());
+
+  // Same plugin as that read without compression.
+  auto const expected_plugin = Plugin::ReadFromMessage(message);
+  serialization::Plugin expected_message;
+  expected_plugin->WriteToMessage(&expected_message);
+  serialization::Plugin actual_message;
+  plugin->WriteToMessage(&actual_message);
+  EXPECT_THAT(actual_message, EqualsProto(expected_message));
+  principia__DeletePlugin(&plugin);
+}
+
 // Use for debugging saves given by users.
 TEST_F(InterfaceTest, DISABLED_SECULAR_DeserializePluginDebug) {
   Plugin const* plugin = nullptr;
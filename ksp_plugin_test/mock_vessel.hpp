@@ -42,6 +42,11 @@ class MockVessel : public Vessel {
                      void(not_null<serialization::Vessel*> message,
                           PileUp::SerializationIndexForPileUp const&
                               serialization_index_for_pile_up));
+  MOCK_CONST_METHOD3(WriteDeltaToMessage,
+                     Instant(not_null<serialization::Vessel*> message,
+                             PileUp::SerializationIndexForPileUp const&
+                                 serialization_index_for_pile_up,
+                             Instant const& history_omitted_t_max));
 };
 
 }  // namespace internal_vessel
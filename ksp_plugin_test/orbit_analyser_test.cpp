@@ -19,15 +19,19 @@ using astronomy::ITRS;
 using astronomy::OrbitRecurrence;
 using astronomy::StandardProduct3;
 using base::not_null;
+using geometry::Displacement;
+using geometry::Instant;
 using geometry::Position;
 using integrators::SymmetricLinearMultistepIntegrator;
 using integrators::methods::QuinlanTremaine1990Order12;
 using physics::BodySurfaceDynamicFrame;
+using physics::DegreesOfFreedom;
 using physics::Ephemeris;
 using physics::RotatingBody;
 using physics::SolarSystem;
 using quantities::astronomy::JulianYear;
 using quantities::astronomy::TerrestrialEquatorialRadius;
+using quantities::Time;
 using quantities::si::Hour;
 using quantities::si::Kilo;
 using quantities::si::Metre;
@@ -38,6 +42,7 @@ using testing_utilities::operator""_⑴;
 using ::testing::AllOf;
 using ::testing::Eq;
 using ::testing::IsNull;
+using ::testing::Ne;
 using ::testing::Optional;
 using ::testing::Property;
 
@@ -71,6 +76,17 @@ class OrbitAnalyserTest : public testing::Test {
   BodySurfaceDynamicFrame<Barycentric, ITRS> itrs_;
   StandardProduct3 topex_poséidon_;
 
+  // Waits until |analyser| has produced an analysis for a mission of the given
+  // duration and refreshes it.
+  static void WaitForAnalysis(OrbitAnalyser& analyser,
+                              Time const& mission_duration) {
+    do {
+      absl::SleepFor(absl::Milliseconds(10));
+      analyser.RefreshAnalysis();
+    } while (analyser.analysis() == nullptr ||
+             analyser.analysis()->mission_duration() < mission_duration);
+  }
+
  private:
   SolarSystem<Barycentric> RemoveAllButEarth(
       SolarSystem<Barycentric> solar_system) {
@@ -137,5 +153,57 @@ TEST_F(OrbitAnalyserTest, TOPEXPoséidon) {
                              Property(&OrbitRecurrence::Cᴛₒ, 10))));
 }
 
+TEST_F(OrbitAnalyserTest, IncrementalAnalysis) {
+  OrbitAnalyser analyser(ephemeris_.get(), DefaultHistoryParameters());
+  auto const& arc =
+      *topex_poséidon_.orbit(
+          {StandardProduct3::SatelliteGroup::General, 1}).front();
+  Instant const first_time = arc.begin()->time;
+  ephemeris_->Prolong(first_time);
+  auto const first_degrees_of_freedom =
+      itrs_.FromThisFrameAtTime(first_time)(arc.begin()->degrees_of_freedom);
+
+  analyser.RequestAnalysis(
+      first_time, first_degrees_of_freedom, 3 * Hour, &earth_);
+  WaitForAnalysis(analyser, 3 * Hour);
+  EXPECT_THAT(analyser.analysis()->reused_duration(), Eq(Time{}));
+  auto const semimajor_axis = analyser.analysis()
+                                  ->elements()
+                                  ->mean_semimajor_axis_interval()
+                                  .midpoint();
+
+  // A longer mission starting at the same point reuses the whole of the
+  // previously analysed trajectory and integrates only the tail.
+  analyser.RequestAnalysis(
+      first_time, first_degrees_of_freedom, 6 * Hour, &earth_);
+  WaitForAnalysis(analyser, 6 * Hour);
+  EXPECT_THAT(analyser.analysis()->reused_duration(), IsNear(3.0_⑴ * Hour));
+  EXPECT_THAT(analyser.analysis()
+                  ->elements()
+                  ->mean_semimajor_axis_interval()
+                  .midpoint(),
+              IsNear(7714_⑴ * Kilo(Metre)));
+  EXPECT_THAT(analyser.analysis()->recurrence(),
+              Optional(AllOf(Property(&OrbitRecurrence::νₒ, 13),
+                             Property(&OrbitRecurrence::Dᴛₒ, -3),
+                             Property(&OrbitRecurrence::Cᴛₒ, 10))));
+
+  // A request that does not start on the analysed trajectory is computed from
+  // scratch.
+  auto const perturbed_degrees_of_freedom = DegreesOfFreedom<Barycentric>(
+      first_degrees_of_freedom.position() +
+          Displacement<Barycentric>({1 * Kilo(Metre), 0 * Metre, 0 * Metre}),
+      first_degrees_of_freedom.velocity());
+  analyser.RequestAnalysis(
+      first_time, perturbed_degrees_of_freedom, 9 * Hour, &earth_);
+  WaitForAnalysis(analyser, 9 * Hour);
+  EXPECT_THAT(analyser.analysis()->reused_duration(), Eq(Time{}));
+  EXPECT_THAT(analyser.analysis()
+                  ->elements()
+                  ->mean_semimajor_axis_interval()
+                  .midpoint(),
+              Ne(semimajor_axis));
+}
+
 }  // namespace ksp_plugin
 }  // namespace principia
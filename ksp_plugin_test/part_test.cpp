@@ -1,6 +1,8 @@
 ﻿
 #include "ksp_plugin/part.hpp"
 
+#include <memory>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "ksp_plugin/frames.hpp"
@@ -11,6 +13,7 @@ namespace ksp_plugin {
 namespace internal_part {
 
 using geometry::Displacement;
+using physics::RelativeDegreesOfFreedom;
 using quantities::Force;
 using quantities::si::Kilogram;
 using quantities::si::Metre;
@@ -84,11 +87,19 @@ TEST_F(PartTest, Serialization) {
                    multivector().vector().y().quantity().magnitude());
   EXPECT_EQ(6, message.degrees_of_freedom().t2().
                    multivector().vector().z().quantity().magnitude());
-  EXPECT_EQ(1, message.prehistory().timeline_size());
+  auto const& prehistory_instants =
+      message.prehistory().packed_timeline().instant();
+  EXPECT_EQ(1,
+            prehistory_instants.value_size() +
+                prehistory_instants.xor_value_size());
   EXPECT_EQ(1, message.prehistory().children_size());
   EXPECT_EQ(1, message.prehistory().children(0).trajectories_size());
+  auto const& psychohistory_instants = message.prehistory().children(0).
+                                           trajectories(0).packed_timeline().
+                                           instant();
   EXPECT_EQ(1,
-            message.prehistory().children(0).trajectories(0).timeline_size());
+            psychohistory_instants.value_size() +
+                psychohistory_instants.xor_value_size());
 
   auto const p = Part::ReadFromMessage(message, /*deletion_callback=*/nullptr);
   EXPECT_EQ(part_.mass(), p->mass());
@@ -101,6 +112,65 @@ TEST_F(PartTest, Serialization) {
   EXPECT_THAT(message, EqualsProto(second_message));
 }
 
+TEST_F(PartTest, Segment) {
+  auto const segment = std::make_shared<PileUp::Segment>();
+  segment->history.emplace_back(
+      astronomy::J2000 + 1 * Second,
+      DegreesOfFreedom<Barycentric>(
+          Barycentric::origin +
+              Displacement<Barycentric>({1 * Metre, 2 * Metre, 3 * Metre}),
+          Velocity<Barycentric>(
+              {4 * Metre / Second, 5 * Metre / Second, 6 * Metre / Second})));
+  segment->psychohistory.emplace_back(
+      astronomy::J2000 + 2 * Second,
+      DegreesOfFreedom<Barycentric>(
+          Barycentric::origin +
+              Displacement<Barycentric>({7 * Metre, 8 * Metre, 9 * Metre}),
+          Velocity<Barycentric>(
+              {1 * Metre / Second, 2 * Metre / Second, 3 * Metre / Second})));
+  RelativeDegreesOfFreedom<Barycentric> const offset(
+      Displacement<Barycentric>({10 * Metre, 20 * Metre, 30 * Metre}),
+      Velocity<Barycentric>(
+          {40 * Metre / Second, 50 * Metre / Second, 60 * Metre / Second}));
+
+  // A part with an empty history shares the points of the segment until they
+  // are accessed.
+  Part part(part_id_,
+            "part",
+            mass_,
+            degrees_of_freedom_,
+            /*deletion_callback=*/nullptr);
+  part.AppendSegment(segment, offset);
+  EXPECT_EQ(segment.get(), part.segment());
+  EXPECT_EQ(offset, part.segment_offset());
+  auto it = part.history_begin();
+  EXPECT_EQ(nullptr, part.segment());
+  EXPECT_EQ(astronomy::J2000 + 1 * Second, it->time);
+  EXPECT_EQ(segment->history[0].second + offset, it->degrees_of_freedom);
+  EXPECT_EQ(part.history_end(), ++it);
+  it = part.psychohistory_begin();
+  EXPECT_EQ(astronomy::J2000 + 2 * Second, it->time);
+  EXPECT_EQ(segment->psychohistory[0].second + offset, it->degrees_of_freedom);
+  EXPECT_EQ(part.psychohistory_end(), ++it);
+
+  // Clearing the history drops the points that were not copied.
+  part.ClearHistory();
+  part.AppendSegment(segment, offset);
+  part.ClearHistory();
+  EXPECT_EQ(nullptr, part.segment());
+  EXPECT_EQ(part.history_begin(), part.history_end());
+  EXPECT_EQ(part.psychohistory_begin(), part.psychohistory_end());
+
+  // A part with a history copies the points immediately.
+  part_.AppendSegment(segment, offset);
+  EXPECT_EQ(nullptr, part_.segment());
+  it = part_.history_begin();
+  EXPECT_EQ(astronomy::J2000, it->time);
+  ++it;
+  EXPECT_EQ(astronomy::J2000 + 1 * Second, it->time);
+  EXPECT_EQ(part_.history_end(), ++it);
+}
+
 }  // namespace internal_part
 }  // namespace ksp_plugin
 }  // namespace principia
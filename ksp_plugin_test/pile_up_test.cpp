@@ -607,7 +607,9 @@ TEST_F(PileUpTest, Serialization) {
   EXPECT_EQ(2, message.part_id_size());
   EXPECT_EQ(part_id1_, message.part_id(0));
   EXPECT_EQ(part_id2_, message.part_id(1));
-  EXPECT_EQ(1, message.history().timeline_size());
+  auto const& history_instants = message.history().packed_timeline().instant();
+  EXPECT_EQ(1,
+            history_instants.value_size() + history_instants.xor_value_size());
   EXPECT_EQ(2, message.actual_part_degrees_of_freedom().size());
   EXPECT_TRUE(message.apparent_part_degrees_of_freedom().empty());
 
@@ -650,7 +652,9 @@ TEST_F(PileUpTest, SerializationCompatibility) {
 
   // Clear the children to simulate pre-Cesàro serialization.
   message.mutable_history()->clear_children();
-  EXPECT_EQ(1, message.history().timeline_size());
+  auto const& history_instants = message.history().packed_timeline().instant();
+  EXPECT_EQ(1,
+            history_instants.value_size() + history_instants.xor_value_size());
 
   auto const part_id_to_part = [this](PartId const part_id) {
     if (part_id == part_id1_) {
@@ -13,8 +13,11 @@
 
 #include "astronomy/frames.hpp"
 #include "astronomy/time_scales.hpp"
+#include "base/array.hpp"
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
+#include "base/pull_serializer.hpp"
+#include "base/push_deserializer.hpp"
 #include "base/serialization.hpp"
 #include "base/status.hpp"
 #include "geometry/identity.hpp"
@@ -50,10 +53,13 @@ namespace internal_plugin {
 
 using astronomy::ICRS;
 using astronomy::ParseTT;
+using base::Array;
 using base::Error;
 using base::FindOrDie;
 using base::make_not_null_unique;
 using base::not_null;
+using base::PullSerializer;
+using base::PushDeserializer;
 using base::SerializeAsBytes;
 using base::Status;
 using geometry::AngularVelocity;
@@ -453,11 +459,15 @@ TEST_F(PluginTest, Serialization) {
   EXPECT_EQ(SolarSystemFactory::Earth, message.vessel(0).parent_index());
   EXPECT_TRUE(message.vessel(0).vessel().has_flight_plan());
   EXPECT_TRUE(message.vessel(0).vessel().has_history());
-  auto const& vessel_0_history = message.vessel(0).vessel().history();
-  EXPECT_EQ(4, vessel_0_history.timeline_size());
-  Instant const t0 =
-      Instant() +
-      vessel_0_history.timeline(0).instant().scalar().magnitude() * Second;
+  // Read the timeline of the history, without its forks.
+  serialization::DiscreteTrajectory vessel_0_history =
+      message.vessel(0).vessel().history();
+  vessel_0_history.clear_children();
+  vessel_0_history.clear_fork_position();
+  auto const history = DiscreteTrajectory<Barycentric>::ReadFromMessage(
+      vessel_0_history, /*forks=*/{});
+  EXPECT_EQ(4, history->Size());
+  Instant const t0 = history->front().time;
   EXPECT_THAT(t0,
               AllOf(Gt(HistoryTime(time, 3) - step), Le(HistoryTime(time, 3))));
   EXPECT_TRUE(message.has_renderer());
@@ -468,6 +478,139 @@ TEST_F(PluginTest, Serialization) {
             message.renderer().plotting_frame().GetExtension(
                 serialization::BodyCentredNonRotatingDynamicFrame::extension).
                     centre());
+
+  // Streaming deserialization yields the same plugin, whether or not the
+  // fields come in the streaming order.
+  for (bool const streaming_order : {false, true}) {
+    std::string serialized;
+    {
+      PullSerializer serializer(/*chunk_size=*/1 << 10,
+                                /*number_of_chunks=*/4,
+                                /*compressor=*/nullptr);
+      if (streaming_order) {
+        serializer.Start(&message, Plugin::StreamingFieldOrder());
+      } else {
+        serializer.Start(&message);
+      }
+      for (;;) {
+        Array<std::uint8_t> const bytes = serializer.Pull();
+        if (bytes.size == 0) {
+          break;
+        }
+        serialized.append(reinterpret_cast<char const*>(bytes.data),
+                          static_cast<std::size_t>(bytes.size));
+      }
+    }
+    EXPECT_EQ(streaming_order, serialized != message.SerializeAsString());
+
+    google::protobuf::Arena arena;
+    Plugin::StreamingReader reader;
+    bool retained = false;
+    std::unique_ptr<Plugin> streamed_plugin;
+    {
+      PushDeserializer deserializer(/*chunk_size=*/1 << 10,
+                                    /*number_of_chunks=*/4,
+                                    /*compressor=*/nullptr);
+      deserializer.StartStreaming(
+          &serialization::Plugin::default_instance(),
+          &arena,
+          [&reader, &retained](google::protobuf::Message const& field) {
+            bool const released =
+                reader.Read(static_cast<serialization::Plugin const&>(field));
+            retained |= !released;
+            return released;
+          },
+          [&reader, &streamed_plugin]() {
+            streamed_plugin = reader.Finish();
+          });
+      deserializer.Push(
+          Array<std::uint8_t>(reinterpret_cast<std::uint8_t*>(&serialized[0]),
+                              serialized.size()),
+          /*done=*/nullptr);
+      deserializer.Push(Array<std::uint8_t>(), /*done=*/nullptr);
+    }
+    ASSERT_TRUE(streamed_plugin != nullptr);
+    // In the streaming order, no field is retained by the reader.
+    EXPECT_EQ(!streaming_order, retained);
+    serialization::Plugin streamed_message;
+    streamed_plugin->WriteToMessage(&streamed_message);
+    EXPECT_THAT(streamed_message, EqualsProto(message)) << streaming_order;
+  }
+}
+
+TEST_F(PluginTest, DeltaSerialization) {
+  GUID const satellite = "satellite";
+  PartId const part_id = 666;
+
+  auto plugin = make_not_null_unique<Plugin>(
+                    initial_time_,
+                    initial_time_,
+                    planetarium_rotation_);
+  for (int index = SolarSystemFactory::Sun;
+       index <= SolarSystemFactory::LastMajorBody;
+       ++index) {
+    std::optional<Index> parent_index;
+    if (index != SolarSystemFactory::Sun) {
+      parent_index = SolarSystemFactory::parent(index);
+    }
+    std::string const name = SolarSystemFactory::name(index);
+    plugin->InsertCelestialAbsoluteCartesian(
+        index,
+        parent_index,
+        solar_system_->gravity_model_message(name),
+        solar_system_->cartesian_initial_state_message(name));
+  }
+  plugin->EndInitialization();
+  bool inserted;
+  plugin->InsertOrKeepVessel(satellite,
+                             "v" + satellite,
+                             SolarSystemFactory::Earth,
+                             /*loaded=*/false,
+                             inserted);
+  plugin->InsertUnloadedPart(
+      part_id,
+      "part",
+      satellite,
+      RelativeDegreesOfFreedom<AliceSun>(satellite_initial_displacement_,
+                                         satellite_initial_velocity_));
+  plugin->PrepareToReportCollisions();
+  plugin->FreeVesselsAndPartsAndCollectPileUps(20 * Milli(Second));
+
+  // Replay the deltas as a reader would, and check that each replay yields the
+  // full save written at the same time.  The loop goes through a compaction.
+  serialization::Plugin replayed;
+  Instant time = ParseTT(initial_time_);
+  VesselSet collided_vessels;
+  for (int i = 0; i <= Plugin::deltas_between_full_saves + 1; ++i) {
+    time = HistoryTime(time, 100);
+    plugin->InsertOrKeepVessel(satellite,
+                               "v" + satellite,
+                               SolarSystemFactory::Earth,
+                               /*loaded=*/false,
+                               inserted);
+    plugin->AdvanceTime(time, Angle());
+    plugin->CatchUpLaggingVessels(collided_vessels);
+    if (i == Plugin::deltas_between_full_saves / 2) {
+      plugin->ForgetAllHistoriesBefore(HistoryTime(time, -150));
+    }
+
+    serialization::PluginDelta delta;
+    plugin->WriteDeltaToMessage(&delta);
+    serialization::Plugin full;
+    plugin->WriteToMessage(&full);
+
+    bool const is_full_save = i % (Plugin::deltas_between_full_saves + 1) == 0;
+    EXPECT_EQ(is_full_save, delta.ephemeris_trajectory_omission_size() == 0);
+    EXPECT_EQ(is_full_save, delta.vessel_history_omission_size() == 0);
+    EXPECT_LE(delta.plugin().ByteSizeLong(), full.ByteSizeLong());
+    Plugin::ReplayDelta(&delta, &replayed);
+    EXPECT_THAT(replayed, EqualsProto(full));
+  }
+
+  plugin = Plugin::ReadFromMessage(replayed);
+  serialization::Plugin second_message;
+  plugin->WriteToMessage(&second_message);
+  EXPECT_THAT(second_message, EqualsProto(replayed));
 }
 
 TEST_F(PluginTest, Initialization) {
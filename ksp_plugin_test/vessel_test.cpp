@@ -2,6 +2,7 @@
 #include "ksp_plugin/vessel.hpp"
 
 #include <limits>
+#include <memory>
 #include <set>
 
 #include "astronomy/epoch.hpp"
@@ -30,6 +31,7 @@ using geometry::Position;
 using geometry::Velocity;
 using physics::MassiveBody;
 using physics::MockEphemeris;
+using physics::RelativeDegreesOfFreedom;
 using physics::RotatingBody;
 using quantities::si::Degree;
 using quantities::si::Kilogram;
@@ -236,6 +238,129 @@ TEST_F(VesselTest, AdvanceTime) {
                                        110.6 / 3.0 * Metre / Second}), 0)));
 }
 
+TEST_F(VesselTest, AdvanceTimeWithSharedSegment) {
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(astronomy::J2000 + 2 * Second));
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::InfiniteFuture, _, _))
+      .Times(AnyNumber());
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 2 * Second, _, _))
+      .Times(AnyNumber());
+  vessel_.PrepareHistory(astronomy::J2000);
+
+  auto const segment = std::make_shared<PileUp::Segment>();
+  for (int i = 1; i <= 3; ++i) {
+    auto& points = i < 3 ? segment->history : segment->psychohistory;
+    points.emplace_back(
+        astronomy::J2000 + i * 0.5 * Second,
+        DegreesOfFreedom<Barycentric>(
+            Barycentric::origin +
+                Displacement<Barycentric>(
+                    {i * Metre, (i + 1) * Metre, (i + 2) * Metre}),
+            Velocity<Barycentric>({(i + 9) * Metre / Second,
+                                   (i + 19) * Metre / Second,
+                                   (i + 29) * Metre / Second})));
+  }
+  p1_->AppendSegment(
+      segment,
+      RelativeDegreesOfFreedom<Barycentric>(Displacement<Barycentric>(),
+                                            Velocity<Barycentric>()));
+  p2_->AppendSegment(
+      segment,
+      RelativeDegreesOfFreedom<Barycentric>(
+          Displacement<Barycentric>({3 * Metre, 3 * Metre, 3 * Metre}),
+          Velocity<Barycentric>(
+              {3 * Metre / Second, 3 * Metre / Second, 3 * Metre / Second})));
+
+  vessel_.AdvanceTime();
+
+  // The parts never copied the points of the segment.
+  EXPECT_EQ(nullptr, p1_->segment());
+  EXPECT_EQ(p1_->history_begin(), p1_->history_end());
+  EXPECT_EQ(4, vessel_.psychohistory().Size());
+  auto it = vessel_.psychohistory().begin();
+  for (int i = 1; i <= 3; ++i) {
+    ++it;
+    EXPECT_EQ(astronomy::J2000 + i * 0.5 * Second, it->time);
+    EXPECT_THAT(
+        it->degrees_of_freedom,
+        Componentwise(AlmostEquals(Barycentric::origin +
+                                       Displacement<Barycentric>(
+                                           {(i + 2) * Metre,
+                                            (i + 3) * Metre,
+                                            (i + 4) * Metre}), 0),
+                      AlmostEquals(Velocity<Barycentric>(
+                                       {(i + 11) * Metre / Second,
+                                        (i + 21) * Metre / Second,
+                                        (i + 31) * Metre / Second}), 0)));
+  }
+}
+
+TEST_F(VesselTest, HistoryCompression) {
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(astronomy::J2000 + 2 * Second));
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::InfiniteFuture, _, _))
+      .Times(AnyNumber());
+  EXPECT_CALL(
+      ephemeris_,
+      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 2 * Second, _, _))
+      .Times(AnyNumber());
+  vessel_.PrepareHistory(astronomy::J2000);
+  // Otherwise the points would be retained for downsampling.
+  vessel_.DisableDownsampling();
+  vessel_.set_history_compression_age(0.7 * Second);
+
+  auto const segment = std::make_shared<PileUp::Segment>();
+  for (int i = 1; i <= 4; ++i) {
+    auto& points = i < 4 ? segment->history : segment->psychohistory;
+    points.emplace_back(
+        astronomy::J2000 + i * 0.5 * Second,
+        DegreesOfFreedom<Barycentric>(
+            Barycentric::origin +
+                Displacement<Barycentric>(
+                    {i * Metre, (i + 1) * Metre, (i + 2) * Metre}),
+            Velocity<Barycentric>({(i + 9) * Metre / Second,
+                                   (i + 19) * Metre / Second,
+                                   (i + 29) * Metre / Second})));
+  }
+  p1_->AppendSegment(
+      segment,
+      RelativeDegreesOfFreedom<Barycentric>(Displacement<Barycentric>(),
+                                            Velocity<Barycentric>()));
+  p2_->AppendSegment(
+      segment,
+      RelativeDegreesOfFreedom<Barycentric>(Displacement<Barycentric>(),
+                                            Velocity<Barycentric>()));
+
+  vessel_.AdvanceTime();
+
+  // The points of the history before 0.8 s are moved to the compressed
+  // timeline.
+  auto const& compressed_timeline =
+      *vessel_.psychohistory().root()->compressed_timeline();
+  EXPECT_EQ(2, compressed_timeline.size());
+  auto compressed_it = compressed_timeline.begin();
+  EXPECT_EQ(astronomy::J2000, compressed_it->first);
+  ++compressed_it;
+  EXPECT_EQ(astronomy::J2000 + 0.5 * Second, compressed_it->first);
+  EXPECT_EQ(segment->history[0].second, compressed_it->second);
+
+  EXPECT_EQ(3, vessel_.psychohistory().Size());
+  auto it = vessel_.psychohistory().begin();
+  for (int i = 2; i <= 4; ++i) {
+    EXPECT_EQ(astronomy::J2000 + i * 0.5 * Second, it->time);
+    EXPECT_EQ(i < 4 ? segment->history[i - 1].second
+                    : segment->psychohistory[0].second,
+              it->degrees_of_freedom);
+    ++it;
+  }
+}
+
 TEST_F(VesselTest, Prediction) {
   EXPECT_CALL(ephemeris_, t_min_locked())
       .WillRepeatedly(Return(astronomy::J2000));
@@ -5,11 +5,13 @@
 #include <fstream>  // NOLINT(readability/streams)
 #include <iostream>  // NOLINT(readability/streams)
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "base/bundle.hpp"
 #include "base/file.hpp"
 #include "base/status.hpp"
+#include "base/thread_pool.hpp"
 #include "glog/logging.h"
 #include "integrators/methods.hpp"
 #include "integrators/symmetric_linear_multistep_integrator.hpp"
@@ -54,6 +56,7 @@ using base::Bundle;
 using base::not_null;
 using base::OFStream;
 using base::Status;
+using base::ThreadPool;
 using geometry::BarycentreCalculator;
 using geometry::Displacement;
 using geometry::InnerProduct;
@@ -223,9 +226,11 @@ class WorkErrorGraphGenerator {
   }
 
   std::string GetMathematicaData() {
-    LOG(INFO) << "Using " << std::thread::hardware_concurrency()
-              << " worker threads";
-    Bundle bundle;
+    int const number_of_threads =
+        std::max<int>(1, std::thread::hardware_concurrency());
+    LOG(INFO) << "Using " << number_of_threads << " worker threads";
+    ThreadPool<void> pool(number_of_threads);
+    Bundle bundle(&pool);
     for (int method_index = 0; method_index < methods_.size(); ++method_index) {
       for (int time_step_index = 0;
            time_step_index < integrations_per_integrator_;
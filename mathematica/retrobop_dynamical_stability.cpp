@@ -9,6 +9,7 @@
 #include <memory>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "astronomy/stabilize_ksp.hpp"
@@ -17,6 +18,7 @@
 #include "base/file.hpp"
 #include "base/get_line.hpp"
 #include "base/hexadecimal.hpp"
+#include "base/thread_pool.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "integrators/methods.hpp"
 #include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
@@ -33,6 +35,7 @@ using base::not_null;
 using base::Status;
 using base::GetLine;
 using base::OFStream;
+using base::ThreadPool;
 using base::UniqueArray;
 using geometry::BarycentreCalculator;
 using geometry::Instant;
@@ -467,9 +470,10 @@ void AnalyseGlobalError() {
   // Errors above this mean we are pretty much completely out of phase.
   Length const chaotic_threshold = 1e8 * Metre;
 
+  ThreadPool<void> pool(std::max<int>(1, std::thread::hardware_concurrency()));
   for (int year = 1;; ++year) {
     Instant const t = ksp_epoch + year * JulianYear;
-    Bundle bundle;
+    Bundle bundle(&pool);
     if (reference_ephemeris != nullptr) {
       bundle.Add([&reference_ephemeris = *reference_ephemeris, t]() {
         reference_ephemeris.Prolong(t);
@@ -565,9 +569,10 @@ void StatisticallyAnalyseStability() {
   // (though that may be costly if done naïvely).
   Length const yearly_allowed_numerical_error = 1 * Kilo(Metre);
 
+  ThreadPool<void> pool(std::max<int>(1, std::thread::hardware_concurrency()));
   for (int year = 1; year <= 200; ++year) {
     Instant const t = ksp_epoch + year * JulianYear;
-    Bundle bundle;
+    Bundle bundle(&pool);
     for (auto const& ephemeris : perturbed_ephemerides) {
       bundle.Add([
         &numerically_unsound,
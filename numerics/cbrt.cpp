@@ -77,5 +77,69 @@ double Cbrt(double const y) {
   return x_sign_y - numerator / denominator;
 }
 
+void Cbrt(double const* const y, int const size, double* const cbrt_y) {
+  // |sign_bit| is only set in its low lane.
+  __m128d const sign_bits = _mm_unpacklo_pd(sign_bit, sign_bit);
+  // The bits of nonnegative doubles are ordered like their values, and those
+  // of the NaNs without their sign are above those of +∞.  Comparing them as
+  // integers does not signal the invalid operation exception for NaNs, unlike
+  // the packed double comparisons.
+  static std::uint64_t const y₁_bits =
+      _mm_cvtsi128_si64(_mm_castpd_si128(_mm_set_sd(y₁)));
+  static std::uint64_t const y₂_bits =
+      _mm_cvtsi128_si64(_mm_castpd_si128(_mm_set_sd(y₂)));
+  int i = 0;
+  for (; i + 1 < size; i += 2) {
+    __m128d const y_0 = _mm_loadu_pd(&y[i]);
+    __m128d const sign = _mm_and_pd(sign_bits, y_0);
+    __m128d const abs_y_0 = _mm_andnot_pd(sign_bits, y_0);
+    std::uint64_t const Y₀ = _mm_cvtsi128_si64(_mm_castpd_si128(abs_y_0));
+    std::uint64_t const Y₁ = _mm_cvtsi128_si64(
+        _mm_castpd_si128(_mm_unpackhi_pd(abs_y_0, abs_y_0)));
+    // The pair is processed by the scalar function if any of its values
+    // requires rescaling or is a NaN.
+    if (Y₀ < y₁_bits || Y₀ > y₂_bits || Y₁ < y₁_bits || Y₁ > y₂_bits) {
+      cbrt_y[i] = Cbrt(y[i]);
+      cbrt_y[i + 1] = Cbrt(y[i + 1]);
+      continue;
+    }
+    // The same computation as in the scalar function.  There is no packed
+    // 64-bit integer division, but the division by a constant is a
+    // multiplication.
+    __m128d const q = _mm_castsi128_pd(_mm_set_epi64x(C + Y₁ / 3, C + Y₀ / 3));
+    __m128d const q³ = _mm_mul_pd(_mm_mul_pd(q, q), q);
+    __m128d const ξ = _mm_sub_pd(
+        q,
+        _mm_div_pd(_mm_mul_pd(_mm_sub_pd(q³, abs_y_0), q),
+                   _mm_add_pd(_mm_mul_pd(_mm_set1_pd(2), q³), abs_y_0)));
+    __m128d const x = _mm_and_pd(
+        ξ, _mm_unpacklo_pd(sign_exponent_and_sixteen_bits_of_mantissa,
+                           sign_exponent_and_sixteen_bits_of_mantissa));
+    __m128d const x³ = _mm_mul_pd(_mm_mul_pd(x, x), x);
+    __m128d const x⁶ = _mm_mul_pd(x³, x³);
+    __m128d const y² = _mm_mul_pd(y_0, y_0);
+    __m128d const x_sign_y = _mm_or_pd(x, sign);
+    __m128d const numerator = _mm_mul_pd(
+        _mm_mul_pd(x_sign_y, _mm_sub_pd(x³, abs_y_0)),
+        _mm_add_pd(
+            _mm_mul_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(5), x³),
+                                  _mm_mul_pd(_mm_set1_pd(17), abs_y_0)),
+                       x³),
+            _mm_mul_pd(_mm_set1_pd(5), y²)));
+    __m128d const denominator = _mm_add_pd(
+        _mm_mul_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(7), x³),
+                              _mm_mul_pd(_mm_set1_pd(42), abs_y_0)),
+                   x⁶),
+        _mm_mul_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(30), x³),
+                              _mm_mul_pd(_mm_set1_pd(2), abs_y_0)),
+                   y²));
+    _mm_storeu_pd(&cbrt_y[i],
+                  _mm_sub_pd(x_sign_y, _mm_div_pd(numerator, denominator)));
+  }
+  for (; i < size; ++i) {
+    cbrt_y[i] = Cbrt(y[i]);
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -7,5 +7,11 @@ namespace numerics {
 // incorrectly rounded for approximately 5 inputs per million.
 double Cbrt(double y);
 
+// Same as above for the |size| values |y|, with the results stored in |cbrt_y|,
+// which must have room for |size| values.  The values are processed two at a
+// time with SSE, except near the ends of the range of |double|, and the results
+// are identical to those of the scalar function.
+void Cbrt(double const* y, int size, double* cbrt_y);
+
 }  // namespace numerics
 }  // namespace principia
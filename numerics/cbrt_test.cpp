@@ -4,7 +4,10 @@
 #include <cfenv>
 #include <pmmintrin.h>
 
+#include <cmath>
 #include <limits>
+#include <random>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -15,6 +18,7 @@ namespace principia {
 namespace numerics {
 
 using ::testing::AllOf;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::Gt;
 using ::testing::Lt;
@@ -127,5 +131,57 @@ TEST_F(CubeRootTest, ParticularlyBadRounding) {
   EXPECT_THAT(x_ulps, AllOf(Gt(0.5000551), Lt(0.5000552))) << x_ulps - 0.5;
 }
 
+// The vectorized function gives the same results as the scalar one, both in
+// the range where it is vectorized and for the values that require rescaling.
+TEST_F(CubeRootTest, Array) {
+  std::vector<double> y = {0,
+                           -0.0,
+                           std::numeric_limits<double>::infinity(),
+                           2,
+                           quiet_dead_beef_,
+                           -2,
+                           0x1p-225,
+                           0x1p237,
+                           0x1p1021,
+                           0x1p-1073,
+                           0x1.14E35E87EA5DFp0};
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> mantissa_distribution(-1.0, 1.0);
+  std::uniform_int_distribution<> exponent_distribution(-1074, 1023);
+  for (int i = 0; i < 100'000; ++i) {
+    y.push_back(std::ldexp(mantissa_distribution(random),
+                           exponent_distribution(random)));
+  }
+  std::vector<double> cbrt_y(y.size());
+  Cbrt(y.data(), y.size(), cbrt_y.data());
+  for (int i = 0; i < y.size(); ++i) {
+    EXPECT_THAT(Bits(cbrt_y[i]), Eq(Bits(Cbrt(y[i])))) << y[i];
+  }
+}
+
+// Both lanes of the vectorized function handle negative values.
+TEST_F(CubeRootTest, ArraySigns) {
+  std::vector<double> const y = {8, 27, -8, 27, 8, -27, -8, -27};
+  std::vector<double> cbrt_y(y.size());
+  Cbrt(y.data(), y.size(), cbrt_y.data());
+  EXPECT_THAT(cbrt_y, ElementsAre(2, 3, -2, 3, 2, -3, -2, -3));
+}
+
+// Like the scalar function, the vectorized function doesn't signal the invalid
+// operation exception on quiet NaNs.
+TEST_F(CubeRootTest, ArrayExceptions) {
+  std::vector<double> const y = {quiet_dead_beef_,
+                                 0,
+                                 -std::numeric_limits<double>::infinity(),
+                                 -quiet_dead_beef_};
+  std::vector<double> cbrt_y(y.size());
+  std::feclearexcept(FE_ALL_EXCEPT);
+  Cbrt(y.data(), y.size(), cbrt_y.data());
+  EXPECT_THAT(std::fetestexcept(FE_ALL_EXCEPT), Eq(0));
+  for (int i = 0; i < y.size(); ++i) {
+    EXPECT_THAT(Bits(cbrt_y[i]), Eq(Bits(Cbrt(y[i])))) << y[i];
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -51,7 +51,9 @@ template<typename T, typename U>
 DoublePrecision<Product<T, U>> Scale(T const& scale,
                                      DoublePrecision<U> const& right);
 
-// Returns the exact product of its arguments.
+// Returns the exact product of its arguments.  The error term is computed
+// using an FMA instruction if |PRINCIPIA_USE_AVX2_FMA_INTRINSICS|, using
+// |std::fma| otherwise.
 template<typename T, typename U>
 DoublePrecision<Product<T, U>> TwoProduct(T const& a, U const& b);
 
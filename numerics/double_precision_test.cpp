@@ -1,6 +1,7 @@
 ﻿
 #include "numerics/double_precision.hpp"
 
+#include <cmath>
 #include <limits>
 #include <random>
 
@@ -291,6 +292,20 @@ TEST_F(DoublePrecisionTest, Product) {
                            0));
 }
 
+// The error term is the same whether it is computed by an FMA instruction or by
+// the library.
+TEST_F(DoublePrecisionTest, ProductError) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1.0, 1.0);
+  for (int i = 0; i < 1000; ++i) {
+    double const a = distribution(random);
+    double const b = std::ldexp(distribution(random), i % 100 - 50);
+    DoublePrecision<double> const c = TwoProduct(a, b);
+    EXPECT_EQ(a * b, c.value);
+    EXPECT_EQ(std::fma(a, b, -(a * b)), c.error);
+  }
+}
+
 }  // namespace internal_double_precision
 }  // namespace numerics
 }  // namespace principia
@@ -1,8 +1,12 @@
 ﻿
 #include "numerics/elliptic_functions.hpp"
 
+#include <pmmintrin.h>
+
 #include <tuple>
+#include <vector>
 
+#include "base/macros.hpp"
 #include "glog/logging.h"
 #include "numerics/combinatorics.hpp"
 #include "numerics/elliptic_integrals.hpp"
@@ -204,6 +208,198 @@ void JacobiSNCNDNWithK(Angle const& u,
     s = -s;
   }
 }
+
+// Same as |JacobiSNCNDNReduced| for the |size| arguments |u|, expressed in
+// radians, which must all be in [0, K/2[.  The arguments are processed in pairs
+// with SSE: the lanes run the same number of duplications, the extra ones being
+// masked out, and the choice between the two recurrences is made by blending.
+// The operations of each lane are those of the scalar function, so the results
+// are identical.
+void JacobiSNCNDNReduced(double const* const u,
+                         int const size,
+                         double const mc,
+                         double* const s,
+                         double* const c,
+                         double* const d) {
+  int i = 0;
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  double const m = 1.0 - mc;
+  double const uT = 5.217e-3 - 2.143e-3 * m;
+  double const uA = 1.76269 + 1.16357 * mc;
+  __m128d const b₀1 = _mm_set1_pd(fukushima_b₀_maclaurin_m_1.Evaluate(m));
+  __m128d const b₀2 = _mm_set1_pd(fukushima_b₀_maclaurin_m_2.Evaluate(m));
+  __m128d const b₀3 = _mm_set1_pd(fukushima_b₀_maclaurin_m_3.Evaluate(m));
+  __m128d const m_128d = _mm_set1_pd(m);
+  __m128d const mc_128d = _mm_set1_pd(mc);
+  __m128d const two_m = _mm_set1_pd(2.0 * m);
+  __m128d const two_mc = _mm_set1_pd(2.0 * mc);
+  __m128d const zero = _mm_setzero_pd();
+  __m128d const one = _mm_set1_pd(1.0);
+  __m128d const two = _mm_set1_pd(2.0);
+  auto const blend = [](__m128d const mask,
+                        __m128d const if_true,
+                        __m128d const if_false) {
+    return _mm_or_pd(_mm_and_pd(mask, if_true),
+                     _mm_andnot_pd(mask, if_false));
+  };
+
+  for (; i + 1 < size; i += 2) {
+    // The number of duplications is small, so it is determined by halving as
+    // in the scalar function.
+    double u₀[2] = {u[i], u[i + 1]};
+    int n[2] = {0, 0};
+    for (int lane = 0; lane < 2; ++lane) {
+      for (; u₀[lane] >= uT; ++n[lane]) {
+        u₀[lane] = 0.5 * u₀[lane];
+      }
+    }
+    __m128d const n_128d = _mm_set_pd(n[1], n[0]);
+    __m128d const u₀_128d = _mm_loadu_pd(u₀);
+    __m128d const u₀² = _mm_mul_pd(u₀_128d, u₀_128d);
+    __m128d const may_have_cancellation =
+        _mm_cmpgt_pd(_mm_loadu_pd(&u[i]), _mm_set1_pd(uA));
+
+    // Horner evaluation of the Maclaurin series in u₀².
+    __m128d bᵢ = _mm_add_pd(
+        zero,
+        _mm_mul_pd(
+            u₀²,
+            _mm_add_pd(b₀1,
+                       _mm_mul_pd(u₀², _mm_add_pd(b₀2, _mm_mul_pd(u₀², b₀3))))));
+    __m128d aᵢ = one;
+    // In the lanes that have switched to the recurrence that avoids
+    // cancellations, the numerator of c.
+    __m128d cᵢ = zero;
+    __m128d has_cancellation = zero;
+    for (int j = 0; j < std::max(n[0], n[1]); ++j) {
+      __m128d const active = _mm_cmplt_pd(_mm_set1_pd(j), n_128d);
+
+      __m128d const yᵢ =
+          _mm_mul_pd(bᵢ, _mm_sub_pd(_mm_mul_pd(two, aᵢ), bᵢ));
+      __m128d const zᵢ = _mm_mul_pd(aᵢ, aᵢ);
+      __m128d const myᵢ = _mm_mul_pd(m_128d, yᵢ);
+      __m128d const switches = _mm_and_pd(
+          _mm_andnot_pd(has_cancellation,
+                        _mm_and_pd(active, may_have_cancellation)),
+          _mm_cmplt_pd(zᵢ, _mm_mul_pd(two, myᵢ)));
+      has_cancellation = _mm_or_pd(has_cancellation, switches);
+      cᵢ = blend(switches, _mm_sub_pd(aᵢ, bᵢ), cᵢ);
+
+      // The recurrence without cancellations.
+      __m128d const xᵢ = _mm_mul_pd(cᵢ, cᵢ);
+      __m128d const wᵢ = _mm_sub_pd(_mm_mul_pd(_mm_mul_pd(m_128d, xᵢ), xᵢ),
+                                    _mm_mul_pd(_mm_mul_pd(mc_128d, zᵢ), zᵢ));
+      __m128d const xᵢzᵢ = _mm_mul_pd(xᵢ, zᵢ);
+      __m128d const cancellation_cᵢ =
+          _mm_add_pd(_mm_mul_pd(two_mc, xᵢzᵢ), wᵢ);
+      __m128d const cancellation_aᵢ =
+          _mm_sub_pd(_mm_mul_pd(two_m, xᵢzᵢ), wᵢ);
+
+      // The ordinary recurrence.
+      __m128d const ordinary_bᵢ =
+          _mm_mul_pd(_mm_mul_pd(two, yᵢ), _mm_sub_pd(zᵢ, myᵢ));
+      __m128d const ordinary_aᵢ =
+          _mm_sub_pd(_mm_mul_pd(zᵢ, zᵢ), _mm_mul_pd(myᵢ, yᵢ));
+
+      __m128d const cancellation = _mm_and_pd(active, has_cancellation);
+      __m128d const ordinary = _mm_andnot_pd(has_cancellation, active);
+      cᵢ = blend(cancellation, cancellation_cᵢ, cᵢ);
+      bᵢ = blend(ordinary, ordinary_bᵢ, bᵢ);
+      aᵢ = blend(cancellation,
+                 cancellation_aᵢ,
+                 blend(ordinary, ordinary_aᵢ, aᵢ));
+    }
+
+    // The results of the recurrence without cancellations.  The square roots
+    // may be NaNs in the lanes that are not selected, which is harmless.
+    __m128d const cancellation_c = _mm_div_pd(cᵢ, aᵢ);
+    __m128d const cancellation_c² =
+        _mm_mul_pd(cancellation_c, cancellation_c);
+    __m128d const cancellation_s =
+        _mm_sqrt_pd(_mm_sub_pd(one, cancellation_c²));
+    __m128d const cancellation_d = _mm_sqrt_pd(
+        _mm_add_pd(mc_128d, _mm_mul_pd(m_128d, cancellation_c²)));
+
+    // The results of the ordinary recurrence.
+    bᵢ = _mm_div_pd(bᵢ, aᵢ);
+    __m128d const yᵢ = _mm_mul_pd(bᵢ, _mm_sub_pd(two, bᵢ));
+    __m128d const ordinary_c = _mm_sub_pd(one, bᵢ);
+    __m128d const ordinary_s = _mm_sqrt_pd(yᵢ);
+    __m128d const ordinary_d =
+        _mm_sqrt_pd(_mm_sub_pd(one, _mm_mul_pd(m_128d, yᵢ)));
+
+    _mm_storeu_pd(&s[i], blend(has_cancellation, cancellation_s, ordinary_s));
+    _mm_storeu_pd(&c[i], blend(has_cancellation, cancellation_c, ordinary_c));
+    _mm_storeu_pd(&d[i], blend(has_cancellation, cancellation_d, ordinary_d));
+  }
+#endif
+  for (; i < size; ++i) {
+    JacobiSNCNDNReduced(u[i] * Radian, mc, s[i], c[i], d[i]);
+  }
+}
+
+// Same as |JacobiSNCNDNWithK| for all the arguments |u|.  The reduction of
+// each argument to [0, K/2[ is branch-free: the octant of the reduced argument
+// selects the multiple of K to subtract and the transformation that yields the
+// functions of the argument from those of the reduced argument.
+void JacobiSNCNDNWithK(std::vector<Angle> const& u,
+                       double const mc,
+                       Angle const& k,
+                       std::vector<double>& s,
+                       std::vector<double>& c,
+                       std::vector<double>& d) {
+  // For the octant o, the reduced argument is
+  //   (o + 1) / 2 * K - |u| if o is odd, |u| - (o + 1) / 2 * K if o is even,
+  // and the functions are obtained by multiplying sn and cn (or cn / dn and
+  // k′ sn / dn, if |swaps|) by the signs below.
+  static constexpr bool swaps[8] = {
+      false, true, true, false, false, true, true, false};
+  static constexpr double s_signs[8] = {1, 1, 1, 1, -1, -1, -1, -1};
+  static constexpr double c_signs[8] = {1, 1, -1, -1, -1, -1, 1, 1};
+
+  int const size = u.size();
+  s.resize(size);
+  c.resize(size);
+  d.resize(size);
+  double const kʹ = Sqrt(mc);
+  Angle const four_k = 4.0 * k;
+  std::vector<double> reduced_u(size);
+  std::vector<int> octants(size);
+  for (int i = 0; i < size; ++i) {
+    Angle const abs_u = Abs(u[i]);
+    Angle const modulo_four_k =
+        abs_u < k_over_2_lower_bound
+            ? abs_u
+            : abs_u - four_k * static_cast<double>(
+                                   static_cast<int>(abs_u / four_k));
+    int const octant =
+        (modulo_four_k >= 0.5 * k) + (modulo_four_k >= k) +
+        (modulo_four_k >= 1.5 * k) + (modulo_four_k >= 2.0 * k) +
+        (modulo_four_k >= 2.5 * k) + (modulo_four_k >= 3.0 * k) +
+        (modulo_four_k >= 3.5 * k);
+    // The first octant is handled separately in case K is infinite.
+    double const sign = octant % 2 == 0 ? 1 : -1;
+    reduced_u[i] =
+        (octant == 0 ? modulo_four_k
+                     : sign * (modulo_four_k - ((octant + 1) / 2) * k)) /
+        Radian;
+    octants[i] = octant;
+  }
+
+  JacobiSNCNDNReduced(
+      reduced_u.data(), size, mc, s.data(), c.data(), d.data());
+
+  for (int i = 0; i < size; ++i) {
+    int const octant = octants[i];
+    double const sign_u = u[i] < Angle() ? -1 : 1;
+    double const sx = swaps[octant] ? c[i] / d[i] : s[i];
+    double const cx = swaps[octant] ? kʹ * s[i] / d[i] : c[i];
+    d[i] = swaps[octant] ? kʹ / d[i] : d[i];
+    s[i] = sign_u * s_signs[octant] * sx;
+    c[i] = c_signs[octant] * cx;
+  }
+}
+
 }  // namespace
 
 Angle JacobiAmplitude(Angle const& u, double mc) {
@@ -275,6 +471,41 @@ void JacobiSNCNDN(Angle const& u,
   }
 }
 
+void JacobiAmplitude(std::vector<Angle> const& u,
+                     double const mc,
+                     std::vector<Angle>& am) {
+  DCHECK_LE(0, mc);
+  DCHECK_GE(1, mc);
+  // See the scalar function for the reduction to [-K, K].
+  int const size = u.size();
+  Angle const k = EllipticK(mc);
+  std::vector<Angle> reduced_u(size);
+  std::vector<double> n(size);
+  for (int i = 0; i < size; ++i) {
+    n[i] = Abs(u[i]) < k_over_2_lower_bound ? 0.0
+                                             : std::nearbyint(u[i] / (2.0 * k));
+    reduced_u[i] = n[i] == 0.0 ? u[i] : u[i] - 2.0 * n[i] * k;
+  }
+  std::vector<double> s;
+  std::vector<double> c;
+  std::vector<double> d;
+  JacobiSNCNDNWithK(reduced_u, mc, k, s, c, d);
+  am.resize(size);
+  for (int i = 0; i < size; ++i) {
+    am[i] = n[i] * π * Radian + ArcTan(s[i], c[i]);
+  }
+}
+
+void JacobiSNCNDN(std::vector<Angle> const& u,
+                  double const mc,
+                  std::vector<double>& s,
+                  std::vector<double>& c,
+                  std::vector<double>& d) {
+  DCHECK_LE(0, mc);
+  DCHECK_GE(1, mc);
+  JacobiSNCNDNWithK(u, mc, EllipticK(mc), s, c, d);
+}
+
 }  // namespace internal_elliptic_functions
 }  // namespace numerics
 }  // namespace principia
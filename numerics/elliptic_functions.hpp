@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "quantities/quantities.hpp"
 
 // This code is a derived from: Fukushima, Toshio. (2012). xgscd.txt (Fortran
@@ -18,6 +20,22 @@ Angle JacobiAmplitude(Angle const& u, double mc);
 
 void JacobiSNCNDN(Angle const& u, double mc, double& s, double& c, double& d);
 
+// Batched versions of the above functions for arguments |u| sharing the same
+// |mc|, e.g., the successive times at which the attitude of a rigid body is
+// sampled.  The quantities that only depend on |mc| are computed once, the
+// range reduction is branch-free, and the reduced arguments are processed in
+// pairs with SSE.  The results are identical to those of the scalar functions.
+// The outputs are resized to the size of |u|.
+void JacobiAmplitude(std::vector<Angle> const& u,
+                     double mc,
+                     std::vector<Angle>& am);
+
+void JacobiSNCNDN(std::vector<Angle> const& u,
+                  double mc,
+                  std::vector<double>& s,
+                  std::vector<double>& c,
+                  std::vector<double>& d);
+
 }  // namespace internal_elliptic_functions
 
 using internal_elliptic_functions::JacobiAmplitude;
@@ -2,6 +2,8 @@
 #include "numerics/elliptic_functions.hpp"
 
 #include <limits>
+#include <map>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gmock/gmock.h"
@@ -104,6 +106,60 @@ TEST_F(EllipticFunctionsTest, Mathematica) {
   }
 }
 
+// The batched functions yield the same results as the scalar ones.
+TEST_F(EllipticFunctionsTest, Batch) {
+  auto const elliptic_functions_expected = ReadFromTabulatedData(
+      SOLUTION_DIR / "numerics" / "elliptic_functions.proto.txt");
+
+  // The entries for each value of m.
+  std::map<double, std::vector<int>> entries_by_m;
+  for (int i = 0; i < elliptic_functions_expected.entry_size(); ++i) {
+    entries_by_m[elliptic_functions_expected.entry(i).argument(1)].push_back(i);
+  }
+
+  for (auto const& [m, entries] : entries_by_m) {
+    double const mc = 1.0 - m;
+    std::vector<Angle> us;
+    for (int const i : entries) {
+      us.push_back(elliptic_functions_expected.entry(i).argument(0) * Radian);
+    }
+    // Large arguments, to exercise all the octants of the reduction.
+    Angle const k = EllipticK(mc);
+    for (int i = -17; i <= 17; ++i) {
+      us.push_back(i * 0.25 * k + 1e-3 * Radian);
+      us.push_back(i * 0.25 * k - 1e-3 * Radian);
+    }
+
+    std::vector<double> batch_s;
+    std::vector<double> batch_c;
+    std::vector<double> batch_d;
+    std::vector<Angle> batch_a;
+    JacobiSNCNDN(us, mc, batch_s, batch_c, batch_d);
+    JacobiAmplitude(us, mc, batch_a);
+    ASSERT_EQ(us.size(), batch_s.size());
+    ASSERT_EQ(us.size(), batch_a.size());
+
+    for (int j = 0; j < us.size(); ++j) {
+      double s;
+      double c;
+      double d;
+      JacobiSNCNDN(us[j], mc, s, c, d);
+      EXPECT_EQ(s, batch_s[j]) << us[j] << " " << m;
+      EXPECT_EQ(c, batch_c[j]) << us[j] << " " << m;
+      EXPECT_EQ(d, batch_d[j]) << us[j] << " " << m;
+      EXPECT_EQ(JacobiAmplitude(us[j], mc), batch_a[j]) << us[j] << " " << m;
+      if (j < entries.size()) {
+        auto const& entry = elliptic_functions_expected.entry(entries[j]);
+        EXPECT_THAT(batch_s[j], AlmostEquals(entry.value(0), 0, 12507));
+        EXPECT_THAT(batch_c[j], AlmostEquals(entry.value(1), 0, 7648));
+        EXPECT_THAT(batch_d[j], AlmostEquals(entry.value(2), 0, 85));
+        EXPECT_THAT(batch_a[j],
+                    AlmostEquals(entry.value(3) * Radian, 0, 22074));
+      }
+    }
+  }
+}
+
 #if !defined(_DEBUG)
 TEST_F(EllipticFunctionsTest, Monotonicity) {
   for (double const mc : {0.01, 0.1, 0.5}) {
@@ -4,6 +4,7 @@
 #include <limits>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "numerics/combinatorics.hpp"
 #include "numerics/elliptic_integrals.hpp"
@@ -98,6 +99,35 @@ void Reduce(Angle const& angle,
             Angle& fractional_part,
             std::int64_t& integer_part);
 
+// The complete integrals B(m), D(m) and J(n, m), computed when first needed.
+// They may be shared by the computations of the incomplete integrals for the
+// same n and m.
+class FukushimaCompleteIntegrals final {
+ public:
+  FukushimaCompleteIntegrals(double n, double mc);
+
+  void Get(Angle& B_m, Angle& D_m, Angle& J_n_m);
+
+ private:
+  double const nc_;
+  double const mc_;
+  bool has_computed_ = false;
+  Angle B_m_{uninitialized};
+  Angle D_m_{uninitialized};
+  Angle J_n_m_{uninitialized};
+};
+
+// Same as the public |FukushimaEllipticBDJ|, but obtains the complete
+// integrals from |complete_integrals|, which must have been constructed for
+// |n| and |mc|.
+void FukushimaEllipticBDJ(Angle const& φ,
+                          double n,
+                          double mc,
+                          FukushimaCompleteIntegrals& complete_integrals,
+                          Angle& B_φǀm,
+                          Angle& D_φǀm,
+                          Angle& J_φ_nǀm);
+
 // A generator for the Maclaurin series for q(m) / m where q is Jacobi's nome
 // function.
 template<int n, template<typename, typename, int> class Evaluator>
@@ -1644,19 +1674,28 @@ void Reduce(Angle const& angle,
   fractional_part = reduced_in_half_cycles * π * Radian;
 }
 
-}  // namespace
+FukushimaCompleteIntegrals::FukushimaCompleteIntegrals(double const n,
+                                                       double const mc)
+    : nc_(1.0 - n),
+      mc_(mc) {}
+
+void FukushimaCompleteIntegrals::Get(Angle& B_m, Angle& D_m, Angle& J_n_m) {
+  if (!has_computed_) {
+    FukushimaEllipticBDJ(nc_, mc_, B_m_, D_m_, J_n_m_);
+    has_computed_ = true;
+  }
+  B_m = B_m_;
+  D_m = D_m_;
+  J_n_m = J_n_m_;
+}
 
 void FukushimaEllipticBDJ(Angle const& φ,
                           double const n,
                           double const mc,
+                          FukushimaCompleteIntegrals& complete_integrals,
                           Angle& B_φǀm,
                           Angle& D_φǀm,
                           Angle& J_φ_nǀm) {
-  DCHECK_LE(0, n);
-  DCHECK_GE(1, n);
-  DCHECK_LE(0, mc);
-  DCHECK_GE(1, mc);
-
   // See Appendix B of [Fuk11b] and Appendix A.1 of [Fuk12] for argument
   // reduction.
   // TODO(phl): This is extremely imprecise near large multiples of π.  Use a
@@ -1676,7 +1715,6 @@ void FukushimaEllipticBDJ(Angle const& φ,
   constexpr Angle φs = 1.249 * Radian;
   constexpr double ys = 0.9;
 
-  bool has_computed_complete_integrals = false;
   Angle B{uninitialized};  // B(m).
   Angle D{uninitialized};  // D(m).
   Angle J{uninitialized};  // J(n, m).
@@ -1701,13 +1739,12 @@ void FukushimaEllipticBDJ(Angle const& φ,
       Angle Ds{uninitialized};  // Ds(z|m).
       Angle Js{uninitialized};  // Js(z, n|m).
       FukushimaEllipticBsDsJs(z, n, mc, Bs, Ds, Js);
-      FukushimaEllipticBDJ(nc, mc, B, D, J);
+      complete_integrals.Get(B, D, J);
       double const sz = z * Sqrt(1.0 - c²);
       double const t = sz / nc;
       B_φǀm = B - (Bs - sz * Radian);
       D_φǀm = D - (Ds + sz * Radian);
       J_φ_nǀm = J - (Js + FukushimaT(t, h));
-      has_computed_complete_integrals = true;
     } else {
       double const w²_numerator = mc * (1.0 - c²);
       if (w²_numerator < c² * z²_denominator) {
@@ -1719,13 +1756,12 @@ void FukushimaEllipticBDJ(Angle const& φ,
         Angle Dc{uninitialized};  // Dc(w|m).
         Angle Jc{uninitialized};  // Jc(w, n|m).
         FukushimaEllipticBcDcJc(Sqrt(mc * w²_over_mc), n, mc, Bc, Dc, Jc);
-        FukushimaEllipticBDJ(nc, mc, B, D, J);
+        complete_integrals.Get(B, D, J);
         double const sz = c * Sqrt(w²_over_mc);
         double const t = sz / nc;
         B_φǀm = B - (Bc - sz * Radian);
         D_φǀm = D - (Dc + sz * Radian);
         J_φ_nǀm = J - (Jc + FukushimaT(t, h));
-        has_computed_complete_integrals = true;
       }
     }
   }
@@ -1737,10 +1773,7 @@ void FukushimaEllipticBDJ(Angle const& φ,
     J_φ_nǀm = -J_φ_nǀm;
   }
   if (j != 0) {
-    if (!has_computed_complete_integrals) {
-      double const nc = 1.0 - n;
-      FukushimaEllipticBDJ(nc, mc, B, D, J);
-    }
+    complete_integrals.Get(B, D, J);
     // See [Fuk11b], equations (B.2), and [Fuk12], equation (A.2).
     B_φǀm += 2 * j * B;
     D_φǀm += 2 * j * D;
@@ -1748,6 +1781,42 @@ void FukushimaEllipticBDJ(Angle const& φ,
   }
 }
 
+}  // namespace
+
+void FukushimaEllipticBDJ(Angle const& φ,
+                          double const n,
+                          double const mc,
+                          Angle& B_φǀm,
+                          Angle& D_φǀm,
+                          Angle& J_φ_nǀm) {
+  DCHECK_LE(0, n);
+  DCHECK_GE(1, n);
+  DCHECK_LE(0, mc);
+  DCHECK_GE(1, mc);
+  FukushimaCompleteIntegrals complete_integrals(n, mc);
+  FukushimaEllipticBDJ(φ, n, mc, complete_integrals, B_φǀm, D_φǀm, J_φ_nǀm);
+}
+
+void FukushimaEllipticBDJ(std::vector<Angle> const& φ,
+                          double const n,
+                          double const mc,
+                          std::vector<Angle>& B_φǀm,
+                          std::vector<Angle>& D_φǀm,
+                          std::vector<Angle>& J_φ_nǀm) {
+  DCHECK_LE(0, n);
+  DCHECK_GE(1, n);
+  DCHECK_LE(0, mc);
+  DCHECK_GE(1, mc);
+  FukushimaCompleteIntegrals complete_integrals(n, mc);
+  B_φǀm.resize(φ.size(), Angle{uninitialized});
+  D_φǀm.resize(φ.size(), Angle{uninitialized});
+  J_φ_nǀm.resize(φ.size(), Angle{uninitialized});
+  for (int i = 0; i < φ.size(); ++i) {
+    FukushimaEllipticBDJ(
+        φ[i], n, mc, complete_integrals, B_φǀm[i], D_φǀm[i], J_φ_nǀm[i]);
+  }
+}
+
 Angle EllipticF(Angle const& φ, double const mc) {
   Angle F{uninitialized};
   Angle E{uninitialized};
@@ -1795,6 +1864,25 @@ void EllipticFEΠ(Angle const& φ,
   Π_φ_nǀm = F_φǀm + n * J;
 }
 
+void EllipticFEΠ(std::vector<Angle> const& φ,
+                 double const n,
+                 double const mc,
+                 std::vector<Angle>& F_φǀm,
+                 std::vector<Angle>& E_φǀm,
+                 std::vector<Angle>& Π_φ_nǀm) {
+  // The integrals B, D and J are computed in the outputs.
+  FukushimaEllipticBDJ(φ, n, mc, F_φǀm, E_φǀm, Π_φ_nǀm);
+  for (int i = 0; i < φ.size(); ++i) {
+    Angle const& B = F_φǀm[i];
+    Angle const& D = E_φǀm[i];
+    Angle const& J = Π_φ_nǀm[i];
+    Angle const F = B + D;
+    E_φǀm[i] = B + mc * D;
+    F_φǀm[i] = F;
+    Π_φ_nǀm[i] = F + n * J;
+  }
+}
+
 // Note that the identifiers in the function definition are not the same as
 // those in the function declaration.
 // The notation here follows [Fuk09], whereas the notation in the function
@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include <vector>
+
 #include "quantities/quantities.hpp"
 
 // Bibliography:
@@ -72,6 +74,26 @@ void EllipticFEΠ(Angle const& φ,
                  Angle& E_φǀm,
                  Angle& Π_φ_nǀm);
 
+// Batched versions of |FukushimaEllipticBDJ| and |EllipticFEΠ| for amplitudes
+// |φ| sharing the same |n| and |mc|, e.g., the successive angles of rotation of
+// a rigid body.  The complete integrals, which are needed for amplitudes beyond
+// φs and for all the amplitudes outside of [-π/2, π/2], are computed at most
+// once per batch.  The results are identical to those of the scalar functions.
+// The outputs are resized to the size of |φ|.
+void FukushimaEllipticBDJ(std::vector<Angle> const& φ,
+                          double n,
+                          double mc,
+                          std::vector<Angle>& B_φǀm,
+                          std::vector<Angle>& D_φǀm,
+                          std::vector<Angle>& J_φ_nǀm);
+
+void EllipticFEΠ(std::vector<Angle> const& φ,
+                 double n,
+                 double mc,
+                 std::vector<Angle>& F_φǀm,
+                 std::vector<Angle>& E_φǀm,
+                 std::vector<Angle>& Π_φ_nǀm);
+
 // Returns the complete elliptic integral of the first kind K(m), where
 // m = 1 - mc.
 Angle EllipticK(double mc);
@@ -1,6 +1,7 @@
 ﻿
 #include "numerics/elliptic_integrals.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <vector>
 #include <utility>
@@ -111,6 +112,71 @@ TEST_F(EllipticIntegralsTest, Xelbdj) {
   }
 }
 
+// The batched functions yield the same results as the scalar ones, on the
+// parameters of the preceding test and on amplitudes in all the ranges of the
+// argument reduction.
+TEST_F(EllipticIntegralsTest, Batch) {
+  auto const xeldbj_expected =
+      ReadFromTabulatedData(SOLUTION_DIR / "numerics" / "xelbdj.proto.txt");
+
+  constexpr int lend = 5;
+  constexpr int kend = 5;
+  constexpr int iend = 4;
+  constexpr double Δnc = 1.0 / (lend - 1);
+  constexpr double Δmc = 1.0 / (kend - 1);
+  constexpr Angle Δφ = (π / 2) * Radian / iend;
+
+  int expected_index = 0;
+  for (int l = 1; l <= lend; ++l) {
+    double const nc = std::max((l - 1) * Δnc, 2.44e-4);
+    double const nn = 1.0 - nc;
+    for (int k = 1; k <= kend; ++k) {
+      double const mc = k == 1 ? 1.21e-32 : (k - 1) * Δmc;
+      std::vector<Angle> φs;
+      for (int i = 0; i <= iend; ++i) {
+        φs.push_back(Δφ * i);
+      }
+      for (int i = -20; i <= 20; ++i) {
+        φs.push_back(Δφ * i + 1e-3 * Radian);
+      }
+
+      std::vector<Angle> batch_b;
+      std::vector<Angle> batch_d;
+      std::vector<Angle> batch_j;
+      std::vector<Angle> batch_f;
+      std::vector<Angle> batch_e;
+      std::vector<Angle> batch_ᴨ;
+      FukushimaEllipticBDJ(φs, nn, mc, batch_b, batch_d, batch_j);
+      EllipticFEΠ(φs, nn, mc, batch_f, batch_e, batch_ᴨ);
+      ASSERT_EQ(φs.size(), batch_b.size());
+      ASSERT_EQ(φs.size(), batch_f.size());
+
+      for (int i = 0; i < φs.size(); ++i) {
+        Angle b, d, j;
+        FukushimaEllipticBDJ(φs[i], nn, mc, b, d, j);
+        EXPECT_EQ(b, batch_b[i]) << φs[i] << " " << nn << " " << mc;
+        EXPECT_EQ(d, batch_d[i]) << φs[i] << " " << nn << " " << mc;
+        EXPECT_EQ(j, batch_j[i]) << φs[i] << " " << nn << " " << mc;
+        Angle f, e, ᴨ;
+        EllipticFEΠ(φs[i], nn, mc, f, e, ᴨ);
+        EXPECT_EQ(f, batch_f[i]) << φs[i] << " " << nn << " " << mc;
+        EXPECT_EQ(e, batch_e[i]) << φs[i] << " " << nn << " " << mc;
+        EXPECT_EQ(ᴨ, batch_ᴨ[i]) << φs[i] << " " << nn << " " << mc;
+        if (i <= iend) {
+          auto const& expected_entry = xeldbj_expected.entry(expected_index);
+          EXPECT_THAT(batch_b[i],
+                      AlmostEquals(expected_entry.value(0) * Radian, 0, 8));
+          EXPECT_THAT(batch_d[i],
+                      AlmostEquals(expected_entry.value(1) * Radian, 0, 97));
+          EXPECT_THAT(batch_j[i],
+                      AlmostEquals(expected_entry.value(2) * Radian, 0, 135));
+          ++expected_index;
+        }
+      }
+    }
+  }
+}
+
 TEST_F(EllipticIntegralsTest, MathematicaBivariate) {
   auto const bivariate_elliptic_integrals_expected = ReadFromTabulatedData(
       SOLUTION_DIR / "numerics" / "bivariate_elliptic_integrals.proto.txt");
@@ -3,6 +3,8 @@
 
 #include <pmmintrin.h>
 
+#include <cstdint>
+
 #include "base/macros.hpp"
 #include "numerics/polynomial.hpp"
 #include "numerics/polynomial_evaluators.hpp"
@@ -33,12 +35,14 @@ double const s₅ = 79.5314110676979262924240784281 / (4 * 16 * 16);
 
 // The cosine polynomial for 16 z² ⟼ (Cos(2 π z) - 1)/(16 z²) is turned into a
 // polynomial for 16 z² ⟼ Cos(2 π z) by multiplying by the argument and adding
-// 1, i.e., prepending 1 to the list of coefficients.
-P3 cos_polynomial(P3::Coefficients{
-    1.0,
-    -19.7391672615468690589481752820 / 16,
-    64.9232282990046449731568966307 / (16 * 16),
-    -83.6659064641344641438100039739 / (16 * 16 * 16)});
+// 1, i.e., prepending 1 to the list of coefficients.  The coefficients are
+// named for the vectorized evaluation.  The polynomial for Cos(2 π y/4) is
+// c₀ + c₂ y² + c₄ y⁴ + c₆ y⁶.
+double const c₀ = 1.0;
+double const c₂ = -19.7391672615468690589481752820 / 16;
+double const c₄ = 64.9232282990046449731568966307 / (16 * 16);
+double const c₆ = -83.6659064641344641438100039739 / (16 * 16 * 16);
+P3 cos_polynomial(P3::Coefficients{c₀, c₂, c₄, c₆});
 
 struct Decomposition {
   std::int64_t integer_part;
@@ -102,5 +106,67 @@ void FastSinCos2π(double const cycles, double& sin, double& cos) {
   }
 }
 
+void FastSinCos2π(double const* const cycles,
+                  int const size,
+                  double* const sin,
+                  double* const cos) {
+  int i = 0;
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  static __m128d const sign_bit =
+      _mm_castsi128_pd(_mm_set1_epi64x(0x8000'0000'0000'0000));
+  __m128d const s₁_128d = _mm_set1_pd(s₁);
+  __m128d const s₃_128d = _mm_set1_pd(s₃);
+  __m128d const s₅_128d = _mm_set1_pd(s₅);
+  __m128d const c₀_128d = _mm_set1_pd(c₀);
+  __m128d const c₂_128d = _mm_set1_pd(c₂);
+  __m128d const c₄_128d = _mm_set1_pd(c₄);
+  __m128d const c₆_128d = _mm_set1_pd(c₆);
+  for (; i + 1 < size; i += 2) {
+    // The argument reduction of the scalar function, for each lane.  There is
+    // no packed conversion to 64-bit integers.
+    __m128d const x = _mm_mul_pd(_mm_set1_pd(4.0), _mm_loadu_pd(&cycles[i]));
+    std::int64_t const n₀ = _mm_cvtsd_si64(x);
+    std::int64_t const n₁ = _mm_cvtsd_si64(_mm_unpackhi_pd(x, x));
+    __m128d const y = _mm_sub_pd(
+        x,
+        _mm_unpacklo_pd(_mm_cvtsi64_sd(__m128d{}, n₀),
+                        _mm_cvtsi64_sd(__m128d{}, n₁)));
+    __m128d const y² = _mm_mul_pd(y, y);
+    __m128d const y³ = _mm_mul_pd(y², y);
+    __m128d const y⁴ = _mm_mul_pd(y², y²);
+
+    // The same evaluations as in the scalar function.
+    __m128d const s = _mm_add_pd(
+        _mm_mul_pd(s₁_128d, y),
+        _mm_mul_pd(_mm_add_pd(s₃_128d, _mm_mul_pd(s₅_128d, y²)), y³));
+    __m128d const c = _mm_add_pd(
+        _mm_add_pd(c₀_128d, _mm_mul_pd(y², c₂_128d)),
+        _mm_mul_pd(y⁴, _mm_add_pd(c₄_128d, _mm_mul_pd(y², c₆_128d))));
+
+    // The quadrant selection, without branches: the odd quadrants swap the
+    // sine and the cosine, the quadrants 2 and 3 change the sign of the sine,
+    // and the quadrants 1 and 2 change the sign of the cosine.
+    __m128d const swap = _mm_castsi128_pd(
+        _mm_set_epi64x(-(n₁ & 0b1), -(n₀ & 0b1)));
+    __m128d const sin_sign = _mm_and_pd(
+        sign_bit,
+        _mm_castsi128_pd(_mm_set_epi64x(-(n₁ & 0b10), -(n₀ & 0b10))));
+    __m128d const cos_sign = _mm_and_pd(
+        sign_bit,
+        _mm_castsi128_pd(
+            _mm_set_epi64x(-((n₁ + 1) & 0b10), -((n₀ + 1) & 0b10))));
+    __m128d const sin_unsigned =
+        _mm_or_pd(_mm_and_pd(swap, c), _mm_andnot_pd(swap, s));
+    __m128d const cos_unsigned =
+        _mm_or_pd(_mm_and_pd(swap, s), _mm_andnot_pd(swap, c));
+    _mm_storeu_pd(&sin[i], _mm_xor_pd(sin_sign, sin_unsigned));
+    _mm_storeu_pd(&cos[i], _mm_xor_pd(cos_sign, cos_unsigned));
+  }
+#endif
+  for (; i < size; ++i) {
+    FastSinCos2π(cycles[i], sin[i], cos[i]);
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
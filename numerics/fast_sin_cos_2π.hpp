@@ -9,5 +9,11 @@ namespace numerics {
 // cycles.  The argument must be in the range of the 64-bit integers.
 void FastSinCos2π(double cycles, double& sin, double& cos);
 
+// Same as above for the |size| arguments |cycles|, with the results stored in
+// |sin| and |cos|, which must have room for |size| values.  The arguments are
+// processed two at a time with SSE and the results are identical to those of
+// the scalar function.
+void FastSinCos2π(double const* cycles, int size, double* sin, double* cos);
+
 }  // namespace numerics
 }  // namespace principia
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <random>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
@@ -147,5 +148,26 @@ TEST_F(FastSinCos2πTest, Monotonicity) {
   EXPECT_LT(max_cos_error, 4e-16);
 }
 
+// The vectorized function gives the same results as the scalar one, including
+// for the argument reduction and for an odd number of arguments.
+TEST_F(FastSinCos2πTest, Array) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1e6, 1e6);
+  std::vector<double> cycles = {0.0, 0.25, 0.5, 0.75, 1.0, -0.25, -0.5};
+  for (int i = 0; i < 10'001; ++i) {
+    cycles.push_back(distribution(random));
+  }
+  std::vector<double> sin(cycles.size());
+  std::vector<double> cos(cycles.size());
+  FastSinCos2π(cycles.data(), cycles.size(), sin.data(), cos.data());
+  for (int i = 0; i < cycles.size(); ++i) {
+    double scalar_sin;
+    double scalar_cos;
+    FastSinCos2π(cycles[i], scalar_sin, scalar_cos);
+    EXPECT_EQ(scalar_sin, sin[i]) << cycles[i];
+    EXPECT_EQ(scalar_cos, cos[i]) << cycles[i];
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -16,8 +16,13 @@ namespace internal_newhall {
 
 using base::not_null;
 using geometry::Instant;
+using quantities::Time;
 using quantities::Variation;
 
+// Only supports 8 divisions for now.
+constexpr int divisions = 8;
+constexpr int max_degree = 17;
+
 // Computes a Newhall approximation of the given |degree| in the Чебышёв basis.
 // |q| and |v| are the positions and velocities over a constant division of
 // [t_min, t_max].  |error_estimate| gives an estimate of the error between the
@@ -56,10 +61,85 @@ NewhallApproximationInMonomialBasis(int degree,
                                     Instant const& t_max,
                                     Vector& error_estimate);
 
+// A batch of functions sampled over the same constant division of
+// [t_min, t_max], e.g., the positions of all the bodies of an ephemeris over a
+// step.  The samples of each function are packed once, symmetrized with respect
+// to the middle of the interval, in an aligned matrix.  The approximation of a
+// function, or its error estimate, is then the product of that matrix with a
+// Newhall matrix having half as many columns, vectorized over pairs of
+// coordinates.  Each function is approximated separately, possibly with its
+// own degree.
+// The error estimates agree with those of the preceding functions to within an
+// ULP of the samples.  The approximations do not agree as closely, because the
+// symmetrization changes the rounding of the coefficients, which is amplified
+// by the conversion to the monomial basis: the relative error between the
+// values of the polynomials grows with the degree and is about 1e-9 for the
+// maximal degree.
+template<typename Vector>
+class NewhallBatch final {
+ public:
+  NewhallBatch(Instant const& t_min, Instant const& t_max);
+
+  // Removes all the functions from the batch and changes its interval to
+  // [t_min, t_max].  The memory of the batch is retained, so a batch should be
+  // reused for successive intervals.
+  void Reset(Instant const& t_min, Instant const& t_max);
+
+  // Adds to the batch the function having the positions |q| and velocities
+  // |v|.  Its index in the batch is the previous value of |size()|.
+  void Add(std::vector<Vector> const& q,
+           std::vector<Variation<Vector>> const& v);
+
+  int size() const;
+
+  // Returns the error estimate of the approximation of the given |degree| of
+  // the function at |index|.  This only computes one coefficient and is much
+  // cheaper than computing the approximation, so it should be used to choose
+  // the degree before fitting.
+  Vector ErrorEstimate(int index, int degree) const;
+
+  // Returns the approximation in the monomial basis of the given |degree| of
+  // the function at |index|, and its |error_estimate|.
+  template<template<typename, typename, int> class Evaluator>
+  not_null<std::unique_ptr<Polynomial<Vector, Instant>>>
+  ApproximationInMonomialBasis(int index,
+                               int degree,
+                               Vector& error_estimate) const;
+
+ private:
+  // Two coordinates of the samples of a function.  The Newhall matrices are
+  // symmetric or antisymmetric with respect to the middle of the interval,
+  // depending on the parity of the row, so the rows are multiplied by the sums
+  // and differences of the samples symmetric with respect to the middle, which
+  // halves the number of operations.  The values for the two coordinates are
+  // adjacent so that they may be processed in one SSE register.
+  struct alignas(16) Panel {
+    // The samples for the rows of even index.
+    double even[divisions + 1][2];
+    // The samples for the rows of odd index.
+    double odd[divisions + 1][2];
+  };
+
+  // Multiplies the rows [first_row, last_row[ of a symmetrized Newhall
+  // |matrix| by the panels of the function at |index|.  Row |n| of the product
+  // for the panel |p| is stored in |product[p][n]|.
+  void Multiply(double const* matrix,
+                int first_row,
+                int last_row,
+                int index,
+                double (*product)[max_degree + 1][2]) const;
+
+  Instant t_min_;
+  Instant t_max_;
+  Time duration_over_two_;
+  std::vector<Panel> panels_;
+};
+
 }  // namespace internal_newhall
 
 using internal_newhall::NewhallApproximationInЧебышёвBasis;
 using internal_newhall::NewhallApproximationInMonomialBasis;
+using internal_newhall::NewhallBatch;
 
 }  // namespace numerics
 }  // namespace principia
@@ -2,9 +2,15 @@
 
 #include "numerics/newhall.hpp"
 
+#include <pmmintrin.h>
+
+#include <algorithm>
 #include <vector>
 
+#include "base/macros.hpp"
 #include "geometry/barycentre_calculator.hpp"
+#include "geometry/grassmann.hpp"
+#include "geometry/r3_element.hpp"
 #include "glog/logging.h"
 #include "numerics/fixed_arrays.hpp"
 #include "quantities/elementary_functions.hpp"
@@ -16,12 +22,11 @@ namespace internal_newhall {
 
 using base::make_not_null_unique;
 using geometry::Barycentre;
+using geometry::Multivector;
+using geometry::R3Element;
 using quantities::Exponentiation;
 using quantities::Frequency;
-using quantities::Time;
-
-// Only supports 8 divisions for now.
-constexpr int divisions = 8;
+using quantities::SIUnit;
 
 template<typename Vector, int degree,
          template<typename, typename, int> class Evaluator>
@@ -264,6 +269,327 @@ NewhallApproximationInMonomialBasis(int degree,
 
 #undef PRINCIPIA_NEWHALL_APPROXIMATION_IN_MONOMIAL_BASIS_CASE
 
+#define PRINCIPIA_NEWHALL_MATRIX_CASE(basis, degree)                          \
+  case (degree):                                                              \
+    return newhall_c_matrix_##basis##_degree_##degree##_divisions_8_w04[0]
+
+// Defines a function |Newhall<name>Matrix| returning the Newhall matrix of the
+// given degree in the given |basis|, in row-major order.
+#define PRINCIPIA_NEWHALL_MATRIX(name, basis)                                 \
+  inline double const* Newhall##name##Matrix(int const degree) {              \
+    switch (degree) {                                                         \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 3);                                \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 4);                                \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 5);                                \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 6);                                \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 7);                                \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 8);                                \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 9);                                \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 10);                               \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 11);                               \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 12);                               \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 13);                               \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 14);                               \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 15);                               \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 16);                               \
+      PRINCIPIA_NEWHALL_MATRIX_CASE(basis, 17);                               \
+      default:                                                                \
+        LOG(FATAL) << "Unexpected degree " << degree;                         \
+        return nullptr;                                                       \
+    }                                                                         \
+  }
+
+PRINCIPIA_NEWHALL_MATRIX(Чебышёв, чебышёв)
+PRINCIPIA_NEWHALL_MATRIX(Monomial, monomial)
+
+#undef PRINCIPIA_NEWHALL_MATRIX
+#undef PRINCIPIA_NEWHALL_MATRIX_CASE
+
+// The Newhall matrices of all the degrees restricted to the columns that
+// multiply the symmetrized samples of a |NewhallBatch|: for each row, the
+// entries for q and v of the samples in the first half of the interval,
+// followed by the entry for q (even rows) or v (odd rows) of the middle sample.
+class SymmetrizedNewhallMatrices final {
+ public:
+  explicit SymmetrizedNewhallMatrices(
+      double const* (*const newhall_matrix)(int degree)) {
+    constexpr int columns = 2 * divisions + 2;
+    for (int degree = 3; degree <= max_degree; ++degree) {
+      double const* const matrix = newhall_matrix(degree);
+      for (int n = 0; n <= degree; ++n) {
+        double const* const row = &matrix[n * columns];
+        double* const symmetrized_row = entries_[degree][n];
+        std::copy(row, row + divisions, symmetrized_row);
+        symmetrized_row[divisions] = row[divisions + n % 2];
+      }
+    }
+  }
+
+  // The matrix for the given |degree|, in row-major order.
+  double const* operator[](int const degree) const {
+    DCHECK_LE(3, degree);
+    DCHECK_LE(degree, max_degree);
+    return entries_[degree][0];
+  }
+
+ private:
+  double entries_[max_degree + 1][max_degree + 1][divisions + 1] = {};
+};
+
+inline SymmetrizedNewhallMatrices const& SymmetrizedNewhallЧебышёвMatrices() {
+  static SymmetrizedNewhallMatrices const matrices(&NewhallЧебышёвMatrix);
+  return matrices;
+}
+
+inline SymmetrizedNewhallMatrices const& SymmetrizedNewhallMonomialMatrices() {
+  static SymmetrizedNewhallMatrices const matrices(&NewhallMonomialMatrix);
+  return matrices;
+}
+
+// The conversion between the values of the functions and their coordinates in
+// the panels of |NewhallBatch|.
+template<typename Vector>
+struct PackedCoordinates {
+  static constexpr int dimension = 1;
+
+  static void Pack(Vector const& value, double* const coordinates) {
+    coordinates[0] = value / SIUnit<Vector>();
+  }
+
+  static Vector Unpack(double const* const coordinates) {
+    return coordinates[0] * SIUnit<Vector>();
+  }
+};
+
+template<typename Scalar, typename Frame, int rank>
+struct PackedCoordinates<Multivector<Scalar, Frame, rank>> {
+  static constexpr int dimension = 3;
+
+  static void Pack(Multivector<Scalar, Frame, rank> const& value,
+                   double* const coordinates) {
+    R3Element<Scalar> const& r3_element = value.coordinates();
+    coordinates[0] = r3_element.x / SIUnit<Scalar>();
+    coordinates[1] = r3_element.y / SIUnit<Scalar>();
+    coordinates[2] = r3_element.z / SIUnit<Scalar>();
+  }
+
+  static Multivector<Scalar, Frame, rank> Unpack(
+      double const* const coordinates) {
+    return Multivector<Scalar, Frame, rank>(
+        R3Element<Scalar>(coordinates[0] * SIUnit<Scalar>(),
+                          coordinates[1] * SIUnit<Scalar>(),
+                          coordinates[2] * SIUnit<Scalar>()));
+  }
+};
+
+// The number of panels occupied by each function of a |NewhallBatch|.  The
+// panels are not shared between functions so that the functions may be fitted
+// with different degrees.
+template<typename Vector>
+constexpr int panels_per_function =
+    (PackedCoordinates<Vector>::dimension + 1) / 2;
+
+// The row |n| of the product of a Newhall matrix with the panels of a function.
+template<typename Vector>
+Vector UnpackRow(double const (*const product)[max_degree + 1][2],
+                 int const n) {
+  constexpr int dimension = PackedCoordinates<Vector>::dimension;
+  double coordinates[dimension];
+  for (int d = 0; d < dimension; ++d) {
+    coordinates[d] = product[d / 2][n][d % 2];
+  }
+  return PackedCoordinates<Vector>::Unpack(coordinates);
+}
+
+template<typename Vector, int degree,
+         template<typename, typename, int> class Evaluator>
+not_null<std::unique_ptr<Polynomial<Vector, Instant>>>
+UnpackApproximationInMonomialBasis(
+    double const (*const product)[max_degree + 1][2],
+    Frequency const& scale,
+    Instant const& origin) {
+  FixedVector<Vector, degree + 1> homogeneous_coefficients;
+  for (int n = 0; n <= degree; ++n) {
+    homogeneous_coefficients[n] = UnpackRow<Vector>(product, n);
+  }
+  return make_not_null_unique<
+      PolynomialInMonomialBasis<Vector, Instant, degree, Evaluator>>(
+      Dehomogeneize<Vector, degree, Evaluator>(
+          homogeneous_coefficients, scale, origin));
+}
+
+template<typename Vector>
+NewhallBatch<Vector>::NewhallBatch(Instant const& t_min, Instant const& t_max)
+    : t_min_(t_min),
+      t_max_(t_max),
+      duration_over_two_(0.5 * (t_max - t_min)) {}
+
+template<typename Vector>
+void NewhallBatch<Vector>::Reset(Instant const& t_min, Instant const& t_max) {
+  t_min_ = t_min;
+  t_max_ = t_max;
+  duration_over_two_ = 0.5 * (t_max - t_min);
+  panels_.clear();
+}
+
+template<typename Vector>
+void NewhallBatch<Vector>::Add(std::vector<Vector> const& q,
+                               std::vector<Variation<Vector>> const& v) {
+  using Coordinates = PackedCoordinates<Vector>;
+  constexpr int dimension = Coordinates::dimension;
+  CHECK_EQ(divisions + 1, q.size());
+  CHECK_EQ(divisions + 1, v.size());
+
+  // Tricky.  The order in Newhall's matrices is such that the entries for the
+  // largest time occur first.
+  double q_coordinates[divisions + 1][dimension];
+  double v_coordinates[divisions + 1][dimension];
+  for (int i = 0; i < divisions + 1; ++i) {
+    Coordinates::Pack(q[i], q_coordinates[divisions - i]);
+    Coordinates::Pack(v[i] * duration_over_two_, v_coordinates[divisions - i]);
+  }
+
+  int const first_panel = panels_.size();
+  panels_.resize(first_panel + panels_per_function<Vector>);
+  for (int d = 0; d < dimension; ++d) {
+    Panel& panel = panels_[first_panel + d / 2];
+    int const lane = d % 2;
+    for (int j = 0; j < divisions / 2; ++j) {
+      int const mirror = divisions - j;
+      panel.even[2 * j][lane] = q_coordinates[j][d] + q_coordinates[mirror][d];
+      panel.even[2 * j + 1][lane] =
+          v_coordinates[j][d] - v_coordinates[mirror][d];
+      panel.odd[2 * j][lane] = q_coordinates[j][d] - q_coordinates[mirror][d];
+      panel.odd[2 * j + 1][lane] =
+          v_coordinates[j][d] + v_coordinates[mirror][d];
+    }
+    panel.even[divisions][lane] = q_coordinates[divisions / 2][d];
+    panel.odd[divisions][lane] = v_coordinates[divisions / 2][d];
+  }
+}
+
+template<typename Vector>
+int NewhallBatch<Vector>::size() const {
+  return panels_.size() / panels_per_function<Vector>;
+}
+
+template<typename Vector>
+Vector NewhallBatch<Vector>::ErrorEstimate(int const index,
+                                           int const degree) const {
+  alignas(16) double product[panels_per_function<Vector>][max_degree + 1][2];
+  // The error estimate is the highest-degree coefficient in the Чебышёв basis.
+  Multiply(SymmetrizedNewhallЧебышёвMatrices()[degree],
+           /*first_row=*/degree,
+           /*last_row=*/degree + 1,
+           index,
+           product);
+  return UnpackRow<Vector>(product, degree);
+}
+
+#define PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(degree) \
+  case (degree):                                                             \
+    return UnpackApproximationInMonomialBasis<Vector, (degree), Evaluator>(  \
+        product, /*scale=*/1.0 / duration_over_two_, t_mid)
+
+template<typename Vector>
+template<template<typename, typename, int> class Evaluator>
+not_null<std::unique_ptr<Polynomial<Vector, Instant>>>
+NewhallBatch<Vector>::ApproximationInMonomialBasis(
+    int const index,
+    int const degree,
+    Vector& error_estimate) const {
+  alignas(16) double product[panels_per_function<Vector>][max_degree + 1][2];
+  Multiply(SymmetrizedNewhallMonomialMatrices()[degree],
+           /*first_row=*/0,
+           /*last_row=*/degree + 1,
+           index,
+           product);
+  error_estimate = ErrorEstimate(index, degree);
+
+  Instant const t_mid = Barycentre<Instant, double>({t_min_, t_max_}, {1, 1});
+  switch (degree) {
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(3);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(4);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(5);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(6);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(7);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(8);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(9);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(10);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(11);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(12);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(13);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(14);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(15);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(16);
+    PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE(17);
+    default:
+      LOG(FATAL) << "Unexpected degree " << degree;
+      break;
+  }
+}
+
+#undef PRINCIPIA_NEWHALL_BATCH_APPROXIMATION_IN_MONOMIAL_BASIS_CASE
+
+template<typename Vector>
+void NewhallBatch<Vector>::Multiply(
+    double const* const matrix,
+    int const first_row,
+    int const last_row,
+    int const index,
+    double (* const product)[max_degree + 1][2]) const {
+  constexpr int columns = divisions + 1;
+  constexpr int panels = panels_per_function<Vector>;
+  DCHECK_LE(0, index);
+  DCHECK_LT(index, size());
+  Panel const* const panel = &panels_[index * panels];
+  // Two rows are processed at once to have independent sums.  If the number of
+  // rows is odd the last row is computed twice.
+  for (int n0 = first_row; n0 < last_row; n0 += 2) {
+    int const n1 = std::min(n0 + 1, last_row - 1);
+    double const* const row0 = &matrix[n0 * columns];
+    double const* const row1 = &matrix[n1 * columns];
+    auto const samples = [panel](int const p, int const n) {
+      return n % 2 == 0 ? panel[p].even : panel[p].odd;
+    };
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+    __m128d sums0[panels];
+    __m128d sums1[panels];
+    for (int p = 0; p < panels; ++p) {
+      sums0[p] = _mm_setzero_pd();
+      sums1[p] = _mm_setzero_pd();
+    }
+    for (int k = 0; k < columns; ++k) {
+      __m128d const m0 = _mm_set1_pd(row0[k]);
+      __m128d const m1 = _mm_set1_pd(row1[k]);
+      for (int p = 0; p < panels; ++p) {
+        sums0[p] = _mm_add_pd(
+            sums0[p], _mm_mul_pd(m0, _mm_load_pd(samples(p, n0)[k])));
+        sums1[p] = _mm_add_pd(
+            sums1[p], _mm_mul_pd(m1, _mm_load_pd(samples(p, n1)[k])));
+      }
+    }
+    for (int p = 0; p < panels; ++p) {
+      _mm_store_pd(product[p][n0], sums0[p]);
+      _mm_store_pd(product[p][n1], sums1[p]);
+    }
+#else
+    for (int p = 0; p < panels; ++p) {
+      for (int lane = 0; lane < 2; ++lane) {
+        double sum0 = 0;
+        double sum1 = 0;
+        for (int k = 0; k < columns; ++k) {
+          sum0 += row0[k] * samples(p, n0)[k][lane];
+          sum1 += row1[k] * samples(p, n1)[k][lane];
+        }
+        product[p][n0][lane] = sum0;
+        product[p][n1][lane] = sum1;
+      }
+    }
+#endif
+  }
+}
+
 }  // namespace internal_newhall
 }  // namespace numerics
 }  // namespace principia
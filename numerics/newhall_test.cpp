@@ -5,6 +5,7 @@
 #include <cmath>
 #include <vector>
 
+#include "astronomy/frames.hpp"
 #include "geometry/named_quantities.hpp"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -21,7 +22,10 @@
 namespace principia {
 namespace numerics {
 
+using astronomy::ICRS;
+using geometry::Displacement;
 using geometry::Instant;
+using geometry::Velocity;
 using quantities::Abs;
 using quantities::Length;
 using quantities::Speed;
@@ -34,6 +38,7 @@ using testing_utilities::ApproximateQuantity;
 using testing_utilities::IsNear;
 using testing_utilities::RelativeError;
 using testing_utilities::operator""_⑴;
+using ::testing::Lt;
 
 // The adapters wrap the result of the Newhall approximation so that they can be
 // used consistently in this test.
@@ -769,5 +774,77 @@ TEST_F(NewhallTest, NonConstantDegree) {
                               length_function_1_(t_min_)), IsNear(9e-13_⑴));
 }
 
+// The batch gives the same results as the approximations of the individual
+// functions.
+TEST_F(NewhallTest, Batch) {
+  std::vector<std::vector<Displacement<ICRS>>> displacements(2);
+  std::vector<std::vector<Velocity<ICRS>>> velocities(2);
+  std::vector<Length> lengths;
+  std::vector<Speed> speeds;
+  for (Instant t = t_min_; t <= t_max_; t += 0.5 * Second) {
+    displacements[0].push_back(Displacement<ICRS>({length_function_1_(t),
+                                                   length_function_2_(t),
+                                                   -length_function_1_(t)}));
+    velocities[0].push_back(Velocity<ICRS>({speed_function_1_(t),
+                                            speed_function_2_(t),
+                                            -speed_function_1_(t)}));
+    displacements[1].push_back(Displacement<ICRS>({length_function_2_(t),
+                                                   -length_function_1_(t),
+                                                   length_function_2_(t)}));
+    velocities[1].push_back(Velocity<ICRS>({speed_function_2_(t),
+                                            -speed_function_1_(t),
+                                            speed_function_2_(t)}));
+    lengths.push_back(length_function_2_(t));
+    speeds.push_back(speed_function_2_(t));
+  }
+
+  {
+    NewhallBatch<Displacement<ICRS>> batch(t_min_, t_max_);
+    batch.Add(displacements[0], velocities[0]);
+    batch.Add(displacements[1], velocities[1]);
+    ASSERT_EQ(2, batch.size());
+    for (int i = 0; i < batch.size(); ++i) {
+      int const degree = i == 0 ? 10 : 17;
+      Displacement<ICRS> batch_error_estimate;
+      auto const batch_approximation =
+          batch.ApproximationInMonomialBasis<EstrinEvaluator>(
+              i, degree, batch_error_estimate);
+      Displacement<ICRS> error_estimate;
+      auto const approximation =
+          NewhallApproximationInMonomialBasis<Displacement<ICRS>,
+                                              EstrinEvaluator>(
+              degree,
+              displacements[i], velocities[i],
+              t_min_, t_max_,
+              error_estimate);
+      EXPECT_THAT(AbsoluteError(error_estimate, batch_error_estimate),
+                  Lt(1e-14 * Metre));
+      EXPECT_EQ(batch_error_estimate, batch.ErrorEstimate(i, degree));
+      // The symmetrization changes the rounding of the coefficients, which is
+      // amplified by the conversion to the monomial basis.
+      double const tolerance = degree == 10 ? 1e-12 : 1e-9;
+      for (Instant t = t_min_; t <= t_max_; t += 0.05 * Second) {
+        EXPECT_THAT(RelativeError(approximation->Evaluate(t),
+                                  batch_approximation->Evaluate(t)),
+                    Lt(tolerance));
+      }
+    }
+  }
+
+  {
+    NewhallBatch<Length> batch(t_min_, t_max_);
+    batch.Add(lengths, speeds);
+    for (int degree = 3; degree <= 17; ++degree) {
+      Length error_estimate;
+      NewhallApproximationInЧебышёвBasis(degree,
+                                         lengths, speeds,
+                                         t_min_, t_max_,
+                                         error_estimate);
+      EXPECT_THAT(AbsoluteError(error_estimate, batch.ErrorEstimate(0, degree)),
+                  Lt(1e-14 * Metre)) << degree;
+    }
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -54,6 +54,22 @@ class Polynomial {
   template<template<typename, typename, int> class Evaluator>
   static not_null<std::unique_ptr<Polynomial>> ReadFromMessage(
       serialization::Polynomial const& message);
+
+  // Appends this polynomial to |message|.
+  virtual void WriteToMessage(
+      not_null<serialization::PackedPolynomials*> message) const = 0;
+
+  // Reads the polynomial at |index| in |message|, whose block starts at
+  // |block_index|, and advances |block_index| to the next block.
+  template<template<typename, typename, int> class Evaluator>
+  static not_null<std::unique_ptr<Polynomial>> ReadFromMessage(
+      serialization::PackedPolynomials const& message,
+      int index,
+      int& block_index);
+
+  // The size of the block of a polynomial of the given |degree| in a
+  // |serialization::PackedPolynomials|.
+  static int PackedBlockSize(int degree);
 };
 
 template<typename Value, typename Argument, int degree_,
@@ -87,6 +103,13 @@ class PolynomialInMonomialBasis : public Polynomial<Value, Argument> {
   static PolynomialInMonomialBasis ReadFromMessage(
       serialization::Polynomial const& message);
 
+  void WriteToMessage(
+      not_null<serialization::PackedPolynomials*> message) const override;
+  static PolynomialInMonomialBasis ReadFromMessage(
+      serialization::PackedPolynomials const& message,
+      int index,
+      int& block_index);
+
  private:
   Coefficients coefficients_;
 
@@ -155,6 +178,13 @@ class PolynomialInMonomialBasis<Value, Point<Argument>, degree_, Evaluator>
   static PolynomialInMonomialBasis ReadFromMessage(
       serialization::Polynomial const& message);
 
+  void WriteToMessage(
+      not_null<serialization::PackedPolynomials*> message) const override;
+  static PolynomialInMonomialBasis ReadFromMessage(
+      serialization::PackedPolynomials const& message,
+      int index,
+      int& block_index);
+
  private:
   Coefficients coefficients_;
   Point<Argument> origin_;
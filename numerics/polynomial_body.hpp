@@ -9,6 +9,7 @@
 #include "base/not_constructible.hpp"
 #include "geometry/cartesian_product.hpp"
 #include "geometry/serialization.hpp"
+#include "google/protobuf/repeated_field.h"
 #include "numerics/combinatorics.hpp"
 
 namespace principia {
@@ -18,11 +19,13 @@ namespace internal_polynomial {
 using base::make_not_null_unique;
 using base::not_constructible;
 using geometry::DoubleOrQuantityOrMultivectorSerializer;
+using geometry::PackedSerializer;
 using geometry::cartesian_product::operator+;
 using geometry::cartesian_product::operator-;
 using geometry::cartesian_product::operator*;
 using geometry::cartesian_product::operator/;
 using geometry::polynomial_ring::operator*;
+using google::protobuf::RepeatedField;
 using quantities::Apply;
 
 template<typename Tuple, int order,
@@ -50,6 +53,11 @@ struct TupleSerializer : not_constructible {
   static void FillFromMessage(
       serialization::PolynomialInMonomialBasis const& message,
       Tuple& tuple);
+  static void WriteToField(Tuple const& tuple,
+                           not_null<RepeatedField<double>*> field);
+  static void FillFromField(RepeatedField<double> const& field,
+                            int& index,
+                            Tuple& tuple);
 };
 
 template<typename Tuple, int size>
@@ -60,6 +68,11 @@ struct TupleSerializer<Tuple, size, size> : not_constructible {
   static void FillFromMessage(
       serialization::PolynomialInMonomialBasis const& message,
       Tuple& tuple);
+  static void WriteToField(Tuple const& tuple,
+                           not_null<RepeatedField<double>*> field);
+  static void FillFromField(RepeatedField<double> const& field,
+                            int& index,
+                            Tuple& tuple);
 };
 
 template<typename Tuple, int k, int size>
@@ -85,6 +98,26 @@ void TupleSerializer<Tuple, k, size>::FillFromMessage(
   TupleSerializer<Tuple, k + 1, size>::FillFromMessage(message, tuple);
 }
 
+template<typename Tuple, int k, int size>
+void TupleSerializer<Tuple, k, size>::WriteToField(
+    Tuple const& tuple,
+    not_null<RepeatedField<double>*> const field) {
+  PackedSerializer<std::tuple_element_t<k, Tuple>>::WriteToField(
+      std::get<k>(tuple), field);
+  TupleSerializer<Tuple, k + 1, size>::WriteToField(tuple, field);
+}
+
+template<typename Tuple, int k, int size>
+void TupleSerializer<Tuple, k, size>::FillFromField(
+    RepeatedField<double> const& field,
+    int& index,
+    Tuple& tuple) {
+  std::get<k>(tuple) =
+      PackedSerializer<std::tuple_element_t<k, Tuple>>::ReadFromField(field,
+                                                                      index);
+  TupleSerializer<Tuple, k + 1, size>::FillFromField(field, index, tuple);
+}
+
 template<typename Tuple, int size>
 void TupleSerializer<Tuple, size, size>::WriteToMessage(
     Tuple const& tuple,
@@ -95,6 +128,26 @@ void TupleSerializer<Tuple, size, size>::FillFromMessage(
     serialization::PolynomialInMonomialBasis const& message,
     Tuple& tuple) {}
 
+template<typename Tuple, int size>
+void TupleSerializer<Tuple, size, size>::WriteToField(
+    Tuple const& tuple,
+    not_null<RepeatedField<double>*> const field) {}
+
+template<typename Tuple, int size>
+void TupleSerializer<Tuple, size, size>::FillFromField(
+    RepeatedField<double> const& field,
+    int& index,
+    Tuple& tuple) {}
+
+// The number of doubles used by the origin of a polynomial in a
+// |serialization::PackedPolynomials|.
+template<typename Argument>
+constexpr int packed_origin_size = 0;
+
+template<typename Argument>
+constexpr int packed_origin_size<Point<Argument>> =
+    PackedSerializer<Point<Argument>>::size;
+
 
 #define PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(value)                  \
   case value:                                                          \
@@ -142,6 +195,61 @@ Polynomial<Value, Argument>::ReadFromMessage(
 
 #undef PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE
 
+#define PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(value)                  \
+  case value:                                                          \
+    return make_not_null_unique<                                       \
+        PolynomialInMonomialBasis<Value, Argument, value, Evaluator>>( \
+        PolynomialInMonomialBasis<Value, Argument, value, Evaluator>:: \
+            ReadFromMessage(message, index, block_index))
+
+template<typename Value, typename Argument>
+template<template<typename, typename, int> class Evaluator>
+not_null<std::unique_ptr<Polynomial<Value, Argument>>>
+Polynomial<Value, Argument>::ReadFromMessage(
+    serialization::PackedPolynomials const& message,
+    int const index,
+    int& block_index) {
+  // Same degrees as for |serialization::Polynomial|.
+  switch (message.degree(index)) {
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(1);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(2);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(3);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(4);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(5);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(6);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(7);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(8);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(9);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(10);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(11);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(12);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(13);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(14);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(15);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(16);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(17);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(18);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(19);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(20);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(21);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(22);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(23);
+    PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE(24);
+    default:
+      LOG(FATAL) << "Unexpected degree " << message.degree(index);
+      break;
+  }
+}
+
+#undef PRINCIPIA_POLYNOMIAL_DEGREE_VALUE_CASE
+
+template<typename Value, typename Argument>
+int Polynomial<Value, Argument>::PackedBlockSize(int const degree) {
+  // The derivatives of |Value| have as many coordinates as |Value|.
+  return packed_origin_size<Argument> +
+         (degree + 1) * PackedSerializer<Value>::size;
+}
+
 template<typename Value, typename Argument, int degree_,
          template<typename, typename, int> class Evaluator>
 constexpr PolynomialInMonomialBasis<Value, Argument, degree_, Evaluator>::
@@ -214,6 +322,32 @@ PolynomialInMonomialBasis<Value, Argument, degree_, Evaluator>::ReadFromMessage(
   return PolynomialInMonomialBasis(coefficients);
 }
 
+template<typename Value, typename Argument, int degree_,
+         template<typename, typename, int> class Evaluator>
+void PolynomialInMonomialBasis<Value, Argument, degree_, Evaluator>::
+    WriteToMessage(
+        not_null<serialization::PackedPolynomials*> const message) const {
+  message->add_degree(degree_);
+  TupleSerializer<Coefficients, 0>::WriteToField(coefficients_,
+                                                 message->mutable_block());
+}
+
+template<typename Value, typename Argument, int degree_,
+         template<typename, typename, int> class Evaluator>
+PolynomialInMonomialBasis<Value, Argument, degree_, Evaluator>
+PolynomialInMonomialBasis<Value, Argument, degree_, Evaluator>::ReadFromMessage(
+    serialization::PackedPolynomials const& message,
+    int const index,
+    int& block_index) {
+  CHECK_EQ(degree_, message.degree(index));
+  int const block_size = Polynomial<Value, Argument>::PackedBlockSize(degree_);
+  CHECK_LE(block_index + block_size, message.block_size());
+  Coefficients coefficients;
+  TupleSerializer<Coefficients, 0>::FillFromField(
+      message.block(), block_index, coefficients);
+  return PolynomialInMonomialBasis(coefficients);
+}
+
 template<typename Value, typename Argument, int degree_,
          template<typename, typename, int> class Evaluator>
 constexpr
@@ -278,6 +412,38 @@ ReadFromMessage(serialization::Polynomial const& message) {
   return PolynomialInMonomialBasis(coefficients, origin);
 }
 
+template<typename Value, typename Argument, int degree_,
+         template<typename, typename, int> class Evaluator>
+void PolynomialInMonomialBasis<Value, Point<Argument>, degree_, Evaluator>::
+    WriteToMessage(
+        not_null<serialization::PackedPolynomials*> const message) const {
+  message->add_degree(degree_);
+  PackedSerializer<Point<Argument>>::WriteToField(origin_,
+                                                  message->mutable_block());
+  TupleSerializer<Coefficients, 0>::WriteToField(coefficients_,
+                                                 message->mutable_block());
+}
+
+template<typename Value, typename Argument, int degree_,
+         template<typename, typename, int> class Evaluator>
+PolynomialInMonomialBasis<Value, Point<Argument>, degree_, Evaluator>
+PolynomialInMonomialBasis<Value, Point<Argument>, degree_, Evaluator>::
+ReadFromMessage(serialization::PackedPolynomials const& message,
+                int const index,
+                int& block_index) {
+  CHECK_EQ(degree_, message.degree(index));
+  int const block_size =
+      Polynomial<Value, Point<Argument>>::PackedBlockSize(degree_);
+  CHECK_LE(block_index + block_size, message.block_size());
+  auto const origin =
+      PackedSerializer<Point<Argument>>::ReadFromField(message.block(),
+                                                       block_index);
+  Coefficients coefficients;
+  TupleSerializer<Coefficients, 0>::FillFromField(
+      message.block(), block_index, coefficients);
+  return PolynomialInMonomialBasis(coefficients, origin);
+}
+
 template<typename Value, typename Argument, int ldegree_, int rdegree_,
          template<typename, typename, int> class Evaluator>
 FORCE_INLINE(constexpr)
@@ -2,10 +2,12 @@
 #include "numerics/polynomial.hpp"
 
 #include <tuple>
+#include <vector>
 
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/named_quantities.hpp"
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "numerics/polynomial_evaluators.hpp"
 #include "quantities/constants.hpp"
@@ -48,6 +50,7 @@ using quantities::si::Second;
 using quantities::si::Watt;
 using testing_utilities::AlmostEquals;
 using testing_utilities::EqualsProto;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 
 namespace numerics {
@@ -351,6 +354,61 @@ TEST_F(PolynomialTest, Serialization) {
   }
 }
 
+TEST_F(PolynomialTest, PackedSerialization) {
+  P2V p2v(coefficients_);
+  P2A p2a(coefficients_, Instant() + 3 * Second);
+  P17::Coefficients const coefficients;
+  P17 p17(coefficients);
+  serialization::PackedPolynomials message;
+  p2v.WriteToMessage(&message);
+  p17.WriteToMessage(&message);
+  EXPECT_THAT(message.degree(), ElementsAre(2, 17));
+  EXPECT_EQ(9 + 54, message.block_size());
+  EXPECT_EQ(9 + 54,
+            (Polynomial<Displacement<World>, Time>::PackedBlockSize(2) +
+             Polynomial<Displacement<World>, Time>::PackedBlockSize(17)));
+  EXPECT_THAT(std::vector<double>(message.block().begin(),
+                                  message.block().begin() + 9),
+              ElementsAre(0, 0, 1, 0, 1, 0, 1, 0, 0));
+
+  int block_index = 0;
+  auto const p2v_read =
+      Polynomial<Displacement<World>, Time>::ReadFromMessage<HornerEvaluator>(
+          message, /*index=*/0, block_index);
+  EXPECT_EQ(9, block_index);
+  auto const p17_read =
+      Polynomial<Displacement<World>, Time>::ReadFromMessage<HornerEvaluator>(
+          message, /*index=*/1, block_index);
+  EXPECT_EQ(message.block_size(), block_index);
+  EXPECT_EQ(2, p2v_read->degree());
+  EXPECT_THAT(
+      p2v_read->Evaluate(0.5 * Second),
+      AlmostEquals(
+          Displacement<World>({0.25 * Metre, 0.5 * Metre, 1 * Metre}), 0));
+  EXPECT_EQ(17, p17_read->degree());
+  serialization::PackedPolynomials message2;
+  p2v_read->WriteToMessage(&message2);
+  p17_read->WriteToMessage(&message2);
+  EXPECT_THAT(message2, EqualsProto(message));
+
+  // In the affine case the block starts with the origin.
+  message.Clear();
+  p2a.WriteToMessage(&message);
+  EXPECT_EQ(10, message.block_size());
+  EXPECT_EQ(10, (Polynomial<Displacement<World>, Instant>::PackedBlockSize(2)));
+  EXPECT_EQ(3, message.block(0));
+  block_index = 0;
+  auto const p2a_read =
+      Polynomial<Displacement<World>,
+                 Instant>::ReadFromMessage<HornerEvaluator>(message,
+                                                            /*index=*/0,
+                                                            block_index);
+  EXPECT_THAT(
+      p2a_read->Evaluate(Instant() + 3.5 * Second),
+      AlmostEquals(
+          Displacement<World>({0.25 * Metre, 0.5 * Metre, 1 * Metre}), 0));
+}
+
 }  // namespace numerics
 }  // namespace principia
 
@@ -33,6 +33,21 @@ class EvaluationHelper final {
 
   Vector EvaluateImplementation(double scaled_t) const;
 
+  // The number of arguments processed at once by the functions below.
+  static constexpr int batch_size = 4;
+
+  // Evaluate the series, or its derivative with respect to the scaled
+  // argument, at the first |size| elements of |scaled_ts|, and store the
+  // results in |values[0]|, ..., |values[size - 1]|.  All the elements of
+  // |scaled_ts| must be initialized.  The results are identical to those of
+  // the evaluation at a single argument.
+  void EvaluateImplementation(double const (&scaled_ts)[batch_size],
+                              int size,
+                              Vector* values) const;
+  void EvaluateDerivativeImplementation(double const (&scaled_ts)[batch_size],
+                                        int size,
+                                        Vector* values) const;
+
   Vector coefficients(int index) const;
   int degree() const;
 
@@ -69,11 +84,28 @@ class ЧебышёвSeries final {
   Vector Evaluate(Instant const& t) const;
   Variation<Vector> EvaluateDerivative(Instant const& t) const;
 
+  // Same as above, but for all the |times|, which must be in the range
+  // [t_min, t_max].  The Clenshaw recurrence is run for several times at once
+  // using SIMD instructions.  The results are identical to those of the
+  // evaluation at a single time.
+  void Evaluate(std::vector<Instant> const& times,
+                std::vector<Vector>& values) const;
+  void EvaluateDerivative(std::vector<Instant> const& times,
+                          std::vector<Variation<Vector>>& derivatives) const;
+
   void WriteToMessage(not_null<serialization::ЧебышёвSeries*> message) const;
   static ЧебышёвSeries ReadFromMessage(
       serialization::ЧебышёвSeries const& message);
 
  private:
+  // Stores in |scaled_ts| the scaled arguments for the |times| of indices in
+  // [begin, end[, padded with the last one.
+  void ScaleTimes(
+      std::vector<Instant> const& times,
+      int begin,
+      int end,
+      double (&scaled_ts)[EvaluationHelper<Vector>::batch_size]) const;
+
   Instant t_min_;
   Instant t_max_;
   Inverse<Time> one_over_duration_;
@@ -1,14 +1,19 @@
 ﻿
 #include "numerics/чебышёв_series.hpp"
 
+#include <pmmintrin.h>
+
+#include <algorithm>
 #include <vector>
 
+#include "base/macros.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/r3_element.hpp"
 #include "geometry/serialization.hpp"
 #include "glog/logging.h"
 #include "numerics/fixed_arrays.hpp"
 #include "numerics/newhall.mathematica.h"
+#include "quantities/traits.hpp"
 
 namespace principia {
 namespace numerics {
@@ -17,6 +22,7 @@ namespace internal_чебышёв_series {
 using geometry::DoubleOrQuantityOrMultivectorSerializer;
 using geometry::Multivector;
 using geometry::R3Element;
+using quantities::is_quantity;
 using quantities::SIUnit;
 
 // The compiler does a much better job on an |R3Element<double>| than on a
@@ -33,6 +39,16 @@ class EvaluationHelper<Multivector<Scalar, Frame, rank>> final {
   Multivector<Scalar, Frame, rank> EvaluateImplementation(
       double const scaled_t) const;
 
+  static constexpr int batch_size = 4;
+  void EvaluateImplementation(
+      double const (&scaled_ts)[batch_size],
+      int size,
+      Multivector<Scalar, Frame, rank>* values) const;
+  void EvaluateDerivativeImplementation(
+      double const (&scaled_ts)[batch_size],
+      int size,
+      Multivector<Scalar, Frame, rank>* values) const;
+
   Multivector<Scalar, Frame, rank> coefficients(int const index) const;
   int degree() const;
 
@@ -41,6 +57,106 @@ class EvaluationHelper<Multivector<Scalar, Frame, rank>> final {
   int degree_;
 };
 
+// Evaluates the derivative of the series represented by |helper| with respect
+// to the scaled argument.  This is the Clenshaw recurrence for the series
+// Σ (k + 1) cₖ₊₁ Uₖ.
+template<typename Vector>
+Vector EvaluateDerivativeWithHelper(EvaluationHelper<Vector> const& helper,
+                                    double const scaled_t) {
+  double const two_scaled_t = scaled_t + scaled_t;
+  Vector b_kplus2_vector{};
+  Vector b_kplus1_vector{};
+  Vector* b_kplus2 = &b_kplus2_vector;
+  Vector* b_kplus1 = &b_kplus1_vector;
+  Vector* const& b_k = b_kplus2;  // An overlay.
+  for (int k = helper.degree() - 1; k >= 1; --k) {
+    *b_k = helper.coefficients(k + 1) * (k + 1) +
+           two_scaled_t * *b_kplus1 - *b_kplus2;
+    Vector* const last_b_k = b_k;
+    b_kplus2 = b_kplus1;
+    b_kplus1 = last_b_k;
+  }
+  return helper.coefficients(1) + two_scaled_t * *b_kplus1 - *b_kplus2;
+}
+
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+
+// The Clenshaw recurrence for |dimension| components, run for the 4 arguments
+// |scaled_ts| in the lanes of 2 SSE registers.  |coefficient(k, d)| is the
+// component |d| of the coefficient of Tₖ.  If |derivative| is true, computes
+// the derivative with respect to the argument, like
+// |EvaluateDerivativeWithHelper|.  The operations are the same as those of the
+// evaluation at a single argument, so the results are identical.  The results
+// for the first |size| arguments are built by |make_value| from their
+// components and stored in |values|.
+template<int dimension, bool derivative,
+         typename Coefficient, typename MakeValue, typename Value>
+void ClenshawInLanes(Coefficient const& coefficient,
+                     int const degree,
+                     double const (&scaled_ts)[4],
+                     int const size,
+                     MakeValue const& make_value,
+                     Value* const values) {
+  // The coefficient of index |k| of the series actually evaluated, which has
+  // degree |n|.
+  auto const a = [&coefficient](int const k, int const d) {
+    if constexpr (derivative) {
+      return _mm_set1_pd(coefficient(k + 1, d) * (k + 1));
+    } else {
+      return _mm_set1_pd(coefficient(k, d));
+    }
+  };
+  int const n = derivative ? degree - 1 : degree;
+
+  __m128d const scaled_t_01 = _mm_loadu_pd(&scaled_ts[0]);
+  __m128d const scaled_t_23 = _mm_loadu_pd(&scaled_ts[2]);
+  __m128d const two_scaled_t_01 = _mm_add_pd(scaled_t_01, scaled_t_01);
+  __m128d const two_scaled_t_23 = _mm_add_pd(scaled_t_23, scaled_t_23);
+  // a_0 + t b_1 - b_2 for Tₖ, a_0 + 2 t b_1 - b_2 for Uₖ.
+  __m128d const final_scaled_t_01 = derivative ? two_scaled_t_01 : scaled_t_01;
+  __m128d const final_scaled_t_23 = derivative ? two_scaled_t_23 : scaled_t_23;
+
+  // The components are independent, so the recurrences for successive
+  // components may overlap in the processor.
+  alignas(16) double components[4][dimension];
+  for (int d = 0; d < dimension; ++d) {
+    __m128d b_kplus1_01 = _mm_setzero_pd();
+    __m128d b_kplus1_23 = _mm_setzero_pd();
+    __m128d b_kplus2_01 = _mm_setzero_pd();
+    __m128d b_kplus2_23 = _mm_setzero_pd();
+    for (int k = n; k >= 1; --k) {
+      __m128d const a_k = a(k, d);
+      // b_k = a_k + 2 t b_k+1 - b_k+2.
+      __m128d const b_k_01 = _mm_sub_pd(
+          _mm_add_pd(a_k, _mm_mul_pd(two_scaled_t_01, b_kplus1_01)),
+          b_kplus2_01);
+      __m128d const b_k_23 = _mm_sub_pd(
+          _mm_add_pd(a_k, _mm_mul_pd(two_scaled_t_23, b_kplus1_23)),
+          b_kplus2_23);
+      b_kplus2_01 = b_kplus1_01;
+      b_kplus2_23 = b_kplus1_23;
+      b_kplus1_01 = b_k_01;
+      b_kplus1_23 = b_k_23;
+    }
+    __m128d const a_0 = n < 0 ? _mm_setzero_pd() : a(0, d);
+    __m128d const result_01 = _mm_sub_pd(
+        _mm_add_pd(a_0, _mm_mul_pd(final_scaled_t_01, b_kplus1_01)),
+        b_kplus2_01);
+    __m128d const result_23 = _mm_sub_pd(
+        _mm_add_pd(a_0, _mm_mul_pd(final_scaled_t_23, b_kplus1_23)),
+        b_kplus2_23);
+    components[0][d] = _mm_cvtsd_f64(result_01);
+    components[1][d] = _mm_cvtsd_f64(_mm_unpackhi_pd(result_01, result_01));
+    components[2][d] = _mm_cvtsd_f64(result_23);
+    components[3][d] = _mm_cvtsd_f64(_mm_unpackhi_pd(result_23, result_23));
+  }
+  for (int i = 0; i < size; ++i) {
+    values[i] = make_value(components[i]);
+  }
+}
+
+#endif
+
 template<typename Vector>
 EvaluationHelper<Vector>::EvaluationHelper(
     std::vector<Vector> const& coefficients,
@@ -80,6 +196,58 @@ Vector EvaluationHelper<Vector>::EvaluateImplementation(
   }
 }
 
+template<typename Vector>
+void EvaluationHelper<Vector>::EvaluateImplementation(
+    double const (&scaled_ts)[batch_size],
+    int const size,
+    Vector* const values) const {
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  if constexpr (is_quantity<Vector>::value) {
+    ClenshawInLanes</*dimension=*/1, /*derivative=*/false>(
+        [this](int const k, int) {
+          return coefficients_[k] / SIUnit<Vector>();
+        },
+        degree_,
+        scaled_ts,
+        size,
+        [](double const (&components)[1]) {
+          return components[0] * SIUnit<Vector>();
+        },
+        values);
+    return;
+  }
+#endif
+  for (int i = 0; i < size; ++i) {
+    values[i] = EvaluateImplementation(scaled_ts[i]);
+  }
+}
+
+template<typename Vector>
+void EvaluationHelper<Vector>::EvaluateDerivativeImplementation(
+    double const (&scaled_ts)[batch_size],
+    int const size,
+    Vector* const values) const {
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  if constexpr (is_quantity<Vector>::value) {
+    ClenshawInLanes</*dimension=*/1, /*derivative=*/true>(
+        [this](int const k, int) {
+          return coefficients_[k] / SIUnit<Vector>();
+        },
+        degree_,
+        scaled_ts,
+        size,
+        [](double const (&components)[1]) {
+          return components[0] * SIUnit<Vector>();
+        },
+        values);
+    return;
+  }
+#endif
+  for (int i = 0; i < size; ++i) {
+    values[i] = EvaluateDerivativeWithHelper(*this, scaled_ts[i]);
+  }
+}
+
 template<typename Vector>
 Vector EvaluationHelper<Vector>::coefficients(int const index) const {
   return coefficients_[index];
@@ -143,6 +311,55 @@ EvaluationHelper<Multivector<Scalar, Frame, rank>>::EvaluateImplementation(
     }
 }
 
+template<typename Scalar, typename Frame, int rank>
+void EvaluationHelper<Multivector<Scalar, Frame, rank>>::EvaluateImplementation(
+    double const (&scaled_ts)[batch_size],
+    int const size,
+    Multivector<Scalar, Frame, rank>* const values) const {
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  ClenshawInLanes</*dimension=*/3, /*derivative=*/false>(
+      [this](int const k, int const d) { return coefficients_[k][d]; },
+      degree_,
+      scaled_ts,
+      size,
+      [](double const (&components)[3]) {
+        return Multivector<double, Frame, rank>(R3Element<double>(
+                   components[0], components[1], components[2])) *
+               SIUnit<Scalar>();
+      },
+      values);
+#else
+  for (int i = 0; i < size; ++i) {
+    values[i] = EvaluateImplementation(scaled_ts[i]);
+  }
+#endif
+}
+
+template<typename Scalar, typename Frame, int rank>
+void EvaluationHelper<Multivector<Scalar, Frame, rank>>::
+EvaluateDerivativeImplementation(
+    double const (&scaled_ts)[batch_size],
+    int const size,
+    Multivector<Scalar, Frame, rank>* const values) const {
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  ClenshawInLanes</*dimension=*/3, /*derivative=*/true>(
+      [this](int const k, int const d) { return coefficients_[k][d]; },
+      degree_,
+      scaled_ts,
+      size,
+      [](double const (&components)[3]) {
+        return Multivector<double, Frame, rank>(R3Element<double>(
+                   components[0], components[1], components[2])) *
+               SIUnit<Scalar>();
+      },
+      values);
+#else
+  for (int i = 0; i < size; ++i) {
+    values[i] = EvaluateDerivativeWithHelper(*this, scaled_ts[i]);
+  }
+#endif
+}
+
 template<typename Scalar, typename Frame, int rank>
 Multivector<Scalar, Frame, rank>
 EvaluationHelper<Multivector<Scalar, Frame, rank>>::coefficients(
@@ -228,28 +445,72 @@ Variation<Vector> ЧебышёвSeries<Vector>::EvaluateDerivative(
     Instant const& t) const {
   // See comments above.
   double const scaled_t = ((t - t_max_) + (t - t_min_)) * one_over_duration_;
-  double const two_scaled_t = scaled_t + scaled_t;
 #ifdef _DEBUG
   CHECK_LE(scaled_t, 1.1);
   CHECK_GE(scaled_t, -1.1);
 #endif
 
-  Vector b_kplus2_vector{};
-  Vector b_kplus1_vector{};
-  Vector* b_kplus2 = &b_kplus2_vector;
-  Vector* b_kplus1 = &b_kplus1_vector;
-  Vector* const& b_k = b_kplus2;  // An overlay.
-  for (int k = helper_.degree() - 1; k >= 1; --k) {
-    *b_k = helper_.coefficients(k + 1) * (k + 1) +
-           two_scaled_t * *b_kplus1 - *b_kplus2;
-    Vector* const last_b_k = b_k;
-    b_kplus2 = b_kplus1;
-    b_kplus1 = last_b_k;
-  }
-  return (helper_.coefficients(1) + two_scaled_t * *b_kplus1 - *b_kplus2) *
+  return EvaluateDerivativeWithHelper(helper_, scaled_t) *
              (one_over_duration_ + one_over_duration_);
 }
 
+template<typename Vector>
+void ЧебышёвSeries<Vector>::Evaluate(std::vector<Instant> const& times,
+                                     std::vector<Vector>& values) const {
+  constexpr int batch_size = EvaluationHelper<Vector>::batch_size;
+  int const size = times.size();
+  values.resize(size);
+  double scaled_ts[batch_size];
+  for (int i = 0; i < size; i += batch_size) {
+    int const batch_end = std::min(i + batch_size, size);
+    ScaleTimes(times, i, batch_end, scaled_ts);
+    helper_.EvaluateImplementation(scaled_ts, batch_end - i, &values[i]);
+  }
+}
+
+template<typename Vector>
+void ЧебышёвSeries<Vector>::EvaluateDerivative(
+    std::vector<Instant> const& times,
+    std::vector<Variation<Vector>>& derivatives) const {
+  constexpr int batch_size = EvaluationHelper<Vector>::batch_size;
+  int const size = times.size();
+  derivatives.resize(size);
+  double scaled_ts[batch_size];
+  Vector values[batch_size];
+  for (int i = 0; i < size; i += batch_size) {
+    int const batch_end = std::min(i + batch_size, size);
+    ScaleTimes(times, i, batch_end, scaled_ts);
+    helper_.EvaluateDerivativeImplementation(
+        scaled_ts, batch_end - i, values);
+    for (int j = i; j < batch_end; ++j) {
+      derivatives[j] =
+          values[j - i] * (one_over_duration_ + one_over_duration_);
+    }
+  }
+}
+
+template<typename Vector>
+void ЧебышёвSeries<Vector>::ScaleTimes(
+    std::vector<Instant> const& times,
+    int const begin,
+    int const end,
+    double (&scaled_ts)[EvaluationHelper<Vector>::batch_size]) const {
+  for (int i = begin; i < end; ++i) {
+    // See comments in |Evaluate|.
+    double const scaled_t =
+        ((times[i] - t_max_) + (times[i] - t_min_)) * one_over_duration_;
+#ifdef _DEBUG
+    CHECK_LE(scaled_t, 1.1);
+    CHECK_GE(scaled_t, -1.1);
+#endif
+    scaled_ts[i - begin] = scaled_t;
+  }
+  // Pad with the last argument.
+  for (int i = end - begin; i < EvaluationHelper<Vector>::batch_size; ++i) {
+    scaled_ts[i] = scaled_ts[end - begin - 1];
+  }
+}
+
 template<typename Vector>
 void ЧебышёвSeries<Vector>::WriteToMessage(
     not_null<serialization::ЧебышёвSeries*> const message) const {
@@ -1,6 +1,9 @@
 ﻿
 #include "numerics/чебышёв_series.hpp"
 
+#include <random>
+#include <vector>
+
 #include "astronomy/frames.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/named_quantities.hpp"
@@ -133,6 +136,55 @@ TEST_F(ЧебышёвSeriesTest, X6Vector) {
             x6.Evaluate(t0_ + 3 * Second));
 }
 
+TEST_F(ЧебышёвSeriesTest, BatchEvaluation) {
+  using V = Vector<Length, ICRS>;
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> coefficient_distribution(-1, 1);
+  std::uniform_real_distribution<> time_distribution(-1, 3);
+  for (int degree = 1; degree <= 17; ++degree) {
+    std::vector<Length> length_coefficients;
+    std::vector<V> vector_coefficients;
+    for (int k = 0; k <= degree; ++k) {
+      length_coefficients.push_back(coefficient_distribution(random) * Metre);
+      vector_coefficients.push_back(
+          V({coefficient_distribution(random) * Metre,
+             coefficient_distribution(random) * Metre,
+             coefficient_distribution(random) * Metre}));
+    }
+    ЧебышёвSeries<Length> const length_series(
+        length_coefficients, t_min_, t_max_);
+    ЧебышёвSeries<V> const vector_series(vector_coefficients, t_min_, t_max_);
+
+    // Exercise the partially filled lanes.
+    for (int size = 1; size <= 9; ++size) {
+      std::vector<Instant> times;
+      for (int i = 0; i < size; ++i) {
+        times.push_back(t0_ + time_distribution(random) * Second);
+      }
+      std::vector<Length> lengths;
+      std::vector<Speed> speeds;
+      std::vector<V> vectors;
+      std::vector<Vector<Speed, ICRS>> velocities;
+      length_series.Evaluate(times, lengths);
+      length_series.EvaluateDerivative(times, speeds);
+      vector_series.Evaluate(times, vectors);
+      vector_series.EvaluateDerivative(times, velocities);
+      ASSERT_EQ(size, lengths.size());
+      ASSERT_EQ(size, speeds.size());
+      ASSERT_EQ(size, vectors.size());
+      ASSERT_EQ(size, velocities.size());
+      for (int i = 0; i < size; ++i) {
+        EXPECT_EQ(length_series.Evaluate(times[i]), lengths[i]) << degree;
+        EXPECT_EQ(length_series.EvaluateDerivative(times[i]), speeds[i])
+            << degree;
+        EXPECT_EQ(vector_series.Evaluate(times[i]), vectors[i]) << degree;
+        EXPECT_EQ(vector_series.EvaluateDerivative(times[i]), velocities[i])
+            << degree;
+      }
+    }
+  }
+}
+
 TEST_F(ЧебышёвSeriesDeathTest, SerializationError) {
   ЧебышёвSeries<Speed> v({1 * Metre / Second,
                           -2 * Metre / Second,
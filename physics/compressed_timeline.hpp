@@ -0,0 +1,215 @@
+﻿
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "geometry/named_quantities.hpp"
+#include "numerics/hermite3.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/trajectory.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_compressed_timeline {
+
+using geometry::Instant;
+using geometry::Position;
+using geometry::Velocity;
+using numerics::Hermite3;
+
+// A compact, append-only sequence of (time, degrees of freedom) pairs, meant
+// for old history that is rarely read.  The points are grouped in blocks of
+// |points_per_block|.  Within a block, each double is XORed with a prediction
+// computed from the preceding points and the result is stored with the
+// variable-length encoding of [PZB+15].  The encoding is lossless: iterating
+// over the timeline yields exactly the points that were appended, and the
+// evaluation functions give the same results as those of |DiscreteTrajectory|
+// for the same points.  This is where |DiscreteTrajectory::CompressBefore|
+// moves the old points of a trajectory.
+// [PZB+15]: Pelkonen, Franklin, Teller, Cavallaro, Huang, Meza and
+// Veeraraghavan (2015), Gorilla: a fast, scalable, in-memory time series
+// database.
+template<typename Frame>
+class CompressedTimeline : public Trajectory<Frame> {
+ public:
+  // As in |std::map|, so that the points of the compressed and uncompressed
+  // timelines have the same type.
+  using value_type = std::pair<Instant const, DegreesOfFreedom<Frame>>;
+
+ private:
+  // The doubles of a point, in the order in which they are encoded: the time,
+  // the velocity and the position, the latter being predicted using the
+  // former.
+  static constexpr int channels = 7;
+  using Channels = std::array<double, channels>;
+
+  // The state of the encoding or decoding of a block: the previous points and
+  // the windows of meaningful bits of the XORed values.
+  class Codec {
+   public:
+    Codec();
+
+    // Encodes or decodes the next point of the block, which holds |bits|.
+    void Encode(Channels const& values, std::vector<std::uint64_t>& bits,
+                std::int64_t& bit_position);
+    Channels Decode(std::vector<std::uint64_t> const& bits,
+                    std::int64_t& bit_position);
+
+   private:
+    // Returns the prediction for |channel| of the next point, which may depend
+    // on the lower channels of that point, given in |values|.
+    double Predict(int channel, Channels const& values) const;
+
+    void Push(Channels const& values);
+
+    std::int64_t points_ = 0;
+    Channels previous_{};
+    Channels before_previous_{};
+    // The number of leading and trailing zeros of the last value which was
+    // not encoded using the window of the preceding one.  Negative if there is
+    // no such value.
+    std::array<int, channels> leading_zeros_;
+    std::array<int, channels> trailing_zeros_;
+  };
+
+  struct Block {
+    explicit Block(value_type const& first);
+
+    // The first and last points of the block, kept in the clear for
+    // interpolation across blocks and for access to the ends of the timeline
+    // without decoding.
+    value_type const first;
+    std::optional<value_type> last;
+    std::int64_t size = 0;
+    std::vector<std::uint64_t> bits;
+    std::int64_t bit_size = 0;
+  };
+
+ public:
+  // An iterator which decodes the points of the timeline on the fly.  Like the
+  // iterators of |std::vector|, it is invalidated by |Append| and by the
+  // |Forget...| functions.  The decoded points are returned by value, as they
+  // are not stored in the timeline.  Decrementing it decodes its block from
+  // the start.
+  class Iterator final {
+   public:
+    Iterator(Iterator const& other) = default;
+    // Needed because |value_type| is not assignable.
+    Iterator& operator=(Iterator const& other);
+
+    value_type operator*() const;
+    std::optional<value_type> operator->() const;
+    Iterator& operator++();
+    Iterator& operator--();
+
+    bool operator==(Iterator const& right) const;
+    bool operator!=(Iterator const& right) const;
+
+   private:
+    Iterator(CompressedTimeline const* timeline, std::int64_t block_index);
+
+    // Decodes the point at |index_in_block_| into |current_|, unless it is
+    // kept in the clear.
+    void Decode();
+    // Restarts the decoding at the beginning of the block.
+    void Rewind();
+
+    CompressedTimeline const* timeline_;
+    std::int64_t block_index_;
+    std::int64_t index_in_block_ = 0;
+    // The number of points of the block consumed by |codec_|.
+    std::int64_t decoded_points_ = 0;
+    std::int64_t bit_position_ = 0;
+    Codec codec_;
+    std::optional<value_type> current_;
+
+    friend class CompressedTimeline;
+  };
+
+  explicit CompressedTimeline(std::int64_t points_per_block = 256);
+
+  // |time| must be (strictly) after |t_max()|.
+  void Append(Instant const& time,
+              DegreesOfFreedom<Frame> const& degrees_of_freedom);
+
+  // Removes the points (strictly) before |time|.  The blocks all of whose
+  // points are before |time| are dropped, and the first remaining block is
+  // reencoded if some of its points are before |time|.
+  void ForgetBefore(Instant const& time);
+
+  // Removes the points (strictly) after |time|.  The blocks all of whose points
+  // are after |time| are dropped, and the last remaining block is reencoded if
+  // needed.
+  void ForgetAfter(Instant const& time);
+
+  bool empty() const;
+  std::int64_t size() const;
+
+  // The number of bytes used by the blocks of this object, excluding the
+  // object itself.
+  std::int64_t encoded_bytes() const;
+
+  Iterator begin() const;
+  Iterator end() const;
+
+  // Returns an iterator to the first point at or after |time|, or |end()| if
+  // there is no such point.
+  Iterator LowerBound(Instant const& time) const;
+
+  // Implementation of the interface |Trajectory|.
+
+  // The bounds are the times of the first and last points if this timeline is
+  // nonempty, otherwise they are infinities of the appropriate signs.
+  Instant t_min() const override;
+  Instant t_max() const override;
+
+  Position<Frame> EvaluatePosition(Instant const& time) const override;
+  Velocity<Frame> EvaluateVelocity(Instant const& time) const override;
+  DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(
+      Instant const& time) const override;
+  void EvaluateDegreesOfFreedom(
+      std::vector<Instant> const& times,
+      std::vector<DegreesOfFreedom<Frame>>& degrees_of_freedom) const override;
+
+  // End of the implementation of the interface.
+
+ private:
+  static Channels ToChannels(Instant const& time,
+                             DegreesOfFreedom<Frame> const& degrees_of_freedom);
+  static value_type FromChannels(Channels const& values);
+
+  // Encodes |point| at the end of |block| using |codec|.
+  static void AppendToBlock(value_type const& point,
+                            Codec& codec,
+                            Block& block);
+
+  // Returns the index of the first block whose last point is at or after
+  // |time|, or the number of blocks if there is no such block.
+  std::int64_t FindBlock(Instant const& time) const;
+
+  // Returns the Hermite interpolation for the left-open, right-closed segment
+  // containing the given |time|, or, if |time| is |t_min()|, a first-degree
+  // polynomial which should be evaluated only at |t_min()|.
+  Hermite3<Instant, Position<Frame>> GetInterpolation(
+      Instant const& time) const;
+
+  std::int64_t const points_per_block_;
+  std::deque<Block> blocks_;
+  std::int64_t size_ = 0;
+  // The state of the encoding of the last block.
+  Codec codec_;
+};
+
+}  // namespace internal_compressed_timeline
+
+using internal_compressed_timeline::CompressedTimeline;
+
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/compressed_timeline_body.hpp"
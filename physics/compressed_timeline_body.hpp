@@ -0,0 +1,587 @@
+﻿
+#pragma once
+
+#include "physics/compressed_timeline.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "astronomy/epoch.hpp"
+#include "base/macros.hpp"
+#include "glog/logging.h"
+#include "quantities/si.hpp"
+
+#if PRINCIPIA_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+namespace principia {
+namespace physics {
+namespace internal_compressed_timeline {
+
+using astronomy::InfiniteFuture;
+using astronomy::InfinitePast;
+using geometry::Displacement;
+using quantities::si::Metre;
+using quantities::si::Second;
+
+// The number of leading zeros is encoded on 5 bits, so it is capped.
+constexpr int max_leading_zeros = 31;
+
+inline int LeadingZeros(std::uint64_t const x) {
+  DCHECK_NE(x, 0);
+#if PRINCIPIA_COMPILER_MSVC
+  unsigned long index;  // NOLINT(runtime/int)
+  _BitScanReverse64(&index, x);
+  return 63 - index;
+#else
+  return __builtin_clzll(x);
+#endif
+}
+
+inline int TrailingZeros(std::uint64_t const x) {
+  DCHECK_NE(x, 0);
+#if PRINCIPIA_COMPILER_MSVC
+  unsigned long index;  // NOLINT(runtime/int)
+  _BitScanForward64(&index, x);
+  return index;
+#else
+  return __builtin_ctzll(x);
+#endif
+}
+
+// Writes the |count| low-order bits of |value|, which must be in [1, 64], at
+// |bit_position| in |bits|, least significant bit first.
+inline void WriteBits(std::uint64_t const value,
+                      int const count,
+                      std::vector<std::uint64_t>& bits,
+                      std::int64_t& bit_position) {
+  DCHECK_LE(1, count);
+  DCHECK_LE(count, 64);
+  int const offset = bit_position % 64;
+  if (offset == 0) {
+    bits.push_back(value);
+  } else {
+    bits.back() |= value << offset;
+    if (offset + count > 64) {
+      bits.push_back(value >> (64 - offset));
+    }
+  }
+  bit_position += count;
+}
+
+// Reads |count| bits, which must be in [1, 64], at |bit_position| in |bits|.
+inline std::uint64_t ReadBits(int const count,
+                              std::vector<std::uint64_t> const& bits,
+                              std::int64_t& bit_position) {
+  DCHECK_LE(1, count);
+  DCHECK_LE(count, 64);
+  std::int64_t const word = bit_position / 64;
+  int const offset = bit_position % 64;
+  std::uint64_t value = bits[word] >> offset;
+  if (offset + count > 64) {
+    value |= bits[word + 1] << (64 - offset);
+  }
+  bit_position += count;
+  return count == 64 ? value : value & ((std::uint64_t{1} << count) - 1);
+}
+
+template<typename Frame>
+CompressedTimeline<Frame>::Codec::Codec() {
+  leading_zeros_.fill(-1);
+  trailing_zeros_.fill(-1);
+}
+
+template<typename Frame>
+void CompressedTimeline<Frame>::Codec::Encode(
+    Channels const& values,
+    std::vector<std::uint64_t>& bits,
+    std::int64_t& bit_position) {
+  for (int c = 0; c < channels; ++c) {
+    double const prediction = Predict(c, values);
+    std::uint64_t value_bits;
+    std::uint64_t prediction_bits;
+    std::memcpy(&value_bits, &values[c], sizeof(double));
+    std::memcpy(&prediction_bits, &prediction, sizeof(double));
+    std::uint64_t const x = value_bits ^ prediction_bits;
+    if (x == 0) {
+      WriteBits(0b0, 1, bits, bit_position);
+      continue;
+    }
+    int const leading_zeros = std::min(LeadingZeros(x), max_leading_zeros);
+    int const trailing_zeros = TrailingZeros(x);
+    if (leading_zeros_[c] >= 0 &&
+        leading_zeros >= leading_zeros_[c] &&
+        trailing_zeros >= trailing_zeros_[c]) {
+      // The meaningful bits fit in the window of the previous value.
+      WriteBits(0b01, 2, bits, bit_position);
+      WriteBits(x >> trailing_zeros_[c],
+                64 - leading_zeros_[c] - trailing_zeros_[c],
+                bits,
+                bit_position);
+    } else {
+      int const meaningful_bits = 64 - leading_zeros - trailing_zeros;
+      WriteBits(0b11, 2, bits, bit_position);
+      WriteBits(leading_zeros, 5, bits, bit_position);
+      WriteBits(meaningful_bits - 1, 6, bits, bit_position);
+      WriteBits(x >> trailing_zeros, meaningful_bits, bits, bit_position);
+      leading_zeros_[c] = leading_zeros;
+      trailing_zeros_[c] = trailing_zeros;
+    }
+  }
+  Push(values);
+}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::Channels
+CompressedTimeline<Frame>::Codec::Decode(
+    std::vector<std::uint64_t> const& bits,
+    std::int64_t& bit_position) {
+  Channels values;
+  for (int c = 0; c < channels; ++c) {
+    double const prediction = Predict(c, values);
+    std::uint64_t prediction_bits;
+    std::memcpy(&prediction_bits, &prediction, sizeof(double));
+    std::uint64_t x = 0;
+    if (ReadBits(1, bits, bit_position) != 0) {
+      if (ReadBits(1, bits, bit_position) != 0) {
+        leading_zeros_[c] = ReadBits(5, bits, bit_position);
+        int const meaningful_bits = ReadBits(6, bits, bit_position) + 1;
+        trailing_zeros_[c] = 64 - leading_zeros_[c] - meaningful_bits;
+      }
+      x = ReadBits(64 - leading_zeros_[c] - trailing_zeros_[c],
+                   bits,
+                   bit_position) << trailing_zeros_[c];
+    }
+    std::uint64_t const value_bits = x ^ prediction_bits;
+    std::memcpy(&values[c], &value_bits, sizeof(double));
+  }
+  Push(values);
+  return values;
+}
+
+template<typename Frame>
+double CompressedTimeline<Frame>::Codec::Predict(
+    int const channel,
+    Channels const& values) const {
+  // The encoder and the decoder must compute bitwise-identical predictions, so
+  // this function must not depend on anything but its inputs.
+  if (channel < 4) {
+    // The time and the velocity are extrapolated linearly.
+    return points_ < 2 ? previous_[channel]
+                       : previous_[channel] +
+                             (previous_[channel] - before_previous_[channel]);
+  } else if (points_ == 0) {
+    return 0;
+  } else {
+    // The position is integrated using the trapezoidal rule on the velocities
+    // of this point and of the previous one.
+    double const Δt = values[0] - previous_[0];
+    return previous_[channel] +
+           (previous_[channel - 3] + values[channel - 3]) * (0.5 * Δt);
+  }
+}
+
+template<typename Frame>
+void CompressedTimeline<Frame>::Codec::Push(Channels const& values) {
+  before_previous_ = previous_;
+  previous_ = values;
+  ++points_;
+}
+
+template<typename Frame>
+CompressedTimeline<Frame>::Block::Block(value_type const& first)
+    : first(first),
+      last(first) {}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::Iterator&
+CompressedTimeline<Frame>::Iterator::operator=(Iterator const& other) {
+  timeline_ = other.timeline_;
+  block_index_ = other.block_index_;
+  index_in_block_ = other.index_in_block_;
+  decoded_points_ = other.decoded_points_;
+  bit_position_ = other.bit_position_;
+  codec_ = other.codec_;
+  current_.reset();
+  if (other.current_.has_value()) {
+    current_.emplace(*other.current_);
+  }
+  return *this;
+}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::value_type
+CompressedTimeline<Frame>::Iterator::operator*() const {
+  Block const& block = timeline_->blocks_[block_index_];
+  if (index_in_block_ == 0) {
+    return block.first;
+  } else if (index_in_block_ == block.size - 1) {
+    return *block.last;
+  } else {
+    return *current_;
+  }
+}
+
+template<typename Frame>
+std::optional<typename CompressedTimeline<Frame>::value_type>
+CompressedTimeline<Frame>::Iterator::operator->() const {
+  return **this;
+}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::Iterator&
+CompressedTimeline<Frame>::Iterator::operator++() {
+  ++index_in_block_;
+  if (index_in_block_ == timeline_->blocks_[block_index_].size) {
+    ++block_index_;
+    index_in_block_ = 0;
+    Rewind();
+  }
+  Decode();
+  return *this;
+}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::Iterator&
+CompressedTimeline<Frame>::Iterator::operator--() {
+  if (index_in_block_ == 0) {
+    CHECK_LT(0, block_index_);
+    --block_index_;
+    index_in_block_ = timeline_->blocks_[block_index_].size - 1;
+    Rewind();
+  } else {
+    --index_in_block_;
+  }
+  Decode();
+  return *this;
+}
+
+template<typename Frame>
+bool CompressedTimeline<Frame>::Iterator::operator==(
+    Iterator const& right) const {
+  DCHECK_EQ(timeline_, right.timeline_);
+  return block_index_ == right.block_index_ &&
+         index_in_block_ == right.index_in_block_;
+}
+
+template<typename Frame>
+bool CompressedTimeline<Frame>::Iterator::operator!=(
+    Iterator const& right) const {
+  return !(*this == right);
+}
+
+template<typename Frame>
+CompressedTimeline<Frame>::Iterator::Iterator(
+    CompressedTimeline const* const timeline,
+    std::int64_t const block_index)
+    : timeline_(timeline),
+      block_index_(block_index) {}
+
+template<typename Frame>
+void CompressedTimeline<Frame>::Iterator::Decode() {
+  if (block_index_ == timeline_->blocks_.size()) {
+    return;
+  }
+  Block const& block = timeline_->blocks_[block_index_];
+  if (index_in_block_ == 0 || index_in_block_ == block.size - 1) {
+    // The point is in the clear.  If needed, it will be decoded when moving to
+    // the next point.
+    return;
+  }
+  if (decoded_points_ > index_in_block_) {
+    Rewind();
+  }
+  while (decoded_points_ <= index_in_block_) {
+    current_.emplace(FromChannels(codec_.Decode(block.bits, bit_position_)));
+    ++decoded_points_;
+  }
+}
+
+template<typename Frame>
+void CompressedTimeline<Frame>::Iterator::Rewind() {
+  decoded_points_ = 0;
+  bit_position_ = 0;
+  codec_ = Codec();
+}
+
+template<typename Frame>
+CompressedTimeline<Frame>::CompressedTimeline(
+    std::int64_t const points_per_block)
+    : points_per_block_(points_per_block) {
+  CHECK_LT(0, points_per_block_);
+}
+
+template<typename Frame>
+void CompressedTimeline<Frame>::Append(
+    Instant const& time,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+  CHECK_LT(t_max(), time);
+  value_type const point{time, degrees_of_freedom};
+  if (blocks_.empty() || blocks_.back().size == points_per_block_) {
+    if (!blocks_.empty()) {
+      blocks_.back().bits.shrink_to_fit();
+    }
+    blocks_.emplace_back(point);
+    codec_ = Codec();
+  }
+  AppendToBlock(point, codec_, blocks_.back());
+  ++size_;
+}
+
+template<typename Frame>
+void CompressedTimeline<Frame>::ForgetBefore(Instant const& time) {
+  while (!blocks_.empty() && blocks_.front().last->first < time) {
+    size_ -= blocks_.front().size;
+    blocks_.pop_front();
+  }
+  if (blocks_.empty() || time <= blocks_.front().first.first) {
+    return;
+  }
+
+  // The first block has points on both sides of |time|, the last of them being
+  // after |time|.
+  std::vector<value_type> kept;
+  for (Iterator it = LowerBound(time); it.block_index_ == 0; ++it) {
+    kept.push_back(*it);
+  }
+  bool const is_last_block = blocks_.size() == 1;
+  size_ -= blocks_.front().size;
+  blocks_.pop_front();
+  Codec codec;
+  Block& block = blocks_.emplace_front(kept.front());
+  for (auto const& point : kept) {
+    AppendToBlock(point, codec, block);
+  }
+  size_ += block.size;
+  if (is_last_block) {
+    codec_ = codec;
+  } else {
+    block.bits.shrink_to_fit();
+  }
+}
+
+template<typename Frame>
+void CompressedTimeline<Frame>::ForgetAfter(Instant const& time) {
+  bool dropped_blocks = false;
+  while (!blocks_.empty() && blocks_.back().first.first > time) {
+    size_ -= blocks_.back().size;
+    blocks_.pop_back();
+    dropped_blocks = true;
+  }
+  if (blocks_.empty() ||
+      (!dropped_blocks && blocks_.back().last->first <= time)) {
+    return;
+  }
+
+  // Reencode the last block, even if all its points are kept, to recover the
+  // state of |codec_| needed to append to it.
+  std::vector<value_type> kept;
+  for (Iterator it(this, blocks_.size() - 1);
+       it != end() && it->first <= time;
+       ++it) {
+    kept.push_back(*it);
+  }
+  size_ -= blocks_.back().size;
+  blocks_.pop_back();
+  codec_ = Codec();
+  Block& block = blocks_.emplace_back(kept.front());
+  for (auto const& point : kept) {
+    AppendToBlock(point, codec_, block);
+  }
+  size_ += block.size;
+}
+
+template<typename Frame>
+bool CompressedTimeline<Frame>::empty() const {
+  return blocks_.empty();
+}
+
+template<typename Frame>
+std::int64_t CompressedTimeline<Frame>::size() const {
+  return size_;
+}
+
+template<typename Frame>
+std::int64_t CompressedTimeline<Frame>::encoded_bytes() const {
+  std::int64_t result = 0;
+  for (auto const& block : blocks_) {
+    result += sizeof(Block) + block.bits.capacity() * sizeof(std::uint64_t);
+  }
+  return result;
+}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::Iterator
+CompressedTimeline<Frame>::begin() const {
+  return Iterator(this, /*block_index=*/0);
+}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::Iterator
+CompressedTimeline<Frame>::end() const {
+  return Iterator(this, /*block_index=*/blocks_.size());
+}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::Iterator
+CompressedTimeline<Frame>::LowerBound(Instant const& time) const {
+  Iterator it(this, FindBlock(time));
+  // The block found by |FindBlock| contains a point at or after |time|, so
+  // this doesn't go past the end of the block.
+  while (it != end() && it->first < time) {
+    ++it;
+  }
+  return it;
+}
+
+template<typename Frame>
+Instant CompressedTimeline<Frame>::t_min() const {
+  return empty() ? InfiniteFuture : blocks_.front().first.first;
+}
+
+template<typename Frame>
+Instant CompressedTimeline<Frame>::t_max() const {
+  return empty() ? InfinitePast : blocks_.back().last->first;
+}
+
+template<typename Frame>
+Position<Frame> CompressedTimeline<Frame>::EvaluatePosition(
+    Instant const& time) const {
+  return GetInterpolation(time).Evaluate(time);
+}
+
+template<typename Frame>
+Velocity<Frame> CompressedTimeline<Frame>::EvaluateVelocity(
+    Instant const& time) const {
+  return GetInterpolation(time).EvaluateDerivative(time);
+}
+
+template<typename Frame>
+DegreesOfFreedom<Frame> CompressedTimeline<Frame>::EvaluateDegreesOfFreedom(
+    Instant const& time) const {
+  auto const interpolation = GetInterpolation(time);
+  return {interpolation.Evaluate(time), interpolation.EvaluateDerivative(time)};
+}
+
+template<typename Frame>
+void CompressedTimeline<Frame>::EvaluateDegreesOfFreedom(
+    std::vector<Instant> const& times,
+    std::vector<DegreesOfFreedom<Frame>>& degrees_of_freedom) const {
+  degrees_of_freedom.clear();
+  if (times.empty()) {
+    return;
+  }
+  degrees_of_freedom.reserve(times.size());
+  CHECK_LE(t_min(), times.front());
+  CHECK_GE(t_max(), times.back());
+
+  std::int64_t const first_block = FindBlock(times.front());
+  std::optional<value_type> lower;
+  if (first_block > 0) {
+    lower.emplace(*blocks_[first_block - 1].last);
+  }
+  Iterator upper(this, first_block);
+  std::optional<Hermite3<Instant, Position<Frame>>> interpolation;
+  for (Instant const& time : times) {
+    bool upper_changed = !interpolation.has_value();
+    while (upper->first < time) {
+      lower.emplace(*upper);
+      ++upper;
+      upper_changed = true;
+    }
+    if (upper_changed) {
+      auto const& [lower_time, lower_degrees_of_freedom] =
+          lower.has_value() ? *lower : *upper;
+      auto const& [upper_time, upper_degrees_of_freedom] = *upper;
+      interpolation.emplace(
+          std::pair{lower_time, upper_time},
+          std::pair{lower_degrees_of_freedom.position(),
+                    upper_degrees_of_freedom.position()},
+          std::pair{lower_degrees_of_freedom.velocity(),
+                    upper_degrees_of_freedom.velocity()});
+    }
+    degrees_of_freedom.emplace_back(interpolation->Evaluate(time),
+                                    interpolation->EvaluateDerivative(time));
+  }
+}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::Channels
+CompressedTimeline<Frame>::ToChannels(
+    Instant const& time,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+  auto const q = (degrees_of_freedom.position() - Frame::origin).coordinates();
+  auto const v = degrees_of_freedom.velocity().coordinates();
+  return {(time - Instant()) / Second,
+          v.x / (Metre / Second),
+          v.y / (Metre / Second),
+          v.z / (Metre / Second),
+          q.x / Metre,
+          q.y / Metre,
+          q.z / Metre};
+}
+
+template<typename Frame>
+typename CompressedTimeline<Frame>::value_type
+CompressedTimeline<Frame>::FromChannels(Channels const& values) {
+  return {Instant() + values[0] * Second,
+          DegreesOfFreedom<Frame>(
+              Frame::origin + Displacement<Frame>({values[4] * Metre,
+                                                   values[5] * Metre,
+                                                   values[6] * Metre}),
+              Velocity<Frame>({values[1] * (Metre / Second),
+                               values[2] * (Metre / Second),
+                               values[3] * (Metre / Second)}))};
+}
+
+template<typename Frame>
+void CompressedTimeline<Frame>::AppendToBlock(value_type const& point,
+                                              Codec& codec,
+                                              Block& block) {
+  codec.Encode(ToChannels(point.first, point.second),
+               block.bits,
+               block.bit_size);
+  block.last.emplace(point);
+  ++block.size;
+}
+
+template<typename Frame>
+std::int64_t CompressedTimeline<Frame>::FindBlock(Instant const& time) const {
+  return std::partition_point(blocks_.begin(),
+                              blocks_.end(),
+                              [&time](Block const& block) {
+                                return block.last->first < time;
+                              }) -
+         blocks_.begin();
+}
+
+template<typename Frame>
+Hermite3<Instant, Position<Frame>> CompressedTimeline<Frame>::GetInterpolation(
+    Instant const& time) const {
+  CHECK_LE(t_min(), time);
+  CHECK_GE(t_max(), time);
+  std::int64_t const block = FindBlock(time);
+  std::optional<value_type> lower;
+  if (block > 0) {
+    lower.emplace(*blocks_[block - 1].last);
+  }
+  Iterator upper(this, block);
+  while (upper->first < time) {
+    lower.emplace(*upper);
+    ++upper;
+  }
+  auto const& [lower_time, lower_degrees_of_freedom] =
+      lower.has_value() ? *lower : *upper;
+  auto const& [upper_time, upper_degrees_of_freedom] = *upper;
+  return Hermite3<Instant, Position<Frame>>{
+      {lower_time, upper_time},
+      {lower_degrees_of_freedom.position(),
+       upper_degrees_of_freedom.position()},
+      {lower_degrees_of_freedom.velocity(),
+       upper_degrees_of_freedom.velocity()}};
+}
+
+}  // namespace internal_compressed_timeline
+}  // namespace physics
+}  // namespace principia
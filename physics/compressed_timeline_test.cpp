@@ -0,0 +1,233 @@
+﻿
+#include "physics/compressed_timeline.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "geometry/frame.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "physics/discrete_trajectory.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace physics {
+
+using geometry::Displacement;
+using geometry::Frame;
+using geometry::Instant;
+using geometry::Velocity;
+using quantities::AngularFrequency;
+using quantities::Cos;
+using quantities::Length;
+using quantities::Sin;
+using quantities::Speed;
+using quantities::Time;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Radian;
+using quantities::si::Second;
+using ::testing::Eq;
+using ::testing::Lt;
+
+class CompressedTimelineTest : public testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      serialization::Frame::TEST1, true>;
+
+  // Fills |trajectory| with |number_of_points| points of a circular orbit, at
+  // irregular times.
+  void FillCircularOrbit(int const number_of_points,
+                         DiscreteTrajectory<World>& trajectory) {
+    Length const r = 7000 * Kilo(Metre);
+    AngularFrequency const ω = 1e-3 * Radian / Second;
+    Speed const v = ω * r / Radian;
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<> step_distribution(5, 15);
+    Time t;
+    for (int i = 0; i < number_of_points; ++i) {
+      trajectory.Append(
+          t0_ + t,
+          DegreesOfFreedom<World>(
+              World::origin + Displacement<World>({r * Cos(ω * t),
+                                                   r * Sin(ω * t),
+                                                   1 * Metre}),
+              Velocity<World>({-v * Sin(ω * t),
+                               v * Cos(ω * t),
+                               0 * Metre / Second})));
+      t += step_distribution(random) * Second;
+    }
+  }
+
+  Instant const t0_ = Instant() + 12345.6789 * Second;
+};
+
+TEST_F(CompressedTimelineTest, Empty) {
+  CompressedTimeline<World> timeline;
+  EXPECT_TRUE(timeline.empty());
+  EXPECT_EQ(0, timeline.size());
+  EXPECT_TRUE(timeline.begin() == timeline.end());
+  EXPECT_LT(timeline.t_max(), timeline.t_min());
+}
+
+TEST_F(CompressedTimelineTest, RoundTrip) {
+  DiscreteTrajectory<World> trajectory;
+  FillCircularOrbit(1000, trajectory);
+  CompressedTimeline<World> timeline(/*points_per_block=*/64);
+  for (auto const& [time, degrees_of_freedom] : trajectory.Points()) {
+    timeline.Append(time, degrees_of_freedom);
+  }
+  EXPECT_EQ(1000, timeline.size());
+  EXPECT_EQ(trajectory.t_min(), timeline.t_min());
+  EXPECT_EQ(trajectory.t_max(), timeline.t_max());
+
+  // The encoding is lossless.
+  auto it = timeline.begin();
+  for (auto const& [time, degrees_of_freedom] : trajectory.Points()) {
+    ASSERT_TRUE(it != timeline.end());
+    EXPECT_EQ(time, it->first);
+    EXPECT_EQ(degrees_of_freedom, it->second);
+    ++it;
+  }
+  EXPECT_TRUE(it == timeline.end());
+
+  // The 7 doubles of a point take 56 bytes.
+  EXPECT_THAT(timeline.encoded_bytes(), Lt(40 * timeline.size()));
+}
+
+TEST_F(CompressedTimelineTest, Evaluation) {
+  DiscreteTrajectory<World> trajectory;
+  FillCircularOrbit(300, trajectory);
+  CompressedTimeline<World> timeline(/*points_per_block=*/16);
+  for (auto const& [time, degrees_of_freedom] : trajectory.Points()) {
+    timeline.Append(time, degrees_of_freedom);
+  }
+
+  std::vector<Instant> times;
+  for (Instant t = trajectory.t_min();
+       t <= trajectory.t_max();
+       t += 3.7 * Second) {
+    times.push_back(t);
+  }
+  for (auto const& [time, _] : trajectory.Points()) {
+    times.push_back(time);
+  }
+  std::sort(times.begin(), times.end());
+
+  for (Instant const& t : times) {
+    EXPECT_EQ(trajectory.EvaluateDegreesOfFreedom(t),
+              timeline.EvaluateDegreesOfFreedom(t));
+    EXPECT_EQ(trajectory.EvaluatePosition(t), timeline.EvaluatePosition(t));
+    EXPECT_EQ(trajectory.EvaluateVelocity(t), timeline.EvaluateVelocity(t));
+  }
+  std::vector<DegreesOfFreedom<World>> expected;
+  std::vector<DegreesOfFreedom<World>> actual;
+  trajectory.EvaluateDegreesOfFreedom(times, expected);
+  timeline.EvaluateDegreesOfFreedom(times, actual);
+  EXPECT_THAT(actual, Eq(expected));
+}
+
+TEST_F(CompressedTimelineTest, Decrement) {
+  DiscreteTrajectory<World> trajectory;
+  FillCircularOrbit(35, trajectory);
+  CompressedTimeline<World> timeline(/*points_per_block=*/10);
+  for (auto const& [time, degrees_of_freedom] : trajectory.Points()) {
+    timeline.Append(time, degrees_of_freedom);
+  }
+
+  auto it = timeline.end();
+  for (auto trajectory_it = trajectory.end();
+       trajectory_it != trajectory.begin();) {
+    --trajectory_it;
+    --it;
+    EXPECT_EQ(trajectory_it->time, it->first);
+    EXPECT_EQ(trajectory_it->degrees_of_freedom, it->second);
+  }
+  EXPECT_TRUE(it == timeline.begin());
+}
+
+TEST_F(CompressedTimelineTest, ForgetBefore) {
+  DiscreteTrajectory<World> trajectory;
+  FillCircularOrbit(100, trajectory);
+  CompressedTimeline<World> timeline(/*points_per_block=*/10);
+  std::vector<Instant> times;
+  std::vector<DegreesOfFreedom<World>> degrees_of_freedom;
+  for (auto const& [time, dof] : trajectory.Points()) {
+    timeline.Append(time, dof);
+    times.push_back(time);
+    degrees_of_freedom.push_back(dof);
+  }
+
+  // Forgetting in the middle of a block reencodes the rest of that block.
+  timeline.ForgetBefore(times[25]);
+  EXPECT_EQ(75, timeline.size());
+  EXPECT_EQ(times[25], timeline.t_min());
+  EXPECT_EQ(times[25], timeline.begin()->first);
+  EXPECT_EQ(times[26], (++timeline.begin())->first);
+  EXPECT_EQ(times[30], timeline.LowerBound(times[30])->first);
+  EXPECT_EQ(times[31], timeline.LowerBound(times[30] + 1 * Second)->first);
+  EXPECT_TRUE(timeline.LowerBound(times[99] + 1 * Second) == timeline.end());
+  auto it = timeline.begin();
+  for (int i = 25; i < 100; ++i, ++it) {
+    EXPECT_EQ(times[i], it->first);
+    EXPECT_EQ(degrees_of_freedom[i], it->second);
+  }
+
+  // Forgetting at the beginning of a block keeps that block.
+  timeline.ForgetBefore(times[40]);
+  EXPECT_EQ(60, timeline.size());
+  EXPECT_EQ(times[40], timeline.t_min());
+  EXPECT_EQ(times[99], timeline.t_max());
+
+  // Forgetting in the last block leaves a timeline that may be extended.
+  timeline.ForgetBefore(times[95]);
+  EXPECT_EQ(5, timeline.size());
+  timeline.Append(times[99] + 1 * Second,
+                  trajectory.begin()->degrees_of_freedom);
+  EXPECT_EQ(6, timeline.size());
+  EXPECT_EQ(times[99] + 1 * Second, timeline.t_max());
+  EXPECT_EQ(trajectory.begin()->degrees_of_freedom,
+            timeline.LowerBound(times[99] + 1 * Second)->second);
+  EXPECT_EQ(degrees_of_freedom[97], timeline.LowerBound(times[97])->second);
+
+  timeline.ForgetBefore(timeline.t_max() + 1 * Second);
+  EXPECT_TRUE(timeline.empty());
+}
+
+TEST_F(CompressedTimelineTest, ForgetAfter) {
+  DiscreteTrajectory<World> trajectory;
+  FillCircularOrbit(100, trajectory);
+  CompressedTimeline<World> timeline(/*points_per_block=*/10);
+  std::vector<Instant> times;
+  std::vector<DegreesOfFreedom<World>> degrees_of_freedom;
+  for (auto const& [time, dof] : trajectory.Points()) {
+    timeline.Append(time, dof);
+    times.push_back(time);
+    degrees_of_freedom.push_back(dof);
+  }
+
+  timeline.ForgetAfter(times[54]);
+  EXPECT_EQ(55, timeline.size());
+  EXPECT_EQ(times[0], timeline.t_min());
+  EXPECT_EQ(times[54], timeline.t_max());
+
+  // The last block may be extended.
+  for (int i = 55; i < 100; ++i) {
+    timeline.Append(times[i], degrees_of_freedom[i]);
+  }
+  EXPECT_EQ(100, timeline.size());
+  auto it = timeline.begin();
+  for (int i = 0; i < 100; ++i, ++it) {
+    EXPECT_EQ(times[i], it->first);
+    EXPECT_EQ(degrees_of_freedom[i], it->second);
+  }
+
+  timeline.ForgetAfter(times[0] - 1 * Second);
+  EXPECT_TRUE(timeline.empty());
+}
+
+}  // namespace physics
+}  // namespace principia
@@ -86,6 +86,10 @@ class ContinuousTrajectory : public Trajectory<Frame> {
       EXCLUDES(lock_);
   DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(
       Instant const& time) const override EXCLUDES(lock_);
+  void EvaluateDegreesOfFreedom(
+      std::vector<Instant> const& times,
+      std::vector<DegreesOfFreedom<Frame>>& degrees_of_freedom) const override
+      EXCLUDES(lock_);
 
   // End of the implementation of the interface.
 
@@ -94,6 +98,22 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   static not_null<std::unique_ptr<ContinuousTrajectory>> ReadFromMessage(
       serialization::ContinuousTrajectory const& message);
 
+  // Same as |WriteToMessage|, but the polynomials whose |t_max| is at or before
+  // |omitted_t_max| are not written.  Returns the |t_max| of the last
+  // polynomial that |WriteToMessage| would write, or -∞ if there is none; this
+  // is the |omitted_t_max| to use for the next delta.
+  Instant WriteDeltaToMessage(
+      not_null<serialization::ContinuousTrajectory*> message,
+      Instant const& omitted_t_max) const EXCLUDES(lock_);
+  // Completes a |message| written by |WriteDeltaToMessage| by copying to it the
+  // polynomials of |previous| that were omitted, i.e., those whose |t_max| is
+  // at or before |omitted_t_max| and that were not forgotten since |previous|
+  // was written.
+  static void RestoreOmissions(
+      not_null<serialization::ContinuousTrajectory*> previous,
+      Instant const& omitted_t_max,
+      not_null<serialization::ContinuousTrajectory*> message);
+
   // Checkpointing support.  The checkpointer is exposed to make it possible for
   // Ephemeris to create synchronized checkpoints of its state and that of its
   // trajectories.
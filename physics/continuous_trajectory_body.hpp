@@ -4,6 +4,7 @@
 #include "physics/continuous_trajectory.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <optional>
 #include <sstream>
@@ -12,6 +13,7 @@
 
 #include "astronomy/epoch.hpp"
 #include "glog/stl_logging.h"
+#include "google/protobuf/repeated_field.h"
 #include "numerics/newhall.hpp"
 #include "numerics/polynomial_evaluators.hpp"
 #include "numerics/ulp_distance.hpp"
@@ -24,6 +26,7 @@ namespace internal_continuous_trajectory {
 
 using base::Error;
 using base::make_not_null_unique;
+using google::protobuf::RepeatedField;
 using numerics::EstrinEvaluator;
 using numerics::ULPDistance;
 using numerics::ЧебышёвSeries;
@@ -202,21 +205,71 @@ DegreesOfFreedom<Frame> ContinuousTrajectory<Frame>::EvaluateDegreesOfFreedom(
                                  polynomial->EvaluateDerivative(time));
 }
 
+template<typename Frame>
+void ContinuousTrajectory<Frame>::EvaluateDegreesOfFreedom(
+    std::vector<Instant> const& times,
+    std::vector<DegreesOfFreedom<Frame>>& degrees_of_freedom) const {
+  degrees_of_freedom.clear();
+  if (times.empty()) {
+    return;
+  }
+  degrees_of_freedom.reserve(times.size());
+  absl::ReaderMutexLock l(&lock_);
+  CHECK_LE(t_min_locked(), times.front());
+  CHECK_GE(t_max_locked(), times.back());
+  // Since the |times| are sorted, the polynomials are found by walking
+  // forward from the one for the first time.
+  auto it = FindPolynomialForInstant(times.front());
+  for (Instant const& time : times) {
+    DCHECK(degrees_of_freedom.empty() ||
+           times[degrees_of_freedom.size() - 1] <= time);
+    while (it->t_max < time) {
+      ++it;
+    }
+    CHECK(it != polynomials_.end());
+    auto const& polynomial = it->polynomial;
+    degrees_of_freedom.emplace_back(
+        polynomial->Evaluate(time) + Frame::origin,
+        polynomial->EvaluateDerivative(time));
+  }
+}
+
 template<typename Frame>
 void ContinuousTrajectory<Frame>::WriteToMessage(
       not_null<serialization::ContinuousTrajectory*> const message) const {
+  WriteDeltaToMessage(message, /*omitted_t_max=*/astronomy::InfinitePast);
+}
+
+template<typename Frame>
+Instant ContinuousTrajectory<Frame>::WriteDeltaToMessage(
+    not_null<serialization::ContinuousTrajectory*> const message,
+    Instant const& omitted_t_max) const {
   absl::ReaderMutexLock l(&lock_);
   Instant const checkpoint_time =  checkpointer_.WriteToMessage(message);
   checkpoint_time.WriteToMessage(message->mutable_checkpoint_time());
   step_.WriteToMessage(message->mutable_step());
   tolerance_.WriteToMessage(message->mutable_tolerance());
-  for (auto const& pair : polynomials_) {
-    Instant const& t_max = pair.t_max;
-    auto const& polynomial = pair.polynomial;
+
+  auto it = std::upper_bound(polynomials_.begin(),
+                             polynomials_.end(),
+                             omitted_t_max,
+                             [](Instant const& left,
+                                InstantPolynomialPair const& right) {
+                               return left < right.t_max;
+                             });
+  // Only the polynomials up to the checkpoint are written, so they are the only
+  // ones that may be omitted by the next delta.
+  Instant last_t_max = astronomy::InfinitePast;
+  if (it != polynomials_.begin() && std::prev(it)->t_max <= checkpoint_time) {
+    last_t_max = std::prev(it)->t_max;
+  }
+  for (; it != polynomials_.end(); ++it) {
+    Instant const& t_max = it->t_max;
+    auto const& polynomial = it->polynomial;
     if (t_max <= checkpoint_time) {
-      auto* const pair = message->add_instant_polynomial_pair();
-      t_max.WriteToMessage(pair->mutable_t_max());
-      polynomial->WriteToMessage(pair->mutable_polynomial());
+      message->add_polynomial_t_max((t_max - Instant()) / Second);
+      polynomial->WriteToMessage(message->mutable_polynomials());
+      last_t_max = t_max;
     } else {
       break;
     }
@@ -224,6 +277,74 @@ void ContinuousTrajectory<Frame>::WriteToMessage(
   if (first_time_) {
     first_time_->WriteToMessage(message->mutable_first_time());
   }
+  return last_t_max;
+}
+
+template<typename Frame>
+void ContinuousTrajectory<Frame>::RestoreOmissions(
+    not_null<serialization::ContinuousTrajectory*> const previous,
+    Instant const& omitted_t_max,
+    not_null<serialization::ContinuousTrajectory*> const message) {
+  // An empty trajectory has no polynomials to restore.
+  if (!message->has_first_time()) {
+    return;
+  }
+  Instant const first_time = Instant::ReadFromMessage(message->first_time());
+
+  // Both messages were written by this version, so they don't have
+  // pre-Frobenius polynomials.
+  CHECK_EQ(0, previous->instant_polynomial_pair_size());
+  CHECK_EQ(0, message->instant_polynomial_pair_size());
+
+  // |ForgetBefore| keeps the polynomials whose |t_max| is at or after the
+  // |first_time|.
+  auto const& previous_t_maxes = previous->polynomial_t_max();
+  auto const t_max = [](double const t) { return Instant() + t * Second; };
+  auto const begin = std::partition_point(
+      previous_t_maxes.begin(),
+      previous_t_maxes.end(),
+      [&first_time, &t_max](double const t) {
+        return t_max(t) < first_time;
+      });
+  auto const end = std::partition_point(
+      begin,
+      previous_t_maxes.end(),
+      [&omitted_t_max, &t_max](double const t) {
+        return t_max(t) <= omitted_t_max;
+      });
+  if (begin == end) {
+    return;
+  }
+
+  // Locate the blocks of the omitted polynomials.
+  int const start = begin - previous_t_maxes.begin();
+  int const omitted_size = end - begin;
+  auto const& previous_polynomials = previous->polynomials();
+  int block_start = 0;
+  int block_end = 0;
+  for (int i = 0; i < start + omitted_size; ++i) {
+    if (i == start) {
+      block_start = block_end;
+    }
+    block_end += Polynomial<Displacement<Frame>, Instant>::PackedBlockSize(
+        previous_polynomials.degree(i));
+  }
+
+  // Insert the omitted polynomials before those of |message|.
+  auto* const polynomials = message->mutable_polynomials();
+  RepeatedField<double> t_maxes(begin, end);
+  t_maxes.MergeFrom(message->polynomial_t_max());
+  message->mutable_polynomial_t_max()->Swap(&t_maxes);
+  RepeatedField<std::int32_t> degrees(
+      previous_polynomials.degree().begin() + start,
+      previous_polynomials.degree().begin() + start + omitted_size);
+  degrees.MergeFrom(polynomials->degree());
+  polynomials->mutable_degree()->Swap(&degrees);
+  RepeatedField<double> blocks(
+      previous_polynomials.block().begin() + block_start,
+      previous_polynomials.block().begin() + block_end);
+  blocks.MergeFrom(polynomials->block());
+  polynomials->mutable_block()->Swap(&blocks);
 }
 
 template<typename Frame>
@@ -261,12 +382,23 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
               error_estimate));
     }
   } else {
+    // Pre-Frobenius.
     for (auto const& pair : message.instant_polynomial_pair()) {
       continuous_trajectory->polynomials_.emplace_back(
           Instant::ReadFromMessage(pair.t_max()),
           Polynomial<Displacement<Frame>, Instant>::template ReadFromMessage<
               EstrinEvaluator>(pair.polynomial()));
     }
+    auto const& polynomials = message.polynomials();
+    CHECK_EQ(message.polynomial_t_max_size(), polynomials.degree_size());
+    int block_index = 0;
+    for (int i = 0; i < message.polynomial_t_max_size(); ++i) {
+      continuous_trajectory->polynomials_.emplace_back(
+          Instant() + message.polynomial_t_max(i) * Second,
+          Polynomial<Displacement<Frame>, Instant>::template ReadFromMessage<
+              EstrinEvaluator>(polynomials, i, block_index));
+    }
+    CHECK_EQ(polynomials.block_size(), block_index);
   }
   if (message.has_first_time()) {
     continuous_trajectory->first_time_ =
@@ -7,6 +7,7 @@
 #include <limits>
 #include <vector>
 
+#include "astronomy/epoch.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/named_quantities.hpp"
 #include "gtest/gtest.h"
@@ -30,9 +31,11 @@ namespace principia {
 namespace physics {
 namespace internal_continuous_trajectory {
 
+using astronomy::InfinitePast;
 using geometry::Displacement;
 using geometry::Frame;
 using geometry::Velocity;
+using numerics::EstrinEvaluator;
 using numerics::Polynomial;
 using numerics::PolynomialInMonomialBasis;
 using numerics::HornerEvaluator;
@@ -539,6 +542,22 @@ TEST_F(ContinuousTrajectoryTest, Io) {
   }
   EXPECT_THAT(max_position_absolute_error, IsNear(31_⑴ * Milli(Metre)));
   EXPECT_THAT(max_velocity_absolute_error, IsNear(1.43e-5_⑴ * Metre / Second));
+
+  // Batch evaluation must agree exactly with the evaluation at each time.
+  std::vector<Instant> times;
+  for (Instant time = trajectory->t_min();
+       time <= trajectory->t_max();
+       time += step / number_of_substeps) {
+    times.push_back(time);
+  }
+  times.push_back(trajectory->t_max());
+  std::vector<DegreesOfFreedom<World>> degrees_of_freedom;
+  trajectory->EvaluateDegreesOfFreedom(times, degrees_of_freedom);
+  ASSERT_EQ(times.size(), degrees_of_freedom.size());
+  for (int i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(trajectory->EvaluateDegreesOfFreedom(times[i]),
+              degrees_of_freedom[i]);
+  }
 }
 
 TEST_F(ContinuousTrajectoryTest, Continuity) {
@@ -634,7 +653,7 @@ TEST_F(ContinuousTrajectoryTest, Serialization) {
     EXPECT_FALSE(message.has_degree());
     EXPECT_FALSE(message.has_degree_age());
     EXPECT_EQ(0, message.last_point_size());
-    EXPECT_EQ(2, message.instant_polynomial_pair_size());
+    EXPECT_EQ(2, message.polynomial_t_max_size());
     EXPECT_TRUE(message.has_first_time());
 
     auto const trajectory_read =
@@ -666,7 +685,7 @@ TEST_F(ContinuousTrajectoryTest, Serialization) {
     EXPECT_TRUE(message.has_is_unstable());
     EXPECT_EQ(3, message.degree());
     EXPECT_GE(100, message.degree_age());
-    EXPECT_EQ(2, message.instant_polynomial_pair_size());
+    EXPECT_EQ(2, message.polynomial_t_max_size());
     EXPECT_TRUE(message.has_first_time());
     EXPECT_EQ(4, message.last_point_size());
 
@@ -687,6 +706,71 @@ TEST_F(ContinuousTrajectoryTest, Serialization) {
   }
 }
 
+TEST_F(ContinuousTrajectoryTest, DeltaSerialization) {
+  int const number_of_steps = 40;
+  Time const step = 0.01 * Second;
+  Length const tolerance = 0.1 * Metre;
+
+  auto position_function =
+      [this](Instant const t) {
+        return World::origin +
+            Displacement<World>({(t - t0_) * 3 * Metre / Second,
+                                 (t - t0_) * 5 * Metre / Second,
+                                 (t - t0_) * (-2) * Metre / Second});
+      };
+  auto velocity_function =
+      [](Instant const t) {
+        return Velocity<World>({3 * Metre / Second,
+                                5 * Metre / Second,
+                                -2 * Metre / Second});
+      };
+
+  auto const trajectory = std::make_unique<ContinuousTrajectory<World>>(
+                              step, tolerance);
+
+  // Replay the deltas and check that the result is identical to a full
+  // serialization.  The oldest checkpoint only moves when the beginning of the
+  // trajectory is forgotten.
+  serialization::ContinuousTrajectory replayed;
+  Instant omitted_t_max = InfinitePast;
+  for (int i = 0; i < 3; ++i) {
+    FillTrajectory(number_of_steps,
+                   step,
+                   position_function,
+                   velocity_function,
+                   t0_ + i * number_of_steps * step,
+                   *trajectory);
+    if (i == 2) {
+      trajectory->ForgetBefore(t0_ + 1.5 * number_of_steps * step);
+    }
+    trajectory->checkpointer().CreateUnconditionally(trajectory->t_max());
+
+    serialization::ContinuousTrajectory delta;
+    Instant const next_omitted_t_max =
+        trajectory->WriteDeltaToMessage(&delta, omitted_t_max);
+    serialization::ContinuousTrajectory full;
+    trajectory->WriteToMessage(&full);
+    int new_polynomials = 0;
+    for (double const t_max : full.polynomial_t_max()) {
+      if (Instant() + t_max * Second > omitted_t_max) {
+        ++new_polynomials;
+      }
+    }
+    EXPECT_EQ(new_polynomials, delta.polynomial_t_max_size());
+    if (i == 1) {
+      // The oldest checkpoint hasn't moved, there is nothing new to write.
+      EXPECT_EQ(0, delta.polynomial_t_max_size());
+      EXPECT_LT(0, full.polynomial_t_max_size());
+    }
+
+    ContinuousTrajectory<World>::RestoreOmissions(
+        &replayed, omitted_t_max, &delta);
+    EXPECT_THAT(delta, EqualsProto(full));
+    replayed.Swap(&delta);
+    omitted_t_max = next_omitted_t_max;
+  }
+}
+
 TEST_F(ContinuousTrajectoryTest, PreCohenCompatibility) {
   Time const step = 0.01 * Second;
   Length const tolerance = 0.1 * Metre;
@@ -699,7 +783,8 @@ TEST_F(ContinuousTrajectoryTest, PreCohenCompatibility) {
 
   // Remove the polynomials and add a single Чебышёв series of the form:
   //   T₀ - 2 * T₁ + 3 * T₂  + 4 * T₃.
-  message.clear_instant_polynomial_pair();
+  message.clear_polynomial_t_max();
+  message.clear_polynomials();
   auto* const series = message.add_series();
   Instant t_min = Instant() - 1 * Second;
   Instant t_max = Instant() + 1 * Second;
@@ -721,23 +806,81 @@ TEST_F(ContinuousTrajectoryTest, PreCohenCompatibility) {
       ContinuousTrajectory<World>::ReadFromMessage(message);
   serialization::ContinuousTrajectory message2;
   trajectory_read->WriteToMessage(&message2);
-  EXPECT_EQ(1, message2.instant_polynomial_pair_size());
-  EXPECT_EQ(3, message2.instant_polynomial_pair(0).polynomial().degree());
-  auto const& polynomial_in_monomial_basis =
-      message2.instant_polynomial_pair(0).polynomial().GetExtension(
-          serialization::PolynomialInMonomialBasis::extension);
-  EXPECT_EQ(-2,
-            polynomial_in_monomial_basis.coefficient(0).multivector().vector().
-                x().quantity().magnitude());
-  EXPECT_EQ(-14,
-            polynomial_in_monomial_basis.coefficient(1).multivector().vector().
-                x().quantity().magnitude());
-  EXPECT_EQ(6,
-            polynomial_in_monomial_basis.coefficient(2).multivector().vector().
-                x().quantity().magnitude());
-  EXPECT_EQ(16,
-            polynomial_in_monomial_basis.coefficient(3).multivector().vector().
-                x().quantity().magnitude());
+  EXPECT_EQ(1, message2.polynomial_t_max_size());
+  EXPECT_EQ(3, message2.polynomials().degree(0));
+  // The block starts with the origin, followed by the coordinates of the
+  // coefficients.
+  auto const& block = message2.polynomials().block();
+  EXPECT_EQ(13, block.size());
+  EXPECT_EQ(-2, block[1]);
+  EXPECT_EQ(-14, block[4]);
+  EXPECT_EQ(6, block[7]);
+  EXPECT_EQ(16, block[10]);
+}
+
+TEST_F(ContinuousTrajectoryTest, PreFrobeniusCompatibility) {
+  int const number_of_steps = 30;
+  Time const step = 0.01 * Second;
+  Length const tolerance = 0.1 * Metre;
+
+  auto position_function =
+      [this](Instant const t) {
+        return World::origin +
+            Displacement<World>({(t - t0_) * 3 * Metre / Second,
+                                 (t - t0_) * 5 * Metre / Second,
+                                 (t - t0_) * (-2) * Metre / Second});
+      };
+  auto velocity_function =
+      [](Instant const t) {
+        return Velocity<World>({3 * Metre / Second,
+                                5 * Metre / Second,
+                                -2 * Metre / Second});
+      };
+
+  auto const trajectory = std::make_unique<ContinuousTrajectory<World>>(
+                              step, tolerance);
+  FillTrajectory(number_of_steps,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_,
+                 *trajectory);
+  trajectory->checkpointer().CreateUnconditionally(trajectory->t_max());
+  serialization::ContinuousTrajectory message;
+  trajectory->WriteToMessage(&message);
+  EXPECT_EQ(0, message.instant_polynomial_pair_size());
+  EXPECT_LT(0, message.polynomial_t_max_size());
+
+  // Rewrite the polynomials in the pre-Frobenius format.
+  serialization::ContinuousTrajectory pre_frobenius_message = message;
+  pre_frobenius_message.clear_polynomial_t_max();
+  pre_frobenius_message.clear_polynomials();
+  int block_index = 0;
+  for (int i = 0; i < message.polynomial_t_max_size(); ++i) {
+    auto const polynomial = Polynomial<Displacement<World>, Instant>::
+        ReadFromMessage<EstrinEvaluator>(message.polynomials(), i, block_index);
+    auto* const pair = pre_frobenius_message.add_instant_polynomial_pair();
+    (Instant() + message.polynomial_t_max(i) * Second).WriteToMessage(
+        pair->mutable_t_max());
+    polynomial->WriteToMessage(pair->mutable_polynomial());
+  }
+  EXPECT_EQ(message.polynomials().block_size(), block_index);
+  EXPECT_LT(message.ByteSizeLong(), pre_frobenius_message.ByteSizeLong());
+
+  // Reading the pre-Frobenius message gives the same trajectory.
+  auto const trajectory_read =
+      ContinuousTrajectory<World>::ReadFromMessage(pre_frobenius_message);
+  EXPECT_EQ(trajectory->t_min(), trajectory_read->t_min());
+  EXPECT_EQ(trajectory->t_max(), trajectory_read->t_max());
+  for (Instant time = trajectory->t_min();
+       time <= trajectory->t_max();
+       time += step / 10) {
+    EXPECT_EQ(trajectory->EvaluateDegreesOfFreedom(time),
+              trajectory_read->EvaluateDegreesOfFreedom(time));
+  }
+  serialization::ContinuousTrajectory second_message;
+  trajectory_read->WriteToMessage(&second_message);
+  EXPECT_THAT(second_message, EqualsProto(message));
 }
 
 TEST_F(ContinuousTrajectoryTest, Checkpoint) {
@@ -791,7 +934,7 @@ TEST_F(ContinuousTrajectoryTest, Checkpoint) {
   EXPECT_TRUE(message.has_is_unstable());
   EXPECT_EQ(3, message.degree());
   EXPECT_GE(100, message.degree_age());
-  EXPECT_EQ(3, message.instant_polynomial_pair_size());
+  EXPECT_EQ(3, message.polynomial_t_max_size());
   EXPECT_TRUE(message.has_first_time());
   EXPECT_EQ(6, message.last_point_size());
 
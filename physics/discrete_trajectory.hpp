@@ -1,6 +1,7 @@
 ﻿
 #pragma once
 
+#include <array>
 #include <functional>
 #include <list>
 #include <map>
@@ -13,6 +14,7 @@
 #include "geometry/grassmann.hpp"
 #include "geometry/named_quantities.hpp"
 #include "numerics/hermite3.hpp"
+#include "physics/compressed_timeline.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/forkable.hpp"
 #include "physics/trajectory.hpp"
@@ -132,6 +134,22 @@ class DiscreteTrajectory : public Forkable<DiscreteTrajectory<Frame>,
   // |time|.  This trajectory must be a root.
   void ForgetBefore(Instant const& time);
 
+  // Moves the points of this trajectory at times (strictly) less than |time| to
+  // the end of |compressed_timeline()|, where they take less memory but are
+  // slower to access.  Like |ForgetBefore|, this removes them from the
+  // iteration, |Find|, |LowerBound| and the evaluation functions of this
+  // trajectory, which remain as fast as for an uncompressed trajectory.  The
+  // points that may still be removed by downsampling are not compressed.  This
+  // trajectory must be a root and must not have forks at times (strictly) less
+  // than |time|.  The compressed points are serialized before the others, and
+  // are uncompressed when read.
+  void CompressBefore(Instant const& time);
+
+  // The points moved by |CompressBefore|, which precede those of this
+  // trajectory.  Returns null if no point was compressed.  This trajectory must
+  // be a root.
+  CompressedTimeline<Frame> const* compressed_timeline() const;
+
   // This trajectory must be root, and must not be already downsampling.
   // Following this call, this trajectory must not have forks when calling
   // |Append|.  Occasionally removes intermediate points from the trajectory
@@ -156,6 +174,9 @@ class DiscreteTrajectory : public Forkable<DiscreteTrajectory<Frame>,
   Velocity<Frame> EvaluateVelocity(Instant const& time) const override;
   DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(
       Instant const& time) const override;
+  void EvaluateDegreesOfFreedom(
+      std::vector<Instant> const& times,
+      std::vector<DegreesOfFreedom<Frame>>& degrees_of_freedom) const override;
 
   // End of the implementation of the interface.
 
@@ -174,6 +195,29 @@ class DiscreteTrajectory : public Forkable<DiscreteTrajectory<Frame>,
       serialization::DiscreteTrajectory const& message,
       std::vector<DiscreteTrajectory<Frame>**> const& forks);
 
+  // Returns the time of the last point of the timeline of this trajectory,
+  // including its compressed points, that may only be removed by |ForgetBefore|
+  // from now on, i.e., that is not subject to downsampling.  Returns -∞ if there
+  // is no such point.  This trajectory must be a root.
+  Instant settled_t_max() const;
+
+  // Same as |WriteToMessage|, but the points of the timeline of this trajectory
+  // at or before |omitted_t_max| are not written, except that nothing is
+  // omitted if |omitted_t_max| is -∞.  The points of the forks are always
+  // written.
+  void WriteDeltaToMessage(
+      not_null<serialization::DiscreteTrajectory*> message,
+      std::vector<DiscreteTrajectory<Frame>*> const& forks,
+      Instant const& omitted_t_max) const;
+  // Completes a |message| written by |WriteDeltaToMessage| by copying to its
+  // timeline the points of the timeline of |previous| in
+  // [omitted_t_min, omitted_t_max].
+  static void RestoreOmissions(
+      not_null<serialization::DiscreteTrajectory*> previous,
+      Instant const& omitted_t_min,
+      Instant const& omitted_t_max,
+      not_null<serialization::DiscreteTrajectory*> message);
+
  protected:
   // The API inherited from Forkable.
   not_null<DiscreteTrajectory*> that() override;
@@ -240,10 +284,35 @@ class DiscreteTrajectory : public Forkable<DiscreteTrajectory<Frame>,
     std::int64_t dense_intervals_;
   };
 
+  // The coordinates of the points of a timeline in SI units, in the order of
+  // the columns of |serialization::DiscreteTrajectory::PackedTimeline|.
+  using Columns = std::array<std::vector<double>, 7>;
+
+  static void AppendToColumns(Instant const& time,
+                              DegreesOfFreedom<Frame> const& degrees_of_freedom,
+                              Columns& columns);
+  // Clears the |packed_timeline| of |message| if the |columns| are empty.
+  static void WriteColumnsToMessage(
+      Columns const& columns,
+      not_null<serialization::DiscreteTrajectory*> message);
+  static Columns ReadColumnsFromMessage(
+      serialization::DiscreteTrajectory::PackedTimeline const& message);
+  static void WriteColumnToMessage(
+      std::vector<double> const& column,
+      not_null<serialization::DiscreteTrajectory::Column*> message);
+  static std::vector<double> ReadColumnFromMessage(
+      serialization::DiscreteTrajectory::Column const& message);
+
   // This trajectory need not be a root.
   void WriteSubTreeToMessage(
       not_null<serialization::DiscreteTrajectory*> message,
       std::vector<DiscreteTrajectory<Frame>*>& forks) const;
+  // Same as above, but the points of the timeline at or before |omitted_t_max|
+  // are not written.
+  void WriteSubTreeToMessage(
+      not_null<serialization::DiscreteTrajectory*> message,
+      std::vector<DiscreteTrajectory<Frame>*>& forks,
+      Instant const& omitted_t_max) const;
 
   void FillSubTreeFromMessage(
       serialization::DiscreteTrajectory const& message,
@@ -256,6 +325,12 @@ class DiscreteTrajectory : public Forkable<DiscreteTrajectory<Frame>,
   Hermite3<Instant, Position<Frame>> GetInterpolation(
       Instant const& time) const;
 
+  // Whether there are points in the compressed tier.
+  bool has_compressed_timeline() const;
+
+  // The points moved by |CompressBefore|, which precede those of |timeline_|.
+  // Only engaged for a root on which |CompressBefore| was called.
+  std::optional<CompressedTimeline<Frame>> compressed_timeline_;
   Timeline timeline_;
 
   std::optional<Downsampling> downsampling_;
@@ -4,6 +4,8 @@
 #include "physics/discrete_trajectory.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <list>
 #include <map>
 #include <vector>
@@ -11,7 +13,9 @@
 #include "astronomy/epoch.hpp"
 #include "geometry/named_quantities.hpp"
 #include "glog/logging.h"
+#include "google/protobuf/io/coded_stream.h"
 #include "numerics/fit_hermite_spline.hpp"
+#include "quantities/si.hpp"
 
 namespace principia {
 namespace physics {
@@ -58,7 +62,10 @@ namespace internal_discrete_trajectory {
 using astronomy::InfiniteFuture;
 using astronomy::InfinitePast;
 using base::make_not_null_unique;
+using geometry::Displacement;
 using numerics::FitHermiteSpline;
+using quantities::si::Metre;
+using quantities::si::Second;
 
 template<typename Frame>
 not_null<DiscreteTrajectory<Frame>*>
@@ -95,6 +102,8 @@ not_null<DiscreteTrajectory<Frame>*>
 DiscreteTrajectory<Frame>::NewForkAtLast() {
   auto end = timeline_.end();
   if (timeline_.empty()) {
+    // The last point may be compressed, but it cannot be a fork point.
+    CHECK(!has_compressed_timeline());
     return this->NewFork(end);
   } else {
     return this->NewFork(--end);
@@ -177,6 +186,10 @@ void DiscreteTrajectory<Frame>::Append(
                  << this->back().time << "]";
     return;
   }
+  if (timeline_.empty() && has_compressed_timeline()) {
+    CHECK_LT(compressed_timeline_->t_max(), time)
+        << "Append out of order at " << time;
+  }
   auto it = timeline_.emplace_hint(timeline_.end(),
                                    time,
                                    degrees_of_freedom);
@@ -254,6 +267,9 @@ void DiscreteTrajectory<Frame>::ForgetAfter(Instant const& time) {
   if (downsampling_.has_value()) {
     downsampling_->RecountDenseIntervals(timeline_);
   }
+  if (compressed_timeline_.has_value()) {
+    compressed_timeline_->ForgetAfter(time);
+  }
 }
 
 template<typename Frame>
@@ -270,6 +286,41 @@ void DiscreteTrajectory<Frame>::ForgetBefore(Instant const& time) {
     downsampling_->SetStartOfDenseTimeline(first_kept_in_timeline, timeline_);
   }
   timeline_.erase(timeline_.begin(), first_kept_in_timeline);
+  if (compressed_timeline_.has_value()) {
+    compressed_timeline_->ForgetBefore(time);
+  }
+}
+
+template<typename Frame>
+void DiscreteTrajectory<Frame>::CompressBefore(Instant const& time) {
+  CHECK(this->is_root());
+  this->CheckNoForksBefore(time);
+
+  TimelineConstIterator end_of_compressed_points = timeline_.lower_bound(time);
+  // The start of the dense timeline is referenced by |downsampling_|, and the
+  // points that follow it may be removed by downsampling.
+  if (downsampling_.has_value() &&
+      downsampling_->start_of_dense_timeline() != timeline_.end() &&
+      downsampling_->first_dense_time() < time) {
+    end_of_compressed_points = downsampling_->start_of_dense_timeline();
+  }
+  if (end_of_compressed_points == timeline_.begin()) {
+    return;
+  }
+  if (!compressed_timeline_.has_value()) {
+    compressed_timeline_.emplace();
+  }
+  for (auto it = timeline_.begin(); it != end_of_compressed_points; ++it) {
+    compressed_timeline_->Append(it->first, it->second);
+  }
+  timeline_.erase(timeline_.begin(), end_of_compressed_points);
+}
+
+template<typename Frame>
+CompressedTimeline<Frame> const*
+DiscreteTrajectory<Frame>::compressed_timeline() const {
+  CHECK(this->is_root());
+  return has_compressed_timeline() ? &*compressed_timeline_ : nullptr;
 }
 
 template<typename Frame>
@@ -315,20 +366,55 @@ DegreesOfFreedom<Frame> DiscreteTrajectory<Frame>::EvaluateDegreesOfFreedom(
   return {interpolation.Evaluate(time), interpolation.EvaluateDerivative(time)};
 }
 
+template<typename Frame>
+void DiscreteTrajectory<Frame>::EvaluateDegreesOfFreedom(
+    std::vector<Instant> const& times,
+    std::vector<DegreesOfFreedom<Frame>>& degrees_of_freedom) const {
+  degrees_of_freedom.clear();
+  if (times.empty()) {
+    return;
+  }
+  degrees_of_freedom.reserve(times.size());
+  CHECK_LE(t_min(), times.front());
+  CHECK_GE(t_max(), times.back());
+
+  // Walk the points of the trajectory once, maintaining the bounds of the
+  // interval used by |GetInterpolation|, and only rebuild the interpolation
+  // when the upper bound changes.
+  auto const points = this->Points();
+  auto upper = points.begin();
+  auto lower = upper;
+  std::optional<Hermite3<Instant, Position<Frame>>> interpolation;
+  for (Instant const& time : times) {
+    DCHECK(degrees_of_freedom.empty() ||
+           times[degrees_of_freedom.size() - 1] <= time);
+    bool upper_changed = !interpolation.has_value();
+    while ((*upper).first < time) {
+      lower = upper;
+      ++upper;
+      upper_changed = true;
+    }
+    if (upper_changed) {
+      auto const& [lower_time, lower_degrees_of_freedom] = *lower;
+      auto const& [upper_time, upper_degrees_of_freedom] = *upper;
+      interpolation.emplace(
+          std::pair{lower_time, upper_time},
+          std::pair{lower_degrees_of_freedom.position(),
+                    upper_degrees_of_freedom.position()},
+          std::pair{lower_degrees_of_freedom.velocity(),
+                    upper_degrees_of_freedom.velocity()});
+    }
+    degrees_of_freedom.emplace_back(interpolation->Evaluate(time),
+                                    interpolation->EvaluateDerivative(time));
+  }
+}
+
 template<typename Frame>
 void DiscreteTrajectory<Frame>::WriteToMessage(
     not_null<serialization::DiscreteTrajectory*> const message,
     std::vector<DiscreteTrajectory<Frame>*> const& forks)
     const {
-  CHECK(this->is_root());
-
-  std::vector<DiscreteTrajectory<Frame>*> mutable_forks = forks;
-  WriteSubTreeToMessage(message, mutable_forks);
-  CHECK(std::all_of(mutable_forks.begin(),
-                    mutable_forks.end(),
-                    [](DiscreteTrajectory<Frame>* const fork) {
-                      return fork == nullptr;
-                    }));
+  WriteDeltaToMessage(message, forks, /*omitted_t_max=*/InfinitePast);
 }
 
 template<typename Frame>
@@ -346,6 +432,88 @@ DiscreteTrajectory<Frame>::ReadFromMessage(
   return trajectory;
 }
 
+template<typename Frame>
+Instant DiscreteTrajectory<Frame>::settled_t_max() const {
+  CHECK(this->is_root());
+  // The points before the start of the dense timeline are the left endpoints of
+  // downsampled intervals, they are never removed by downsampling.
+  TimelineConstIterator const end_of_settled_timeline =
+      downsampling_.has_value() ? downsampling_->start_of_dense_timeline()
+                                : timeline_.end();
+  if (end_of_settled_timeline == timeline_.begin()) {
+    // The compressed points are never removed by downsampling.
+    return has_compressed_timeline() ? compressed_timeline_->t_max()
+                                     : InfinitePast;
+  } else {
+    return std::prev(end_of_settled_timeline)->first;
+  }
+}
+
+template<typename Frame>
+void DiscreteTrajectory<Frame>::WriteDeltaToMessage(
+    not_null<serialization::DiscreteTrajectory*> const message,
+    std::vector<DiscreteTrajectory<Frame>*> const& forks,
+    Instant const& omitted_t_max) const {
+  CHECK(this->is_root());
+
+  std::vector<DiscreteTrajectory<Frame>*> mutable_forks = forks;
+  WriteSubTreeToMessage(message, mutable_forks, omitted_t_max);
+  CHECK(std::all_of(mutable_forks.begin(),
+                    mutable_forks.end(),
+                    [](DiscreteTrajectory<Frame>* const fork) {
+                      return fork == nullptr;
+                    }));
+}
+
+template<typename Frame>
+void DiscreteTrajectory<Frame>::RestoreOmissions(
+    not_null<serialization::DiscreteTrajectory*> const previous,
+    Instant const& omitted_t_min,
+    Instant const& omitted_t_max,
+    not_null<serialization::DiscreteTrajectory*> const message) {
+  // Both messages were written by this version, so they don't have a
+  // pre-Frobenius timeline.
+  CHECK_EQ(0, previous->timeline_size());
+  CHECK_EQ(0, message->timeline_size());
+  if (!previous->has_packed_timeline()) {
+    return;
+  }
+  Columns const previous_columns =
+      ReadColumnsFromMessage(previous->packed_timeline());
+  std::vector<double> const& previous_times = previous_columns[0];
+  auto const time = [](double const t) { return Instant() + t * Second; };
+  auto const begin = std::partition_point(
+      previous_times.begin(),
+      previous_times.end(),
+      [&omitted_t_min, &time](double const t) {
+        return time(t) < omitted_t_min;
+      });
+  auto const end = std::partition_point(
+      begin,
+      previous_times.end(),
+      [&omitted_t_max, &time](double const t) {
+        return time(t) <= omitted_t_max;
+      });
+  if (begin == end) {
+    return;
+  }
+
+  // The omitted points precede those of |message|.
+  int const start = begin - previous_times.begin();
+  int const omitted_size = end - begin;
+  Columns columns;
+  if (message->has_packed_timeline()) {
+    columns = ReadColumnsFromMessage(message->packed_timeline());
+  }
+  for (int i = 0; i < columns.size(); ++i) {
+    auto const& previous_column = previous_columns[i];
+    columns[i].insert(columns[i].begin(),
+                      previous_column.begin() + start,
+                      previous_column.begin() + start + omitted_size);
+  }
+  WriteColumnsToMessage(columns, message);
+}
+
 template<typename Frame>
 not_null<DiscreteTrajectory<Frame>*> DiscreteTrajectory<Frame>::that() {
   return this;
@@ -488,17 +656,142 @@ DiscreteTrajectory<Frame>::Downsampling::ReadFromMessage(
                       timeline);
 }
 
+template<typename Frame>
+void DiscreteTrajectory<Frame>::AppendToColumns(
+    Instant const& time,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom,
+    Columns& columns) {
+  auto& [t, x, y, z, vx, vy, vz] = columns;
+  auto const q = (degrees_of_freedom.position() - Frame::origin).coordinates();
+  auto const& v = degrees_of_freedom.velocity().coordinates();
+  t.push_back((time - Instant()) / Second);
+  x.push_back(q.x / Metre);
+  y.push_back(q.y / Metre);
+  z.push_back(q.z / Metre);
+  vx.push_back(v.x / (Metre / Second));
+  vy.push_back(v.y / (Metre / Second));
+  vz.push_back(v.z / (Metre / Second));
+}
+
+template<typename Frame>
+void DiscreteTrajectory<Frame>::WriteColumnsToMessage(
+    Columns const& columns,
+    not_null<serialization::DiscreteTrajectory*> const message) {
+  if (columns[0].empty()) {
+    message->clear_packed_timeline();
+    return;
+  }
+  auto const& [t, x, y, z, vx, vy, vz] = columns;
+  auto* const packed_timeline = message->mutable_packed_timeline();
+  Frame::WriteToMessage(packed_timeline->mutable_frame());
+  WriteColumnToMessage(t, packed_timeline->mutable_instant());
+  WriteColumnToMessage(x, packed_timeline->mutable_x());
+  WriteColumnToMessage(y, packed_timeline->mutable_y());
+  WriteColumnToMessage(z, packed_timeline->mutable_z());
+  WriteColumnToMessage(vx, packed_timeline->mutable_vx());
+  WriteColumnToMessage(vy, packed_timeline->mutable_vy());
+  WriteColumnToMessage(vz, packed_timeline->mutable_vz());
+}
+
+template<typename Frame>
+typename DiscreteTrajectory<Frame>::Columns
+DiscreteTrajectory<Frame>::ReadColumnsFromMessage(
+    serialization::DiscreteTrajectory::PackedTimeline const& message) {
+  Frame::ReadFromMessage(message.frame());
+  Columns columns{ReadColumnFromMessage(message.instant()),
+                  ReadColumnFromMessage(message.x()),
+                  ReadColumnFromMessage(message.y()),
+                  ReadColumnFromMessage(message.z()),
+                  ReadColumnFromMessage(message.vx()),
+                  ReadColumnFromMessage(message.vy()),
+                  ReadColumnFromMessage(message.vz())};
+  for (auto const& column : columns) {
+    CHECK_EQ(columns[0].size(), column.size());
+  }
+  return columns;
+}
+
+template<typename Frame>
+void DiscreteTrajectory<Frame>::WriteColumnToMessage(
+    std::vector<double> const& column,
+    not_null<serialization::DiscreteTrajectory::Column*> const message) {
+  using google::protobuf::io::CodedOutputStream;
+  message->Clear();
+  std::vector<std::uint64_t> xor_values;
+  xor_values.reserve(column.size());
+  std::int64_t xor_size = 0;
+  std::uint64_t previous_bits = 0;
+  for (double const value : column) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(double));
+    xor_values.push_back(bits ^ previous_bits);
+    xor_size += CodedOutputStream::VarintSize64(xor_values.back());
+    previous_bits = bits;
+  }
+  if (xor_size < column.size() * sizeof(double)) {
+    message->mutable_xor_value()->Add(xor_values.begin(), xor_values.end());
+  } else {
+    message->mutable_value()->Add(column.begin(), column.end());
+  }
+}
+
+template<typename Frame>
+std::vector<double> DiscreteTrajectory<Frame>::ReadColumnFromMessage(
+    serialization::DiscreteTrajectory::Column const& message) {
+  CHECK(message.value_size() == 0 || message.xor_value_size() == 0);
+  if (message.xor_value_size() == 0) {
+    return std::vector<double>(message.value().begin(), message.value().end());
+  }
+  std::vector<double> column;
+  column.reserve(message.xor_value_size());
+  std::uint64_t bits = 0;
+  for (std::uint64_t const xor_value : message.xor_value()) {
+    bits ^= xor_value;
+    double value;
+    std::memcpy(&value, &bits, sizeof(double));
+    column.push_back(value);
+  }
+  return column;
+}
+
 template<typename Frame>
 void DiscreteTrajectory<Frame>::WriteSubTreeToMessage(
     not_null<serialization::DiscreteTrajectory*> const message,
     std::vector<DiscreteTrajectory<Frame>*>& forks) const {
+  WriteSubTreeToMessage(message, forks, /*omitted_t_max=*/InfinitePast);
+}
+
+template<typename Frame>
+void DiscreteTrajectory<Frame>::WriteSubTreeToMessage(
+    not_null<serialization::DiscreteTrajectory*> const message,
+    std::vector<DiscreteTrajectory<Frame>*>& forks,
+    Instant const& omitted_t_max) const {
   Forkable<DiscreteTrajectory, Iterator>::WriteSubTreeToMessage(message, forks);
-  for (auto const& [instant, degrees_of_freedom] : timeline_) {
-    auto const instantaneous_degrees_of_freedom = message->add_timeline();
-    instant.WriteToMessage(instantaneous_degrees_of_freedom->mutable_instant());
-    degrees_of_freedom.WriteToMessage(
-        instantaneous_degrees_of_freedom->mutable_degrees_of_freedom());
+  // The prehistory of a part has a point at -∞, which must be written when
+  // nothing is omitted.
+  Columns columns;
+  // The compressed points are written in the same columns as the others.
+  if (has_compressed_timeline()) {
+    for (auto it = omitted_t_max == InfinitePast
+                       ? compressed_timeline_->begin()
+                       : compressed_timeline_->LowerBound(omitted_t_max);
+         it != compressed_timeline_->end();
+         ++it) {
+      auto const& [instant, degrees_of_freedom] = *it;
+      if (omitted_t_max == InfinitePast || instant > omitted_t_max) {
+        AppendToColumns(instant, degrees_of_freedom, columns);
+      }
+    }
+  }
+  for (auto it = omitted_t_max == InfinitePast
+                     ? timeline_.begin()
+                     : timeline_.upper_bound(omitted_t_max);
+       it != timeline_.end();
+       ++it) {
+    auto const& [instant, degrees_of_freedom] = *it;
+    AppendToColumns(instant, degrees_of_freedom, columns);
   }
+  WriteColumnsToMessage(columns, message);
   if (downsampling_.has_value()) {
     downsampling_->WriteToMessage(message->mutable_downsampling(), timeline_);
   }
@@ -508,6 +801,7 @@ template<typename Frame>
 void DiscreteTrajectory<Frame>::FillSubTreeFromMessage(
     serialization::DiscreteTrajectory const& message,
     std::vector<DiscreteTrajectory<Frame>**> const& forks) {
+  // Pre-Frobenius.
   for (auto timeline_it = message.timeline().begin();
        timeline_it != message.timeline().end();
        ++timeline_it) {
@@ -515,6 +809,21 @@ void DiscreteTrajectory<Frame>::FillSubTreeFromMessage(
            DegreesOfFreedom<Frame>::ReadFromMessage(
                timeline_it->degrees_of_freedom()));
   }
+  if (message.has_packed_timeline()) {
+    Columns const columns = ReadColumnsFromMessage(message.packed_timeline());
+    auto const& [t, x, y, z, vx, vy, vz] = columns;
+    for (int i = 0; i < t.size(); ++i) {
+      Append(Instant() + t[i] * Second,
+             DegreesOfFreedom<Frame>(
+                 Frame::origin +
+                     Displacement<Frame>({x[i] * Metre,
+                                          y[i] * Metre,
+                                          z[i] * Metre}),
+                 Velocity<Frame>({vx[i] * (Metre / Second),
+                                  vy[i] * (Metre / Second),
+                                  vz[i] * (Metre / Second)})));
+    }
+  }
   if (message.has_downsampling()) {
     CHECK(this->is_root());
     downsampling_.emplace(
@@ -541,6 +850,11 @@ Hermite3<Instant, Position<Frame>> DiscreteTrajectory<Frame>::GetInterpolation(
        upper->degrees_of_freedom.velocity()}};
 }
 
+template<typename Frame>
+bool DiscreteTrajectory<Frame>::has_compressed_timeline() const {
+  return compressed_timeline_.has_value() && !compressed_timeline_->empty();
+}
+
 }  // namespace internal_discrete_trajectory
 }  // namespace physics
 }  // namespace principia
@@ -3,11 +3,13 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <list>
 #include <map>
 #include <string>
 #include <vector>
 
+#include "astronomy/epoch.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/named_quantities.hpp"
@@ -26,6 +28,7 @@ namespace principia {
 namespace physics {
 namespace internal_discrete_trajectory {
 
+using astronomy::InfinitePast;
 using geometry::Displacement;
 using geometry::Frame;
 using geometry::Instant;
@@ -119,6 +122,20 @@ class DiscreteTrajectoryTest : public testing::Test {
     return result;
   }
 
+  // The points of the timeline of |message|, excluding those of its children.
+  std::map<Instant, DegreesOfFreedom<World>> Timeline(
+      serialization::DiscreteTrajectory message) const {
+    message.clear_children();
+    message.clear_fork_position();
+    auto const trajectory =
+        DiscreteTrajectory<World>::ReadFromMessage(message, /*forks=*/{});
+    std::map<Instant, DegreesOfFreedom<World>> result;
+    for (auto const& [time, degrees_of_freedom] : *trajectory) {
+      result.emplace_hint(result.end(), time, degrees_of_freedom);
+    }
+    return result;
+  }
+
   std::list<Instant> Times(DiscreteTrajectory<World> const& trajectory) const {
     std::list<Instant> result;
     for (auto const& [time, degrees_of_freedom] : trajectory) {
@@ -720,55 +737,20 @@ TEST_F(DiscreteTrajectoryTest, TrajectorySerializationSuccess) {
                                            deserialized_fork2});
   EXPECT_THAT(reference_message, EqualsProto(message));
   EXPECT_THAT(message.children_size(), Eq(2));
-  EXPECT_THAT(message.timeline_size(), Eq(3));
-  EXPECT_THAT(Instant::ReadFromMessage(message.timeline(0).instant()), Eq(t1_));
-  EXPECT_THAT(Instant::ReadFromMessage(message.timeline(1).instant()), Eq(t2_));
-  EXPECT_THAT(Instant::ReadFromMessage(message.timeline(2).instant()), Eq(t3_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.timeline(0).degrees_of_freedom()), Eq(d1_));
-  EXPECT_THAT(
-        DegreesOfFreedom<World>::ReadFromMessage(
-            message.timeline(1).degrees_of_freedom()), Eq(d2_));
-  EXPECT_THAT(
-        DegreesOfFreedom<World>::ReadFromMessage(
-            message.timeline(2).degrees_of_freedom()), Eq(d3_));
+  EXPECT_THAT(message.timeline_size(), Eq(0));
+  EXPECT_THAT(Timeline(message),
+              ElementsAre(Pair(t1_, d1_), Pair(t2_, d2_), Pair(t3_, d3_)));
   EXPECT_THAT(message.children(0).trajectories_size(), Eq(2));
   EXPECT_THAT(message.children(0).trajectories(0).children_size(), Eq(0));
-  EXPECT_THAT(message.children(0).trajectories(0).timeline_size(), Eq(1));
-  EXPECT_THAT(
-      Instant::ReadFromMessage(
-          message.children(0).trajectories(0).timeline(0).instant()), Eq(t3_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.children(0).trajectories(0).timeline(0).degrees_of_freedom()),
-      Eq(d3_));
+  EXPECT_THAT(Timeline(message.children(0).trajectories(0)),
+              ElementsAre(Pair(t3_, d3_)));
   EXPECT_THAT(message.children(0).trajectories(1).children_size(), Eq(0));
-  EXPECT_THAT(message.children(0).trajectories(1).timeline_size(), Eq(2));
-  EXPECT_THAT(
-      Instant::ReadFromMessage(
-          message.children(0).trajectories(1).timeline(0).instant()), Eq(t3_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.children(0).trajectories(1).timeline(0).degrees_of_freedom()),
-      Eq(d3_));
-  EXPECT_THAT(
-      Instant::ReadFromMessage(
-          message.children(0).trajectories(1).timeline(1).instant()), Eq(t4_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.children(0).trajectories(1).timeline(1).degrees_of_freedom()),
-      Eq(d4_));
+  EXPECT_THAT(Timeline(message.children(0).trajectories(1)),
+              ElementsAre(Pair(t3_, d3_), Pair(t4_, d4_)));
   EXPECT_THAT(message.children(1).trajectories_size(), Eq(1));
   EXPECT_THAT(message.children(1).trajectories(0).children_size(), Eq(0));
-  EXPECT_THAT(message.children(1).trajectories(0).timeline_size(), Eq(1));
-  EXPECT_THAT(
-      Instant::ReadFromMessage(
-          message.children(1).trajectories(0).timeline(0).instant()), Eq(t4_));
-  EXPECT_THAT(
-      DegreesOfFreedom<World>::ReadFromMessage(
-          message.children(1).trajectories(0).timeline(0).degrees_of_freedom()),
-      Eq(d4_));
+  EXPECT_THAT(Timeline(message.children(1).trajectories(0)),
+              ElementsAre(Pair(t4_, d4_)));
 }
 
 TEST_F(DiscreteTrajectoryDeathTest, LastError) {
@@ -868,6 +850,54 @@ TEST_F(DiscreteTrajectoryTest, QuadrilateralCircle) {
   EXPECT_THAT(max_v_error, IsNear(0.012_⑴));
 }
 
+TEST_F(DiscreteTrajectoryTest, BatchEvaluation) {
+  DiscreteTrajectory<World> circle;
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Speed const v = ω * r / Radian;
+  Time const period = 2 * π * Radian / ω;
+  auto const append = [ω, r, v, this](Time const& t,
+                                       DiscreteTrajectory<World>& trajectory) {
+    trajectory.Append(
+        t0_ + t,
+        {World::origin + Displacement<World>{{r * Cos(ω * t),
+                                              r * Sin(ω * t),
+                                              0 * Metre}},
+         Velocity<World>{{-v * Sin(ω * t),
+                          v * Cos(ω * t),
+                          0 * Metre / Second}}});
+  };
+  for (Time t; t <= period / 2; t += period / 8) {
+    append(t, circle);
+  }
+  // Make sure that the evaluation crosses the fork point.
+  not_null<DiscreteTrajectory<World>*> const fork =
+      circle.NewForkWithCopy(circle.t_max());
+  for (Time t = period / 2 + period / 8; t <= period; t += period / 8) {
+    append(t, *fork);
+  }
+
+  // Include the times of the points, and repeated times.
+  std::vector<Instant> times;
+  for (Time t; t <= period; t += period / 32) {
+    times.push_back(t0_ + t);
+    if (times.size() % 5 == 0) {
+      times.push_back(t0_ + t);
+    }
+  }
+  times.push_back(fork->t_max());
+  std::vector<DegreesOfFreedom<World>> degrees_of_freedom;
+  fork->EvaluateDegreesOfFreedom(times, degrees_of_freedom);
+  ASSERT_EQ(times.size(), degrees_of_freedom.size());
+  for (int i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(fork->EvaluateDegreesOfFreedom(times[i]), degrees_of_freedom[i])
+        << times[i] - t0_;
+  }
+
+  fork->EvaluateDegreesOfFreedom({}, degrees_of_freedom);
+  EXPECT_TRUE(degrees_of_freedom.empty());
+}
+
 TEST_F(DiscreteTrajectoryTest, Downsampling) {
   DiscreteTrajectory<World> circle;
   DiscreteTrajectory<World> downsampled_circle;
@@ -901,6 +931,61 @@ TEST_F(DiscreteTrajectoryTest, Downsampling) {
       << *std::max_element(errors.begin(), errors.end());
 }
 
+TEST_F(DiscreteTrajectoryTest, PackedTimelineSerialization) {
+  massive_trajectory_->Append(InfinitePast, d1_);
+  massive_trajectory_->Append(t1_, d1_);
+  massive_trajectory_->Append(t2_, d2_);
+  massive_trajectory_->Append(t3_, d3_);
+  serialization::DiscreteTrajectory message;
+  massive_trajectory_->WriteToMessage(&message, /*forks=*/{});
+  EXPECT_THAT(message.timeline_size(), Eq(0));
+  EXPECT_TRUE(message.has_packed_timeline());
+  auto const& packed_timeline = message.packed_timeline();
+  EXPECT_THAT(packed_timeline.frame().tag(), Eq(serialization::Frame::TEST1));
+  // The XOR encoding is longer than the raw values for the instants, which
+  // start at -∞, but shorter for the positions.
+  EXPECT_THAT(packed_timeline.instant().value(),
+              ElementsAre(-std::numeric_limits<double>::infinity(),
+                          (t1_ - Instant()) / Second,
+                          (t2_ - Instant()) / Second,
+                          (t3_ - Instant()) / Second));
+  EXPECT_THAT(packed_timeline.instant().xor_value_size(), Eq(0));
+  EXPECT_THAT(packed_timeline.x().value_size(), Eq(0));
+  EXPECT_THAT(packed_timeline.x().xor_value_size(), Eq(4));
+  EXPECT_THAT(Timeline(message),
+              ElementsAre(Pair(InfinitePast, d1_),
+                          Pair(t1_, d1_),
+                          Pair(t2_, d2_),
+                          Pair(t3_, d3_)));
+
+  // An empty timeline is not written.
+  DiscreteTrajectory<World> empty;
+  message.Clear();
+  empty.WriteToMessage(&message, /*forks=*/{});
+  EXPECT_FALSE(message.has_packed_timeline());
+}
+
+TEST_F(DiscreteTrajectoryTest, PreFrobeniusSerialization) {
+  serialization::DiscreteTrajectory message;
+  for (auto const& [time, degrees_of_freedom] :
+           {std::pair{t1_, d1_}, std::pair{t2_, d2_}, std::pair{t3_, d3_}}) {
+    auto* const instantaneous_degrees_of_freedom = message.add_timeline();
+    time.WriteToMessage(instantaneous_degrees_of_freedom->mutable_instant());
+    degrees_of_freedom.WriteToMessage(
+        instantaneous_degrees_of_freedom->mutable_degrees_of_freedom());
+  }
+  auto const deserialized_trajectory =
+      DiscreteTrajectory<World>::ReadFromMessage(message, /*forks=*/{});
+  EXPECT_THAT(Timeline(message),
+              ElementsAre(Pair(t1_, d1_), Pair(t2_, d2_), Pair(t3_, d3_)));
+
+  // The trajectory is rewritten in packed form.
+  serialization::DiscreteTrajectory rewritten_message;
+  deserialized_trajectory->WriteToMessage(&rewritten_message, /*forks=*/{});
+  EXPECT_THAT(rewritten_message.timeline_size(), Eq(0));
+  EXPECT_THAT(Timeline(rewritten_message), Eq(Timeline(message)));
+}
+
 TEST_F(DiscreteTrajectoryTest, DownsamplingSerialization) {
   DiscreteTrajectory<World> circle;
   auto deserialized_circle = make_not_null_unique<DiscreteTrajectory<World>>();
@@ -948,6 +1033,54 @@ TEST_F(DiscreteTrajectoryTest, DownsamplingSerialization) {
   }
 }
 
+TEST_F(DiscreteTrajectoryTest, DownsamplingDeltaSerialization) {
+  DiscreteTrajectory<World> circle;
+  circle.SetDownsampling(/*max_dense_intervals=*/50,
+                         /*tolerance=*/1 * Milli(Metre));
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Speed const v = ω * r / Radian;
+  auto t = DoublePrecision<Instant>(t0_);
+
+  // Replay the deltas and check that the result is identical to a full
+  // serialization.  Only the points before the dense timeline may be omitted.
+  serialization::DiscreteTrajectory replayed;
+  Instant omitted_t_max = InfinitePast;
+  for (int i = 1; i <= 4; ++i) {
+    for (; t.value <= t0_ + i * 2.5 * Second;
+         t.Increment(10 * Milli(Second))) {
+      DegreesOfFreedom<World> const dof =
+          {World::origin + Displacement<World>{{r * Cos(ω * (t.value - t0_)),
+                                                r * Sin(ω * (t.value - t0_)),
+                                                0 * Metre}},
+           Velocity<World>{{-v * Sin(ω * (t.value - t0_)),
+                            v * Cos(ω * (t.value - t0_)),
+                            0 * Metre / Second}}};
+      circle.Append(t.value, dof);
+    }
+    if (i == 3) {
+      circle.ForgetBefore(t0_ + 1 * Second);
+    }
+
+    serialization::DiscreteTrajectory delta;
+    circle.WriteDeltaToMessage(&delta, /*forks=*/{}, omitted_t_max);
+    serialization::DiscreteTrajectory full;
+    circle.WriteToMessage(&full, /*forks=*/{});
+    if (i == 1) {
+      EXPECT_EQ(Timeline(full).size(), Timeline(delta).size());
+    } else {
+      EXPECT_LT(Timeline(delta).size(), Timeline(full).size());
+    }
+
+    DiscreteTrajectory<World>::RestoreOmissions(
+        &replayed, circle.t_min(), omitted_t_max, &delta);
+    EXPECT_THAT(delta, EqualsProto(full));
+    replayed.Swap(&delta);
+    omitted_t_max = circle.settled_t_max();
+    EXPECT_LT(omitted_t_max, circle.back().time);
+  }
+}
+
 TEST_F(DiscreteTrajectoryTest, DownsamplingForgetAfter) {
   DiscreteTrajectory<World> circle;
   DiscreteTrajectory<World> forgotten_circle;
@@ -993,6 +1126,148 @@ TEST_F(DiscreteTrajectoryTest, DownsamplingForgetAfter) {
   EXPECT_THAT(errors, Each(Eq(0 * Metre)));
 }
 
+TEST_F(DiscreteTrajectoryTest, CompressBefore) {
+  DiscreteTrajectory<World> circle;
+  DiscreteTrajectory<World> compressed_circle;
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Speed const v = ω * r / Radian;
+  auto const append = [ω, r, v, this](Instant const& t,
+                                       DiscreteTrajectory<World>& trajectory) {
+    trajectory.Append(
+        t,
+        {World::origin + Displacement<World>{{r * Cos(ω * (t - t0_)),
+                                              r * Sin(ω * (t - t0_)),
+                                              0 * Metre}},
+         Velocity<World>{{-v * Sin(ω * (t - t0_)),
+                          v * Cos(ω * (t - t0_)),
+                          0 * Metre / Second}}});
+  };
+  Instant t = t0_;
+  for (; t <= t0_ + 10 * Second; t += 10 * Milli(Second)) {
+    append(t, circle);
+    append(t, compressed_circle);
+  }
+  not_null<DiscreteTrajectory<World>*> const fork = circle.NewForkAtLast();
+  not_null<DiscreteTrajectory<World>*> const compressed_fork =
+      compressed_circle.NewForkAtLast();
+  for (; t <= t0_ + 11 * Second; t += 10 * Milli(Second)) {
+    append(t, *fork);
+    append(t, *compressed_fork);
+  }
+  compressed_circle.CompressBefore(t0_ + 6 * Second);
+  EXPECT_EQ(circle.back().time, compressed_circle.back().time);
+  EXPECT_EQ(nullptr, circle.compressed_timeline());
+
+  // The compressed points are no longer part of the trajectory, but they are
+  // found in its compressed timeline.
+  CompressedTimeline<World> const& compressed_timeline =
+      *compressed_circle.compressed_timeline();
+  EXPECT_LE(t0_ + 6 * Second, compressed_circle.front().time);
+  EXPECT_GT(t0_ + 6 * Second, compressed_timeline.t_max());
+  EXPECT_EQ(circle.Size(),
+            compressed_timeline.size() + compressed_circle.Size());
+  EXPECT_EQ(fork->Size(),
+            compressed_timeline.size() + compressed_fork->Size());
+  std::vector<Instant> times;
+  auto it = circle.begin();
+  for (auto const& [time, degrees_of_freedom] : compressed_timeline) {
+    times.push_back(time);
+    EXPECT_EQ(it->time, time);
+    EXPECT_EQ(it->degrees_of_freedom, degrees_of_freedom);
+    ++it;
+  }
+  for (auto const& [time, degrees_of_freedom] : compressed_circle) {
+    EXPECT_EQ(it->time, time);
+    EXPECT_EQ(it->degrees_of_freedom, degrees_of_freedom);
+    ++it;
+  }
+  EXPECT_TRUE(it == circle.end());
+
+  // The evaluation functions of the compressed timeline are those of the
+  // trajectory.
+  std::vector<Instant> evaluation_times;
+  for (Instant s = t0_;
+       s <= compressed_timeline.t_max();
+       s += 3.7 * Milli(Second)) {
+    evaluation_times.push_back(s);
+    EXPECT_EQ(circle.EvaluateDegreesOfFreedom(s),
+              compressed_timeline.EvaluateDegreesOfFreedom(s));
+  }
+  std::vector<DegreesOfFreedom<World>> expected;
+  std::vector<DegreesOfFreedom<World>> actual;
+  circle.EvaluateDegreesOfFreedom(evaluation_times, expected);
+  compressed_timeline.EvaluateDegreesOfFreedom(evaluation_times, actual);
+  EXPECT_THAT(actual, Eq(expected));
+
+  // They are serialized like the others.
+  serialization::DiscreteTrajectory message;
+  circle.WriteToMessage(&message, /*forks=*/{fork});
+  serialization::DiscreteTrajectory compressed_message;
+  compressed_circle.WriteToMessage(&compressed_message,
+                                   /*forks=*/{compressed_fork});
+  EXPECT_THAT(compressed_message, EqualsProto(message));
+
+  // They may be forgotten.
+  circle.ForgetBefore(times[234]);
+  compressed_circle.ForgetBefore(times[234]);
+  EXPECT_EQ(times[234], compressed_timeline.t_min());
+  EXPECT_EQ(circle.Size(),
+            compressed_timeline.size() + compressed_circle.Size());
+  circle.ForgetAfter(times[456]);
+  compressed_circle.ForgetAfter(times[456]);
+  EXPECT_EQ(times[456], compressed_timeline.t_max());
+  EXPECT_TRUE(compressed_circle.Empty());
+  for (; t <= t0_ + 12 * Second; t += 10 * Milli(Second)) {
+    append(t, circle);
+    append(t, compressed_circle);
+  }
+  EXPECT_EQ(circle.Size(),
+            compressed_timeline.size() + compressed_circle.Size());
+  EXPECT_EQ(circle.back().time, compressed_circle.back().time);
+}
+
+TEST_F(DiscreteTrajectoryTest, DownsamplingCompressBefore) {
+  DiscreteTrajectory<World> circle;
+  DiscreteTrajectory<World> compressed_circle;
+  circle.SetDownsampling(/*max_dense_intervals=*/50,
+                         /*tolerance=*/1 * Milli(Metre));
+  compressed_circle.SetDownsampling(/*max_dense_intervals=*/50,
+                                    /*tolerance=*/1 * Milli(Metre));
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Speed const v = ω * r / Radian;
+  for (auto t = t0_; t <= t0_ + 10 * Second; t += 10 * Milli(Second)) {
+    DegreesOfFreedom<World> const dof =
+        {World::origin + Displacement<World>{{r * Cos(ω * (t - t0_)),
+                                              r * Sin(ω * (t - t0_)),
+                                              0 * Metre}},
+         Velocity<World>{{-v * Sin(ω * (t - t0_)),
+                          v * Cos(ω * (t - t0_)),
+                          0 * Metre / Second}}};
+    circle.Append(t, dof);
+    compressed_circle.Append(t, dof);
+    // Only the settled points get compressed, so downsampling is unaffected.
+    compressed_circle.CompressBefore(t);
+    EXPECT_EQ(circle.settled_t_max(), compressed_circle.settled_t_max());
+  }
+  CompressedTimeline<World> const& compressed_timeline =
+      *compressed_circle.compressed_timeline();
+  EXPECT_EQ(circle.Size(),
+            compressed_timeline.size() + compressed_circle.Size());
+  auto it = circle.begin();
+  for (auto const& [time, degrees_of_freedom] : compressed_timeline) {
+    EXPECT_EQ(it->time, time);
+    EXPECT_EQ(it->degrees_of_freedom, degrees_of_freedom);
+    ++it;
+  }
+  for (auto const& [time, degrees_of_freedom] : compressed_circle) {
+    EXPECT_EQ(it->time, time);
+    EXPECT_EQ(it->degrees_of_freedom, degrees_of_freedom);
+    ++it;
+  }
+}
+
 }  // namespace internal_discrete_trajectory
 }  // namespace physics
 }  // namespace principia
@@ -0,0 +1,93 @@
+﻿
+#pragma once
+
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "base/status_or.hpp"
+#include "geometry/named_quantities.hpp"
+#include "geometry/symmetric_bilinear_form.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/ephemeris.hpp"
+#include "physics/massive_body.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_ensemble_propagator {
+
+using base::not_null;
+using base::StatusOr;
+using geometry::Instant;
+using geometry::SymmetricBilinearForm;
+using quantities::Length;
+using quantities::Speed;
+using quantities::Square;
+
+// Propagates an ensemble of massless bodies, e.g., the perturbed copies of a
+// vessel used to assess the dispersion of a manœuvre, and returns statistics
+// about the ensemble without constructing a |DiscreteTrajectory| per member.
+// The members are grouped in systems of |members_per_system| bodies which are
+// integrated together: the members of a system share their evaluations of the
+// ephemeris and their step size control, the step being limited by the member
+// with the largest error.  With |members_per_system == 1| each member has its
+// own steps and the result for a member is the same as that of
+// |Ephemeris::FlowWithAdaptiveStep|.  The systems are integrated in parallel
+// by |number_of_threads| threads.
+template<typename Frame>
+class EnsemblePropagator final {
+ public:
+  struct ClosestApproach final {
+    Instant time;
+    Length distance;
+  };
+
+  struct Statistics final {
+    // The degrees of freedom of the members at the final time, in the order of
+    // the initial states.
+    std::vector<DegreesOfFreedom<Frame>> final_degrees_of_freedom;
+    DegreesOfFreedom<Frame> mean;
+    // The unbiased sample covariances, zero if there is a single member.
+    SymmetricBilinearForm<Square<Length>, Frame> position_covariance;
+    SymmetricBilinearForm<Square<Speed>, Frame> velocity_covariance;
+    // Indexed by target, then by member.  The closest approaches are taken
+    // among the points computed by the integrator, so their accuracy depends
+    // on the step size near the target.
+    std::vector<std::vector<ClosestApproach>> closest_approaches;
+  };
+
+  EnsemblePropagator(
+      not_null<Ephemeris<Frame>*> ephemeris,
+      typename Ephemeris<Frame>::AdaptiveStepParameters const& parameters,
+      int members_per_system,
+      int number_of_threads);
+
+  // Propagates the members having the given |initial_states| at |t0| until
+  // |t|.  |intrinsic_accelerations| is either empty or has one element per
+  // member; its elements may be called from multiple threads.  The closest
+  // approaches are computed for each of the |targets|, which must be bodies of
+  // the ephemeris.  Fails if the integration of any system fails.
+  StatusOr<Statistics> Propagate(
+      Instant const& t0,
+      std::vector<DegreesOfFreedom<Frame>> const& initial_states,
+      typename Ephemeris<Frame>::IntrinsicAccelerations const&
+          intrinsic_accelerations,
+      Instant const& t,
+      std::vector<not_null<MassiveBody const*>> const& targets) const;
+
+ private:
+  not_null<Ephemeris<Frame>*> const ephemeris_;
+  typename Ephemeris<Frame>::AdaptiveStepParameters const parameters_;
+  int const members_per_system_;
+  int const number_of_threads_;
+};
+
+}  // namespace internal_ensemble_propagator
+
+using internal_ensemble_propagator::EnsemblePropagator;
+
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/ensemble_propagator_body.hpp"
@@ -0,0 +1,248 @@
+﻿
+#pragma once
+
+#include "physics/ensemble_propagator.hpp"
+
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "base/thread_pool.hpp"
+#include "geometry/barycentre_calculator.hpp"
+#include "geometry/grassmann.hpp"
+#include "integrators/integrators.hpp"
+#include "numerics/double_precision.hpp"
+#include "physics/continuous_trajectory.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_ensemble_propagator {
+
+using base::Status;
+using base::ThreadPool;
+using geometry::BarycentreCalculator;
+using geometry::Displacement;
+using geometry::Position;
+using geometry::SymmetricProduct;
+using geometry::Vector;
+using geometry::Velocity;
+using integrators::AdaptiveStepSizeIntegrator;
+using integrators::IntegrationProblem;
+using numerics::DoublePrecision;
+using quantities::Acceleration;
+using quantities::Infinity;
+using quantities::Time;
+
+template<typename Frame>
+EnsemblePropagator<Frame>::EnsemblePropagator(
+    not_null<Ephemeris<Frame>*> const ephemeris,
+    typename Ephemeris<Frame>::AdaptiveStepParameters const& parameters,
+    int const members_per_system,
+    int const number_of_threads)
+    : ephemeris_(ephemeris),
+      parameters_(parameters),
+      members_per_system_(members_per_system),
+      number_of_threads_(number_of_threads) {
+  CHECK_LE(1, members_per_system_);
+  CHECK_LE(1, number_of_threads_);
+}
+
+template<typename Frame>
+StatusOr<typename EnsemblePropagator<Frame>::Statistics>
+EnsemblePropagator<Frame>::Propagate(
+    Instant const& t0,
+    std::vector<DegreesOfFreedom<Frame>> const& initial_states,
+    typename Ephemeris<Frame>::IntrinsicAccelerations const&
+        intrinsic_accelerations,
+    Instant const& t,
+    std::vector<not_null<MassiveBody const*>> const& targets) const {
+  using ODE = typename Ephemeris<Frame>::NewtonianMotionEquation;
+  int const number_of_members = initial_states.size();
+  CHECK_LT(0, number_of_members);
+  CHECK_LT(t0, t);
+  CHECK(intrinsic_accelerations.empty() ||
+        intrinsic_accelerations.size() == number_of_members)
+      << intrinsic_accelerations.size() << " " << number_of_members;
+
+  std::vector<not_null<ContinuousTrajectory<Frame> const*>> target_trajectories;
+  for (auto const target : targets) {
+    target_trajectories.push_back(ephemeris_->trajectory(target));
+  }
+
+  // All the systems are integrated within [t0, t], so the ephemeris is not
+  // prolonged concurrently.
+  ephemeris_->Prolong(t);
+
+  // The results of the integration of each member.  The final degrees of
+  // freedom are optional because they are not default-constructible.
+  std::vector<std::optional<DegreesOfFreedom<Frame>>> final_degrees_of_freedom(
+      number_of_members);
+  std::vector<std::vector<ClosestApproach>> closest_approaches(
+      targets.size(),
+      std::vector<ClosestApproach>(number_of_members,
+                                   {t0, Infinity<Length>()}));
+
+  Length const length_integration_tolerance =
+      parameters_.length_integration_tolerance();
+  Speed const speed_integration_tolerance =
+      parameters_.speed_integration_tolerance();
+  auto const tolerance_to_error_ratio =
+      [length_integration_tolerance, speed_integration_tolerance](
+          Time const& current_step_size,
+          typename ODE::SystemStateError const& error) {
+    Length max_length_error;
+    Speed max_speed_error;
+    for (auto const& position_error : error.position_error) {
+      max_length_error = std::max(max_length_error, position_error.Norm());
+    }
+    for (auto const& velocity_error : error.velocity_error) {
+      max_speed_error = std::max(max_speed_error, velocity_error.Norm());
+    }
+    return std::min(length_integration_tolerance / max_length_error,
+                    speed_integration_tolerance / max_speed_error);
+  };
+
+  // Integrates the members in [first_member, last_member[ as one system.
+  auto const integrate_system = [this,
+                                 t0,
+                                 t,
+                                 &initial_states,
+                                 &intrinsic_accelerations,
+                                 &target_trajectories,
+                                 &tolerance_to_error_ratio,
+                                 &final_degrees_of_freedom,
+                                 &closest_approaches](
+                                    int const first_member,
+                                    int const last_member) {
+    IntegrationProblem<ODE> problem;
+    problem.equation.compute_acceleration =
+        [this, first_member, last_member, &intrinsic_accelerations](
+            Instant const& t,
+            std::vector<Position<Frame>> const& positions,
+            std::vector<Vector<Acceleration, Frame>>& accelerations) {
+      Status const status =
+          ephemeris_->ComputeGravitationalAccelerationsOnMasslessBodies(
+              positions, t, accelerations);
+      if (!intrinsic_accelerations.empty()) {
+        for (int m = first_member; m < last_member; ++m) {
+          auto const& intrinsic_acceleration = intrinsic_accelerations[m];
+          if (intrinsic_acceleration != nullptr) {
+            accelerations[m - first_member] += intrinsic_acceleration(t);
+          }
+        }
+      }
+      return status;
+    };
+    problem.initial_state.time = DoublePrecision<Instant>(t0);
+    for (int m = first_member; m < last_member; ++m) {
+      problem.initial_state.positions.emplace_back(
+          initial_states[m].position());
+      problem.initial_state.velocities.emplace_back(
+          initial_states[m].velocity());
+    }
+
+    // Instead of appending to trajectories, keep track of the closest
+    // approaches and of the last state.
+    auto const append_state =
+        [first_member,
+         &target_trajectories,
+         &final_degrees_of_freedom,
+         &closest_approaches](typename ODE::SystemState const& state) {
+      Instant const& time = state.time.value;
+      for (int i = 0; i < target_trajectories.size(); ++i) {
+        Position<Frame> const target_position =
+            target_trajectories[i]->EvaluatePosition(time);
+        for (int j = 0; j < state.positions.size(); ++j) {
+          Length const distance =
+              (state.positions[j].value - target_position).Norm();
+          ClosestApproach& closest_approach =
+              closest_approaches[i][first_member + j];
+          if (distance < closest_approach.distance) {
+            closest_approach = {time, distance};
+          }
+        }
+      }
+      for (int j = 0; j < state.positions.size(); ++j) {
+        final_degrees_of_freedom[first_member + j].emplace(
+            state.positions[j].value, state.velocities[j].value);
+      }
+    };
+
+    typename AdaptiveStepSizeIntegrator<ODE>::Parameters const
+        integrator_parameters(
+            /*first_time_step=*/t - t0,
+            /*safety_factor=*/0.9,
+            parameters_.max_steps(),
+            /*last_step_is_exact=*/true);
+    auto const instance =
+        parameters_.integrator().NewInstance(problem,
+                                             append_state,
+                                             tolerance_to_error_ratio,
+                                             integrator_parameters);
+    return instance->Solve(t);
+  };
+
+  int const number_of_systems =
+      (number_of_members + members_per_system_ - 1) / members_per_system_;
+  std::vector<std::future<void>> futures;
+  std::vector<Status> statuses(number_of_systems);
+  {
+    ThreadPool<void> pool(number_of_threads_);
+    for (int s = 0; s < number_of_systems; ++s) {
+      int const first_member = s * members_per_system_;
+      int const last_member =
+          std::min(first_member + members_per_system_, number_of_members);
+      futures.push_back(pool.Add(
+          [&integrate_system, &status = statuses[s],
+           first_member, last_member]() {
+            status = integrate_system(first_member, last_member);
+          }));
+    }
+    for (auto& future : futures) {
+      future.wait();
+    }
+  }
+  for (auto const& status : statuses) {
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
+  // Compute the statistics at the final time.
+  std::vector<DegreesOfFreedom<Frame>> final_states;
+  final_states.reserve(number_of_members);
+  BarycentreCalculator<DegreesOfFreedom<Frame>, double> calculator;
+  for (auto const& degrees_of_freedom : final_degrees_of_freedom) {
+    final_states.push_back(*degrees_of_freedom);
+    calculator.Add(*degrees_of_freedom, 1);
+  }
+  DegreesOfFreedom<Frame> const mean = calculator.Get();
+  auto position_covariance =
+      SymmetricProduct(Displacement<Frame>(), Displacement<Frame>());
+  auto velocity_covariance =
+      SymmetricProduct(Velocity<Frame>(), Velocity<Frame>());
+  for (auto const& degrees_of_freedom : final_states) {
+    Displacement<Frame> const δq = degrees_of_freedom.position() -
+                                   mean.position();
+    Velocity<Frame> const δv = degrees_of_freedom.velocity() -
+                               mean.velocity();
+    position_covariance += SymmetricProduct(δq, δq);
+    velocity_covariance += SymmetricProduct(δv, δv);
+  }
+  if (number_of_members > 1) {
+    position_covariance /= number_of_members - 1;
+    velocity_covariance /= number_of_members - 1;
+  }
+
+  return Statistics{std::move(final_states),
+                    mean,
+                    position_covariance,
+                    velocity_covariance,
+                    std::move(closest_approaches)};
+}
+
+}  // namespace internal_ensemble_propagator
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,242 @@
+﻿
+#include "physics/ensemble_propagator.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "geometry/frame.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "integrators/embedded_explicit_runge_kutta_nyström_integrator.hpp"
+#include "integrators/methods.hpp"
+#include "integrators/symmetric_linear_multistep_integrator.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "quantities/astronomy.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/matchers.hpp"
+#include "testing_utilities/numerics.hpp"
+
+namespace principia {
+namespace physics {
+
+using base::not_null;
+using geometry::Displacement;
+using geometry::Frame;
+using geometry::InnerProduct;
+using geometry::Instant;
+using geometry::Position;
+using geometry::Vector;
+using geometry::Velocity;
+using integrators::EmbeddedExplicitRungeKuttaNyströmIntegrator;
+using integrators::SymmetricLinearMultistepIntegrator;
+using integrators::methods::DormandالمكاوىPrince1986RKN434FM;
+using integrators::methods::QuinlanTremaine1990Order12;
+using quantities::Acceleration;
+using quantities::GravitationalParameter;
+using quantities::Length;
+using quantities::Pow;
+using quantities::Speed;
+using quantities::Sqrt;
+using quantities::Square;
+using quantities::Time;
+using quantities::si::Hour;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Milli;
+using quantities::si::Minute;
+using quantities::si::Second;
+using testing_utilities::AbsoluteError;
+using testing_utilities::RelativeError;
+using ::testing::Lt;
+
+class EnsemblePropagatorTest : public ::testing::Test {
+ protected:
+  using World =
+      Frame<serialization::Frame::TestTag, serialization::Frame::TEST1, true>;
+
+  EnsemblePropagatorTest()
+      : body_(new MassiveBody(μ_)),
+        ephemeris_(MakeEphemeris(body_)),
+        parameters_(EmbeddedExplicitRungeKuttaNyströmIntegrator<
+                        DormandالمكاوىPrince1986RKN434FM,
+                        Position<World>>(),
+                    std::numeric_limits<std::int64_t>::max(),
+                    1 * Milli(Metre),
+                    1 * Milli(Metre) / Second) {}
+
+  static not_null<std::unique_ptr<Ephemeris<World>>> MakeEphemeris(
+      MassiveBody const* const body) {
+    std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+    bodies.emplace_back(std::unique_ptr<MassiveBody const>(body));
+    return std::make_unique<Ephemeris<World>>(
+        std::move(bodies),
+        std::vector<DegreesOfFreedom<World>>{
+            {World::origin, Velocity<World>()}},
+        Instant(),
+        /*accuracy_parameters=*/Ephemeris<World>::AccuracyParameters(
+            /*fitting_tolerance=*/1 * Milli(Metre),
+            /*geopotential_tolerance=*/0x1p-24),
+        Ephemeris<World>::FixedStepParameters(
+            SymmetricLinearMultistepIntegrator<QuinlanTremaine1990Order12,
+                                               Position<World>>(),
+            10 * Minute));
+  }
+
+  // An eccentric low orbit, with velocities dispersed by about 1 m/s.
+  std::vector<DegreesOfFreedom<World>> DispersedInitialStates(
+      int const number_of_members) {
+    Length const r = 7000 * Kilo(Metre);
+    Speed const v = 0.95 * Sqrt(μ_ / r);
+    std::mt19937_64 random(42);
+    std::normal_distribution<> distribution;
+    std::vector<DegreesOfFreedom<World>> initial_states;
+    for (int i = 0; i < number_of_members; ++i) {
+      initial_states.emplace_back(
+          World::origin + Displacement<World>({r, 0 * Metre, 0 * Metre}),
+          Velocity<World>({distribution(random) * Metre / Second,
+                           v + distribution(random) * Metre / Second,
+                           distribution(random) * Metre / Second}));
+    }
+    return initial_states;
+  }
+
+  GravitationalParameter const μ_ = 398600.4418 * Pow<3>(Kilo(Metre)) /
+                                    Pow<2>(Second);
+  MassiveBody const* const body_;
+  not_null<std::unique_ptr<Ephemeris<World>>> const ephemeris_;
+  Ephemeris<World>::AdaptiveStepParameters const parameters_;
+  Instant const t0_;
+};
+
+// With one member per system, each member is integrated exactly as by
+// |FlowWithAdaptiveStep|.
+TEST_F(EnsemblePropagatorTest, IndependentSteps) {
+  Instant const t = t0_ + 3 * Hour;
+  auto const initial_states = DispersedInitialStates(10);
+  // A constant thrust on some of the members.
+  Ephemeris<World>::IntrinsicAccelerations intrinsic_accelerations(
+      initial_states.size());
+  for (int i = 0; i < initial_states.size(); i += 3) {
+    intrinsic_accelerations[i] = [](Instant const&) {
+      return Vector<Acceleration, World>(
+          {0 * Metre / Pow<2>(Second),
+           1e-3 * Metre / Pow<2>(Second),
+           0 * Metre / Pow<2>(Second)});
+    };
+  }
+
+  EnsemblePropagator<World> const propagator(ephemeris_.get(),
+                                             parameters_,
+                                             /*members_per_system=*/1,
+                                             /*number_of_threads=*/4);
+  auto const status_or_statistics = propagator.Propagate(
+      t0_, initial_states, intrinsic_accelerations, t, {body_});
+  ASSERT_TRUE(status_or_statistics.ok());
+  auto const& statistics = status_or_statistics.ValueOrDie();
+  ASSERT_EQ(initial_states.size(), statistics.final_degrees_of_freedom.size());
+  ASSERT_EQ(1, statistics.closest_approaches.size());
+
+  for (int i = 0; i < initial_states.size(); ++i) {
+    DiscreteTrajectory<World> trajectory;
+    trajectory.Append(t0_, initial_states[i]);
+    EXPECT_OK(ephemeris_->FlowWithAdaptiveStep(
+        &trajectory,
+        intrinsic_accelerations[i],
+        t,
+        parameters_,
+        Ephemeris<World>::unlimited_max_ephemeris_steps));
+    EXPECT_EQ(trajectory.back().degrees_of_freedom,
+              statistics.final_degrees_of_freedom[i]);
+
+    auto const closest = std::min_element(
+        trajectory.begin(),
+        trajectory.end(),
+        [](auto const& left, auto const& right) {
+          return (left.degrees_of_freedom.position() - World::origin).Norm() <
+                 (right.degrees_of_freedom.position() - World::origin).Norm();
+        });
+    EXPECT_EQ(closest->time, statistics.closest_approaches[0][i].time);
+    EXPECT_EQ((closest->degrees_of_freedom.position() - World::origin).Norm(),
+              statistics.closest_approaches[0][i].distance);
+  }
+}
+
+// With all the members in one system, the steps are shared and the results
+// agree with the independent integrations to within the tolerances.
+TEST_F(EnsemblePropagatorTest, SharedSteps) {
+  Instant const t = t0_ + 3 * Hour;
+  auto const initial_states = DispersedInitialStates(100);
+
+  EnsemblePropagator<World> const independent_propagator(
+      ephemeris_.get(),
+      parameters_,
+      /*members_per_system=*/1,
+      /*number_of_threads=*/4);
+  EnsemblePropagator<World> const shared_propagator(
+      ephemeris_.get(),
+      parameters_,
+      /*members_per_system=*/25,
+      /*number_of_threads=*/4);
+  auto const independent = independent_propagator.Propagate(
+      t0_, initial_states, Ephemeris<World>::NoIntrinsicAccelerations, t, {});
+  auto const shared = shared_propagator.Propagate(
+      t0_, initial_states, Ephemeris<World>::NoIntrinsicAccelerations, t, {});
+  ASSERT_TRUE(independent.ok());
+  ASSERT_TRUE(shared.ok());
+  auto const& independent_statistics = independent.ValueOrDie();
+  auto const& shared_statistics = shared.ValueOrDie();
+  EXPECT_TRUE(shared_statistics.closest_approaches.empty());
+
+  for (int i = 0; i < initial_states.size(); ++i) {
+    EXPECT_THAT(
+        AbsoluteError(
+            independent_statistics.final_degrees_of_freedom[i].position(),
+            shared_statistics.final_degrees_of_freedom[i].position()),
+        Lt(10 * Milli(Metre)));
+  }
+
+  // The covariance is that of the final positions.
+  Vector<double, World> const x({1, 0, 0});
+  Square<Length> x_variance;
+  for (auto const& degrees_of_freedom :
+       shared_statistics.final_degrees_of_freedom) {
+    x_variance += Pow<2>(InnerProduct(
+        degrees_of_freedom.position() - shared_statistics.mean.position(), x));
+  }
+  x_variance /= initial_states.size() - 1;
+  EXPECT_THAT(
+      RelativeError(x_variance,
+                    shared_statistics.position_covariance(x, x)),
+      Lt(1e-12));
+  // A velocity dispersion of 1 m/s becomes a position dispersion of several
+  // kilometres after a couple of orbits.
+  EXPECT_THAT(Sqrt(x_variance), Lt(100 * Kilo(Metre)));
+  EXPECT_LT(1 * Kilo(Metre), Sqrt(x_variance));
+}
+
+TEST_F(EnsemblePropagatorTest, IdenticalMembers) {
+  Instant const t = t0_ + 1 * Hour;
+  std::vector<DegreesOfFreedom<World>> const initial_states(
+      2, DispersedInitialStates(1)[0]);
+  EnsemblePropagator<World> const propagator(ephemeris_.get(),
+                                             parameters_,
+                                             /*members_per_system=*/1,
+                                             /*number_of_threads=*/2);
+  auto const status_or_statistics = propagator.Propagate(
+      t0_, initial_states, Ephemeris<World>::NoIntrinsicAccelerations, t, {});
+  ASSERT_TRUE(status_or_statistics.ok());
+  auto const& statistics = status_or_statistics.ValueOrDie();
+  Vector<double, World> const x({1, 0, 0});
+  Vector<double, World> const y({0, 1, 0});
+  EXPECT_EQ(Square<Length>(), statistics.position_covariance(x, x));
+  EXPECT_EQ(Square<Length>(), statistics.position_covariance(x, y));
+  EXPECT_EQ(Square<Speed>(), statistics.velocity_covariance(y, y));
+  EXPECT_EQ(statistics.final_degrees_of_freedom[0], statistics.mean);
+}
+
+}  // namespace physics
+}  // namespace principia
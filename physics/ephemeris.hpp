@@ -155,6 +155,16 @@ class Ephemeris {
     friend class Ephemeris<Frame>;
   };
 
+  // The parameters of the Parareal algorithm used by |FlowWithParareal|.
+  struct PararealParameters final {
+    // The number of time slices, which are integrated in parallel by that many
+    // threads.
+    int number_of_slices;
+    // The factor by which the integration tolerances are multiplied for the
+    // coarse propagator.
+    double coarse_tolerance_factor;
+  };
+
   // Constructs an Ephemeris that owns the |bodies|.  The elements of vectors
   // |bodies| and |initial_state| correspond to one another.
   Ephemeris(std::vector<not_null<std::unique_ptr<MassiveBody const>>>&& bodies,
@@ -224,6 +234,25 @@ class Ephemeris {
       GeneralizedAdaptiveStepParameters const& parameters,
       std::int64_t max_ephemeris_steps) EXCLUDES(lock_);
 
+  // Same as the first |FlowWithAdaptiveStep|, but the interval is split in
+  // slices which are integrated in parallel using the Parareal algorithm
+  // [LMT01]: a coarse propagator, using the tolerances of |parameters|
+  // multiplied by the |coarse_tolerance_factor|, gives the initial states of the
+  // slices, which are refined iteratively using the fine propagator, given by
+  // |parameters|, until the discontinuities between the slices are within the
+  // integration tolerances.  The |intrinsic_acceleration| is called from
+  // multiple threads.  The |max_steps| of |parameters| apply to each slice.  If
+  // the integration of any slice fails, falls back to |FlowWithAdaptiveStep|.
+  // [LMT01]: Lions, Maday and Turinici (2001), Résolution d'EDP par un schéma
+  // en temps « pararéel ».
+  Status FlowWithParareal(
+      not_null<DiscreteTrajectory<Frame>*> trajectory,
+      IntrinsicAcceleration intrinsic_acceleration,
+      Instant const& t,
+      AdaptiveStepParameters const& parameters,
+      std::int64_t max_ephemeris_steps,
+      PararealParameters const& parareal_parameters) EXCLUDES(lock_);
+
   // Integrates, until at most |t|, the trajectories followed by massless
   // bodies in the gravitational potential described by |*this|.  If
   // |t > t_max()|, calls |Prolong(t)| beforehand.  The trajectories and
@@ -240,6 +269,15 @@ class Ephemeris {
       Position<Frame> const& position,
       Instant const& t) const EXCLUDES(lock_);
 
+  // Same as above, but for several massless bodies located at the given
+  // |positions|, for which the massive bodies are evaluated only once.  Returns
+  // an error if any of the massless bodies is inside a massive body.
+  virtual Status ComputeGravitationalAccelerationsOnMasslessBodies(
+      std::vector<Position<Frame>> const& positions,
+      Instant const& t,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const
+      EXCLUDES(lock_);
+
   // Returns the gravitational acceleration on the massless body having the
   // given |trajectory| at time |t|.  |t| must be one of the times of the
   // |trajectory|.
@@ -280,6 +318,16 @@ class Ephemeris {
   static not_null<std::unique_ptr<Ephemeris>> ReadFromMessage(
       serialization::Ephemeris const& message) EXCLUDES(lock_);
 
+  // Same as |WriteToMessage|, but for each trajectory the polynomials whose
+  // |t_max| is at or before the corresponding element of |omitted_t_maxes| are
+  // not written, see |ContinuousTrajectory::WriteDeltaToMessage|.
+  // |omitted_t_maxes| must either be empty, in which case nothing is omitted,
+  // or be indexed like the trajectories of the |message|.  Returns the
+  // |omitted_t_maxes| to use for the next delta.
+  virtual std::vector<Instant> WriteDeltaToMessage(
+      not_null<serialization::Ephemeris*> message,
+      std::vector<Instant> const& omitted_t_maxes) const EXCLUDES(lock_);
+
   // A |Guard| is an RAII object that protects a critical section against
   // changes to |t_min| due to calls to |EventuallyForgetBefore|.
   class Guard final {
@@ -5,15 +5,18 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <limits>
 #include <optional>
 #include <set>
+#include <thread>
 #include <vector>
 
 #include "astronomy/epoch.hpp"
 #include "base/macros.hpp"
 #include "base/map_util.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/r3_element.hpp"
 #include "integrators/integrators.hpp"
@@ -29,11 +32,13 @@ namespace principia {
 namespace physics {
 namespace internal_ephemeris {
 
+using astronomy::InfinitePast;
 using astronomy::J2000;
 using base::dynamic_cast_not_null;
 using base::Error;
 using base::FindOrDie;
 using base::make_not_null_unique;
+using base::ThreadPool;
 using geometry::Barycentre;
 using geometry::Displacement;
 using geometry::InnerProduct;
@@ -514,6 +519,182 @@ Status Ephemeris<Frame>::FlowWithAdaptiveStep(
              max_ephemeris_steps);
 }
 
+template<typename Frame>
+Status Ephemeris<Frame>::FlowWithParareal(
+    not_null<DiscreteTrajectory<Frame>*> const trajectory,
+    IntrinsicAcceleration intrinsic_acceleration,
+    Instant const& t,
+    AdaptiveStepParameters const& parameters,
+    std::int64_t const max_ephemeris_steps,
+    PararealParameters const& parareal_parameters) {
+  int const number_of_slices = parareal_parameters.number_of_slices;
+  CHECK_LE(1, number_of_slices);
+  Instant const trajectory_last_time = trajectory->back().time;
+  if (trajectory_last_time == t) {
+    return Status::OK;
+  }
+
+  // Same computation as in |FlowODEWithAdaptiveStep|, done once here so that
+  // the ephemeris is not prolonged concurrently by the slices.
+  Instant const t_final =
+      std::min(std::max(instance_time() +
+                            max_ephemeris_steps * fixed_step_parameters_.step(),
+                        trajectory_last_time + fixed_step_parameters_.step()),
+               t);
+  Prolong(t_final);
+
+  std::vector<Instant> slice_times;
+  for (int n = 0; n < number_of_slices; ++n) {
+    slice_times.push_back(trajectory_last_time +
+                          (t_final - trajectory_last_time) * n /
+                              number_of_slices);
+  }
+  slice_times.push_back(t_final);
+
+  AdaptiveStepParameters coarse_parameters = parameters;
+  coarse_parameters.set_length_integration_tolerance(
+      parameters.length_integration_tolerance() *
+      parareal_parameters.coarse_tolerance_factor);
+  coarse_parameters.set_speed_integration_tolerance(
+      parameters.speed_integration_tolerance() *
+      parareal_parameters.coarse_tolerance_factor);
+
+  // Integrates the slice |n| from |initial_degrees_of_freedom| into |slice|.
+  auto const flow_slice =
+      [this, &intrinsic_acceleration, max_ephemeris_steps, &slice_times](
+          int const n,
+          DegreesOfFreedom<Frame> const& initial_degrees_of_freedom,
+          AdaptiveStepParameters const& parameters,
+          std::unique_ptr<DiscreteTrajectory<Frame>>& slice) {
+        slice = std::make_unique<DiscreteTrajectory<Frame>>();
+        slice->Append(slice_times[n], initial_degrees_of_freedom);
+        return FlowWithAdaptiveStep(slice.get(),
+                                    intrinsic_acceleration,
+                                    slice_times[n + 1],
+                                    parameters,
+                                    max_ephemeris_steps);
+      };
+  auto const flow_sequentially = [this,
+                                  trajectory,
+                                  &intrinsic_acceleration,
+                                  &t,
+                                  &parameters,
+                                  max_ephemeris_steps]() {
+    return FlowWithAdaptiveStep(trajectory,
+                                intrinsic_acceleration,
+                                t,
+                                parameters,
+                                max_ephemeris_steps);
+  };
+
+  // The initial states of the slices, and the final states computed by the
+  // coarse propagator from these initial states.
+  std::vector<DegreesOfFreedom<Frame>> initial_states;
+  std::vector<DegreesOfFreedom<Frame>> coarse_final_states;
+  // The slices computed by the fine propagator, and the initial states from
+  // which they were computed.
+  std::vector<std::unique_ptr<DiscreteTrajectory<Frame>>> fine_slices(
+      number_of_slices);
+  std::vector<std::optional<DegreesOfFreedom<Frame>>> fine_initial_states(
+      number_of_slices);
+
+  std::unique_ptr<DiscreteTrajectory<Frame>> coarse_slice;
+  initial_states.push_back(trajectory->back().degrees_of_freedom);
+  for (int n = 0; n < number_of_slices - 1; ++n) {
+    if (!flow_slice(n, initial_states[n], coarse_parameters, coarse_slice)
+             .ok()) {
+      return flow_sequentially();
+    }
+    coarse_final_states.push_back(coarse_slice->back().degrees_of_freedom);
+    initial_states.push_back(coarse_final_states.back());
+  }
+
+  ThreadPool<void> pool(number_of_slices);
+  std::vector<Status> fine_statuses(number_of_slices);
+  // Each iteration makes at least one more slice exact, so this terminates
+  // after at most |number_of_slices| iterations.
+  for (;;) {
+    std::vector<std::future<void>> futures;
+    for (int n = 0; n < number_of_slices; ++n) {
+      if (fine_initial_states[n] != initial_states[n]) {
+        fine_initial_states[n] = initial_states[n];
+        futures.push_back(pool.Add([n,
+                                    &flow_slice,
+                                    &parameters,
+                                    &initial_states,
+                                    &fine_slices,
+                                    &fine_statuses]() {
+          fine_statuses[n] = flow_slice(
+              n, initial_states[n], parameters, fine_slices[n]);
+        }));
+      }
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+    for (auto const& status : fine_statuses) {
+      if (!status.ok()) {
+        return flow_sequentially();
+      }
+    }
+
+    bool converged = true;
+    for (int n = 0; n < number_of_slices - 1; ++n) {
+      auto const& fine_final_state = fine_slices[n]->back().degrees_of_freedom;
+      if ((fine_final_state.position() - initial_states[n + 1].position())
+                  .Norm() > parameters.length_integration_tolerance() ||
+          (fine_final_state.velocity() - initial_states[n + 1].velocity())
+                  .Norm() > parameters.speed_integration_tolerance()) {
+        converged = false;
+        break;
+      }
+    }
+    if (converged) {
+      break;
+    }
+
+    // The Parareal correction, which uses the coarse propagator sequentially.
+    for (int n = 0; n < number_of_slices - 1; ++n) {
+      auto const& fine_final_state = fine_slices[n]->back().degrees_of_freedom;
+      if (initial_states[n] == *fine_initial_states[n]) {
+        // The correction would be exactly the fine final state.
+        initial_states[n + 1] = fine_final_state;
+        continue;
+      }
+      if (!flow_slice(n, initial_states[n], coarse_parameters, coarse_slice)
+               .ok()) {
+        return flow_sequentially();
+      }
+      auto const& coarse_final_state = coarse_slice->back().degrees_of_freedom;
+      auto const& previous_coarse_final_state = coarse_final_states[n];
+      initial_states[n + 1] = DegreesOfFreedom<Frame>(
+          coarse_final_state.position() +
+              (fine_final_state.position() -
+               previous_coarse_final_state.position()),
+          coarse_final_state.velocity() +
+              (fine_final_state.velocity() -
+               previous_coarse_final_state.velocity()));
+      coarse_final_states[n] = coarse_final_state;
+    }
+  }
+
+  // Concatenate the fine slices, which overlap at their endpoints.
+  for (auto const& slice : fine_slices) {
+    auto it = slice->begin();
+    for (++it; it != slice->end(); ++it) {
+      trajectory->Append(it->time, it->degrees_of_freedom);
+    }
+  }
+
+  if (t_final == t) {
+    return Status::OK;
+  } else {
+    return Status(Error::DEADLINE_EXCEEDED,
+                  "Couldn't reach " + DebugString(t) + ", stopping at " +
+                      DebugString(t_final));
+  }
+}
+
 template<typename Frame>
 Status Ephemeris<Frame>::FlowWithFixedStep(
     Instant const& t,
@@ -536,6 +717,19 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationOnMasslessBody(
   return accelerations[0];
 }
 
+template<typename Frame>
+Status Ephemeris<Frame>::ComputeGravitationalAccelerationsOnMasslessBodies(
+    std::vector<Position<Frame>> const& positions,
+    Instant const& t,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  accelerations.resize(positions.size());
+  Error const error =
+      ComputeMasslessBodiesGravitationalAccelerations(t,
+                                                      positions,
+                                                      accelerations);
+  return error == Error::OK ? Status::OK : CollisionDetected();
+}
+
 template<typename Frame>
 Vector<Acceleration, Frame>
 Ephemeris<Frame>::ComputeGravitationalAccelerationOnMasslessBody(
@@ -707,7 +901,17 @@ not_null<MassiveBody const*> Ephemeris<Frame>::body_for_serialization_index(
 template<typename Frame>
 void Ephemeris<Frame>::WriteToMessage(
     not_null<serialization::Ephemeris*> const message) const {
+  WriteDeltaToMessage(message, /*omitted_t_maxes=*/{});
+}
+
+template<typename Frame>
+std::vector<Instant> Ephemeris<Frame>::WriteDeltaToMessage(
+    not_null<serialization::Ephemeris*> const message,
+    std::vector<Instant> const& omitted_t_maxes) const {
   LOG(INFO) << __FUNCTION__;
+  CHECK(omitted_t_maxes.empty() ||
+        omitted_t_maxes.size() == trajectories_.size())
+      << omitted_t_maxes.size() << " " << trajectories_.size();
   absl::ReaderMutexLock l(&lock_);
 
   // Make sure that a checkpoint exists, otherwise we would not serialize some
@@ -723,8 +927,12 @@ void Ephemeris<Frame>::WriteToMessage(
   }
   // The trajectories are serialized in the order resulting from the separation
   // between oblate and spherical bodies.
-  for (auto const& trajectory : trajectories_) {
-    trajectory->WriteToMessage(message->add_trajectory());
+  std::vector<Instant> t_maxes;
+  t_maxes.reserve(trajectories_.size());
+  for (int i = 0; i < trajectories_.size(); ++i) {
+    t_maxes.push_back(trajectories_[i]->WriteDeltaToMessage(
+        message->add_trajectory(),
+        omitted_t_maxes.empty() ? InfinitePast : omitted_t_maxes[i]));
   }
   fixed_step_parameters_.WriteToMessage(
       message->mutable_fixed_step_parameters());
@@ -732,6 +940,7 @@ void Ephemeris<Frame>::WriteToMessage(
       message->mutable_accuracy_parameters());
   LOG(INFO) << NAMED(message->SpaceUsed());
   LOG(INFO) << NAMED(message->ByteSize());
+  return t_maxes;
 }
 
 template<typename Frame>
@@ -767,18 +976,34 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
                        accuracy_parameters,
                        fixed_step_parameters);
 
-  int index = 0;
+  // The trajectories are independent and make up most of the message, so they
+  // are deserialized in parallel.
+  int const number_of_trajectories = message.trajectory_size();
+  std::vector<std::unique_ptr<ContinuousTrajectory<Frame>>>
+      deserialized_trajectories(number_of_trajectories);
+  {
+    ThreadPool<void> pool(std::clamp<int>(std::thread::hardware_concurrency(),
+                                          1,
+                                          std::max(number_of_trajectories, 1)));
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < number_of_trajectories; ++i) {
+      futures.push_back(pool.Add([i, &deserialized_trajectories, &message]() {
+        deserialized_trajectories[i] =
+            ContinuousTrajectory<Frame>::ReadFromMessage(message.trajectory(i));
+      }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+
   ephemeris->bodies_to_trajectories_.clear();
   ephemeris->trajectories_.clear();
-  for (auto const& trajectory : message.trajectory()) {
-    not_null<MassiveBody const*> const body = ephemeris->bodies_[index].get();
-    not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>
-        deserialized_trajectory =
-            ContinuousTrajectory<Frame>::ReadFromMessage(trajectory);
-    ephemeris->trajectories_.push_back(deserialized_trajectory.get());
+  for (int i = 0; i < number_of_trajectories; ++i) {
+    not_null<MassiveBody const*> const body = ephemeris->bodies_[i].get();
+    ephemeris->trajectories_.push_back(deserialized_trajectories[i].get());
     ephemeris->bodies_to_trajectories_.emplace(
-        body, std::move(deserialized_trajectory));
-    ++index;
+        body, std::move(deserialized_trajectories[i]));
   }
 
   Instant checkpoint_time;
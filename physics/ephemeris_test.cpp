@@ -646,6 +646,91 @@ TEST_P(EphemerisTest, EarthTwoProbes) {
               Eq(q_probe2));
 }
 
+// A probe in low orbit around the Earth, flowed sequentially and with the
+// Parareal algorithm.
+TEST_P(EphemerisTest, Parareal) {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<ICRS>> initial_state;
+  Position<ICRS> centre_of_mass;
+  Time period;
+  SetUpEarthMoonSystem(bodies, initial_state, centre_of_mass, period);
+  MassiveBody const* const earth = bodies[0].get();
+  DegreesOfFreedom<ICRS> const earth_degrees_of_freedom = initial_state[0];
+
+  Ephemeris<ICRS> ephemeris(
+      std::move(bodies),
+      initial_state,
+      t0_,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/5 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<ICRS>::FixedStepParameters(integrator(), period / 100));
+
+  Length const r = 1e7 * Metre;
+  Speed const v = Sqrt(earth->gravitational_parameter() / r);
+  DegreesOfFreedom<ICRS> const probe_degrees_of_freedom(
+      earth_degrees_of_freedom.position() +
+          Displacement<ICRS>({r, 0 * Metre, 0 * Metre}),
+      earth_degrees_of_freedom.velocity() +
+          Velocity<ICRS>({0 * Metre / Second, v, 0 * Metre / Second}));
+  Ephemeris<ICRS>::AdaptiveStepParameters const parameters(
+      EmbeddedExplicitRungeKuttaNyströmIntegrator<
+          DormandالمكاوىPrince1986RKN434FM,
+          Position<ICRS>>(),
+      max_steps,
+      1 * Milli(Metre),
+      1 * Milli(Metre) / Second);
+  // About 20 orbits.
+  Instant const t_final = t0_ + period / 10;
+
+  DiscreteTrajectory<ICRS> sequential;
+  sequential.Append(t0_, probe_degrees_of_freedom);
+  EXPECT_OK(ephemeris.FlowWithAdaptiveStep(
+      &sequential,
+      Ephemeris<ICRS>::NoIntrinsicAcceleration,
+      t_final,
+      parameters,
+      Ephemeris<ICRS>::unlimited_max_ephemeris_steps));
+  DegreesOfFreedom<ICRS> const sequential_final_degrees_of_freedom =
+      sequential.back().degrees_of_freedom;
+
+  // With a single slice, the fine propagator does all the work.
+  DiscreteTrajectory<ICRS> single_slice;
+  single_slice.Append(t0_, probe_degrees_of_freedom);
+  EXPECT_OK(ephemeris.FlowWithParareal(
+      &single_slice,
+      Ephemeris<ICRS>::NoIntrinsicAcceleration,
+      t_final,
+      parameters,
+      Ephemeris<ICRS>::unlimited_max_ephemeris_steps,
+      {/*number_of_slices=*/1, /*coarse_tolerance_factor=*/1e3}));
+  EXPECT_EQ(sequential.Size(), single_slice.Size());
+  EXPECT_EQ(sequential_final_degrees_of_freedom,
+            single_slice.back().degrees_of_freedom);
+
+  for (int const number_of_slices : {2, 8}) {
+    DiscreteTrajectory<ICRS> parareal;
+    parareal.Append(t0_, probe_degrees_of_freedom);
+    EXPECT_OK(ephemeris.FlowWithParareal(
+        &parareal,
+        Ephemeris<ICRS>::NoIntrinsicAcceleration,
+        t_final,
+        parameters,
+        Ephemeris<ICRS>::unlimited_max_ephemeris_steps,
+        {number_of_slices, /*coarse_tolerance_factor=*/1e3}));
+    EXPECT_EQ(t_final, parareal.back().time);
+    // The slices restart the step size control, so the trajectories differ
+    // by amounts commensurate with the integration tolerances.
+    EXPECT_THAT(AbsoluteError(sequential_final_degrees_of_freedom.position(),
+                              parareal.back().degrees_of_freedom.position()),
+                Lt(0.1 * Metre))
+        << number_of_slices;
+    EXPECT_THAT(AbsoluteError(sequential_final_degrees_of_freedom.velocity(),
+                              parareal.back().degrees_of_freedom.velocity()),
+                Lt(1e-4 * Metre / Second))
+        << number_of_slices;
+  }
+}
+
 TEST_P(EphemerisTest, Serialization) {
   std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
   std::vector<DegreesOfFreedom<ICRS>> initial_state;
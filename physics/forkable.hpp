@@ -2,6 +2,7 @@
 #pragma once
 
 #include <deque>
+#include <iterator>
 #include <optional>
 #include <map>
 #include <memory>
@@ -97,6 +98,62 @@ class ForkableIterator {
   friend class Forkable;
 };
 
+// A lightweight view of the points of a Forkable object, taking forks into
+// account, for fast forward iteration, e.g., in range-for loops.  The ancestry
+// is flattened at construction into a list of contiguous ranges of timeline
+// iterators, one per ancestor that contributes points, so that advancing a
+// |Cursor| costs little more than advancing a timeline iterator and involves
+// no virtual calls.  The view and its cursors are invalidated by any change to
+// the object or to its ancestors.
+template<typename Tr4jectory, typename It3rator>
+class ForkableRange final {
+  using TimelineConstIterator =
+      typename ForkableTraits<Tr4jectory>::TimelineConstIterator;
+
+  // A nonempty range [begin, end[ in the timeline of an ancestor.
+  struct Segment {
+    TimelineConstIterator begin;
+    TimelineConstIterator end;
+  };
+
+ public:
+  class Cursor final {
+   public:
+    using reference =
+        typename std::iterator_traits<TimelineConstIterator>::reference;
+
+    reference operator*() const;
+    Cursor& operator++();
+
+    bool operator==(Cursor const& right) const;
+    bool operator!=(Cursor const& right) const;
+
+   private:
+    Cursor(Segment const* segment,
+           Segment const* last_segment,
+           TimelineConstIterator const& current);
+
+    // Null if the view is empty.
+    Segment const* segment_;
+    Segment const* last_segment_;
+    TimelineConstIterator current_;
+
+    friend class ForkableRange;
+  };
+
+  Cursor begin() const;
+  Cursor end() const;
+
+ private:
+  explicit ForkableRange(std::vector<Segment> segments);
+
+  // The segments in increasing time order, i.e., starting with the root.
+  std::vector<Segment> segments_;
+
+  template<typename, typename>
+  friend class Forkable;
+};
+
 // This template represents a trajectory which is forkable and iterable (using
 // a ForkableIterator).
 template<typename Tr4jectory, typename It3rator>
@@ -135,6 +192,11 @@ class Forkable {
   It3rator begin() const;
   It3rator end() const;
 
+  // Returns a lightweight view of the points of this object, which is cheaper
+  // than |begin()| and |end()| when iterating over the entire trajectory.
+  // Complexity is O(|depth|).
+  ForkableRange<Tr4jectory, It3rator> Points() const;
+
   typename It3rator::reference front() const;
   typename It3rator::reference back() const;
 
@@ -243,6 +305,7 @@ class Forkable {
 }  // namespace internal_forkable
 
 using internal_forkable::Forkable;
+using internal_forkable::ForkableRange;
 
 }  // namespace physics
 }  // namespace principia
@@ -1,8 +1,11 @@
 ﻿
 #pragma once
 
+#include <algorithm>
 #include <deque>
+#include <iterator>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "physics/forkable.hpp"
@@ -124,6 +127,71 @@ void ForkableIterator<Tr4jectory, It3rator>::CheckNormalizedIfEnd() {
         current_ != ancestry_.front()->timeline_end());
 }
 
+template<typename Tr4jectory, typename It3rator>
+typename ForkableRange<Tr4jectory, It3rator>::Cursor::reference
+ForkableRange<Tr4jectory, It3rator>::Cursor::operator*() const {
+  return *current_;
+}
+
+template<typename Tr4jectory, typename It3rator>
+typename ForkableRange<Tr4jectory, It3rator>::Cursor&
+ForkableRange<Tr4jectory, It3rator>::Cursor::operator++() {
+  DCHECK(current_ != segment_->end);
+  ++current_;
+  if (current_ == segment_->end && segment_ != last_segment_) {
+    ++segment_;
+    current_ = segment_->begin;
+  }
+  return *this;
+}
+
+template<typename Tr4jectory, typename It3rator>
+bool ForkableRange<Tr4jectory, It3rator>::Cursor::operator==(
+    Cursor const& right) const {
+  // Timeline iterators may only be compared if they are in the same segment.
+  return segment_ == right.segment_ && current_ == right.current_;
+}
+
+template<typename Tr4jectory, typename It3rator>
+bool ForkableRange<Tr4jectory, It3rator>::Cursor::operator!=(
+    Cursor const& right) const {
+  return !(*this == right);
+}
+
+template<typename Tr4jectory, typename It3rator>
+ForkableRange<Tr4jectory, It3rator>::Cursor::Cursor(
+    Segment const* const segment,
+    Segment const* const last_segment,
+    TimelineConstIterator const& current)
+    : segment_(segment),
+      last_segment_(last_segment),
+      current_(current) {}
+
+template<typename Tr4jectory, typename It3rator>
+typename ForkableRange<Tr4jectory, It3rator>::Cursor
+ForkableRange<Tr4jectory, It3rator>::begin() const {
+  if (segments_.empty()) {
+    return end();
+  }
+  return Cursor(&segments_.front(), &segments_.back(), segments_.front().begin);
+}
+
+template<typename Tr4jectory, typename It3rator>
+typename ForkableRange<Tr4jectory, It3rator>::Cursor
+ForkableRange<Tr4jectory, It3rator>::end() const {
+  if (segments_.empty()) {
+    return Cursor(/*segment=*/nullptr,
+                  /*last_segment=*/nullptr,
+                  TimelineConstIterator());
+  }
+  return Cursor(&segments_.back(), &segments_.back(), segments_.back().end);
+}
+
+template<typename Tr4jectory, typename It3rator>
+ForkableRange<Tr4jectory, It3rator>::ForkableRange(
+    std::vector<Segment> segments)
+    : segments_(std::move(segments)) {}
+
 template<typename Tr4jectory, typename It3rator>
 void Forkable<Tr4jectory, It3rator>::DeleteFork(Tr4jectory*& trajectory) {
   CHECK_NOTNULL(trajectory);
@@ -190,6 +258,32 @@ It3rator Forkable<Tr4jectory, It3rator>::end() const {
   return iterator;
 }
 
+template<typename Tr4jectory, typename It3rator>
+ForkableRange<Tr4jectory, It3rator> Forkable<Tr4jectory, It3rator>::Points()
+    const {
+  using Segment = typename ForkableRange<Tr4jectory, It3rator>::Segment;
+  // Walk up the ancestry.  Each ancestor contributes the points of its
+  // timeline up to and including the fork point of its child; if the fork
+  // point is not in its timeline (i.e., the child is forked at the fork time
+  // of the ancestor) it contributes nothing.  This is consistent with
+  // |ForkableIterator::operator++|.
+  std::vector<Segment> segments;
+  not_null<Tr4jectory const*> ancestor = that();
+  if (!ancestor->timeline_empty()) {
+    segments.push_back({ancestor->timeline_begin(), ancestor->timeline_end()});
+  }
+  while (ancestor->parent_ != nullptr) {
+    TimelineConstIterator const fork_point =
+        *ancestor->position_in_parent_timeline_;
+    ancestor = ancestor->parent_;
+    if (fork_point != ancestor->timeline_end()) {
+      segments.push_back({ancestor->timeline_begin(), std::next(fork_point)});
+    }
+  }
+  std::reverse(segments.begin(), segments.end());
+  return ForkableRange<Tr4jectory, It3rator>(std::move(segments));
+}
+
 template<typename Tr4jectory, typename It3rator>
 typename It3rator::reference Forkable<Tr4jectory, It3rator>::front() const {
   // TODO(phl): This can be implemented more efficiently.
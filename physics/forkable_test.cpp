@@ -184,6 +184,15 @@ class ForkableTest : public testing::Test {
     return *it.current();
   }
 
+  static std::vector<Instant> PointTimes(
+      not_null<FakeTrajectory const*> const trajectory) {
+    std::vector<Instant> times;
+    for (Instant const& time : trajectory->Points()) {
+      times.push_back(time);
+    }
+    return times;
+  }
+
   static std::vector<Instant> Times(
       not_null<FakeTrajectory const*> const trajectory) {
     std::vector<Instant> times;
@@ -755,6 +764,44 @@ TEST_F(ForkableTest, FrontBack) {
   EXPECT_EQ(t5_, fork2->back());
 }
 
+TEST_F(ForkableTest, Points) {
+  EXPECT_THAT(PointTimes(&trajectory_), ElementsAre());
+
+  trajectory_.push_back(t1_);
+  trajectory_.push_back(t2_);
+  trajectory_.push_back(t3_);
+  EXPECT_THAT(PointTimes(&trajectory_), ElementsAre(t1_, t2_, t3_));
+
+  // An empty fork, and forks at the fork time of their parent.
+  not_null<FakeTrajectory*> const fork1 =
+      trajectory_.NewFork(trajectory_.timeline_find(t2_));
+  not_null<FakeTrajectory*> const fork2 =
+      fork1->NewFork(fork1->timeline_end());
+  not_null<FakeTrajectory*> const fork3 =
+      fork2->NewFork(fork2->timeline_end());
+  EXPECT_THAT(PointTimes(fork1), ElementsAre(t1_, t2_));
+  EXPECT_THAT(PointTimes(fork3), ElementsAre(t1_, t2_));
+
+  fork1->push_back(t3_);
+  fork1->push_back(t4_);
+  fork3->push_back(t5_);
+  EXPECT_THAT(PointTimes(fork1), ElementsAre(t1_, t2_, t3_, t4_));
+  EXPECT_THAT(PointTimes(fork2), ElementsAre(t1_, t2_));
+  EXPECT_THAT(PointTimes(fork3), ElementsAre(t1_, t2_, t5_));
+
+  // A fork at the last point of a fork.
+  not_null<FakeTrajectory*> const fork4 =
+      fork1->NewFork(fork1->timeline_find(t4_));
+  fork4->push_back(t5_);
+  EXPECT_THAT(PointTimes(fork4), ElementsAre(t1_, t2_, t3_, t4_, t5_));
+
+  for (not_null<FakeTrajectory const*> const trajectory :
+       std::vector<not_null<FakeTrajectory const*>>{
+           &trajectory_, fork1, fork2, fork3, fork4}) {
+    EXPECT_EQ(Times(trajectory), PointTimes(trajectory));
+  }
+}
+
 }  // namespace internal_forkable
 }  // namespace physics
 }  // namespace principia
@@ -63,6 +63,11 @@ class MockEphemeris : public Ephemeris<Frame> {
       ComputeGravitationalAccelerationOnMasslessBody,
       Vector<Acceleration, Frame>(Position<Frame> const& position,
                                   Instant const & t));
+  MOCK_CONST_METHOD3_T(
+      ComputeGravitationalAccelerationsOnMasslessBodies,
+      Status(std::vector<Position<Frame>> const& positions,
+             Instant const& t,
+             std::vector<Vector<Acceleration, Frame>>& accelerations));
 
   // NOTE(phl): This overload introduces ambiguities in the expectations.
   // MOCK_CONST_METHOD2_T(
@@ -87,6 +92,10 @@ class MockEphemeris : public Ephemeris<Frame> {
 
   MOCK_CONST_METHOD1_T(WriteToMessage,
                        void(not_null<serialization::Ephemeris*> message));
+  MOCK_CONST_METHOD2_T(WriteDeltaToMessage,
+                       std::vector<Instant>(
+                           not_null<serialization::Ephemeris*> message,
+                           std::vector<Instant> const& omitted_t_maxes));
 
   MOCK_CONST_METHOD0_T(t_min_locked, Instant());
 };
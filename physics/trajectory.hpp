@@ -1,6 +1,8 @@
 ﻿
 #pragma once
 
+#include <vector>
+
 #include "base/not_null.hpp"
 #include "geometry/named_quantities.hpp"
 #include "physics/degrees_of_freedom.hpp"
@@ -31,6 +33,15 @@ class Trajectory {
   virtual Velocity<Frame> EvaluateVelocity(Instant const& time) const = 0;
   virtual DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(
       Instant const& time) const = 0;
+
+  // Evaluates the trajectory at each of the given |times|, which must be
+  // sorted in increasing order and in [t_min(), t_max()], and stores the
+  // results in |degrees_of_freedom|, whose previous contents are discarded.
+  // The results are the same as those of the above function, but the
+  // underlying data is traversed only once.
+  virtual void EvaluateDegreesOfFreedom(
+      std::vector<Instant> const& times,
+      std::vector<DegreesOfFreedom<Frame>>& degrees_of_freedom) const = 0;
 };
 
 }  // namespace internal_trajectory
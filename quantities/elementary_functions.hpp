@@ -1,6 +1,8 @@
 ﻿
 #pragma once
 
+#include <vector>
+
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 
@@ -39,6 +41,18 @@ double Sin(Angle const& α);
 double Cos(Angle const& α);
 double Tan(Angle const& α);
 
+// Element-wise versions of the above functions: the result for |x[i]| is stored
+// in |result[i]|, and |result| is resized to the size of |x|.  The results are
+// identical to those of the scalar functions.  |Sqrt| and |Cbrt| process two
+// elements at a time with SSE; |Sin| and |Cos| call the standard library, as
+// there is no vectorized implementation with the same accuracy.
+template<typename Q>
+void Sqrt(std::vector<Q> const& x, std::vector<SquareRoot<Q>>& result);
+template<typename Q>
+void Cbrt(std::vector<Q> const& x, std::vector<CubeRoot<Q>>& result);
+void Sin(std::vector<Angle> const& α, std::vector<double>& result);
+void Cos(std::vector<Angle> const& α, std::vector<double>& result);
+
 Angle ArcSin(double x);
 Angle ArcCos(double x);
 Angle ArcTan(double x);
@@ -3,11 +3,15 @@
 
 #include "quantities/elementary_functions.hpp"
 
+#include <immintrin.h>
 #include <pmmintrin.h>
 
+#include <algorithm>
 #include <cmath>
 #include <type_traits>
+#include <vector>
 
+#include "base/macros.hpp"
 #include "quantities/si.hpp"
 #include "numerics/cbrt.hpp"
 
@@ -21,9 +25,18 @@ template<typename Q1, typename Q2>
 Product<Q1, Q2> FusedMultiplyAdd(Q1 const& x,
                                  Q2 const& y,
                                  Product<Q1, Q2> const& z) {
+#if PRINCIPIA_USE_AVX2_FMA_INTRINSICS
+  // Make sure that we get an FMA instruction rather than a library call.
+  return SIUnit<Product<Q1, Q2>>() *
+         _mm_cvtsd_f64(
+             _mm_fmadd_sd(_mm_set_sd(x / SIUnit<Q1>()),
+                          _mm_set_sd(y / SIUnit<Q2>()),
+                          _mm_set_sd(z / SIUnit<Product<Q1, Q2>>())));
+#else
   return SIUnit<Product<Q1, Q2>>() * std::fma(x / SIUnit<Q1>(),
                                               y / SIUnit<Q2>(),
                                               z / SIUnit<Product<Q1, Q2>>());
+#endif
 }
 
 template<typename Q>
@@ -57,6 +70,46 @@ CubeRoot<Q> Cbrt(Q const& x) {
   return SIUnit<CubeRoot<Q>>() * numerics::Cbrt(x / SIUnit<Q>());
 }
 
+template<typename Q>
+void Sqrt(std::vector<Q> const& x, std::vector<SquareRoot<Q>>& result) {
+  int const size = x.size();
+  result.resize(size);
+  int i = 0;
+#if PRINCIPIA_USE_SSE3_INTRINSICS
+  for (; i + 1 < size; i += 2) {
+    __m128d const x_128d =
+        _mm_set_pd(x[i + 1] / SIUnit<Q>(), x[i] / SIUnit<Q>());
+    __m128d const sqrt_x_128d = _mm_sqrt_pd(x_128d);
+    result[i] = SIUnit<SquareRoot<Q>>() * _mm_cvtsd_f64(sqrt_x_128d);
+    result[i + 1] = SIUnit<SquareRoot<Q>>() *
+                    _mm_cvtsd_f64(_mm_unpackhi_pd(sqrt_x_128d, sqrt_x_128d));
+  }
+#endif
+  for (; i < size; ++i) {
+    result[i] = Sqrt(x[i]);
+  }
+}
+
+template<typename Q>
+void Cbrt(std::vector<Q> const& x, std::vector<CubeRoot<Q>>& result) {
+  // The values are converted to |double| by chunks for |numerics::Cbrt|.
+  constexpr int chunk_size = 64;
+  double y[chunk_size];
+  double cbrt_y[chunk_size];
+  int const size = x.size();
+  result.resize(size);
+  for (int first = 0; first < size; first += chunk_size) {
+    int const last = std::min(first + chunk_size, size);
+    for (int i = first; i < last; ++i) {
+      y[i - first] = x[i] / SIUnit<Q>();
+    }
+    numerics::Cbrt(y, last - first, cbrt_y);
+    for (int i = first; i < last; ++i) {
+      result[i] = SIUnit<CubeRoot<Q>>() * cbrt_y[i - first];
+    }
+  }
+}
+
 template<int exponent>
 constexpr double Pow(double x) {
   return std::pow(x, exponent);
@@ -117,6 +170,20 @@ inline double Tan(Angle const& α) {
   return std::tan(α / Radian);
 }
 
+inline void Sin(std::vector<Angle> const& α, std::vector<double>& result) {
+  result.resize(α.size());
+  for (int i = 0; i < α.size(); ++i) {
+    result[i] = Sin(α[i]);
+  }
+}
+
+inline void Cos(std::vector<Angle> const& α, std::vector<double>& result) {
+  result.resize(α.size());
+  for (int i = 0; i < α.size(); ++i) {
+    result[i] = Cos(α[i]);
+  }
+}
+
 inline Angle ArcSin(double const x) {
   return std::asin(x) * Radian;
 }
@@ -1,6 +1,7 @@
 ﻿
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "google/protobuf/stubs/common.h"
 #include "glog/logging.h"
@@ -194,5 +195,35 @@ TEST_F(ElementaryFunctionsTest, ExpLogAndRoots) {
       AlmostEquals(std::exp(std::log(Gallon / Pow<3>(Foot)) / 3) * Foot, 0, 1));
 }
 
+TEST_F(ElementaryFunctionsTest, Arrays) {
+  std::vector<Area> const areas = {Rood, 2 * Rood, 3 * Rood};
+  std::vector<Length> square_roots;
+  Sqrt(areas, square_roots);
+  ASSERT_EQ(3, square_roots.size());
+  for (int i = 0; i < areas.size(); ++i) {
+    EXPECT_EQ(Sqrt(areas[i]), square_roots[i]);
+  }
+
+  std::vector<Volume> const volumes = {Gallon, -Gallon, Volume(), 7 * Gallon};
+  std::vector<Length> cube_roots;
+  Cbrt(volumes, cube_roots);
+  ASSERT_EQ(4, cube_roots.size());
+  for (int i = 0; i < volumes.size(); ++i) {
+    EXPECT_EQ(Cbrt(volumes[i]), cube_roots[i]);
+  }
+
+  std::vector<Angle> const angles = {0 * Degree, 30 * Degree, 1 * Radian};
+  std::vector<double> sines;
+  std::vector<double> cosines;
+  Sin(angles, sines);
+  Cos(angles, cosines);
+  ASSERT_EQ(3, sines.size());
+  ASSERT_EQ(3, cosines.size());
+  for (int i = 0; i < angles.size(); ++i) {
+    EXPECT_EQ(Sin(angles[i]), sines[i]);
+    EXPECT_EQ(Cos(angles[i]), cosines[i]);
+  }
+}
+
 }  // namespace quantities
 }  // namespace principia
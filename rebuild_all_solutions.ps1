@@ -8,7 +8,9 @@ $dependencies = @(".\Google\glog\google-glog.sln",
                   ".\Google\protobuf\vsprojects\protobuf.sln",
                   ".\Google\benchmark\msvc\google-benchmark.sln",
                   ".\Google\gipfeli\msvc\gipfeli.sln",
-                  ".\Google\abseil-cpp\msvc\abseil-cpp.sln")
+                  ".\Google\abseil-cpp\msvc\abseil-cpp.sln",
+                  ".\Third Party\lz4\build\VS2017\lz4.sln",
+                  ".\Third Party\zstd\build\VS2010\zstd.sln")
 
 push-location -path "Google"
 
@@ -34,6 +36,31 @@ foreach ($repository in @("glog", "googletest", "protobuf", "benchmark",
 }
 pop-location
 
+if (!(test-path -path "Third Party")) {
+  new-item -path "Third Party" -itemtype directory | out-null
+}
+push-location -path "Third Party"
+
+# We don't maintain forks of these repositories, so they are pinned to a
+# release; keep in sync with install_deps.sh.
+$pinned_tags = @{"lz4/lz4" = "v1.9.2"; "facebook/zstd" = "v1.4.4"}
+foreach ($repository in @("lz4/lz4", "facebook/zstd")) {
+  $directory = $repository.split("/")[1]
+  if (!(test-path -path $directory)) {
+    git clone ("https://github.com/" + $repository + ".git")
+  }
+  push-location $directory
+  git fetch --tags
+  git checkout $pinned_tags[$repository]
+  if (!$?) {
+    pop-location
+    pop-location
+    exit 1
+  }
+  pop-location
+}
+pop-location
+
 function build_solutions($solutions) {
   foreach ($configuration in "Debug", "Release") {
     foreach ($platform in "x64") {